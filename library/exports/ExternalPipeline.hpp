@@ -5,6 +5,7 @@
 #include <cassert>
 #include <array>
 #include <bitset>
+#include <cstdint>
 
 enum class ExternalBlendOP : std::uint8_t
 {
@@ -51,6 +52,48 @@ struct ExternalBlendState
 	}
 };
 
+// FNV-1a, so the hash of a pipeline is the same on every run.
+class ExternalPipelineHash
+{
+public:
+	ExternalPipelineHash() : m_hash{ s_offsetBasis } {}
+
+	void Add(void const* data, size_t dataSize) noexcept
+	{
+		auto bytes = static_cast<std::uint8_t const*>(data);
+
+		for (size_t index = 0u; index < dataSize; ++index)
+		{
+			m_hash ^= bytes[index];
+			m_hash *= s_prime;
+		}
+	}
+
+	template<typename T>
+	void AddValue(T value) noexcept
+	{
+		Add(&value, sizeof(T));
+	}
+
+	void AddShader(const ShaderName& shaderName) noexcept
+	{
+		const std::wstring name = shaderName.GetName();
+
+		// The length is added as well, so the names of two shaders can't run into each other.
+		AddValue(std::size(name));
+		Add(std::data(name), std::size(name) * sizeof(wchar_t));
+	}
+
+	[[nodiscard]]
+	std::uint64_t Get() const noexcept { return m_hash; }
+
+private:
+	std::uint64_t m_hash;
+
+	static constexpr std::uint64_t s_offsetBasis = 14695981039346656037ull;
+	static constexpr std::uint64_t s_prime       = 1099511628211ull;
+};
+
 class ExternalGraphicsPipeline
 {
 	enum class State : std::uint32_t
@@ -183,6 +226,36 @@ public:
 			m_stencilFormat == other.m_stencilFormat;
 	}
 
+	// Everything which is compared for equality is hashed, so the same pipelines would always
+	// have the same hash.
+	[[nodiscard]]
+	std::uint64_t GetHash() const noexcept
+	{
+		ExternalPipelineHash hash{};
+
+		hash.AddShader(m_vertexShader);
+		hash.AddShader(m_fragmentShader);
+		hash.AddValue(m_renderTargetCount);
+		hash.Add(std::data(m_renderTargetFormats), std::size(m_renderTargetFormats));
+		hash.AddValue(m_depthFormat);
+		hash.AddValue(m_stencilFormat);
+
+		for (const ExternalBlendState& blendState : m_blendStates)
+		{
+			hash.AddValue(blendState.enabled);
+			hash.AddValue(blendState.alphaBlendOP);
+			hash.AddValue(blendState.colourBlendOP);
+			hash.AddValue(blendState.alphaBlendSrc);
+			hash.AddValue(blendState.alphaBlendDst);
+			hash.AddValue(blendState.colourBlendSrc);
+			hash.AddValue(blendState.colourBlendDst);
+		}
+
+		hash.AddValue(m_pipelineStates.to_ullong());
+
+		return hash.Get();
+	}
+
 private:
 	[[nodiscard]]
 	bool AreRenderTargetFormatsSame(const RenderFormats_t& otherRenderTargetFormats) const noexcept
@@ -305,6 +378,16 @@ public:
 	[[nodiscard]]
 	const ShaderName& GetComputeShader() const noexcept { return m_computeShader; }
 
+	[[nodiscard]]
+	std::uint64_t GetHash() const noexcept
+	{
+		ExternalPipelineHash hash{};
+
+		hash.AddShader(m_computeShader);
+
+		return hash.Get();
+	}
+
 private:
 	ShaderName m_computeShader;
 
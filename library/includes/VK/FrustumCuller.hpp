@@ -0,0 +1,135 @@
+#ifndef FRUSTUM_CULLER_HPP_
+#define FRUSTUM_CULLER_HPP_
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <future>
+#include <functional>
+#include <algorithm>
+#include <ThreadPool.hpp>
+
+#include <ModelContainer.hpp>
+#include <BoundingVolumes.hpp>
+#include <Camera.hpp>
+#include <DirectXMath.h>
+
+namespace Terra
+{
+// Culls the models against the view frustum on the CPU, for the engines which don't have a
+// culling compute pass. The models of each bundle are split into chunks, which are culled in
+// parallel on the thread pool. The result is a visibility flag per model, which also includes
+// the visibility set on the model.
+class FrustumCuller
+{
+public:
+	FrustumCuller(ThreadPool* threadPool);
+
+	void SetEnabled(bool value) noexcept { m_isEnabled = value; }
+
+	// The planes should be in the world space.
+	void SetFrustum(const Frustum& frustum) noexcept;
+
+	// Must be called before culling the bundles. The models which aren't in any of the culled
+	// bundles will be invisible.
+	void Reset(size_t modelCount);
+
+	// The culling is asynchronous, so the arguments must stay alive until Wait is called.
+	template<class MeshBundle_t>
+	void CullModels(
+		const ModelContainer& modelContainer,
+		const std::vector<std::uint32_t>& modelIndicesInContainer, const MeshBundle_t& meshBundle
+	) {
+		const size_t modelCount = std::size(modelIndicesInContainer);
+
+		for (size_t index = 0u; index < modelCount; index += s_cullChunkSize)
+			m_waitObjs.emplace_back(m_threadPool->SubmitWork(std::function{
+				[this, &modelContainer, &modelIndicesInContainer, &meshBundle, index, modelCount]
+				{
+					CullChunk(
+						modelContainer, modelIndicesInContainer, meshBundle, index,
+						std::min(index + s_cullChunkSize, modelCount)
+					);
+				}}));
+	}
+
+	void Wait();
+
+	// The box is in the model space and is transformed by the model matrix and the offset.
+	[[nodiscard]]
+	bool IsInFrustum(
+		const AxisAlignedBoundingBox& aabb, const DirectX::XMMATRIX& modelMatrix,
+		const DirectX::XMFLOAT3& modelOffset
+	) const noexcept;
+
+	[[nodiscard]]
+	bool IsEnabled() const noexcept { return m_isEnabled; }
+
+	// Indexed by the model indices in the container.
+	[[nodiscard]]
+	const std::vector<std::uint8_t>& GetModelVisibilities() const noexcept
+	{
+		return m_modelVisibilities;
+	}
+
+private:
+	template<class MeshBundle_t>
+	void CullChunk(
+		const ModelContainer& modelContainer,
+		const std::vector<std::uint32_t>& modelIndicesInContainer, const MeshBundle_t& meshBundle,
+		size_t startIndex, size_t endIndex
+	) noexcept {
+		const std::vector<DirectX::XMMATRIX>& modelMatrices = modelContainer.GetModelMatrices();
+		const std::vector<DirectX::XMFLOAT3>& modelOffsets  = modelContainer.GetModelOffsets();
+		const std::vector<std::uint32_t>& meshIndices       = modelContainer.GetMeshIndices();
+		const std::vector<std::uint8_t>& visibilities       = modelContainer.GetVisibilities();
+
+		for (size_t index = startIndex; index < endIndex; ++index)
+		{
+			const std::uint32_t modelIndex = modelIndicesInContainer[index];
+
+			if (!visibilities[modelIndex])
+				continue;
+
+			const AxisAlignedBoundingBox& aabb
+				= meshBundle.GetMeshDetails(meshIndices[modelIndex]).aabb;
+
+			m_modelVisibilities[modelIndex] = static_cast<std::uint8_t>(
+				IsInFrustum(aabb, modelMatrices[modelIndex], modelOffsets[modelIndex])
+			);
+		}
+	}
+
+private:
+	// Each task should be large enough to be worth the submission.
+	static constexpr size_t s_cullChunkSize = 2048u;
+
+	ThreadPool*                       m_threadPool;
+	std::array<DirectX::XMVECTOR, 6u> m_planes;
+	std::vector<std::uint8_t>         m_modelVisibilities;
+	std::vector<std::future<void>>    m_waitObjs;
+	bool                              m_isEnabled;
+
+public:
+	FrustumCuller(const FrustumCuller&) = delete;
+	FrustumCuller& operator=(const FrustumCuller&) = delete;
+
+	FrustumCuller(FrustumCuller&& other) noexcept
+		: m_threadPool{ other.m_threadPool },
+		m_planes{ other.m_planes },
+		m_modelVisibilities{ std::move(other.m_modelVisibilities) },
+		m_waitObjs{ std::move(other.m_waitObjs) },
+		m_isEnabled{ other.m_isEnabled }
+	{}
+	FrustumCuller& operator=(FrustumCuller&& other) noexcept
+	{
+		m_threadPool        = other.m_threadPool;
+		m_planes            = other.m_planes;
+		m_modelVisibilities = std::move(other.m_modelVisibilities);
+		m_waitObjs          = std::move(other.m_waitObjs);
+		m_isEnabled         = other.m_isEnabled;
+
+		return *this;
+	}
+};
+}
+#endif
@@ -59,12 +59,77 @@ public:
 		m_terra.GetRenderEngine().SetShaderPath(path);
 	}
 
+	// Only available with the VS Individual and the Mesh Shader engines.
+	void SetCPUCulling(bool value) noexcept
+	{
+		m_terra.GetRenderEngine().SetCPUCulling(value);
+	}
+
+	// Only available with the VS Indirect engine, the MS Indirect one only culls against the
+	// frustum. The models hidden behind the ones drawn in the last frame aren't drawn. The depth
+	// texture must be created with sampleTexture and the device should be idle. Must be called
+	// again if the depth texture is recreated.
+	void SetOcclusionCullingDepth(std::uint32_t externalTextureIndex)
+	{
+		m_terra.GetRenderEngine().SetOcclusionCullingDepth(externalTextureIndex);
+	}
+
+	// Only available with the VS Indirect engine.
+	void DisableOcclusionCulling()
+	{
+		m_terra.GetRenderEngine().DisableOcclusionCulling();
+	}
+
+	// Only available with the Indirect engines. The draw counts are read back once the frame
+	// has finished on the GPU.
+	void SetDrawCountReadback(bool value)
+	{
+		m_terra.GetRenderEngine().SetDrawCountReadback(value);
+	}
+
+	// Only available with the Indirect engines.
+	[[nodiscard]]
+	std::uint32_t GetDrawCount(size_t frameIndex) const noexcept
+	{
+		return m_terra.GetRenderEngine().GetDrawCount(frameIndex);
+	}
+
+	// The pipeline cache will be loaded from and saved to a file in the directory.
+	void SetPipelineCacheDirectory(const wchar_t* directory)
+	{
+		m_terra.GetRenderEngine().SetPipelineCacheDirectory(directory);
+	}
+
+	// Every pipeline which is added is recorded in a manifest in the directory. The pipelines
+	// recorded in the previous runs are compiled in FinaliseInitialisation, so this should be
+	// called before it.
+	void SetPipelineManifestDirectory(const wchar_t* directory)
+	{
+		m_terra.GetRenderEngine().SetPipelineManifestDirectory(directory);
+	}
+
 	[[nodiscard]]
 	std::uint32_t AddGraphicsPipeline(const ExternalGraphicsPipeline& gfxPipeline)
 	{
 		return m_terra.GetRenderEngine().AddGraphicsPipeline(gfxPipeline);
 	}
 
+	// The pipelines are compiled in parallel.
+	[[nodiscard]]
+	std::vector<std::uint32_t> AddGraphicsPipelines(
+		const std::vector<ExternalGraphicsPipeline>& gfxPipelines
+	) {
+		return m_terra.GetRenderEngine().AddGraphicsPipelines(gfxPipelines);
+	}
+
+	// Returns straight away. The models using the pipeline won't be drawn until it has
+	// been compiled.
+	[[nodiscard]]
+	std::uint32_t AddGraphicsPipelineAsync(const ExternalGraphicsPipeline& gfxPipeline)
+	{
+		return m_terra.GetRenderEngine().AddGraphicsPipelineAsync(gfxPipeline);
+	}
+
 	void ReconfigureModelPipelinesInBundle(
 		std::uint32_t modelBundleIndex, std::uint32_t decreasedModelsPipelineIndex,
 		std::uint32_t increasedModelsPipelineIndex
@@ -151,12 +216,12 @@ public:
 		return m_terra.WaitForCurrentBackBuffer();
 	}
 
-	void UpdateCamera(size_t frameIndex, const Camera& cameraData) const noexcept
+	void UpdateCamera(size_t frameIndex, const Camera& cameraData) noexcept
 	{
 		m_terra.GetRenderEngine().UpdateCamera(frameIndex, cameraData);
 	}
 
-	void Update(size_t frameIndex) const noexcept
+	void Update(size_t frameIndex) noexcept
 	{
 		m_terra.GetRenderEngine().Update(frameIndex);
 	}
@@ -168,6 +233,60 @@ public:
 
 	void WaitForGPUToFinish() { m_terra.WaitForGPUToFinish(); }
 
+	// Can be used to compare the pipeline creation on a cold and a warm cache.
+	[[nodiscard]]
+	std::uint32_t GetPipelineCacheHitCount() const noexcept
+	{
+		return m_terra.GetRenderEngine().GetPipelineCache().GetHitCount();
+	}
+	[[nodiscard]]
+	std::uint32_t GetPipelineCacheMissCount() const noexcept
+	{
+		return m_terra.GetRenderEngine().GetPipelineCache().GetMissCount();
+	}
+
+	// Can be used to check the memory pressure, before a MemoryException is thrown.
+	[[nodiscard]]
+	std::vector<MemoryManager::HeapBudget> GetHeapBudgets() const
+	{
+		return m_terra.GetRenderEngine().GetMemoryManager()->GetHeapBudgets();
+	}
+
+	// The timestamps are read when the frame is waited on again, so the timings are of the last
+	// finished frame.
+	void SetGpuProfiling(bool value) noexcept
+	{
+		m_terra.GetRenderEngine().GetGpuProfiler().SetEnabled(value);
+	}
+
+	// The GPU time of each engine stage and render pass.
+	[[nodiscard]]
+	std::vector<GpuScopeTiming> GetGpuTimings() const
+	{
+		return m_terra.GetRenderEngine().GetGpuProfiler().GetTimings();
+	}
+
+	// The GPU timings of every frame from now are kept till the capture is saved.
+	void StartGpuTraceCapture()
+	{
+		m_terra.GetRenderEngine().GetGpuProfiler().StartTraceCapture();
+	}
+
+	// Saves the capture as a Chrome trace, which can be opened in chrome://tracing or Perfetto.
+	[[nodiscard]]
+	bool SaveGpuTraceCapture(const wchar_t* filePath)
+	{
+		return m_terra.GetRenderEngine().GetGpuProfiler().SaveTraceCapture(filePath);
+	}
+
+	// The zones are only recorded if the library was built with the TERRA_CPU_TRACING option.
+	// Each thread keeps its last zones, so this can be called at any point.
+	[[nodiscard]]
+	bool SaveCpuTrace(const wchar_t* filePath) const
+	{
+		return CpuTracer::Get().SaveToFile(filePath);
+	}
+
 public:
 	// External stuff
 	[[nodiscard]]
@@ -193,6 +312,23 @@ public:
 		);
 	}
 
+	// Can be called from any thread.
+	[[nodiscard]]
+	std::uint64_t StreamExternalBufferGPUOnlyData(
+		std::uint32_t externalBufferIndex, std::shared_ptr<void> cpuData,
+		size_t srcDataSizeInBytes, size_t dstBufferOffset
+	) {
+		return m_terra.GetRenderEngine().StreamExternalBufferGPUOnlyData(
+			externalBufferIndex, std::move(cpuData), srcDataSizeInBytes, dstBufferOffset
+		);
+	}
+
+	[[nodiscard]]
+	bool IsStreamingRequestComplete(std::uint64_t requestID)
+	{
+		return m_terra.GetRenderEngine().IsStreamingRequestComplete(requestID);
+	}
+
 	void QueueExternalBufferGPUCopy(
 		std::uint32_t externalBufferSrcIndex, std::uint32_t externalBufferDstIndex,
 		size_t dstBufferOffset, size_t srcBufferOffset = 0, size_t srcDataSizeInBytes = 0
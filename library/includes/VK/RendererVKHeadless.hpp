@@ -0,0 +1,407 @@
+#ifndef VK_RENDERER_VK_HEADLESS_HPP_
+#define VK_RENDERER_VK_HEADLESS_HPP_
+#include <vulkan/vulkan.hpp>
+#include <string>
+#include <array>
+#include <ThreadPool.hpp>
+
+#include <RendererCommonTypes.hpp>
+#include <TerraHeadless.hpp>
+
+namespace Terra
+{
+template<class RenderEngine_t>
+class RendererVKHeadless
+{
+public:
+	RendererVKHeadless(
+		const char* appName, std::uint32_t width, std::uint32_t height, std::uint32_t bufferCount,
+		std::shared_ptr<ThreadPool>&& threadPool
+	) : m_terra{ appName, width, height, bufferCount, std::move(threadPool) }
+	{}
+
+	void FinaliseInitialisation()
+	{
+		m_terra.FinaliseInitialisation();
+	}
+
+	void Resize(std::uint32_t width, std::uint32_t height)
+	{
+		m_terra.Resize(width, height);
+	}
+
+	[[nodiscard]]
+	RendererType::Extent GetCurrentRenderingExtent() const noexcept
+	{
+		const VkExtent2D currentRenderArea = m_terra.GetCurrentRenderArea();
+
+		return RendererType::Extent
+		{
+			.width  = currentRenderArea.width,
+			.height = currentRenderArea.height
+		};
+	}
+
+	void SetShaderPath(const wchar_t* path)
+	{
+		m_terra.GetRenderEngine().SetShaderPath(path);
+	}
+
+	// Only available with the VS Individual and the Mesh Shader engines.
+	void SetCPUCulling(bool value) noexcept
+	{
+		m_terra.GetRenderEngine().SetCPUCulling(value);
+	}
+
+	// Only available with the VS Indirect engine, the MS Indirect one only culls against the
+	// frustum. The models hidden behind the ones drawn in the last frame aren't drawn. The depth
+	// texture must be created with sampleTexture and the device should be idle. Must be called
+	// again if the depth texture is recreated.
+	void SetOcclusionCullingDepth(std::uint32_t externalTextureIndex)
+	{
+		m_terra.GetRenderEngine().SetOcclusionCullingDepth(externalTextureIndex);
+	}
+
+	// Only available with the VS Indirect engine.
+	void DisableOcclusionCulling()
+	{
+		m_terra.GetRenderEngine().DisableOcclusionCulling();
+	}
+
+	// Only available with the Indirect engines. The draw counts are read back once the frame
+	// has finished on the GPU.
+	void SetDrawCountReadback(bool value)
+	{
+		m_terra.GetRenderEngine().SetDrawCountReadback(value);
+	}
+
+	// Only available with the Indirect engines.
+	[[nodiscard]]
+	std::uint32_t GetDrawCount(size_t frameIndex) const noexcept
+	{
+		return m_terra.GetRenderEngine().GetDrawCount(frameIndex);
+	}
+
+	// The pipeline cache will be loaded from and saved to a file in the directory.
+	void SetPipelineCacheDirectory(const wchar_t* directory)
+	{
+		m_terra.GetRenderEngine().SetPipelineCacheDirectory(directory);
+	}
+
+	// Every pipeline which is added is recorded in a manifest in the directory. The pipelines
+	// recorded in the previous runs are compiled in FinaliseInitialisation, so this should be
+	// called before it.
+	void SetPipelineManifestDirectory(const wchar_t* directory)
+	{
+		m_terra.GetRenderEngine().SetPipelineManifestDirectory(directory);
+	}
+
+	[[nodiscard]]
+	std::uint32_t AddGraphicsPipeline(const ExternalGraphicsPipeline& gfxPipeline)
+	{
+		return m_terra.GetRenderEngine().AddGraphicsPipeline(gfxPipeline);
+	}
+
+	// The pipelines are compiled in parallel.
+	[[nodiscard]]
+	std::vector<std::uint32_t> AddGraphicsPipelines(
+		const std::vector<ExternalGraphicsPipeline>& gfxPipelines
+	) {
+		return m_terra.GetRenderEngine().AddGraphicsPipelines(gfxPipelines);
+	}
+
+	// Returns straight away. The models using the pipeline won't be drawn until it has
+	// been compiled.
+	[[nodiscard]]
+	std::uint32_t AddGraphicsPipelineAsync(const ExternalGraphicsPipeline& gfxPipeline)
+	{
+		return m_terra.GetRenderEngine().AddGraphicsPipelineAsync(gfxPipeline);
+	}
+
+	void ReconfigureModelPipelinesInBundle(
+		std::uint32_t modelBundleIndex, std::uint32_t decreasedModelsPipelineIndex,
+		std::uint32_t increasedModelsPipelineIndex
+	) {
+		m_terra.GetRenderEngine().ReconfigureModelPipelinesInBundle(
+			modelBundleIndex, decreasedModelsPipelineIndex, increasedModelsPipelineIndex
+		);
+	}
+
+	void RemoveGraphicsPipeline(std::uint32_t pipelineIndex) noexcept
+	{
+		m_terra.GetRenderEngine().RemoveGraphicsPipeline(pipelineIndex);
+	}
+
+	[[nodiscard]]
+	size_t AddTexture(STexture&& texture)
+	{
+		return m_terra.AddTextureAsCombined(std::move(texture));
+	}
+
+	void UnbindTexture(size_t textureIndex, std::uint32_t bindingIndex)
+	{
+		m_terra.GetRenderEngine().UnbindCombinedTexture(textureIndex, bindingIndex);
+	}
+
+	[[nodiscard]]
+	std::uint32_t BindTexture(size_t textureIndex)
+	{
+		return m_terra.BindCombinedTexture(textureIndex);
+	}
+
+	void UnbindExternalTexture(std::uint32_t bindingIndex)
+	{
+		m_terra.GetRenderEngine().UnbindExternalTexture(bindingIndex);
+	}
+
+	void RebindExternalTexture(size_t textureIndex, std::uint32_t bindingIndex)
+	{
+		m_terra.GetRenderEngine().RebindExternalTexture(textureIndex, bindingIndex);
+	}
+
+	[[nodiscard]]
+	std::uint32_t BindExternalTexture(size_t textureIndex)
+	{
+		return m_terra.GetRenderEngine().BindExternalTexture(textureIndex);
+	}
+
+	void RemoveTexture(size_t textureIndex)
+	{
+		m_terra.RemoveTexture(textureIndex);
+	}
+
+	void SetModelContainer(std::shared_ptr<ModelContainer> modelContainer) noexcept
+	{
+		m_terra.GetRenderEngine().SetModelContainer(std::move(modelContainer));
+	}
+
+	[[nodiscard]]
+	std::uint32_t AddModelBundle(std::shared_ptr<ModelBundle>&& modelBundle)
+	{
+		return m_terra.AddModelBundle(std::move(modelBundle));
+	}
+
+	[[nodiscard]]
+	std::shared_ptr<ModelBundle> RemoveModelBundle(std::uint32_t bundleIndex) noexcept
+	{
+		return m_terra.GetRenderEngine().RemoveModelBundle(bundleIndex);
+	}
+
+	[[nodiscard]]
+	std::uint32_t AddMeshBundle(MeshBundleTemporaryData&& meshBundle)
+	{
+		return m_terra.AddMeshBundle(std::move(meshBundle));
+	}
+
+	void RemoveMeshBundle(std::uint32_t bundleIndex) noexcept
+	{
+		m_terra.GetRenderEngine().RemoveMeshBundle(bundleIndex);
+	}
+
+	[[nodiscard]]
+	size_t WaitForCurrentBackBuffer()
+	{
+		return m_terra.WaitForCurrentBackBuffer();
+	}
+
+	void UpdateCamera(size_t frameIndex, const Camera& cameraData) noexcept
+	{
+		m_terra.GetRenderEngine().UpdateCamera(frameIndex, cameraData);
+	}
+
+	void Update(size_t frameIndex) noexcept
+	{
+		m_terra.GetRenderEngine().Update(frameIndex);
+	}
+
+	void Render(size_t frameIndex)
+	{
+		m_terra.Render(frameIndex);
+	}
+
+	void WaitForGPUToFinish() { m_terra.WaitForGPUToFinish(); }
+
+	// Can be used to compare the pipeline creation on a cold and a warm cache.
+	[[nodiscard]]
+	std::uint32_t GetPipelineCacheHitCount() const noexcept
+	{
+		return m_terra.GetRenderEngine().GetPipelineCache().GetHitCount();
+	}
+	[[nodiscard]]
+	std::uint32_t GetPipelineCacheMissCount() const noexcept
+	{
+		return m_terra.GetRenderEngine().GetPipelineCache().GetMissCount();
+	}
+
+	// Can be used to check the memory pressure, before a MemoryException is thrown.
+	[[nodiscard]]
+	std::vector<MemoryManager::HeapBudget> GetHeapBudgets() const
+	{
+		return m_terra.GetRenderEngine().GetMemoryManager()->GetHeapBudgets();
+	}
+
+	// The timestamps are read when the frame is waited on again, so the timings are of the last
+	// finished frame.
+	void SetGpuProfiling(bool value) noexcept
+	{
+		m_terra.GetRenderEngine().GetGpuProfiler().SetEnabled(value);
+	}
+
+	// The GPU time of each engine stage and render pass.
+	[[nodiscard]]
+	std::vector<GpuScopeTiming> GetGpuTimings() const
+	{
+		return m_terra.GetRenderEngine().GetGpuProfiler().GetTimings();
+	}
+
+	// The GPU timings of every frame from now are kept till the capture is saved.
+	void StartGpuTraceCapture()
+	{
+		m_terra.GetRenderEngine().GetGpuProfiler().StartTraceCapture();
+	}
+
+	// Saves the capture as a Chrome trace, which can be opened in chrome://tracing or Perfetto.
+	[[nodiscard]]
+	bool SaveGpuTraceCapture(const wchar_t* filePath)
+	{
+		return m_terra.GetRenderEngine().GetGpuProfiler().SaveTraceCapture(filePath);
+	}
+
+	// The zones are only recorded if the library was built with the TERRA_CPU_TRACING option.
+	// Each thread keeps its last zones, so this can be called at any point.
+	[[nodiscard]]
+	bool SaveCpuTrace(const wchar_t* filePath) const
+	{
+		return CpuTracer::Get().SaveToFile(filePath);
+	}
+
+	// The External texture must be created with the copySrc flag.
+	[[nodiscard]]
+	std::uint32_t AddReadbackTexture(std::uint32_t externalTextureIndex)
+	{
+		return m_terra.AddReadbackTexture(externalTextureIndex);
+	}
+
+	void RemoveReadbackTexture(std::uint32_t readbackIndex)
+	{
+		m_terra.RemoveReadbackTexture(readbackIndex);
+	}
+
+	// The data will be from the last time the frame was rendered. So, it can be read after
+	// WaitForCurrentBackBuffer returns the frame index or after WaitForGPUToFinish.
+	[[nodiscard]]
+	std::uint8_t const* GetReadbackData(
+		size_t frameIndex, std::uint32_t readbackIndex
+	) const noexcept {
+		return m_terra.GetReadbackData(frameIndex, readbackIndex);
+	}
+
+	[[nodiscard]]
+	size_t GetReadbackDataSize(size_t frameIndex, std::uint32_t readbackIndex) const noexcept
+	{
+		return m_terra.GetReadbackDataSize(frameIndex, readbackIndex);
+	}
+
+public:
+	// External stuff
+	[[nodiscard]]
+	auto&& GetExternalResourceManager(this auto&& self) noexcept
+	{
+		return std::forward_like<decltype(self)>(
+			self.m_terra.GetRenderEngine().GetExternalResourceManager()
+		);
+	}
+
+	void UpdateExternalBufferDescriptor(
+		const ExternalBufferBindingDetails& bindingDetails
+	) {
+		m_terra.GetRenderEngine().UpdateExternalBufferDescriptor(bindingDetails);
+	}
+
+	void UploadExternalBufferGPUOnlyData(
+		std::uint32_t externalBufferIndex, std::shared_ptr<void> cpuData,
+		size_t srcDataSizeInBytes, size_t dstBufferOffset
+	) {
+		m_terra.GetRenderEngine().UploadExternalBufferGPUOnlyData(
+			externalBufferIndex, std::move(cpuData), srcDataSizeInBytes, dstBufferOffset
+		);
+	}
+
+	// Can be called from any thread.
+	[[nodiscard]]
+	std::uint64_t StreamExternalBufferGPUOnlyData(
+		std::uint32_t externalBufferIndex, std::shared_ptr<void> cpuData,
+		size_t srcDataSizeInBytes, size_t dstBufferOffset
+	) {
+		return m_terra.GetRenderEngine().StreamExternalBufferGPUOnlyData(
+			externalBufferIndex, std::move(cpuData), srcDataSizeInBytes, dstBufferOffset
+		);
+	}
+
+	[[nodiscard]]
+	bool IsStreamingRequestComplete(std::uint64_t requestID)
+	{
+		return m_terra.GetRenderEngine().IsStreamingRequestComplete(requestID);
+	}
+
+	void QueueExternalBufferGPUCopy(
+		std::uint32_t externalBufferSrcIndex, std::uint32_t externalBufferDstIndex,
+		size_t dstBufferOffset, size_t srcBufferOffset = 0, size_t srcDataSizeInBytes = 0
+	) {
+		m_terra.GetRenderEngine().QueueExternalBufferGPUCopy(
+			externalBufferSrcIndex, externalBufferDstIndex, dstBufferOffset, srcBufferOffset,
+			srcDataSizeInBytes
+		);
+	}
+
+	void AddLocalPipelinesInExternalRenderPass(
+		std::uint32_t modelBundleIndex, size_t renderPassIndex
+	) {
+		m_terra.GetRenderEngine().AddLocalPipelinesInExternalRenderPass(
+			modelBundleIndex, renderPassIndex
+		);
+	}
+
+	[[nodiscard]]
+	std::uint32_t AddExternalRenderPass()
+	{
+		return m_terra.GetRenderEngine().AddExternalRenderPass();
+	}
+
+	[[nodiscard]]
+	std::shared_ptr<VkExternalRenderPass> GetExternalRenderPassSP(
+		size_t index
+	) const noexcept {
+		return m_terra.GetRenderEngine().GetExternalRenderPassSP(index);
+	}
+
+	void RemoveExternalRenderPass(size_t index) noexcept
+	{
+		m_terra.GetRenderEngine().RemoveExternalRenderPass(index);
+	}
+
+	[[nodiscard]]
+	size_t GetActiveRenderPassCount() const noexcept
+	{
+		return m_terra.GetRenderEngine().GetActiveRenderPassCount();
+	}
+
+private:
+	TerraHeadless<RenderEngine_t> m_terra;
+
+public:
+	RendererVKHeadless(const RendererVKHeadless&) = delete;
+	RendererVKHeadless& operator=(const RendererVKHeadless&) = delete;
+
+	RendererVKHeadless(RendererVKHeadless&& other) noexcept
+		: m_terra{ std::move(other.m_terra) }
+	{}
+	RendererVKHeadless& operator=(RendererVKHeadless&& other) noexcept
+	{
+		m_terra = std::move(other.m_terra);
+
+		return *this;
+	}
+};
+}
+#endif
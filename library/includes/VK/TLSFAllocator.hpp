@@ -0,0 +1,158 @@
+#ifndef TLSF_ALLOCATOR_HPP_
+#define TLSF_ALLOCATOR_HPP_
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <limits>
+
+namespace Terra
+{
+// A Two-Level Segregated Fit allocator. The free blocks are kept in lists segregated by their
+// sizes and two levels of bitmaps are used to find a suitable list, so both allocation and
+// deallocation are O(1). It only manages offsets and keeps all of its bookkeeping on the CPU, so
+// it can be used to sub-allocate from GPU memory. Multiple disjoint regions can be added and
+// blocks are never merged across them.
+class TLSFAllocator
+{
+	struct Block
+	{
+		size_t        offset;
+		size_t        size;
+		std::uint32_t prevPhysical;
+		std::uint32_t nextPhysical;
+		std::uint32_t prevFree;
+		std::uint32_t nextFree;
+		bool          isFree;
+	};
+
+	struct ListIndex
+	{
+		std::uint32_t firstLevel;
+		std::uint32_t secondLevel;
+	};
+
+public:
+	struct Region
+	{
+		size_t start;
+		size_t size;
+	};
+
+public:
+	TLSFAllocator();
+
+	// The start should be aligned to the granularity and the size will be rounded down to it.
+	void AddRegion(size_t start, size_t size);
+	// The region must not have any allocations left in it.
+	void RemoveRegion(size_t start) noexcept;
+
+	[[nodiscard]]
+	std::optional<size_t> AllocateN(size_t size, size_t alignment) noexcept;
+
+	// Returns the region the allocation was in, if the whole region is free afterwards. The
+	// region won't be removed.
+	std::optional<Region> Deallocate(size_t start) noexcept;
+
+	[[nodiscard]]
+	bool IsAllocated(size_t start) const noexcept;
+
+	[[nodiscard]]
+	size_t TotalSize() const noexcept { return m_totalSize; }
+	[[nodiscard]]
+	size_t AvailableSize() const noexcept { return m_availableSize; }
+	// The sizes of the allocated blocks, including any rounding up to the granularity.
+	[[nodiscard]]
+	size_t AllocatedSize() const noexcept { return m_totalSize - m_availableSize; }
+	[[nodiscard]]
+	size_t RegionCount() const noexcept { return m_regionCount; }
+
+	// This isn't O(1), as the list with the largest blocks needs to be searched.
+	[[nodiscard]]
+	size_t LargestFreeBlockSize() const noexcept;
+
+	static constexpr size_t s_granularity = 16u;
+
+private:
+	[[nodiscard]]
+	static ListIndex GetInsertIndex(size_t size) noexcept;
+	[[nodiscard]]
+	static ListIndex GetSearchIndex(size_t size) noexcept;
+
+	[[nodiscard]]
+	std::uint32_t FindFreeBlock(ListIndex listIndex) const noexcept;
+
+	void InsertFreeBlock(std::uint32_t blockIndex) noexcept;
+	void RemoveFreeBlock(std::uint32_t blockIndex) noexcept;
+
+	// Splits the block at the size and returns the index of the second block.
+	std::uint32_t SplitBlock(std::uint32_t blockIndex, size_t size);
+	// Merges the next physical block into the block.
+	void MergeWithNext(std::uint32_t blockIndex) noexcept;
+
+	[[nodiscard]]
+	std::uint32_t CreateBlock(const Block& block);
+	void ReleaseBlock(std::uint32_t blockIndex) noexcept;
+
+private:
+	static constexpr std::uint32_t s_invalidIndex     = std::numeric_limits<std::uint32_t>::max();
+	static constexpr std::uint32_t s_granularityShift = 4u;
+	static constexpr std::uint32_t s_secondLevelShift = 4u;
+	static constexpr std::uint32_t s_secondLevelCount = 1u << s_secondLevelShift;
+	// Blocks smaller than this are all kept in the first list of the first level, which is
+	// linearly subdivided.
+	static constexpr std::uint32_t s_smallBlockShift  = s_granularityShift + s_secondLevelShift;
+	static constexpr std::uint32_t s_firstLevelCount  = 32u;
+
+	static_assert(
+		size_t{ 1u } << s_granularityShift == s_granularity,
+		"The granularity shift doesn't match the granularity."
+	);
+
+	using FreeLists_t = std::array<std::array<std::uint32_t, s_secondLevelCount>, s_firstLevelCount>;
+
+	std::vector<Block>                           m_blocks;
+	std::vector<std::uint32_t>                   m_availableBlockIndices;
+	// Both the free and the allocated blocks are mapped by their offsets.
+	std::unordered_map<size_t, std::uint32_t>    m_blockIndices;
+	FreeLists_t                                  m_freeLists;
+	std::array<std::uint32_t, s_firstLevelCount> m_secondLevelBitmaps;
+	std::uint32_t                                m_firstLevelBitmap;
+	size_t                                       m_totalSize;
+	size_t                                       m_availableSize;
+	size_t                                       m_regionCount;
+
+public:
+	TLSFAllocator(const TLSFAllocator&) = delete;
+	TLSFAllocator& operator=(const TLSFAllocator&) = delete;
+
+	TLSFAllocator(TLSFAllocator&& other) noexcept
+		: m_blocks{ std::move(other.m_blocks) },
+		m_availableBlockIndices{ std::move(other.m_availableBlockIndices) },
+		m_blockIndices{ std::move(other.m_blockIndices) },
+		m_freeLists{ other.m_freeLists },
+		m_secondLevelBitmaps{ other.m_secondLevelBitmaps },
+		m_firstLevelBitmap{ std::exchange(other.m_firstLevelBitmap, 0u) },
+		m_totalSize{ std::exchange(other.m_totalSize, 0u) },
+		m_availableSize{ std::exchange(other.m_availableSize, 0u) },
+		m_regionCount{ std::exchange(other.m_regionCount, 0u) }
+	{}
+	TLSFAllocator& operator=(TLSFAllocator&& other) noexcept
+	{
+		m_blocks                = std::move(other.m_blocks);
+		m_availableBlockIndices = std::move(other.m_availableBlockIndices);
+		m_blockIndices          = std::move(other.m_blockIndices);
+		m_freeLists             = other.m_freeLists;
+		m_secondLevelBitmaps    = other.m_secondLevelBitmaps;
+		m_firstLevelBitmap      = std::exchange(other.m_firstLevelBitmap, 0u);
+		m_totalSize             = std::exchange(other.m_totalSize, 0u);
+		m_availableSize         = std::exchange(other.m_availableSize, 0u);
+		m_regionCount           = std::exchange(other.m_regionCount, 0u);
+
+		return *this;
+	}
+};
+}
+#endif
@@ -184,12 +184,19 @@ private:
 				RenderEngineMSDeviceExtension::SetDeviceExtensions(extensionManager);
 			else if constexpr (std::is_same_v<RenderEngine_t, RenderEngineVSIndirect>)
 				RenderEngineVSIndirectDeviceExtension::SetDeviceExtensions(extensionManager);
+			else if constexpr (std::is_same_v<RenderEngine_t, RenderEngineMSIndirect>)
+				RenderEngineMSIndirectDeviceExtension::SetDeviceExtensions(extensionManager);
 			else
 				RenderEngineVSIndividualDeviceExtension::SetDeviceExtensions(extensionManager);
 		}
 
+		const auto& pipelineLibraryExtensions = GraphicsPipelineLibrary::GetRequiredExtensions();
+
 		deviceManager.SetDeviceFeatures(s_coreVersion)
 			.SetPhysicalDeviceAutomatic(vkInstance, vkSurface)
+			.AddOptionalExtensions(
+				{ std::begin(pipelineLibraryExtensions), std::end(pipelineLibraryExtensions) }
+			)
 			.CreateLogicalDevice();
 
 		return deviceManager;
@@ -0,0 +1,304 @@
+#ifndef TERRA_HEADLESS_HPP_
+#define TERRA_HEADLESS_HPP_
+#include <cassert>
+#include <VKInstanceManager.hpp>
+#include <VkDeviceManager.hpp>
+#include <VkRenderEngine.hpp>
+#include <VkExternalFormatMap.hpp>
+#include <VkExternalTextureReadback.hpp>
+
+#include <VkRenderEngineVS.hpp>
+#include <VkRenderEngineMS.hpp>
+
+namespace Terra
+{
+// Renders without a surface or a swapchain. Only the External render passes are executed and
+// the External textures added for readback are copied into CPU visible buffers at the end of
+// each frame. As no window system is required, any Vulkan implementation can be used,
+// including the software ones.
+template<class RenderEngine_t>
+class TerraHeadless
+{
+public:
+	TerraHeadless(
+		std::string_view appName, std::uint32_t width, std::uint32_t height,
+		std::uint32_t bufferCount, std::shared_ptr<ThreadPool> threadPool
+	) : m_instanceManager{ CreateInstance(std::move(appName)) },
+		m_deviceManager{ CreateDevice(m_instanceManager.GetVKInstance()) },
+		m_renderEngine{ m_deviceManager, std::move(threadPool), bufferCount },
+		m_readbackQueue{
+			m_deviceManager.GetLogicalDevice(),
+			m_deviceManager.GetQueueFamilyManager().GetQueue(QueueType::GraphicsQueue),
+			m_deviceManager.GetQueueFamilyManager().GetIndex(QueueType::GraphicsQueue)
+		},
+		m_textureReadback{
+			m_deviceManager.GetLogicalDevice(), m_renderEngine.GetMemoryManager(), bufferCount
+		},
+		m_frameSemaphore{ m_deviceManager.GetLogicalDevice() }, m_renderTarget{},
+		// Semaphores will be initialised as 0. So, the starting value should be 1.
+		m_semaphoreCounter{ 1u }, m_frameCount{ bufferCount }, m_nextFrameIndex{ 0u },
+		m_renderArea{ .width = 0u, .height = 0u }
+	{
+		m_readbackQueue.CreateCommandBuffers(bufferCount);
+
+		// There is no swapchain image to wait for. So, this will be signalled from the CPU
+		// at the start of each frame.
+		m_frameSemaphore.Create(true);
+
+		Resize(width, height);
+	}
+
+	void FinaliseInitialisation()
+	{
+		m_renderEngine.FinaliseInitialisation();
+	}
+
+	void Resize(std::uint32_t width, std::uint32_t height)
+	{
+		if (m_renderArea.width != width || m_renderArea.height != height)
+		{
+			WaitForGPUToFinish();
+
+			// There is no swapchain. So, the format can't change.
+			m_renderEngine.Resize(width, height, false);
+
+			m_renderArea = VkExtent2D{ .width = width, .height = height };
+		}
+	}
+
+	// The readback data of the returned frame index will be from the last time that frame was
+	// rendered. It should be read before calling Render with the index.
+	[[nodiscard]]
+	size_t WaitForCurrentBackBuffer()
+	{
+		const size_t nextFrameIndex = m_nextFrameIndex;
+
+		m_nextFrameIndex = (m_nextFrameIndex + 1u) % m_frameCount;
+
+		// The readback is submitted after the graphics commands of the same frame.
+		m_readbackQueue.WaitForSubmission(nextFrameIndex);
+
+		m_renderEngine.WaitForCurrentBackBuffer(nextFrameIndex);
+
+		return nextFrameIndex;
+	}
+
+	// WaitForCurrentBackBuffer must be called before Render each frame.
+	void Render(size_t frameIndex)
+	{
+		assert(
+			!m_renderEngine.GetSwapchainExternalRenderPassRP()
+			&& "There is no swapchain to copy to in the headless mode."
+		);
+
+		m_frameSemaphore.Signal(m_semaphoreCounter);
+
+		VkSemaphore renderFinishedSemaphore = m_renderEngine.Render(
+			frameIndex, m_renderTarget, m_renderArea, m_semaphoreCounter, m_frameSemaphore
+		);
+
+		const VKCommandBuffer& readbackCmdBuffer = m_readbackQueue.GetCommandBuffer(frameIndex);
+
+		{
+			const CommandBufferScope readbackCmdBufferScope{ readbackCmdBuffer };
+
+			m_textureReadback.RecordCopies(
+				frameIndex, readbackCmdBufferScope,
+				m_renderEngine.GetExternalResourceManager().GetResourceFactory()
+			);
+		}
+
+		// The render finished semaphore is a binary one, so it must be waited on before it can
+		// be signalled again. The readback submission takes the place of the Present call.
+		QueueSubmitBuilder<1u, 0u> readbackSubmitBuilder{};
+		readbackSubmitBuilder
+			.WaitSemaphore(renderFinishedSemaphore, VK_PIPELINE_STAGE_TRANSFER_BIT)
+			.CommandBuffer(readbackCmdBuffer);
+
+		VKFence& signalFence = m_readbackQueue.GetFence(frameIndex);
+		signalFence.Reset();
+
+		m_readbackQueue.SubmitCommandBuffer(readbackSubmitBuilder, signalFence);
+	}
+
+	void WaitForGPUToFinish()
+	{
+		vkDeviceWaitIdle(m_deviceManager.GetLogicalDevice());
+	}
+
+	[[nodiscard]]
+	auto&& GetRenderEngine(this auto&& self) noexcept
+	{
+		return std::forward_like<decltype(self)>(self.m_renderEngine);
+	}
+
+	[[nodiscard]]
+	VkExtent2D GetCurrentRenderArea() const noexcept { return m_renderArea; }
+
+	// The External texture must be created with the copySrc flag.
+	[[nodiscard]]
+	std::uint32_t AddReadbackTexture(std::uint32_t externalTextureIndex)
+	{
+		WaitForGPUToFinish();
+
+		return m_textureReadback.AddTexture(externalTextureIndex);
+	}
+
+	void RemoveReadbackTexture(std::uint32_t readbackIndex)
+	{
+		WaitForGPUToFinish();
+
+		m_textureReadback.RemoveTexture(readbackIndex);
+	}
+
+	[[nodiscard]]
+	std::uint8_t const* GetReadbackData(
+		size_t frameIndex, std::uint32_t readbackIndex
+	) const noexcept {
+		return m_textureReadback.GetData(frameIndex, readbackIndex);
+	}
+
+	[[nodiscard]]
+	size_t GetReadbackDataSize(size_t frameIndex, std::uint32_t readbackIndex) const noexcept
+	{
+		return m_textureReadback.GetDataSize(frameIndex, readbackIndex);
+	}
+
+private:
+	[[nodiscard]]
+	static VkInstanceManager CreateInstance(std::string_view appName)
+	{
+		VkInstanceManager instanceManager{ std::move(appName) };
+
+#ifndef NDEBUG
+		instanceManager.DebugLayers().AddDebugCallback(DebugCallbackType::FileOut);
+#endif
+
+		instanceManager.CreateInstance(s_coreVersion);
+
+		return instanceManager;
+	}
+
+	[[nodiscard]]
+	static VkDeviceManager CreateDevice(VkInstance vkInstance)
+	{
+		VkDeviceManager deviceManager{};
+
+		{
+			VkDeviceExtensionManager& extensionManager = deviceManager.ExtensionManager();
+
+			if constexpr (std::is_same_v<RenderEngine_t, RenderEngineMS>)
+				RenderEngineMSDeviceExtension::SetDeviceExtensions(extensionManager);
+			else if constexpr (std::is_same_v<RenderEngine_t, RenderEngineVSIndirect>)
+				RenderEngineVSIndirectDeviceExtension::SetDeviceExtensions(extensionManager);
+			else if constexpr (std::is_same_v<RenderEngine_t, RenderEngineMSIndirect>)
+				RenderEngineMSIndirectDeviceExtension::SetDeviceExtensions(extensionManager);
+			else
+				RenderEngineVSIndividualDeviceExtension::SetDeviceExtensions(extensionManager);
+		}
+
+		const auto& pipelineLibraryExtensions = GraphicsPipelineLibrary::GetRequiredExtensions();
+
+		deviceManager.SetDeviceFeatures(s_coreVersion)
+			.SetPhysicalDeviceAutomatic(vkInstance)
+			.AddOptionalExtensions(
+				{ std::begin(pipelineLibraryExtensions), std::end(pipelineLibraryExtensions) }
+			)
+			.CreateLogicalDevice();
+
+		return deviceManager;
+	}
+
+private:
+	VkInstanceManager       m_instanceManager;
+	VkDeviceManager         m_deviceManager;
+	RenderEngine_t          m_renderEngine;
+	VkGraphicsQueue         m_readbackQueue;
+	ExternalTextureReadback m_textureReadback;
+	VKSemaphore             m_frameSemaphore;
+	// Only used by the swapchain render pass, which isn't available here.
+	VKImageView             m_renderTarget;
+	std::uint64_t           m_semaphoreCounter;
+	std::uint32_t           m_frameCount;
+	size_t                  m_nextFrameIndex;
+	VkExtent2D              m_renderArea;
+
+	static constexpr CoreVersion s_coreVersion = CoreVersion::V1_3;
+
+public:
+	// Wrappers for Render Engine functions which requires waiting for the GPU to finish first.
+	[[nodiscard]]
+	size_t AddTextureAsCombined(STexture&& texture)
+	{
+		WaitForGPUToFinish();
+
+		return m_renderEngine.AddTextureAsCombined(std::move(texture));
+	}
+
+	[[nodiscard]]
+	std::uint32_t BindCombinedTexture(size_t textureIndex)
+	{
+		WaitForGPUToFinish();
+
+		return m_renderEngine.BindCombinedTexture(textureIndex);
+	}
+
+	void RemoveTexture(size_t textureIndex)
+	{
+		WaitForGPUToFinish();
+
+		m_renderEngine.RemoveTexture(textureIndex);
+	}
+
+	[[nodiscard]]
+	std::uint32_t AddModelBundle(std::shared_ptr<ModelBundle>&& modelBundle)
+	{
+		WaitForGPUToFinish();
+
+		return m_renderEngine.AddModelBundle(std::move(modelBundle));
+	}
+
+	[[nodiscard]]
+	std::uint32_t AddMeshBundle(MeshBundleTemporaryData&& meshBundle)
+	{
+		WaitForGPUToFinish();
+
+		return m_renderEngine.AddMeshBundle(std::move(meshBundle));
+	}
+
+public:
+	TerraHeadless(const TerraHeadless&) = delete;
+	TerraHeadless& operator=(const TerraHeadless&) = delete;
+
+	TerraHeadless(TerraHeadless&& other) noexcept
+		: m_instanceManager{ std::move(other.m_instanceManager) },
+		m_deviceManager{ std::move(other.m_deviceManager) },
+		m_renderEngine{ std::move(other.m_renderEngine) },
+		m_readbackQueue{ std::move(other.m_readbackQueue) },
+		m_textureReadback{ std::move(other.m_textureReadback) },
+		m_frameSemaphore{ std::move(other.m_frameSemaphore) },
+		m_renderTarget{ std::move(other.m_renderTarget) },
+		m_semaphoreCounter{ other.m_semaphoreCounter },
+		m_frameCount{ other.m_frameCount },
+		m_nextFrameIndex{ other.m_nextFrameIndex },
+		m_renderArea{ other.m_renderArea }
+	{}
+	TerraHeadless& operator=(TerraHeadless&& other) noexcept
+	{
+		m_instanceManager  = std::move(other.m_instanceManager);
+		m_deviceManager    = std::move(other.m_deviceManager);
+		m_renderEngine     = std::move(other.m_renderEngine);
+		m_readbackQueue    = std::move(other.m_readbackQueue);
+		m_textureReadback  = std::move(other.m_textureReadback);
+		m_frameSemaphore   = std::move(other.m_frameSemaphore);
+		m_renderTarget     = std::move(other.m_renderTarget);
+		m_semaphoreCounter = other.m_semaphoreCounter;
+		m_frameCount       = other.m_frameCount;
+		m_nextFrameIndex   = other.m_nextFrameIndex;
+		m_renderArea       = other.m_renderArea;
+
+		return *this;
+	}
+};
+}
+#endif
@@ -4,6 +4,7 @@
 #include <vector>
 #include <utility>
 #include <VkVertexLayout.hpp>
+#include <VkPipelineCache.hpp>
 
 namespace Terra
 {
@@ -233,6 +234,20 @@ public:
 
 	// Will add more Builders for each type when I want to customise them.
 
+	// Only hashes the state which is used by the library part. So, the pipelines which only differ
+	// in the state of the other parts would have the same hash for this part.
+	[[nodiscard]]
+	std::uint64_t GetLibraryPartHash(
+		VkGraphicsPipelineLibraryFlagBitsEXT libraryPart
+	) const noexcept;
+
+	// The Mesh Shader pipelines don't have any vertex input.
+	[[nodiscard]]
+	bool HasVertexInput() const noexcept
+	{
+		return m_pipelineCreateInfo.pInputAssemblyState != nullptr;
+	}
+
 	[[nodiscard]]
 	VkGraphicsPipelineCreateInfo const* GetRef() const noexcept { return &m_pipelineCreateInfo; }
 	[[nodiscard]]
@@ -391,8 +406,23 @@ public:
 	VkPipelineObject(VkDevice device) : m_device{ device }, m_pipeline{ VK_NULL_HANDLE } {}
 	~VkPipelineObject() noexcept;
 
-	void CreateGraphicsPipeline(const GraphicsPipelineBuilder& builder);
-	void CreateComputePipeline(const ComputePipelineBuilder& builder);
+	// The cache can be null.
+	void CreateGraphicsPipeline(
+		const GraphicsPipelineBuilder& builder, PipelineCache* pipelineCache
+	);
+	void CreateComputePipeline(const ComputePipelineBuilder& builder, PipelineCache* pipelineCache);
+
+	// Only the state and the shaders of the part are taken from the builder.
+	void CreateGraphicsPipelineLibrary(
+		const GraphicsPipelineBuilder& builder, VkGraphicsPipelineLibraryFlagBitsEXT libraryPart,
+		PipelineCache* pipelineCache
+	);
+	// The optimised link takes much longer, but the pipeline should be as fast as a monolithic
+	// one. The layout and the flags are taken from the builder.
+	void LinkGraphicsPipeline(
+		const GraphicsPipelineBuilder& builder, const std::vector<VkPipeline>& libraries,
+		bool optimise, PipelineCache* pipelineCache
+	);
 
 	[[nodiscard]]
 	VkPipeline Get() const noexcept { return m_pipeline; }
@@ -400,6 +430,10 @@ public:
 private:
 	void SelfDestruct() noexcept;
 
+	void CreateGraphicsPipelineWithFeedback(
+		VkGraphicsPipelineCreateInfo createInfo, PipelineCache* pipelineCache
+	);
+
 private:
 	VkDevice   m_device;
 	VkPipeline m_pipeline;
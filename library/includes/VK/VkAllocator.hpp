@@ -1,6 +1,7 @@
 #ifndef VK_ALLOCATOR_HPP_
 #define VK_ALLOCATOR_HPP_
 #include <Buddy.hpp>
+#include <TLSFAllocator.hpp>
 #include <VkDeviceMemory.hpp>
 #include <optional>
 #include <queue>
@@ -9,6 +10,25 @@
 
 namespace Terra
 {
+struct MemoryFragmentationReport
+{
+	VkDeviceSize totalSize                 = 0u;
+	// The sizes of the live allocations, as they were requested.
+	VkDeviceSize requestedSize             = 0u;
+	// The sizes of the blocks reserved for the live allocations. The difference with the
+	// requested size is the internal fragmentation.
+	VkDeviceSize reservedSize              = 0u;
+	VkDeviceSize smallTierSize             = 0u;
+	VkDeviceSize smallTierAvailableSize    = 0u;
+	VkDeviceSize largestSmallTierFreeBlock = 0u;
+
+	[[nodiscard]]
+	VkDeviceSize InternalWaste() const noexcept { return reservedSize - requestedSize; }
+};
+
+// Large allocations are made with a buddy allocator. Small buffers are sub-allocated with a TLSF
+// allocator from pages, which are allocated from the buddy allocator, as the smallest buddy
+// block would waste most of its memory for them.
 class VkAllocator
 {
 public:
@@ -35,18 +55,36 @@ public:
 	[[nodiscard]]
 	VkDeviceSize Size() const noexcept { return m_memory.Size(); }
 	[[nodiscard]]
+	std::uint32_t GetMemoryTypeIndex() const noexcept { return m_memory.TypeIndex(); }
+	[[nodiscard]]
 	VkDeviceSize AvailableSize() const noexcept
-	{ return static_cast<VkDeviceSize>(m_allocator.AvailableSize()); }
+	{
+		// The pages of the small tier are allocated from the buddy allocator, so their free
+		// memory needs to be added.
+		return static_cast<VkDeviceSize>(
+			m_allocator.AvailableSize() + m_smallAllocator.AvailableSize()
+		);
+	}
 	[[nodiscard]]
 	std::uint8_t* GetCPUStart() const noexcept { return m_memory.CPUMemory(); }
 
+	[[nodiscard]]
+	MemoryFragmentationReport GetFragmentationReport() const noexcept;
+
+	static constexpr VkDeviceSize s_smallAllocationThreshold = 16_KB;
+	static constexpr VkDeviceSize s_smallTierPageSize        = 256_KB;
+
 private:
 	[[nodiscard]]
 	std::optional<VkDeviceSize> Allocate(const VkMemoryRequirements& memoryReq) noexcept;
+	[[nodiscard]]
+	std::optional<VkDeviceSize> AllocateSmall(const VkMemoryRequirements& memoryReq) noexcept;
 
 private:
 	DeviceMemory    m_memory;
 	Callisto::Buddy m_allocator;
+	TLSFAllocator   m_smallAllocator;
+	VkDeviceSize    m_requestedSize;
 	std::uint16_t   m_id;
 
 public:
@@ -55,13 +93,16 @@ public:
 
 	VkAllocator(VkAllocator&& other) noexcept
 		: m_memory{ std::move(other.m_memory) }, m_allocator{ std::move(other.m_allocator) },
-		m_id{ other.m_id } {}
+		m_smallAllocator{ std::move(other.m_smallAllocator) },
+		m_requestedSize{ other.m_requestedSize }, m_id{ other.m_id } {}
 
 	VkAllocator& operator=(VkAllocator&& other) noexcept
 	{
-		m_memory    = std::move(other.m_memory);
-		m_allocator = std::move(other.m_allocator);
-		m_id        = other.m_id;
+		m_memory         = std::move(other.m_memory);
+		m_allocator      = std::move(other.m_allocator);
+		m_smallAllocator = std::move(other.m_smallAllocator);
+		m_requestedSize  = other.m_requestedSize;
+		m_id             = other.m_id;
 
 		return *this;
 	}
@@ -80,6 +121,27 @@ public:
 		bool          isValid = false;
 	};
 
+	// The size of a new memory allocation is the size of the largest existing allocation of that
+	// type multiplied by the growth factor. It is then clamped between the minimum size and the
+	// smaller of the maximum size and the fraction of the heap budget.
+	struct GrowthPolicy
+	{
+		VkDeviceSize minimumSize;
+		VkDeviceSize maximumSize;
+		float        growthFactor;
+		float        maximumBudgetFraction;
+	};
+
+	struct HeapBudget
+	{
+		// The budget and the usage of the whole process, as reported by the driver.
+		VkDeviceSize      budget;
+		VkDeviceSize      usage;
+		// The size of the memory allocated by this manager.
+		VkDeviceSize      allocatedSize;
+		VkMemoryHeapFlags flags;
+	};
+
 public:
 	MemoryManager(
 		VkPhysicalDevice physicalDevice, VkDevice logicalDevice, VkDeviceSize initialBudgetGPU,
@@ -95,6 +157,25 @@ public:
 		const MemoryAllocation& allocation, VkMemoryPropertyFlagBits memoryType
 	) noexcept;
 
+	// The report of all the allocators of a memory type combined.
+	[[nodiscard]]
+	MemoryFragmentationReport GetFragmentationReport(
+		VkMemoryPropertyFlagBits memoryType
+	) const noexcept;
+
+	void SetGrowthPolicy(VkMemoryPropertyFlagBits memoryType, const GrowthPolicy& policy) noexcept;
+
+	[[nodiscard]]
+	const GrowthPolicy& GetGrowthPolicy(VkMemoryPropertyFlagBits memoryType) const noexcept
+	{
+		return memoryType & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT ?
+			m_cpuGrowthPolicy : m_gpuGrowthPolicy;
+	}
+
+	// Indexed by the heap index.
+	[[nodiscard]]
+	std::vector<HeapBudget> GetHeapBudgets() const;
+
 private:
 	struct MemoryType
 	{
@@ -113,6 +194,9 @@ private:
 
 	[[nodiscard]]
 	VkDeviceSize GetAvailableMemoryOfType(VkMemoryPropertyFlagBits memoryType) const noexcept;
+	// The largest budget of the heaps which have the memory type.
+	[[nodiscard]]
+	VkDeviceSize GetHeapBudgetOfType(VkMemoryPropertyFlagBits memoryType) const noexcept;
 
 	[[nodiscard]]
 	VkDeviceSize GetNewAllocationSize(VkMemoryPropertyFlagBits memoryType) const noexcept;
@@ -133,6 +217,23 @@ private:
 	std::vector<VkAllocator>  m_gpuAllocators;
 	std::queue<std::uint16_t> m_availableGPUIndices;
 	std::queue<std::uint16_t> m_availableCPUIndices;
+	GrowthPolicy              m_gpuGrowthPolicy;
+	GrowthPolicy              m_cpuGrowthPolicy;
+
+	static constexpr GrowthPolicy s_defaultGPUGrowthPolicy
+	{
+		.minimumSize           = 64_MB,
+		.maximumSize           = 2_GB,
+		.growthFactor          = 2.f,
+		.maximumBudgetFraction = 0.25f
+	};
+	static constexpr GrowthPolicy s_defaultCPUGrowthPolicy
+	{
+		.minimumSize           = 16_MB,
+		.maximumSize           = 256_MB,
+		.growthFactor          = 2.f,
+		.maximumBudgetFraction = 0.1f
+	};
 
 	static constexpr std::array s_requiredExtensions
 	{
@@ -148,7 +249,9 @@ public:
 		m_cpuAllocators{ std::move(other.m_cpuAllocators) },
 		m_gpuAllocators{ std::move(other.m_gpuAllocators) },
 		m_availableGPUIndices{ std::move(other.m_availableGPUIndices) },
-	    m_availableCPUIndices{ std::move(other.m_availableCPUIndices) } {}
+	    m_availableCPUIndices{ std::move(other.m_availableCPUIndices) },
+		m_gpuGrowthPolicy{ other.m_gpuGrowthPolicy },
+		m_cpuGrowthPolicy{ other.m_cpuGrowthPolicy } {}
 
 	MemoryManager& operator=(MemoryManager&& other) noexcept
 	{
@@ -158,6 +261,8 @@ public:
 		m_gpuAllocators       = std::move(other.m_gpuAllocators);
 		m_availableGPUIndices = std::move(other.m_availableGPUIndices);
 		m_availableCPUIndices = std::move(other.m_availableCPUIndices);
+		m_gpuGrowthPolicy     = other.m_gpuGrowthPolicy;
+		m_cpuGrowthPolicy     = other.m_cpuGrowthPolicy;
 
 		return *this;
 	}
@@ -5,7 +5,9 @@
 #include <VkTextureView.hpp>
 #include <VkResourceBarriers2.hpp>
 #include <VkSyncObjects.hpp>
+#include <CpuTracer.hpp>
 #include <array>
+#include <span>
 #include <utility>
 #include <cassert>
 
@@ -244,6 +246,10 @@ public:
 	void Copy(
 		const Buffer& src, const Buffer& dst, const BufferToBufferCopyBuilder& builder
 	) const noexcept;
+	// The regions must not overlap in the destination.
+	void Copy(
+		const Buffer& src, const Buffer& dst, std::span<const VkBufferCopy> regions
+	) const noexcept;
 	void CopyWhole(
 		const Buffer& src, const Buffer& dst, BufferToBufferCopyBuilder& builder
 	) const noexcept;
@@ -267,6 +273,14 @@ public:
 	void Copy(
 		const VKImageView& src, const VKImageView& dst, const ImageCopyBuilder& builder
 	) const noexcept;
+	// The barriers should be handled before calling this. The texture must be in the
+	// Transfer Src layout.
+	void Copy(
+		const VkTextureView& src, const Buffer& dst, const BufferToImageCopyBuilder& builder
+	) const noexcept;
+	void CopyWhole(
+		const VkTextureView& src, const Buffer& dst, BufferToImageCopyBuilder& builder
+	) const noexcept;
 	void Copy(
 		const VkTextureView& src, const VkTextureView& dst, const ImageCopyBuilder& builder
 	) const noexcept {
@@ -296,6 +310,12 @@ public:
 	{
 		CopyWhole(src, dst, builder);
 	}
+	void CopyWhole(
+		const VkTextureView& src, const Buffer& dst, BufferToImageCopyBuilder&& builder = {}
+	) const noexcept
+	{
+		CopyWhole(src, dst, builder);
+	}
 
 	void AcquireOwnership(
 		const Buffer& buffer,
@@ -562,6 +582,8 @@ public:
 	void SubmitCommandBuffer(
 		const QueueSubmitBuilder<WaitCount, SignalCount, CommandBufferCount>& builder
 	) const noexcept {
+		TERRA_CPU_TRACE_ZONE("vkQueueSubmit");
+
 		vkQueueSubmit(m_commandQueue, 1u, builder.GetPtr(), VK_NULL_HANDLE);
 	}
 
@@ -579,6 +601,8 @@ public:
 		const QueueSubmitBuilder<WaitCount, SignalCount, CommandBufferCount>& builder,
 		const VKFence& fence
 	) const noexcept {
+		TERRA_CPU_TRACE_ZONE("vkQueueSubmit");
+
 		vkQueueSubmit(m_commandQueue, 1u, builder.GetPtr(), fence.Get());
 	}
 
@@ -6,6 +6,7 @@
 #include <VKPipelineObject.hpp>
 #include <VkCommandQueue.hpp>
 #include <VkPipelineLayout.hpp>
+#include <VkShader.hpp>
 #include <ExternalPipeline.hpp>
 
 namespace Terra
@@ -17,15 +18,20 @@ public:
 
 	void Create(
 		VkDevice device, VkPipelineLayout computeLayout,
-		const ExternalComputePipeline& computeExtPipeline, const std::wstring& shaderPath
+		const ExternalComputePipeline& computeExtPipeline, ShaderModuleCache& shaderCache,
+		PipelineCache* pipelineCache
 	);
 	void Create(
 		VkDevice device, const PipelineLayout& computeLayout,
-		const ExternalComputePipeline& computeExtPipeline, const std::wstring& shaderPath
+		const ExternalComputePipeline& computeExtPipeline, ShaderModuleCache& shaderCache,
+		PipelineCache* pipelineCache
 	) {
-		Create(device, computeLayout.Get(), computeExtPipeline, shaderPath);
+		Create(device, computeLayout.Get(), computeExtPipeline, shaderCache, pipelineCache);
 	}
-	void Recreate(VkDevice device, VkPipelineLayout computeLayout, const std::wstring& shaderPath);
+	void Recreate(
+		VkDevice device, VkPipelineLayout computeLayout, ShaderModuleCache& shaderCache,
+		PipelineCache* pipelineCache
+	);
 
 	void Bind(const VKCommandBuffer& computeBuffer) const noexcept;
 
@@ -39,7 +45,8 @@ private:
 	[[nodiscard]]
 	static std::unique_ptr<VkPipelineObject> _createComputePipeline(
 		VkDevice device, VkPipelineLayout computeLayout,
-		const ExternalComputePipeline& computeExtPipeline, const std::wstring& shaderPath
+		const ExternalComputePipeline& computeExtPipeline, ShaderModuleCache& shaderCache,
+		PipelineCache* pipelineCache
 	);
 
 private:
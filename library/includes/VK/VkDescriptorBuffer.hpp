@@ -32,10 +32,29 @@ public:
 		const std::vector<std::uint32_t>& queueFamilyIndices = {}
 	);
 
+	// The variable count binding of a layout is created with its upper bound, but the buffer
+	// only has the space for this many descriptors. If the buffer has already been created, it
+	// will be recreated with the old descriptors. The layouts aren't recreated, so the pipeline
+	// layouts and the pipelines made with them stay valid.
+	// The old buffer might still be used by the frames in flight, so it is retired instead of
+	// being destroyed. It should be released with ReleaseRetiredBuffers once they have finished.
+	void SetVariableDescriptorCount(
+		size_t setLayoutIndex, std::uint32_t descriptorCount,
+		const std::vector<std::uint32_t>& queueFamilyIndices = {}
+	);
+
+	void ReleaseRetiredBuffers() noexcept { m_retiredBuffers.clear(); }
+
 	static void SetDescriptorBufferInfo(VkPhysicalDevice physicalDevice) noexcept;
 
 	[[nodiscard]]
 	std::vector<VkDescriptorSetLayout> GetValidLayouts() const noexcept;
+	// Both of the buffers must have the same number of set layouts and a set layout can only
+	// be valid in one of them. The valid ones are returned in the order of their indices.
+	[[nodiscard]]
+	static std::vector<VkDescriptorSetLayout> GetValidLayouts(
+		const VkDescriptorBuffer& descriptorBuffer, const VkDescriptorBuffer& sharedDescriptorBuffer
+	) noexcept;
 	[[nodiscard]]
 	const DescriptorSetLayout& GetLayout(size_t index) const noexcept
 	{
@@ -43,11 +62,20 @@ public:
 	}
 	[[nodiscard]]
 	bool IsCreated() const noexcept { return m_descriptorBuffer.Get() != VK_NULL_HANDLE; }
+	[[nodiscard]]
+	bool HasRetiredBuffers() const noexcept { return !std::empty(m_retiredBuffers); }
 
 	static void BindDescriptorBuffer(
 		const VkDescriptorBuffer& descriptorBuffer, const VKCommandBuffer& cmdBuffer,
 		VkPipelineBindPoint bindPoint, const PipelineLayout& pipelineLayout
 	);
+	// The shared buffer should have the sets which are the same across all the frames, so it
+	// doesn't need to be duplicated for each frame.
+	static void BindDescriptorBuffer(
+		const VkDescriptorBuffer& descriptorBuffer,
+		const VkDescriptorBuffer& sharedDescriptorBuffer, const VKCommandBuffer& cmdBuffer,
+		VkPipelineBindPoint bindPoint, const PipelineLayout& pipelineLayout
+	);
 
 private:
 	[[nodiscard]]
@@ -64,6 +92,10 @@ private:
 	void _createBuffer(
 		Buffer& descriptorBuffer, const std::vector<std::uint32_t>& queueFamilyIndices
 	);
+	void CreateSetLayouts();
+
+	[[nodiscard]]
+	VkDeviceSize GetLayoutSize(size_t setLayoutIndex) const noexcept;
 
 private:
 	VkDevice                         m_device;
@@ -72,7 +104,9 @@ private:
 	std::vector<std::uint32_t>       m_bufferIndices;
 	std::vector<VkDeviceSize>        m_validOffsets;
 	std::vector<VkDeviceSize>        m_layoutOffsets;
+	std::vector<std::uint32_t>       m_variableDescriptorCounts;
 	Buffer                           m_descriptorBuffer;
+	std::vector<Buffer>              m_retiredBuffers;
 
 	static VkPhysicalDeviceDescriptorBufferPropertiesEXT s_descriptorInfo;
 	static constexpr std::array s_requiredExtensions
@@ -617,6 +651,16 @@ public:
 			descriptorIndex
 		);
 	}
+	// For a view of only some of the mip levels of a texture.
+	void SetStorageImageDescriptor(
+		const VKImageView& imageView, VkImageLayout imageLayout, std::uint32_t bindingIndex,
+		size_t setLayoutIndex, std::uint32_t descriptorIndex
+	) const {
+		GetImageToDescriptor<VK_DESCRIPTOR_TYPE_STORAGE_IMAGE>(
+			imageView.GetView(), VK_NULL_HANDLE, imageLayout, bindingIndex, setLayoutIndex,
+			descriptorIndex
+		);
+	}
 	void SetSamplerDescriptor(
 		const VKSampler& sampler, std::uint32_t bindingIndex, size_t setLayoutIndex,
 		std::uint32_t descriptorIndex
@@ -643,18 +687,22 @@ public:
 		m_bufferIndices{ std::move(other.m_bufferIndices) },
 		m_validOffsets{ std::move(other.m_validOffsets) },
 		m_layoutOffsets{ std::move(other.m_layoutOffsets) },
-		m_descriptorBuffer{ std::move(other.m_descriptorBuffer) }
+		m_variableDescriptorCounts{ std::move(other.m_variableDescriptorCounts) },
+		m_descriptorBuffer{ std::move(other.m_descriptorBuffer) },
+		m_retiredBuffers{ std::move(other.m_retiredBuffers) }
 	{}
 
 	VkDescriptorBuffer& operator=(VkDescriptorBuffer&& other) noexcept
 	{
-		m_device           = other.m_device;
-		m_memoryManager    = other.m_memoryManager;
-		m_setLayouts       = std::move(other.m_setLayouts);
-		m_bufferIndices    = std::move(other.m_bufferIndices);
-		m_validOffsets     = std::move(other.m_validOffsets);
-		m_layoutOffsets    = std::move(other.m_layoutOffsets);
-		m_descriptorBuffer = std::move(other.m_descriptorBuffer);
+		m_device                   = other.m_device;
+		m_memoryManager            = other.m_memoryManager;
+		m_setLayouts               = std::move(other.m_setLayouts);
+		m_bufferIndices            = std::move(other.m_bufferIndices);
+		m_validOffsets             = std::move(other.m_validOffsets);
+		m_layoutOffsets            = std::move(other.m_layoutOffsets);
+		m_variableDescriptorCounts = std::move(other.m_variableDescriptorCounts);
+		m_descriptorBuffer         = std::move(other.m_descriptorBuffer);
+		m_retiredBuffers           = std::move(other.m_retiredBuffers);
 
 		return *this;
 	}
@@ -2,6 +2,7 @@
 #define VK_DESCRIPTOR_SET_LAYOUT_HPP_
 #include <vulkan/vulkan.hpp>
 #include <vector>
+#include <optional>
 #include <utility>
 
 namespace Terra
@@ -35,6 +36,25 @@ public:
 		return m_layoutBindings;
 	}
 
+	// The descriptor count of the returned binding is its upper bound.
+	[[nodiscard]]
+	std::optional<VkDescriptorSetLayoutBinding> GetVariableCountBinding() const noexcept
+	{
+		std::optional<VkDescriptorSetLayoutBinding> oVariableCountBinding{};
+
+		const size_t bindingCount = std::size(m_layoutBindings);
+
+		for (size_t index = 0u; index < bindingCount; ++index)
+			if (m_layoutBindingFlags[index] & VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT)
+			{
+				oVariableCountBinding = m_layoutBindings[index];
+
+				break;
+			}
+
+		return oVariableCountBinding;
+	}
+
 private:
 	void SelfDestruct() noexcept;
 
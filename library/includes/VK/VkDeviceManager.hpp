@@ -2,6 +2,7 @@
 #define DEVICE_MANAGER_HPP_
 #include <vulkan/vulkan.hpp>
 #include <vector>
+#include <array>
 #include <VkQueueFamilyManager.hpp>
 #include <VkExtensionManager.hpp>
 #include <VkFeatureManager.hpp>
@@ -23,6 +24,11 @@ public:
 	VkDeviceManager& SetPhysicalDeviceAutomatic(VkInstance instance, VkSurfaceKHR surface);
 	VkDeviceManager& SetPhysicalDeviceAutomatic(VkInstance instance);
 
+	// Should be called after the physical device has been set. The extensions are only enabled,
+	// if the device supports all of them and their features. The device would be selected
+	// without checking them.
+	VkDeviceManager& AddOptionalExtensions(const std::vector<DeviceExtension>& extensions);
+
 	void CreateLogicalDevice();
 
 	[[nodiscard]]
@@ -53,6 +59,8 @@ public:
 	[[nodiscard]]
 	VkDeviceExtensionManager& ExtensionManager() noexcept { return m_extensionManager; }
 	[[nodiscard]]
+	const VkDeviceExtensionManager& ExtensionManager() const noexcept { return m_extensionManager; }
+	[[nodiscard]]
 	VkPhysicalDevice GetPhysicalDevice() const noexcept { return m_physicalDevice; }
 	[[nodiscard]]
 	VkDevice GetLogicalDevice() const noexcept { return m_logicalDevice; }
@@ -63,8 +71,14 @@ private:
 	[[nodiscard]]
 	bool CheckDeviceExtensionSupport(VkPhysicalDevice device) const noexcept;
 	[[nodiscard]]
+	static bool AreExtensionsSupported(
+		VkPhysicalDevice device, const std::vector<const char*>& extensionNames
+	) noexcept;
+	[[nodiscard]]
 	bool DoesDeviceSupportFeatures(VkPhysicalDevice device) const noexcept;
 	[[nodiscard]]
+	bool DoesDeviceSupportLimits(VkPhysicalDevice device) const noexcept;
+	[[nodiscard]]
 	bool CheckExtensionAndFeatures(VkPhysicalDevice device) const noexcept;
 
 	[[nodiscard]]
@@ -89,6 +103,16 @@ private:
 	[[nodiscard]]
 	VkPhysicalDevice SelectPhysicalDeviceAutomatic(const std::vector<VkPhysicalDevice>& devices);
 
+	// The software implementations like lavapipe report themselves as CPU devices. They are
+	// only picked if there is no actual GPU with the required features.
+	static constexpr std::array s_devicePreferenceOrder
+	{
+		VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU,
+		VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU,
+		VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU,
+		VK_PHYSICAL_DEVICE_TYPE_CPU
+	};
+
 public:
 	VkDeviceManager(const VkDeviceManager&) = delete;
 	VkDeviceManager& operator=(const VkDeviceManager&) = delete;
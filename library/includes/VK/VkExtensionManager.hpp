@@ -13,6 +13,8 @@ enum class DeviceExtension
 	VkKhrSwapchain,
 	VkExtMemoryBudget,
 	VkExtDescriptorBuffer,
+	VkKhrPipelineLibrary,
+	VkExtGraphicsPipelineLibrary,
 	None
 };
 
@@ -78,6 +78,10 @@ public:
 	{
 		return m_currentPipelineStage;
 	}
+	[[nodiscard]]
+	VkAccessFlagBits GetCurrentAccessState() const noexcept { return m_currentAccessState; }
+	[[nodiscard]]
+	VkImageLayout GetCurrentLayoutState() const noexcept { return m_currentLayoutState; }
 
 	// This actually won't change the state. Need to use the barrier builder and then execute it
 	// on a CommandQueue. Need to get the barrier builder through this function, so we can remember
@@ -119,6 +119,13 @@ public:
 
 	void StartPass(const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea) const noexcept;
 
+	// Used when the pass is drawn in two parts, like with the occlusion culling. The first part
+	// stores every attachment and the second one loads them, so the clears only happen once.
+	void StartPassToResume(
+		const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea
+	) const noexcept;
+	void ResumePass(const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea) const noexcept;
+
 	void EndPass(const VKCommandBuffer& graphicsCmdBuffer) const noexcept;
 
 	void EndPassForSwapchain(
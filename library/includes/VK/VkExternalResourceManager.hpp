@@ -30,9 +30,15 @@ public:
 	) const;
 
 	void UploadExternalBufferGPUOnlyData(
-		StagingBufferManager& stagingBufferManager, Callisto::TemporaryDataBufferGPU& tempGPUBuffer,
-		std::uint32_t externalBufferIndex, std::shared_ptr<void> cpuData, size_t srcDataSizeInBytes,
-		size_t dstBufferOffset
+		StagingBufferManager& stagingBufferManager, std::uint32_t externalBufferIndex,
+		std::shared_ptr<void> cpuData, size_t srcDataSizeInBytes, size_t dstBufferOffset
+	) const;
+	// Can be called from any thread, but the buffer must not be recreated or removed, until
+	// the request has been completed.
+	[[nodiscard]]
+	std::uint64_t StreamExternalBufferGPUOnlyData(
+		StagingBufferManager& stagingBufferManager, std::uint32_t externalBufferIndex,
+		std::shared_ptr<void> cpuData, size_t srcDataSizeInBytes, size_t dstBufferOffset
 	) const;
 
 	void QueueExternalBufferGPUCopy(
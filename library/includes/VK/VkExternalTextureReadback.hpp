@@ -0,0 +1,88 @@
+#ifndef VK_EXTERNAL_TEXTURE_READBACK_HPP_
+#define VK_EXTERNAL_TEXTURE_READBACK_HPP_
+#include <vector>
+#include <utility>
+#include <VkResources.hpp>
+#include <VkCommandQueue.hpp>
+#include <VkExternalResourceFactory.hpp>
+#include <ReusableVector.hpp>
+
+namespace Terra
+{
+// Copies External textures into CPU visible buffers at the end of a frame. Each frame has its
+// own buffer, so the data of a frame can be read once that frame has finished its submission,
+// while the next frames are being rendered.
+class ExternalTextureReadback
+{
+	struct ReadbackDetails
+	{
+		std::uint32_t       externalTextureIndex;
+		std::vector<Buffer> frameBuffers;
+	};
+
+public:
+	ExternalTextureReadback(VkDevice device, MemoryManager* memoryManager, std::uint32_t frameCount)
+		: m_device{ device }, m_memoryManager{ memoryManager }, m_frameCount{ frameCount },
+		m_readbackDetails{}
+	{}
+
+	[[nodiscard]]
+	std::uint32_t AddTexture(std::uint32_t externalTextureIndex);
+
+	void RemoveTexture(std::uint32_t readbackIndex) noexcept;
+
+	// The textures must be created with the copySrc flag. The buffers will be (re)created here
+	// if the size of a texture has changed, so the frame must not be in use by the GPU.
+	void RecordCopies(
+		size_t frameIndex, const VKCommandBuffer& graphicsCmdBuffer,
+		const VkExternalResourceFactory& resourceFactory
+	);
+
+	[[nodiscard]]
+	std::uint8_t const* GetData(size_t frameIndex, std::uint32_t readbackIndex) const noexcept
+	{
+		return m_readbackDetails[readbackIndex].frameBuffers[frameIndex].CPUHandle();
+	}
+
+	[[nodiscard]]
+	size_t GetDataSize(size_t frameIndex, std::uint32_t readbackIndex) const noexcept
+	{
+		return static_cast<size_t>(
+			m_readbackDetails[readbackIndex].frameBuffers[frameIndex].BufferSize()
+		);
+	}
+
+private:
+	void RecordCopy(
+		const VKCommandBuffer& graphicsCmdBuffer, const VkExternalTexture& externalTexture,
+		Buffer& dstBuffer
+	);
+
+private:
+	VkDevice                                  m_device;
+	MemoryManager*                            m_memoryManager;
+	std::uint32_t                             m_frameCount;
+	Callisto::ReusableVector<ReadbackDetails> m_readbackDetails;
+
+public:
+	ExternalTextureReadback(const ExternalTextureReadback&) = delete;
+	ExternalTextureReadback& operator=(const ExternalTextureReadback&) = delete;
+
+	ExternalTextureReadback(ExternalTextureReadback&& other) noexcept
+		: m_device{ other.m_device },
+		m_memoryManager{ std::exchange(other.m_memoryManager, nullptr) },
+		m_frameCount{ other.m_frameCount },
+		m_readbackDetails{ std::move(other.m_readbackDetails) }
+	{}
+	ExternalTextureReadback& operator=(ExternalTextureReadback&& other) noexcept
+	{
+		m_device          = other.m_device;
+		m_memoryManager   = std::exchange(other.m_memoryManager, nullptr);
+		m_frameCount      = other.m_frameCount;
+		m_readbackDetails = std::move(other.m_readbackDetails);
+
+		return *this;
+	}
+};
+}
+#endif
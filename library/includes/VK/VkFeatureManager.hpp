@@ -42,6 +42,7 @@ private:
 
 	void SetVkExtMeshShaderFeatures() noexcept;
 	void SetVkExtDescriptorBufferFeatures() noexcept;
+	void SetVkExtGraphicsPipelineLibraryFeatures() noexcept;
 
 private:
 	using MembersType = std::vector<size_t>;
@@ -0,0 +1,185 @@
+#ifndef VK_GPU_PROFILER_HPP_
+#define VK_GPU_PROFILER_HPP_
+#include <vulkan/vulkan.hpp>
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <limits>
+#include <VkCommandQueue.hpp>
+#include <VkQueueFamilyManager.hpp>
+#include <ChromeTrace.hpp>
+
+namespace Terra
+{
+struct GpuScopeTiming
+{
+	std::string name;
+	QueueType   queueType;
+	// From the first timestamp of the frame.
+	double      startMilliseconds;
+	double      durationMilliseconds;
+};
+
+// Writes a timestamp at the start and the end of each scope. Each frame has its own query pool,
+// so the timestamps of a frame are only read once the frame has finished on the GPU, which
+// would be frameCount frames later. So, reading them never stalls. The timings of the last
+// resolved frame are kept and can be captured in a Chrome trace.
+class GpuProfiler
+{
+	struct Scope
+	{
+		std::string_view name;
+		std::uint32_t    nameIndex;
+		QueueType        queueType;
+		std::uint32_t    queryIndex;
+	};
+
+public:
+	static constexpr std::uint32_t s_noNameIndex = std::numeric_limits<std::uint32_t>::max();
+
+public:
+	GpuProfiler(VkDevice device);
+	~GpuProfiler() noexcept;
+
+	void Create(
+		VkPhysicalDevice physicalDevice, const VkQueueFamilyMananger& queueFamilyManager,
+		size_t frameCount
+	);
+
+	void SetEnabled(bool value) noexcept;
+
+	// Won't write anything and return empty, if the profiler isn't enabled, the queue family
+	// doesn't support timestamps or the frame doesn't have any queries left. The name should
+	// outlive the frame. If a name index is passed, it will be added at the end of the name.
+	[[nodiscard]]
+	std::optional<std::uint32_t> BeginScope(
+		const VKCommandBuffer& cmdBuffer, size_t frameIndex, QueueType queueType,
+		std::string_view name, std::uint32_t nameIndex = s_noNameIndex
+	);
+	void EndScope(
+		const VKCommandBuffer& cmdBuffer, size_t frameIndex, std::uint32_t scopeIndex
+	) const noexcept;
+
+	// Should be called after the previous submission of the frame has finished and before
+	// anything new is recorded for it.
+	void ResolveFrame(size_t frameIndex);
+
+	void StartTraceCapture();
+	// Stops the capture as well.
+	[[nodiscard]]
+	bool SaveTraceCapture(const std::wstring& filePath);
+
+	[[nodiscard]]
+	bool IsEnabled() const noexcept { return m_isEnabled; }
+	[[nodiscard]]
+	const std::vector<GpuScopeTiming>& GetTimings() const noexcept { return m_timings; }
+
+private:
+	void SelfDestruct() noexcept;
+
+	void AddTraceEvents(std::uint64_t frameStartTimestamp);
+
+	[[nodiscard]]
+	static constexpr size_t GetQueueSlot(QueueType queueType) noexcept
+	{
+		if (queueType == QueueType::TransferQueue)
+			return 0u;
+		else if (queueType == QueueType::ComputeQueue)
+			return 1u;
+		else
+			return 2u;
+	}
+
+	[[nodiscard]]
+	static std::string GetScopeName(const Scope& scope);
+
+private:
+	VkDevice                        m_device;
+	std::vector<VkQueryPool>        m_queryPools;
+	std::vector<std::vector<Scope>> m_frameScopes;
+	std::vector<std::uint64_t>      m_queryResults;
+	std::vector<GpuScopeTiming>     m_timings;
+	// A mask of zero means the queue can't write timestamps.
+	std::array<std::uint64_t, 3u>   m_timestampMasks;
+	double                          m_timestampPeriod;
+	ChromeTrace                     m_trace;
+	std::optional<std::uint64_t>    m_oTraceStartTimestamp;
+	bool                            m_isCapturingTrace;
+	bool                            m_isEnabled;
+
+	static constexpr std::uint32_t s_maxScopeCount = 128u;
+
+	static constexpr std::array s_queueNames
+	{
+		"Transfer Queue", "Compute Queue", "Graphics Queue"
+	};
+
+public:
+	GpuProfiler(const GpuProfiler&) = delete;
+	GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+	GpuProfiler(GpuProfiler&& other) noexcept
+		: m_device{ other.m_device },
+		m_queryPools{ std::move(other.m_queryPools) },
+		m_frameScopes{ std::move(other.m_frameScopes) },
+		m_queryResults{ std::move(other.m_queryResults) },
+		m_timings{ std::move(other.m_timings) },
+		m_timestampMasks{ other.m_timestampMasks },
+		m_timestampPeriod{ other.m_timestampPeriod },
+		m_trace{ std::move(other.m_trace) },
+		m_oTraceStartTimestamp{ other.m_oTraceStartTimestamp },
+		m_isCapturingTrace{ other.m_isCapturingTrace },
+		m_isEnabled{ other.m_isEnabled }
+	{}
+	GpuProfiler& operator=(GpuProfiler&& other) noexcept
+	{
+		SelfDestruct();
+
+		m_device               = other.m_device;
+		m_queryPools           = std::move(other.m_queryPools);
+		m_frameScopes          = std::move(other.m_frameScopes);
+		m_queryResults         = std::move(other.m_queryResults);
+		m_timings              = std::move(other.m_timings);
+		m_timestampMasks       = other.m_timestampMasks;
+		m_timestampPeriod      = other.m_timestampPeriod;
+		m_trace                = std::move(other.m_trace);
+		m_oTraceStartTimestamp = other.m_oTraceStartTimestamp;
+		m_isCapturingTrace     = other.m_isCapturingTrace;
+		m_isEnabled            = other.m_isEnabled;
+
+		return *this;
+	}
+};
+
+// The scope should be destroyed before the command buffer is closed.
+class GpuProfilerScope
+{
+public:
+	GpuProfilerScope(
+		GpuProfiler& profiler, const VKCommandBuffer& cmdBuffer, size_t frameIndex,
+		QueueType queueType, std::string_view name,
+		std::uint32_t nameIndex = GpuProfiler::s_noNameIndex
+	) : m_profiler{ profiler }, m_cmdBuffer{ cmdBuffer }, m_frameIndex{ frameIndex },
+		m_oScopeIndex{ profiler.BeginScope(cmdBuffer, frameIndex, queueType, name, nameIndex) }
+	{}
+
+	~GpuProfilerScope() noexcept
+	{
+		if (m_oScopeIndex)
+			m_profiler.EndScope(m_cmdBuffer, m_frameIndex, m_oScopeIndex.value());
+	}
+
+private:
+	GpuProfiler&                 m_profiler;
+	const VKCommandBuffer&       m_cmdBuffer;
+	size_t                       m_frameIndex;
+	std::optional<std::uint32_t> m_oScopeIndex;
+
+public:
+	GpuProfilerScope(const GpuProfilerScope&) = delete;
+	GpuProfilerScope& operator=(const GpuProfilerScope&) = delete;
+};
+}
+#endif
@@ -6,6 +6,8 @@
 #include <VKPipelineObject.hpp>
 #include <VkCommandQueue.hpp>
 #include <VkPipelineLayout.hpp>
+#include <VkShader.hpp>
+#include <VkGraphicsPipelineLibrary.hpp>
 #include <ExternalPipeline.hpp>
 
 namespace Terra
@@ -16,25 +18,49 @@ class GraphicsPipelineBase
 public:
 	GraphicsPipelineBase() : m_graphicsPipeline{}, m_graphicsExternalPipeline{} {}
 
+	// If the library isn't null, the pipeline is fast linked from the parts in it.
 	void Create(
 		VkDevice device, VkPipelineLayout graphicsLayout,
-		const std::wstring& shaderPath, const ExternalGraphicsPipeline& graphicsExtPipeline
+		ShaderModuleCache& shaderCache, const ExternalGraphicsPipeline& graphicsExtPipeline,
+		PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary
 	) {
 		m_graphicsExternalPipeline = graphicsExtPipeline;
 
 		m_graphicsPipeline = static_cast<Derived*>(this)->_createGraphicsPipeline(
-			device, graphicsLayout, shaderPath, m_graphicsExternalPipeline
+			device, graphicsLayout, shaderCache, m_graphicsExternalPipeline, pipelineCache,
+			pipelineLibrary, GraphicsPipelineLibrary::LinkType::Fast
+		);
+	}
+
+	void CreateOptimised(
+		VkDevice device, VkPipelineLayout graphicsLayout,
+		ShaderModuleCache& shaderCache, const ExternalGraphicsPipeline& graphicsExtPipeline,
+		PipelineCache* pipelineCache, GraphicsPipelineLibrary& pipelineLibrary
+	) {
+		m_graphicsExternalPipeline = graphicsExtPipeline;
+
+		m_graphicsPipeline = static_cast<Derived*>(this)->_createGraphicsPipeline(
+			device, graphicsLayout, shaderCache, m_graphicsExternalPipeline, pipelineCache,
+			&pipelineLibrary, GraphicsPipelineLibrary::LinkType::Optimised
 		);
 	}
 
 	void Recreate(
-		VkDevice device, VkPipelineLayout graphicsLayout, const std::wstring& shaderPath
+		VkDevice device, VkPipelineLayout graphicsLayout, ShaderModuleCache& shaderCache,
+		PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary
 	) {
 		m_graphicsPipeline = static_cast<Derived*>(this)->_createGraphicsPipeline(
-			device, graphicsLayout, shaderPath, m_graphicsExternalPipeline
+			device, graphicsLayout, shaderCache, m_graphicsExternalPipeline, pipelineCache,
+			pipelineLibrary, GraphicsPipelineLibrary::LinkType::Fast
 		);
 	}
 
+	// The pipeline object would be created later.
+	void SetExternalPipeline(const ExternalGraphicsPipeline& graphicsExtPipeline)
+	{
+		m_graphicsExternalPipeline = graphicsExtPipeline;
+	}
+
 	void Bind(const VKCommandBuffer& graphicsCmdBuffer) const noexcept
 	{
 		VkCommandBuffer cmdBuffer = graphicsCmdBuffer.Get();
@@ -42,6 +68,15 @@ public:
 		vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline->Get());
 	}
 
+	[[nodiscard]]
+	bool IsReady() const noexcept { return m_graphicsPipeline != nullptr; }
+
+	[[nodiscard]]
+	VkPipeline Get() const noexcept
+	{
+		return m_graphicsPipeline ? m_graphicsPipeline->Get() : VK_NULL_HANDLE;
+	}
+
 	[[nodiscard]]
 	const ExternalGraphicsPipeline& GetExternalPipeline() const noexcept
 	{
@@ -74,5 +109,11 @@ public:
 void ConfigurePipelineBuilder(
 	GraphicsPipelineBuilder& builder, const ExternalGraphicsPipeline& graphicsExtPipeline
 ) noexcept;
+
+// Links the pipeline if there is a library, otherwise compiles the whole pipeline.
+void CreateOrLinkGraphicsPipeline(
+	VkPipelineObject& pso, const GraphicsPipelineBuilder& builder, PipelineCache* pipelineCache,
+	GraphicsPipelineLibrary* pipelineLibrary, GraphicsPipelineLibrary::LinkType linkType
+);
 }
 #endif
@@ -0,0 +1,111 @@
+#ifndef VK_GRAPHICS_PIPELINE_LIBRARY_HPP_
+#define VK_GRAPHICS_PIPELINE_LIBRARY_HPP_
+#include <vulkan/vulkan.hpp>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <unordered_map>
+#include <VKPipelineObject.hpp>
+#include <VkExtensionManager.hpp>
+
+namespace Terra
+{
+// Keeps the vertex input, pre-rasterisation, fragment shader and fragment output parts of the
+// graphics pipelines. A new pipeline is linked from the parts, so only the parts which haven't
+// been used by any of the previous pipelines need to be compiled. A fast link should only take
+// a fraction of a millisecond, but the pipeline might be slower than a monolithic one, so an
+// optimised link should replace it later.
+// The parts are keyed by the hash of their state, which has the handles of the shader modules
+// and the pipeline layout. So, the parts must be cleared if either of them is recreated. The
+// pipelines can be linked on multiple threads, so the parts are accessed with a lock. But the
+// lock is only held to find or add a part, so the different parts can be compiled in parallel.
+class GraphicsPipelineLibrary
+{
+	// The first thread which needs a part compiles it. The others wait for the handle.
+	struct LibraryEntry
+	{
+		VkPipelineObject               library;
+		std::shared_future<VkPipeline> handle;
+	};
+
+public:
+	enum class LinkType
+	{
+		Fast,
+		Optimised
+	};
+
+public:
+	GraphicsPipelineLibrary(VkDevice device)
+		: m_device{ device }, m_mutex{ std::make_unique<std::mutex>() }, m_libraries{}
+	{}
+
+	// Won't create the pipeline if any of the parts couldn't be created.
+	void LinkGraphicsPipeline(
+		VkPipelineObject& pipeline, const GraphicsPipelineBuilder& builder, LinkType linkType,
+		PipelineCache* pipelineCache
+	);
+
+	// The pipelines which were linked from the parts can still be used.
+	void Clear() noexcept;
+
+	[[nodiscard]]
+	size_t GetLibraryCount() const noexcept;
+
+private:
+	// The entry is shared, so the part stays alive while a pipeline is being linked from it,
+	// even if the library is cleared.
+	[[nodiscard]]
+	std::shared_ptr<LibraryEntry> GetOrCreateLibrary(
+		const GraphicsPipelineBuilder& builder, VkGraphicsPipelineLibraryFlagBitsEXT libraryPart,
+		PipelineCache* pipelineCache
+	);
+
+private:
+	VkDevice                                                         m_device;
+	// The library must be movable.
+	std::unique_ptr<std::mutex>                                      m_mutex;
+	std::unordered_map<std::uint64_t, std::shared_ptr<LibraryEntry>> m_libraries;
+
+	static constexpr std::array s_libraryParts
+	{
+		VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+		VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+		VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+		VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT
+	};
+
+	static constexpr std::array s_requiredExtensions
+	{
+		DeviceExtension::VkKhrPipelineLibrary,
+		DeviceExtension::VkExtGraphicsPipelineLibrary
+	};
+
+public:
+	[[nodiscard]]
+	static const decltype(s_requiredExtensions)& GetRequiredExtensions() noexcept
+	{
+		return s_requiredExtensions;
+	}
+
+public:
+	GraphicsPipelineLibrary(const GraphicsPipelineLibrary&) = delete;
+	GraphicsPipelineLibrary& operator=(const GraphicsPipelineLibrary&) = delete;
+
+	GraphicsPipelineLibrary(GraphicsPipelineLibrary&& other) noexcept
+		: m_device{ other.m_device },
+		m_mutex{ std::move(other.m_mutex) },
+		m_libraries{ std::move(other.m_libraries) }
+	{}
+	GraphicsPipelineLibrary& operator=(GraphicsPipelineLibrary&& other) noexcept
+	{
+		m_device    = other.m_device;
+		m_mutex     = std::move(other.m_mutex);
+		m_libraries = std::move(other.m_libraries);
+
+		return *this;
+	}
+};
+}
+#endif
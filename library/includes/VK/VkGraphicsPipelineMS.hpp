@@ -15,14 +15,18 @@ private:
 	[[nodiscard]]
 	static std::unique_ptr<VkPipelineObject> CreateGraphicsPipelineMS(
 		VkDevice device, VkPipelineLayout graphicsLayout,
-		ShaderBinaryType binaryType, const std::wstring& shaderPath,
-		const ExternalGraphicsPipeline& graphicsExtPipeline, const ShaderName& taskShader
+		ShaderBinaryType binaryType, ShaderModuleCache& shaderCache,
+		const ExternalGraphicsPipeline& graphicsExtPipeline, const ShaderName& taskShader,
+		PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary,
+		GraphicsPipelineLibrary::LinkType linkType
 	);
 
 	[[nodiscard]]
 	std::unique_ptr<VkPipelineObject> _createGraphicsPipeline(
 		VkDevice device, VkPipelineLayout graphicsLayout,
-		const std::wstring& shaderPath, const ExternalGraphicsPipeline& graphicsExtPipeline
+		ShaderModuleCache& shaderCache, const ExternalGraphicsPipeline& graphicsExtPipeline,
+		PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary,
+		GraphicsPipelineLibrary::LinkType linkType
 	) const;
 
 public:
@@ -15,7 +15,9 @@ private:
 	[[nodiscard]]
 	std::unique_ptr<VkPipelineObject> _createGraphicsPipeline(
 		VkDevice device, VkPipelineLayout graphicsLayout,
-		const std::wstring& shaderPath, const ExternalGraphicsPipeline& graphicsExtPipeline
+		ShaderModuleCache& shaderCache, const ExternalGraphicsPipeline& graphicsExtPipeline,
+		PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary,
+		GraphicsPipelineLibrary::LinkType linkType
 	) const;
 
 public:
@@ -45,7 +47,9 @@ private:
 	[[nodiscard]]
 	std::unique_ptr<VkPipelineObject> _createGraphicsPipeline(
 		VkDevice device, VkPipelineLayout graphicsLayout,
-		const std::wstring& shaderPath, const ExternalGraphicsPipeline& graphicsExtPipeline
+		ShaderModuleCache& shaderCache, const ExternalGraphicsPipeline& graphicsExtPipeline,
+		PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary,
+		GraphicsPipelineLibrary::LinkType linkType
 	) const;
 
 public:
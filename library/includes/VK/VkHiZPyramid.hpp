@@ -0,0 +1,140 @@
+#ifndef VK_HIZ_PYRAMID_HPP_
+#define VK_HIZ_PYRAMID_HPP_
+#include <vulkan/vulkan.hpp>
+#include <vector>
+#include <string>
+#include <utility>
+#include <VkTextureView.hpp>
+#include <VkDescriptorBuffer.hpp>
+#include <VkPipelineLayout.hpp>
+#include <VkPipelineManager.hpp>
+#include <VkComputePipeline.hpp>
+#include <VkCommandQueue.hpp>
+
+namespace Terra
+{
+// A mip chain of a depth texture, where each texel has the farthest depth of the texels it
+// covers in the level above. The first mip is half the size of the depth texture. So, a texel
+// of the mip N covers 2^(N + 1) texels of the depth texture on each axis. If the nearest depth
+// of a model is farther than the depth of the few texels its bounds cover in a mip, it is fully
+// occluded.
+// It is built with a compute shader on the Graphics queue, right after the depth has been
+// drawn, so the depth texture doesn't need to change queues. It has its own descriptor buffer
+// and pipeline layout, as its shader doesn't need anything else.
+class HiZPyramid
+{
+	struct ConstantData
+	{
+		std::uint32_t mipLevel;
+		std::uint32_t mipWidth;
+		std::uint32_t mipHeight;
+	};
+
+public:
+	HiZPyramid(VkDevice device, MemoryManager* memoryManager);
+
+	void SetShaderPath(const std::wstring& shaderPath);
+	void SetPipelineCache(PipelineCache* pipelineCache) noexcept;
+
+	// The shader path should be set before calling this. Won't do anything if the pipeline has
+	// already been created.
+	void CreatePipeline();
+
+	// Should wait for the device to be idle before calling this. Must be called again if the
+	// depth texture is recreated, like after a resize. The queue family indices should have the
+	// families of the queues which would read the pyramid.
+	void SetDepthTexture(
+		const VkTextureView& depthTexture, const std::vector<std::uint32_t>& queueFamilyIndices
+	);
+
+	// Should wait for the device to be idle before calling this.
+	void Destroy() noexcept;
+
+	// The depth texture should be in the Depth attachment layout and will be put back in it.
+	// The descriptor buffer of the pyramid is bound, so the ones bound before are invalidated.
+	void Build(const VKCommandBuffer& graphicsCmdBuffer) const noexcept;
+
+	// The whole pyramid as a combined image sampler in the General layout.
+	static void SetDescriptorBufferLayout(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, std::uint32_t bindingSlot,
+		size_t setLayoutIndex, VkShaderStageFlags shaderStage
+	) noexcept;
+	void SetDescriptorBuffer(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, std::uint32_t bindingSlot,
+		size_t setLayoutIndex
+	) const;
+
+	[[nodiscard]]
+	bool IsCreated() const noexcept { return m_depthTexture != nullptr; }
+	[[nodiscard]]
+	std::uint32_t GetMipLevelCount() const noexcept
+	{
+		return static_cast<std::uint32_t>(std::size(m_mipViews));
+	}
+
+	[[nodiscard]]
+	static consteval std::uint32_t GetConstantBufferSize() noexcept
+	{
+		return static_cast<std::uint32_t>(sizeof(ConstantData));
+	}
+
+private:
+	[[nodiscard]]
+	static std::uint32_t GetMipLevelCount(std::uint32_t width, std::uint32_t height) noexcept;
+
+private:
+	VkDevice                         m_device;
+	MemoryManager*                   m_memoryManager;
+	VkTextureView                    m_pyramid;
+	std::vector<VKImageView>         m_mipViews;
+	VKSampler                        m_sampler;
+	VkDescriptorBuffer               m_descriptorBuffer;
+	PipelineLayout                   m_pipelineLayout;
+	PipelineManager<ComputePipeline> m_pipelineManager;
+	VkTextureView const*             m_depthTexture;
+	std::uint32_t                    m_psoIndex;
+
+	static constexpr VkFormat      s_pyramidFormat       = VK_FORMAT_R32_SFLOAT;
+	static constexpr std::uint32_t s_maxMipLevelCount    = 16u;
+	static constexpr std::uint32_t s_setLayoutCount      = 1u;
+	static constexpr std::uint32_t s_setLayoutIndex      = 0u;
+	static constexpr std::uint32_t s_depthBindingSlot    = 0u;
+	// An array of the storage views of each mip. The shader reads the previous mip and writes
+	// the current one.
+	static constexpr std::uint32_t s_mipViewsBindingSlot = 1u;
+	// Each thread group should reduce 8x8 texels.
+	static constexpr std::uint32_t s_threadGroupSize     = 8u;
+
+public:
+	HiZPyramid(const HiZPyramid&) = delete;
+	HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+	HiZPyramid(HiZPyramid&& other) noexcept
+		: m_device{ other.m_device }, m_memoryManager{ other.m_memoryManager },
+		m_pyramid{ std::move(other.m_pyramid) },
+		m_mipViews{ std::move(other.m_mipViews) },
+		m_sampler{ std::move(other.m_sampler) },
+		m_descriptorBuffer{ std::move(other.m_descriptorBuffer) },
+		m_pipelineLayout{ std::move(other.m_pipelineLayout) },
+		m_pipelineManager{ std::move(other.m_pipelineManager) },
+		m_depthTexture{ std::exchange(other.m_depthTexture, nullptr) },
+		m_psoIndex{ other.m_psoIndex }
+	{}
+	HiZPyramid& operator=(HiZPyramid&& other) noexcept
+	{
+		m_device           = other.m_device;
+		m_memoryManager    = other.m_memoryManager;
+		m_pyramid          = std::move(other.m_pyramid);
+		m_mipViews         = std::move(other.m_mipViews);
+		m_sampler          = std::move(other.m_sampler);
+		m_descriptorBuffer = std::move(other.m_descriptorBuffer);
+		m_pipelineLayout   = std::move(other.m_pipelineLayout);
+		m_pipelineManager  = std::move(other.m_pipelineManager);
+		m_depthTexture     = std::exchange(other.m_depthTexture, nullptr);
+		m_psoIndex         = other.m_psoIndex;
+
+		return *this;
+	}
+};
+}
+#endif
@@ -225,5 +225,85 @@ public:
 		return *this;
 	}
 };
+
+// Same as the MS one, but the data needed to cull the meshes is also uploaded for the Compute
+// shader.
+class MeshManagerMSIndirect : public MeshManager<MeshManagerMSIndirect, VkMeshBundleMS>
+{
+	friend class MeshManager<MeshManagerMSIndirect, VkMeshBundleMS>;
+public:
+	MeshManagerMSIndirect(
+		VkDevice device, MemoryManager* memoryManager, QueueIndices3 queueIndices3
+	);
+
+	void SetDescriptorBufferLayout(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t msSetLayoutIndex
+	) const noexcept;
+
+	// Should be called after a new Mesh has been added.
+	void SetDescriptorBuffers(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t msSetLayoutIndex
+	) const;
+
+	void SetDescriptorBufferLayoutCS(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t csSetLayoutIndex
+	) const noexcept;
+
+	void SetDescriptorBuffersCS(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t csSetLayoutIndex
+	) const;
+
+	void CopyOldBuffers(const VKCommandBuffer& transferBuffer) noexcept;
+
+private:
+	void ConfigureMeshBundle(
+		MeshBundleTemporaryData&& meshBundle, StagingBufferManager& stagingBufferMan,
+		VkMeshBundleMS& vkMeshBundle, Callisto::TemporaryDataBufferGPU& tempBuffer
+	);
+	void ConfigureRemoveMesh(size_t bundleIndex) noexcept;
+
+private:
+	SharedBufferGPU m_perMeshletDataBuffer;
+	SharedBufferGPU m_vertexBuffer;
+	SharedBufferGPU m_vertexIndicesBuffer;
+	SharedBufferGPU m_primIndicesBuffer;
+	SharedBufferGPU m_perMeshDataBuffer;
+	SharedBufferGPU m_perMeshBundleDataBuffer;
+
+	static constexpr std::uint32_t s_perMeshletBufferBindingSlot    = 2u;
+	static constexpr std::uint32_t s_vertexBufferBindingSlot        = 3u;
+	static constexpr std::uint32_t s_vertexIndicesBufferBindingSlot = 4u;
+	static constexpr std::uint32_t s_primIndicesBufferBindingSlot   = 5u;
+
+	// Compute Shader
+	static constexpr std::uint32_t s_perMeshDataBindingSlot         = 6u;
+	static constexpr std::uint32_t s_perMeshBundleDataBindingSlot   = 7u;
+
+public:
+	MeshManagerMSIndirect(const MeshManagerMSIndirect&) = delete;
+	MeshManagerMSIndirect& operator=(const MeshManagerMSIndirect&) = delete;
+
+	MeshManagerMSIndirect(MeshManagerMSIndirect&& other) noexcept
+		: MeshManager{ std::move(other) },
+		m_perMeshletDataBuffer{ std::move(other.m_perMeshletDataBuffer) },
+		m_vertexBuffer{ std::move(other.m_vertexBuffer) },
+		m_vertexIndicesBuffer{ std::move(other.m_vertexIndicesBuffer) },
+		m_primIndicesBuffer{ std::move(other.m_primIndicesBuffer) },
+		m_perMeshDataBuffer{ std::move(other.m_perMeshDataBuffer) },
+		m_perMeshBundleDataBuffer{ std::move(other.m_perMeshBundleDataBuffer) }
+	{}
+	MeshManagerMSIndirect& operator=(MeshManagerMSIndirect&& other) noexcept
+	{
+		MeshManager::operator=(std::move(other));
+		m_perMeshletDataBuffer    = std::move(other.m_perMeshletDataBuffer);
+		m_vertexBuffer            = std::move(other.m_vertexBuffer);
+		m_vertexIndicesBuffer     = std::move(other.m_vertexIndicesBuffer);
+		m_primIndicesBuffer       = std::move(other.m_primIndicesBuffer);
+		m_perMeshDataBuffer       = std::move(other.m_perMeshDataBuffer);
+		m_perMeshBundleDataBuffer = std::move(other.m_perMeshBundleDataBuffer);
+
+		return *this;
+	}
+};
 }
 #endif
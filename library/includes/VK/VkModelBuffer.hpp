@@ -4,6 +4,7 @@
 #include <ModelContainer.hpp>
 #include <VkResources.hpp>
 #include <VkDescriptorBuffer.hpp>
+#include <ThreadPool.hpp>
 
 namespace Terra
 {
@@ -19,7 +20,8 @@ public:
 		m_vertexModelBuffers{ device, memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT },
 		m_fragmentModelBuffers{ device, memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT },
 		m_modelBuffersInstanceSize{ 0u }, m_modelBuffersFragmentInstanceSize{ 0u },
-		m_bufferInstanceCount{ frameCount }, m_modelBuffersQueueIndices{ modelBufferQueueIndices }
+		m_bufferInstanceCount{ frameCount }, m_modelBuffersQueueIndices{ modelBufferQueueIndices },
+		m_pendingFrameUpdates{}, m_threadPool{ nullptr }
 	{}
 
 	void SetModelContainer(std::shared_ptr<ModelContainer> modelContainer) noexcept
@@ -27,6 +29,10 @@ public:
 		m_modelContainer = std::move(modelContainer);
 	}
 
+	// If a thread pool is set, the models are updated in chunks on it. Otherwise, they are
+	// updated on the calling thread.
+	void SetThreadPool(ThreadPool* threadPool) noexcept { m_threadPool = threadPool; }
+
 	void ExtendModelBuffers();
 
 	void SetDescriptorBuffer(
@@ -38,10 +44,27 @@ public:
 		size_t setLayoutIndex
 	) const;
 
-	void Update(VkDeviceSize bufferIndex) const noexcept;
+	// Only the models which have been modified are written. As each frame has its own instance
+	// of the buffers, a modified model is written in the next frameCount updates.
+	void Update(VkDeviceSize bufferIndex) noexcept;
 
 	[[nodiscard]]
 	std::uint32_t GetInstanceCount() const noexcept { return m_bufferInstanceCount; }
+	// The mapped vertex data of a buffer instance.
+	[[nodiscard]]
+	std::uint8_t* GetVertexInstanceData(VkDeviceSize bufferIndex) const noexcept
+	{
+		return m_vertexModelBuffers.CPUHandle() + bufferIndex * m_modelBuffersInstanceSize;
+	}
+	// The number of the buffer instances the model still needs to be written to.
+	[[nodiscard]]
+	std::uint32_t GetPendingFrameUpdates(size_t modelIndex) const noexcept
+	{
+		return m_pendingFrameUpdates[modelIndex];
+	}
+
+	[[nodiscard]]
+	static consteval size_t GetVertexStride() noexcept { return sizeof(ModelVertexData); }
 
 private:
 	struct ModelVertexData
@@ -69,8 +92,6 @@ private:
 	};
 
 private:
-	[[nodiscard]]
-	static consteval size_t GetVertexStride() noexcept { return sizeof(ModelVertexData); }
 	[[nodiscard]]
 	static consteval size_t GetFragmentStride() noexcept { return sizeof(ModelFragmentData); }
 	[[nodiscard]]
@@ -79,6 +100,15 @@ private:
 
 	void CreateBuffer(size_t modelCount);
 
+	void UpdateModels(
+		size_t startIndex, size_t endIndex, std::uint8_t* vertexBufferStart,
+		std::uint8_t* fragmentBufferStart
+	) noexcept;
+
+	// A chunk's vertex data is 160KB, so it should mostly stay in the L2 cache while a chunk is
+	// being packed.
+	static constexpr size_t s_updateChunkSize = 1024u;
+
 private:
 	ModelContainer_t           m_modelContainer;
 	Buffer                     m_vertexModelBuffers;
@@ -87,6 +117,9 @@ private:
 	VkDeviceSize               m_modelBuffersFragmentInstanceSize;
 	std::uint32_t              m_bufferInstanceCount;
 	std::vector<std::uint32_t> m_modelBuffersQueueIndices;
+	// The number of the buffer instances each model still needs to be written to.
+	std::vector<std::uint32_t> m_pendingFrameUpdates;
+	ThreadPool*                m_threadPool;
 
 public:
 	ModelBuffers(const ModelBuffers&) = delete;
@@ -99,7 +132,9 @@ public:
 		m_modelBuffersInstanceSize{ other.m_modelBuffersInstanceSize },
 		m_modelBuffersFragmentInstanceSize{ other.m_modelBuffersFragmentInstanceSize },
 		m_bufferInstanceCount{ other.m_bufferInstanceCount },
-		m_modelBuffersQueueIndices{ std::move(other.m_modelBuffersQueueIndices) }
+		m_modelBuffersQueueIndices{ std::move(other.m_modelBuffersQueueIndices) },
+		m_pendingFrameUpdates{ std::move(other.m_pendingFrameUpdates) },
+		m_threadPool{ other.m_threadPool }
 	{}
 	ModelBuffers& operator=(ModelBuffers&& other) noexcept
 	{
@@ -110,6 +145,8 @@ public:
 		m_modelBuffersFragmentInstanceSize = other.m_modelBuffersFragmentInstanceSize;
 		m_bufferInstanceCount              = other.m_bufferInstanceCount;
 		m_modelBuffersQueueIndices         = std::move(other.m_modelBuffersQueueIndices);
+		m_pendingFrameUpdates              = std::move(other.m_pendingFrameUpdates);
+		m_threadPool                       = other.m_threadPool;
 
 		return *this;
 	}
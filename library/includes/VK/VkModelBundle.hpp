@@ -52,42 +52,85 @@ public:
 	}
 };
 
+// The arguments of the visible models are written into a host visible buffer every frame, so
+// each pipeline is drawn with a single indirect draw. The index of a model is passed as the
+// firstInstance, so the vertex shader can read it from gl_InstanceIndex.
+// The visible models which use the same mesh are drawn with a single instanced draw. The
+// firstInstance of a draw is the offset of its instances in the instance buffer, which has the
+// model index of each instance.
 class PipelineModelsVSIndividual : public PipelineModelsBase
 {
 public:
-	PipelineModelsVSIndividual() : PipelineModelsBase{} {}
+	struct ArgumentOffsets
+	{
+		VkDeviceSize  argumentOffset;
+		std::uint32_t instanceOffset;
+	};
 
-	void CleanupData() noexcept { _cleanupData(); }
+public:
+	PipelineModelsVSIndividual()
+		: PipelineModelsBase{}, m_argumentOffset{ 0u }, m_drawCount{ 0u }, m_instanceCount{ 0u }
+	{}
 
-	void Draw(
-		const VKCommandBuffer& graphicsBuffer, VkPipelineLayout pipelineLayout,
-		const VkMeshBundleVS& meshBundle, const Callisto::ReusableVector<Model>& models,
+	void CleanupData() noexcept { operator=(PipelineModelsVSIndividual{}); }
+
+	void ResetDrawCount() noexcept
+	{
+		m_drawCount     = 0u;
+		m_instanceCount = 0u;
+	}
+
+	// Returns the offsets after the written arguments and instances. The instance keys are
+	// only used as scratch memory, so they can be shared between the pipelines.
+	[[nodiscard]]
+	ArgumentOffsets UpdateArguments(
+		std::uint8_t* argumentBufferStart, std::uint8_t* instanceBufferStart,
+		ArgumentOffsets offsets, std::vector<std::uint64_t>& instanceKeys,
+		const VkMeshBundleVS& meshBundle, const ModelContainer& modelContainer,
+		const std::vector<std::uint8_t>& modelVisibilities,
 		const std::vector<std::uint32_t>& modelIndicesInContainer,
 		const PipelineModelBundle& pipelineBundle
-	) const noexcept;
+	) noexcept;
+
+	void Draw(const VKCommandBuffer& graphicsBuffer, const Buffer& argumentBuffer) const noexcept;
 
 	[[nodiscard]]
-	static consteval std::uint32_t GetConstantBufferSize() noexcept
+	std::uint32_t GetDrawCount() const noexcept { return m_drawCount; }
+	[[nodiscard]]
+	std::uint32_t GetInstanceCount() const noexcept { return m_instanceCount; }
+
+	[[nodiscard]]
+	static consteval size_t GetArgumentStride() noexcept
+	{
+		return sizeof(VkDrawIndexedIndirectCommand);
+	}
+	[[nodiscard]]
+	static consteval size_t GetInstanceStride() noexcept
 	{
-		return static_cast<std::uint32_t>(sizeof(std::uint32_t));
+		return sizeof(std::uint32_t);
 	}
 
 private:
-	void DrawModel(
-		const Model& model, std::uint32_t modelIndexInBuffer, VkCommandBuffer graphicsCmdBuffer,
-		VkPipelineLayout pipelineLayout, const VkMeshBundleVS& meshBundle
-	) const noexcept;
+	VkDeviceSize  m_argumentOffset;
+	std::uint32_t m_drawCount;
+	std::uint32_t m_instanceCount;
 
 public:
 	PipelineModelsVSIndividual(const PipelineModelsVSIndividual&) = delete;
 	PipelineModelsVSIndividual& operator=(const PipelineModelsVSIndividual&) = delete;
 
 	PipelineModelsVSIndividual(PipelineModelsVSIndividual&& other) noexcept
-		: PipelineModelsBase{ std::move(other) }
+		: PipelineModelsBase{ std::move(other) },
+		m_argumentOffset{ other.m_argumentOffset },
+		m_drawCount{ other.m_drawCount },
+		m_instanceCount{ other.m_instanceCount }
 	{}
 	PipelineModelsVSIndividual& operator=(PipelineModelsVSIndividual&& other) noexcept
 	{
 		PipelineModelsBase::operator=(std::move(other));
+		m_argumentOffset = other.m_argumentOffset;
+		m_drawCount      = other.m_drawCount;
+		m_instanceCount  = other.m_instanceCount;
 
 		return *this;
 	}
@@ -117,7 +160,8 @@ public:
 
 	void Draw(
 		const VKCommandBuffer& graphicsBuffer, VkPipelineLayout pipelineLayout,
-		const VkMeshBundleMS& meshBundle, const Callisto::ReusableVector<Model>& models,
+		const VkMeshBundleMS& meshBundle, const ModelContainer& modelContainer,
+		const std::vector<std::uint8_t>& modelVisibilities,
 		const std::vector<std::uint32_t>& modelIndicesInContainer,
 		const PipelineModelBundle& pipelineBundle
 	) const noexcept;
@@ -128,6 +172,14 @@ public:
 		return static_cast<std::uint32_t>(sizeof(ModelDetails));
 	}
 
+	[[nodiscard]]
+	static MeshDetails GetMeshDetails(const MeshTemporaryDetailsMS& meshDetailsMS) noexcept;
+	[[nodiscard]]
+	static std::uint32_t GetTaskGroupCount(std::uint32_t meshletCount) noexcept
+	{
+		return DivRoundUp(meshletCount, s_taskInvocationCount);
+	}
+
 private:
 	[[nodiscard]]
 	static std::uint32_t DivRoundUp(std::uint32_t num, std::uint32_t den) noexcept
@@ -136,7 +188,7 @@ private:
 	}
 
 	void DrawModel(
-		const Model& model, std::uint32_t modelIndexInBuffer, VkCommandBuffer graphicsCmdBuffer,
+		std::uint32_t meshIndex, std::uint32_t modelIndexInBuffer, VkCommandBuffer graphicsCmdBuffer,
 		VkPipelineLayout pipelineLayout, const VkMeshBundleMS& meshBundle
 	) const noexcept;
 
@@ -169,6 +221,73 @@ public:
 	}
 };
 
+// The Indirect classes are shared by the Vertex and the Mesh shader paths. These describe the
+// arguments of each path and how they are drawn.
+class IndirectArgumentsVS
+{
+public:
+	using MeshBundle_t       = VkMeshBundleVS;
+	using Argument_t         = VkDrawIndexedIndirectCommand;
+	using GraphicsPipeline_t = GraphicsPipelineVSIndirectDraw;
+
+	[[nodiscard]]
+	static Argument_t GetArgument(
+		const MeshBundle_t& meshBundle, std::uint32_t meshIndex
+	) noexcept;
+
+	static void BindMeshBundle(
+		const VKCommandBuffer& graphicsBuffer, VkPipelineLayout pipelineLayout,
+		const MeshBundle_t& meshBundle
+	) noexcept;
+
+	static void DrawIndirectCount(
+		VkCommandBuffer graphicsCmdBuffer, const SharedBufferData& argumentSharedData,
+		const SharedBufferData& counterSharedData, std::uint32_t maxDrawCount
+	) noexcept;
+
+	static constexpr VkShaderStageFlags s_constantShaderStages     = VK_SHADER_STAGE_VERTEX_BIT;
+	static constexpr std::uint32_t      s_modelOffsetConstantOffset = 0u;
+};
+
+// The Task shader can't get the details of its mesh from the push constants, as a single call
+// draws every model of a pipeline. So, they are kept in the argument of each draw and the Task
+// shader reads them with the model offset and the draw index.
+class IndirectArgumentsMS
+{
+public:
+	struct DrawArguments
+	{
+		VkDrawMeshTasksIndirectCommandEXT       command;
+		PipelineModelsMSIndividual::MeshDetails meshDetails;
+	};
+
+	using MeshBundle_t       = VkMeshBundleMS;
+	using Argument_t         = DrawArguments;
+	using GraphicsPipeline_t = GraphicsPipelineMS;
+
+	[[nodiscard]]
+	static Argument_t GetArgument(
+		const MeshBundle_t& meshBundle, std::uint32_t meshIndex
+	) noexcept;
+
+	static void BindMeshBundle(
+		const VKCommandBuffer& graphicsBuffer, VkPipelineLayout pipelineLayout,
+		const MeshBundle_t& meshBundle
+	) noexcept;
+
+	static void DrawIndirectCount(
+		VkCommandBuffer graphicsCmdBuffer, const SharedBufferData& argumentSharedData,
+		const SharedBufferData& counterSharedData, std::uint32_t maxDrawCount
+	) noexcept;
+
+	static constexpr VkShaderStageFlags s_constantShaderStages
+		= VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+	// The model offset is after the constants of the mesh bundle.
+	static constexpr std::uint32_t      s_modelOffsetConstantOffset
+		= VkMeshBundleMS::GetConstantBufferSize();
+};
+
+template<class Arguments_t>
 class PipelineModelsCSIndirect : public PipelineModelsBase
 {
 	enum class ModelFlag : std::uint32_t
@@ -177,6 +296,9 @@ class PipelineModelsCSIndirect : public PipelineModelsBase
 		SkipCulling = 2u
 	};
 
+	using MeshBundle_t = typename Arguments_t::MeshBundle_t;
+	using Argument_t   = typename Arguments_t::Argument_t;
+
 public:
 	struct PerPipelineData
 	{
@@ -219,8 +341,8 @@ public:
 	void ResetCullingData() const noexcept;
 
 	void Update(
-		size_t frameIndex, const VkMeshBundleVS& meshBundle, bool skipCulling,
-		const Callisto::ReusableVector<Model>& models,
+		size_t frameIndex, const MeshBundle_t& meshBundle, bool skipCulling,
+		const ModelContainer& modelContainer,
 		const std::vector<std::uint32_t>& modelIndicesInContainer,
 		const PipelineModelBundle& pipelineBundle
 	) const noexcept;
@@ -269,10 +391,13 @@ public:
 	}
 };
 
-class PipelineModelsVSIndirect
+template<class Arguments_t>
+class PipelineModelsDrawIndirect
 {
+	using Argument_t = typename Arguments_t::Argument_t;
+
 public:
-	PipelineModelsVSIndirect();
+	PipelineModelsDrawIndirect();
 
 	void SetModelCount(std::uint32_t count) noexcept { m_modelCount = count; }
 
@@ -282,7 +407,7 @@ public:
 		std::vector<SharedBufferGPUWriteOnly>& modelIndicesSharedBuffers
 	);
 
-	void CleanupData() noexcept { operator=(PipelineModelsVSIndirect{}); }
+	void CleanupData() noexcept { operator=(PipelineModelsDrawIndirect{}); }
 
 	void Draw(
 		size_t frameIndex, const VKCommandBuffer& graphicsBuffer, VkPipelineLayout pipelineLayout
@@ -315,16 +440,16 @@ private:
 	);
 
 public:
-	PipelineModelsVSIndirect(const PipelineModelsVSIndirect&) = delete;
-	PipelineModelsVSIndirect& operator=(const PipelineModelsVSIndirect&) = delete;
+	PipelineModelsDrawIndirect(const PipelineModelsDrawIndirect&) = delete;
+	PipelineModelsDrawIndirect& operator=(const PipelineModelsDrawIndirect&) = delete;
 
-	PipelineModelsVSIndirect(PipelineModelsVSIndirect&& other) noexcept
+	PipelineModelsDrawIndirect(PipelineModelsDrawIndirect&& other) noexcept
 		: m_argumentOutputSharedData{ std::move(other.m_argumentOutputSharedData) },
 		m_counterSharedData{ std::move(other.m_counterSharedData) },
 		m_modelIndicesSharedData{ std::move(other.m_modelIndicesSharedData) },
 		m_modelCount{ other.m_modelCount }, m_modelOffset{ other.m_modelOffset }
 	{}
-	PipelineModelsVSIndirect& operator=(PipelineModelsVSIndirect&& other) noexcept
+	PipelineModelsDrawIndirect& operator=(PipelineModelsDrawIndirect&& other) noexcept
 	{
 		m_argumentOutputSharedData = std::move(other.m_argumentOutputSharedData);
 		m_counterSharedData        = std::move(other.m_counterSharedData);
@@ -336,6 +461,9 @@ public:
 	}
 };
 
+using PipelineModelsVSIndirect = PipelineModelsDrawIndirect<IndirectArgumentsVS>;
+using PipelineModelsMSIndirect = PipelineModelsDrawIndirect<IndirectArgumentsMS>;
+
 template<typename Pipeline_t>
 class ModelBundleBase
 {
@@ -453,11 +581,41 @@ class ModelBundleVSIndividual : public ModelBundleCommon<PipelineModelsVSIndivid
 public:
 	ModelBundleVSIndividual() : ModelBundleCommon{} {}
 
+	// The arguments and the instances of the pipelines are written one after another, starting
+	// from the offsets. Returns the offsets after them. If the models have been culled, the
+	// culled visibilities should be used instead of the visibilities of the models.
+	[[nodiscard]]
+	PipelineModelsVSIndividual::ArgumentOffsets UpdateArguments(
+		std::uint8_t* argumentBufferStart, std::uint8_t* instanceBufferStart,
+		PipelineModelsVSIndividual::ArgumentOffsets offsets,
+		std::vector<std::uint64_t>& instanceKeys, const VkMeshBundleVS& meshBundle,
+		const std::vector<std::uint8_t>* culledVisibilities
+	) noexcept;
+
 	void DrawPipeline(
 		size_t pipelineLocalIndex, const VKCommandBuffer& graphicsBuffer,
-		VkPipelineLayout pipelineLayout, const VkMeshBundleVS& meshBundle
+		const VkMeshBundleVS& meshBundle, const Buffer& argumentBuffer
 	) const noexcept;
 
+	// The maximum number of arguments the pipelines could write. As every visible model is an
+	// instance, it is also the maximum number of instances.
+	[[nodiscard]]
+	size_t GetArgumentCount() const noexcept;
+
+	// So the pipelines don't draw the arguments of an older update.
+	void ResetDrawCounts() noexcept;
+
+	[[nodiscard]]
+	std::uint32_t GetDrawCount(size_t pipelineLocalIndex) const noexcept
+	{
+		return m_pipelines[pipelineLocalIndex].GetDrawCount();
+	}
+	[[nodiscard]]
+	std::uint32_t GetInstanceCount(size_t pipelineLocalIndex) const noexcept
+	{
+		return m_pipelines[pipelineLocalIndex].GetInstanceCount();
+	}
+
 public:
 	ModelBundleVSIndividual(const ModelBundleVSIndividual&) = delete;
 	ModelBundleVSIndividual& operator=(const ModelBundleVSIndividual&) = delete;
@@ -480,12 +638,14 @@ class ModelBundleMSIndividual : public ModelBundleCommon<PipelineModelsMSIndivid
 public:
 	ModelBundleMSIndividual() : ModelBundleCommon{} {}
 
+	// If the models have been culled, the culled visibilities should be used instead of the
+	// visibilities of the models.
 	void DrawPipeline(
 		size_t pipelineLocalIndex, const VKCommandBuffer& graphicsBuffer,
-		VkPipelineLayout pipelineLayout, const VkMeshBundleMS& meshBundle
+		VkPipelineLayout pipelineLayout, const VkMeshBundleMS& meshBundle,
+		const std::vector<std::uint8_t>* culledVisibilities
 	) const noexcept;
 
-private:
 	static void SetMeshBundleConstants(
 		VkCommandBuffer graphicsBuffer, VkPipelineLayout pipelineLayout,
 		const VkMeshBundleMS& meshBundle
@@ -506,12 +666,18 @@ public:
 	}
 };
 
-class ModelBundleVSIndirect : public ModelBundleBase<PipelineModelsCSIndirect>
+template<class Arguments_t>
+class ModelBundleIndirect : public ModelBundleBase<PipelineModelsCSIndirect<Arguments_t>>
 {
-	using GraphicsPipeline_t = GraphicsPipelineVSIndirectDraw;
+	using Base_t             = ModelBundleBase<PipelineModelsCSIndirect<Arguments_t>>;
+	using MeshBundle_t       = typename Arguments_t::MeshBundle_t;
+	using GraphicsPipeline_t = typename Arguments_t::GraphicsPipeline_t;
+
+	using Base_t::m_pipelines;
+	using Base_t::m_modelBundle;
 
 public:
-	ModelBundleVSIndirect() : ModelBundleBase{}, m_vsPipelines{} {}
+	ModelBundleIndirect() : Base_t{}, m_drawPipelines{} {}
 
 	// Assuming any new pipelines will added at the back.
 	void AddNewPipelinesFromBundle(
@@ -549,13 +715,13 @@ public:
 	);
 
 	void UpdatePipeline(
-		size_t pipelineLacalIndex, size_t frameIndex, const VkMeshBundleVS& meshBundle,
+		size_t pipelineLacalIndex, size_t frameIndex, const MeshBundle_t& meshBundle,
 		bool skipCulling
 	) const noexcept;
 
 	void DrawPipeline(
 		size_t pipelineLocalIndex, size_t frameIndex, const VKCommandBuffer& graphicsBuffer,
-		VkPipelineLayout pipelineLayout, const VkMeshBundleVS& meshBundle
+		VkPipelineLayout pipelineLayout, const MeshBundle_t& meshBundle
 	) const noexcept;
 
 	void SetupPipelineBuffers(
@@ -593,23 +759,27 @@ private:
 	size_t GetLocalPipelineIndex(std::uint32_t pipelineIndex);
 
 private:
-	std::vector<PipelineModelsVSIndirect> m_vsPipelines;
+	// The pipelines which draw the arguments written by the Compute shader.
+	std::vector<PipelineModelsDrawIndirect<Arguments_t>> m_drawPipelines;
 
 public:
-	ModelBundleVSIndirect(const ModelBundleVSIndirect&) = delete;
-	ModelBundleVSIndirect& operator=(const ModelBundleVSIndirect&) = delete;
+	ModelBundleIndirect(const ModelBundleIndirect&) = delete;
+	ModelBundleIndirect& operator=(const ModelBundleIndirect&) = delete;
 
-	ModelBundleVSIndirect(ModelBundleVSIndirect&& other) noexcept
-		: ModelBundleBase{ std::move(other) },
-		m_vsPipelines{ std::move(other.m_vsPipelines) }
+	ModelBundleIndirect(ModelBundleIndirect&& other) noexcept
+		: Base_t{ std::move(other) },
+		m_drawPipelines{ std::move(other.m_drawPipelines) }
 	{}
-	ModelBundleVSIndirect& operator=(ModelBundleVSIndirect&& other) noexcept
+	ModelBundleIndirect& operator=(ModelBundleIndirect&& other) noexcept
 	{
-		ModelBundleBase::operator=(std::move(other));
-		m_vsPipelines            = std::move(other.m_vsPipelines);
+		Base_t::operator=(std::move(other));
+		m_drawPipelines = std::move(other.m_drawPipelines);
 
 		return *this;
 	}
 };
+
+using ModelBundleVSIndirect = ModelBundleIndirect<IndirectArgumentsVS>;
+using ModelBundleMSIndirect = ModelBundleIndirect<IndirectArgumentsMS>;
 }
 #endif
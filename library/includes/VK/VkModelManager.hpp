@@ -20,6 +20,7 @@
 #include <VkSharedBuffers.hpp>
 
 #include <VkModelBundle.hpp>
+#include <FrustumCuller.hpp>
 #include <Shader.hpp>
 
 namespace Terra
@@ -101,6 +102,43 @@ public:
 		return modelBundle;
 	}
 
+	template<class MeshManager_t>
+	void CullModels(FrustumCuller& frustumCuller, const MeshManager_t& meshManager) const
+	{
+		const size_t bundleCount = std::size(this->m_modelBundles);
+
+		// All of the bundles should be using the same container, but just to be safe.
+		size_t modelCount = 0u;
+
+		for (size_t index = 0u; index < bundleCount; ++index)
+		{
+			if (!this->m_modelBundles.IsInUse(index))
+				continue;
+
+			const ModelBundle& modelBundle = *this->m_modelBundles[index].GetModelBundle();
+
+			modelCount = std::max(modelCount, modelBundle.GetModelContainer()->GetModelCount());
+		}
+
+		frustumCuller.Reset(modelCount);
+
+		for (size_t index = 0u; index < bundleCount; ++index)
+		{
+			if (!this->m_modelBundles.IsInUse(index))
+				continue;
+
+			const ModelBundleType& localModelBundle = this->m_modelBundles[index];
+			const ModelBundle& modelBundle          = *localModelBundle.GetModelBundle();
+
+			frustumCuller.CullModels(
+				*modelBundle.GetModelContainer(), modelBundle.GetIndicesInContainer(),
+				meshManager.GetBundle(localModelBundle.GetMeshBundleIndex())
+			);
+		}
+
+		frustumCuller.Wait();
+	}
+
 public:
 	ModelManagerCommon(const ModelManagerCommon&) = delete;
 	ModelManagerCommon& operator=(const ModelManagerCommon&) = delete;
@@ -121,38 +159,93 @@ class ModelManagerVSIndividual : public  ModelManagerCommon<ModelBundleVSIndivid
 	using Pipeline_t = GraphicsPipelineVSIndividualDraw;
 
 public:
-	ModelManagerVSIndividual() : ModelManagerCommon{} {}
+	ModelManagerVSIndividual(
+		VkDevice device, MemoryManager* memoryManager, std::uint32_t frameCount
+	);
 
-	static void SetGraphicsConstantRange(PipelineLayout& layout) noexcept;
+	void SetDescriptorBufferLayoutVS(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
+	) const noexcept;
+
+	// Should be called before the draws of the frame are recorded. The visible models of a
+	// pipeline which use the same mesh are written as the instances of a single draw. If the
+	// models have been culled, the culled visibilities should be used. The descriptor buffer
+	// of the frame is updated if the instance buffer of the frame is recreated.
+	void UpdateDrawArguments(
+		size_t frameIndex, const MeshManagerVSIndividual& meshManager,
+		const std::vector<std::uint8_t>* culledVisibilities,
+		VkDescriptorBuffer& descriptorBuffer, size_t vsSetLayoutIndex
+	);
 
 	void DrawPipeline(
-		size_t modelBundleIndex, size_t pipelineLocalIndex, const VKCommandBuffer& graphicsBuffer,
-		const MeshManagerVSIndividual& meshManager, VkPipelineLayout pipelineLayout
+		size_t frameIndex, size_t modelBundleIndex, size_t pipelineLocalIndex,
+		const VKCommandBuffer& graphicsBuffer, const MeshManagerVSIndividual& meshManager
 	) const noexcept;
 
+	// The number of the draws written in the last update.
+	[[nodiscard]]
+	std::uint32_t GetDrawCount(size_t modelBundleIndex, size_t pipelineLocalIndex) const noexcept
+	{
+		return m_modelBundles[modelBundleIndex].GetDrawCount(pipelineLocalIndex);
+	}
+	// The number of the instances written in the last update.
+	[[nodiscard]]
+	std::uint32_t GetInstanceCount(
+		size_t modelBundleIndex, size_t pipelineLocalIndex
+	) const noexcept {
+		return m_modelBundles[modelBundleIndex].GetInstanceCount(pipelineLocalIndex);
+	}
+
+private:
+	// Same as the model indices of the VS Indirect path, so the vertex shaders of both paths
+	// can have the same layout.
+	static constexpr std::uint32_t s_instanceIndicesVSBindingSlot = 2u;
+
+private:
+	// The buffers of a frame are only written after its previous submission has finished, so
+	// they can be recreated when there are more models.
+	std::vector<Buffer>        m_argumentBuffers;
+	std::vector<Buffer>        m_instanceBuffers;
+	std::vector<std::uint64_t> m_instanceKeys;
+
 public:
 	ModelManagerVSIndividual(const ModelManagerVSIndividual&) = delete;
 	ModelManagerVSIndividual& operator=(const ModelManagerVSIndividual&) = delete;
 
 	ModelManagerVSIndividual(ModelManagerVSIndividual&& other) noexcept
-		: ModelManagerCommon{ std::move(other) }
+		: ModelManagerCommon{ std::move(other) },
+		m_argumentBuffers{ std::move(other.m_argumentBuffers) },
+		m_instanceBuffers{ std::move(other.m_instanceBuffers) },
+		m_instanceKeys{ std::move(other.m_instanceKeys) }
 	{}
 	ModelManagerVSIndividual& operator=(ModelManagerVSIndividual&& other) noexcept
 	{
 		ModelManagerCommon::operator=(std::move(other));
+		m_argumentBuffers = std::move(other.m_argumentBuffers);
+		m_instanceBuffers = std::move(other.m_instanceBuffers);
+		m_instanceKeys    = std::move(other.m_instanceKeys);
 
 		return *this;
 	}
 };
 
-class ModelManagerVSIndirect : public ModelManager<ModelBundleVSIndirect>
+// The culling and the argument buffers of the Indirect paths. The derived classes only add the
+// bindings of their graphics shaders.
+template<class Arguments_t>
+class ModelManagerIndirect : public ModelManager<ModelBundleIndirect<Arguments_t>>
 {
-	using GraphicsPipeline_t = GraphicsPipelineVSIndirectDraw;
+protected:
+	using ModelBundle_t      = ModelBundleIndirect<Arguments_t>;
+	using GraphicsPipeline_t = typename Arguments_t::GraphicsPipeline_t;
 	using ComputePipeline_t  = ComputePipeline;
 
+	using ModelManager<ModelBundle_t>::m_modelBundles;
+
 	struct ConstantData
 	{
 		std::uint32_t allocatedModelCount;
+		// Only read by the occlusion culling shader.
+		std::uint32_t occlusionPhase;
 	};
 
 	struct PerModelBundleData
@@ -161,7 +254,7 @@ class ModelManagerVSIndirect : public ModelManager<ModelBundleVSIndirect>
 	};
 
 public:
-	ModelManagerVSIndirect(
+	ModelManagerIndirect(
 		VkDevice device, MemoryManager* memoryManager, QueueIndices3 queueIndices3,
 		std::uint32_t frameCount
 	);
@@ -171,9 +264,16 @@ public:
 	) const noexcept;
 
 	void SetCSPSOIndex(std::uint32_t psoIndex) noexcept { m_csPSOIndex = psoIndex; }
+	void SetOcclusionCSPSOIndex(std::uint32_t psoIndex) noexcept
+	{
+		m_occlusionCSPSOIndex = psoIndex;
+	}
+
+	// The draw counts of each frame are copied to a host visible buffer after the culling. They
+	// can be read once the frame has finished on the GPU.
+	void SetDrawCountReadback(bool value);
 
 	static void SetComputeConstantRange(PipelineLayout& layout) noexcept;
-	static void SetGraphicsConstantRange(PipelineLayout& layout) noexcept;
 
 	// Will think about Adding a new model later.
 	[[nodiscard]]
@@ -183,13 +283,6 @@ public:
 	[[nodiscard]]
 	std::shared_ptr<ModelBundle> RemoveModelBundle(std::uint32_t bundleIndex) noexcept;
 
-	void SetDescriptorBufferLayoutVS(
-		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
-	) const noexcept;
-	void SetDescriptorBuffersVS(
-		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
-	) const;
-
 	void SetDescriptorBufferLayoutCS(
 		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t csSetLayoutIndex
 	) const noexcept;
@@ -203,25 +296,81 @@ public:
 		std::uint32_t increasedModelsPipelineIndex
 	);
 
+	template<class MeshManager_t>
 	void DrawPipeline(
 		size_t frameIndex, size_t modelBundleIndex, size_t pipelineLocalIndex,
-		const VKCommandBuffer& graphicsBuffer, const MeshManagerVSIndirect& meshManager,
+		const VKCommandBuffer& graphicsBuffer, const MeshManager_t& meshManager,
 		VkPipelineLayout pipelineLayout
-	) const noexcept;
+	) const noexcept {
+		if (!m_modelBundles.IsInUse(modelBundleIndex))
+			return;
+
+		const ModelBundle_t& modelBundle = m_modelBundles[modelBundleIndex];
+
+		const auto& meshBundle = meshManager.GetBundle(modelBundle.GetMeshBundleIndex());
+
+		modelBundle.DrawPipeline(
+			pipelineLocalIndex, frameIndex, graphicsBuffer, pipelineLayout, meshBundle
+		);
+	}
 
 	void Dispatch(
 		const VKCommandBuffer& computeBuffer,
 		const PipelineManager<ComputePipeline_t>& pipelineManager
 	) const noexcept;
+	// In the first phase, only the models which were visible in the last frame are drawn. In
+	// the second phase, every model is tested against the Hi-Z pyramid of the depth drawn in the
+	// first phase and the visible ones which weren't drawn already are drawn. The visibility of
+	// each model is kept for the next frame.
+	void DispatchOcclusion(
+		const VKCommandBuffer& computeBuffer,
+		const PipelineManager<ComputePipeline_t>& pipelineManager, std::uint32_t occlusionPhase
+	);
+
+	// Should be called after each Dispatch, if the readback is enabled. Without the occlusion
+	// culling, the phase should be 0.
+	void CopyDrawCounts(
+		const VKCommandBuffer& computeBuffer, size_t frameIndex, std::uint32_t occlusionPhase
+	) const noexcept;
+
+	// The number of the indirect draws of both phases in the last finished submission of the
+	// frame. Will be 0 if the readback isn't enabled.
+	[[nodiscard]]
+	std::uint32_t GetDrawCount(size_t frameIndex) const noexcept;
+	[[nodiscard]]
+	bool IsDrawCountReadbackEnabled() const noexcept { return m_drawCountReadback; }
 
+	template<class MeshManager_t>
 	void UpdatePipelinePerFrame(
 		VkDeviceSize frameIndex, size_t modelBundleIndex, size_t pipelineLocalIndex,
-		const MeshManagerVSIndirect& meshManager, bool skipCulling
-	) const noexcept;
+		const MeshManager_t& meshManager, bool skipCulling
+	) const noexcept {
+		std::uint8_t* bufferOffsetPtr = m_perModelBundleBuffer.GetInstancePtr(frameIndex);
+		constexpr size_t strideSize   = sizeof(PerModelBundleData);
+
+		if (!m_modelBundles.IsInUse(modelBundleIndex))
+			return;
+
+		const VkDeviceSize bufferOffset     = strideSize * modelBundleIndex;
+
+		const ModelBundle_t& modelBundle    = m_modelBundles[modelBundleIndex];
+
+		const std::uint32_t meshBundleIndex = modelBundle.GetMeshBundleIndex();
+
+		const auto& meshBundle              = meshManager.GetBundle(meshBundleIndex);
+
+		modelBundle.UpdatePipeline(
+			pipelineLocalIndex, static_cast<size_t>(frameIndex), meshBundle, skipCulling
+		);
+
+		memcpy(bufferOffsetPtr + bufferOffset, &meshBundleIndex, strideSize);
+	}
 
 private:
 	void UpdateAllocatedModelCount() noexcept;
 	void UpdateCounterResetValues();
+	void UpdateModelVisibilityBuffer();
+	void UpdateDrawCountReadbackBuffers();
 
 	[[nodiscard]]
 	static consteval std::uint32_t GetConstantBufferSize() noexcept
@@ -229,7 +378,7 @@ private:
 		return static_cast<std::uint32_t>(sizeof(ConstantData));
 	}
 
-private:
+protected:
 	std::vector<SharedBufferCPU>          m_argumentInputBuffers;
 	std::vector<SharedBufferGPUWriteOnly> m_argumentOutputBuffers;
 	std::vector<SharedBufferGPUWriteOnly> m_modelIndicesBuffers;
@@ -242,10 +391,12 @@ private:
 	std::uint32_t                         m_dispatchXCount;
 	std::uint32_t                         m_allocatedModelCount;
 	std::uint32_t                         m_csPSOIndex;
-
-	// Vertex Shader ones
-	// To read the model indices of the not culled models.
-	static constexpr std::uint32_t s_modelIndicesVSBindingSlot   = 2u;
+	// One value for each allocated model. Only accessed on the Compute queue.
+	Buffer                                m_modelVisibilityBuffer;
+	std::vector<Buffer>                   m_drawCountReadbackBuffers;
+	std::uint32_t                         m_occlusionCSPSOIndex;
+	bool                                  m_clearModelVisibility;
+	bool                                  m_drawCountReadback;
 
 	// Compute Shader ones
 	static constexpr std::uint32_t s_perModelBindingSlot         = 1u;
@@ -256,16 +407,20 @@ private:
 	static constexpr std::uint32_t s_perModelBundleBindingSlot   = 8u;
 	// To write the model indices of the not culled models.
 	static constexpr std::uint32_t s_modelIndicesVSCSBindingSlot = 9u;
+	static constexpr std::uint32_t s_modelVisibilityBindingSlot  = 11u;
+
+	// The counters of the first and the second occlusion phases.
+	static constexpr VkDeviceSize s_drawCountPhaseCount = 2u;
 
 	// Each Compute Thread Group should have 64 threads.
 	static constexpr float THREADBLOCKSIZE = 64.f;
 
 public:
-	ModelManagerVSIndirect(const ModelManagerVSIndirect&) = delete;
-	ModelManagerVSIndirect& operator=(const ModelManagerVSIndirect&) = delete;
+	ModelManagerIndirect(const ModelManagerIndirect&) = delete;
+	ModelManagerIndirect& operator=(const ModelManagerIndirect&) = delete;
 
-	ModelManagerVSIndirect(ModelManagerVSIndirect&& other) noexcept
-		: ModelManager{ std::move(other) },
+	ModelManagerIndirect(ModelManagerIndirect&& other) noexcept
+		: ModelManager<ModelBundle_t>{ std::move(other) },
 		m_argumentInputBuffers{ std::move(other.m_argumentInputBuffers) },
 		m_argumentOutputBuffers{ std::move(other.m_argumentOutputBuffers) },
 		m_modelIndicesBuffers{ std::move(other.m_modelIndicesBuffers) },
@@ -277,23 +432,110 @@ public:
 		m_queueIndices3{ other.m_queueIndices3 },
 		m_dispatchXCount{ other.m_dispatchXCount },
 		m_allocatedModelCount{ other.m_allocatedModelCount },
-		m_csPSOIndex{ other.m_csPSOIndex }
+		m_csPSOIndex{ other.m_csPSOIndex },
+		m_modelVisibilityBuffer{ std::move(other.m_modelVisibilityBuffer) },
+		m_drawCountReadbackBuffers{ std::move(other.m_drawCountReadbackBuffers) },
+		m_occlusionCSPSOIndex{ other.m_occlusionCSPSOIndex },
+		m_clearModelVisibility{ other.m_clearModelVisibility },
+		m_drawCountReadback{ other.m_drawCountReadback }
+	{}
+	ModelManagerIndirect& operator=(ModelManagerIndirect&& other) noexcept
+	{
+		ModelManager<ModelBundle_t>::operator=(std::move(other));
+		m_argumentInputBuffers     = std::move(other.m_argumentInputBuffers);
+		m_argumentOutputBuffers    = std::move(other.m_argumentOutputBuffers);
+		m_modelIndicesBuffers      = std::move(other.m_modelIndicesBuffers);
+		m_perPipelineBuffer        = std::move(other.m_perPipelineBuffer);
+		m_counterBuffers           = std::move(other.m_counterBuffers);
+		m_counterResetBuffer       = std::move(other.m_counterResetBuffer);
+		m_perModelBundleBuffer     = std::move(other.m_perModelBundleBuffer);
+		m_perModelBuffer           = std::move(other.m_perModelBuffer);
+		m_queueIndices3            = other.m_queueIndices3;
+		m_dispatchXCount           = other.m_dispatchXCount;
+		m_allocatedModelCount      = other.m_allocatedModelCount;
+		m_csPSOIndex               = other.m_csPSOIndex;
+		m_modelVisibilityBuffer    = std::move(other.m_modelVisibilityBuffer);
+		m_drawCountReadbackBuffers = std::move(other.m_drawCountReadbackBuffers);
+		m_occlusionCSPSOIndex      = other.m_occlusionCSPSOIndex;
+		m_clearModelVisibility     = other.m_clearModelVisibility;
+		m_drawCountReadback        = other.m_drawCountReadback;
+
+		return *this;
+	}
+};
+
+class ModelManagerVSIndirect : public ModelManagerIndirect<IndirectArgumentsVS>
+{
+public:
+	ModelManagerVSIndirect(
+		VkDevice device, MemoryManager* memoryManager, QueueIndices3 queueIndices3,
+		std::uint32_t frameCount
+	) : ModelManagerIndirect{ device, memoryManager, queueIndices3, frameCount }
+	{}
+
+	static void SetGraphicsConstantRange(PipelineLayout& layout) noexcept;
+
+	void SetDescriptorBufferLayoutVS(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
+	) const noexcept;
+	void SetDescriptorBuffersVS(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
+	) const;
+
+private:
+	// To read the model indices of the not culled models.
+	static constexpr std::uint32_t s_modelIndicesVSBindingSlot = 2u;
+
+public:
+	ModelManagerVSIndirect(const ModelManagerVSIndirect&) = delete;
+	ModelManagerVSIndirect& operator=(const ModelManagerVSIndirect&) = delete;
+
+	ModelManagerVSIndirect(ModelManagerVSIndirect&& other) noexcept
+		: ModelManagerIndirect{ std::move(other) }
 	{}
 	ModelManagerVSIndirect& operator=(ModelManagerVSIndirect&& other) noexcept
 	{
-		ModelManager::operator=(std::move(other));
-		m_argumentInputBuffers   = std::move(other.m_argumentInputBuffers);
-		m_argumentOutputBuffers  = std::move(other.m_argumentOutputBuffers);
-		m_modelIndicesBuffers    = std::move(other.m_modelIndicesBuffers);
-		m_perPipelineBuffer      = std::move(other.m_perPipelineBuffer);
-		m_counterBuffers         = std::move(other.m_counterBuffers);
-		m_counterResetBuffer     = std::move(other.m_counterResetBuffer);
-		m_perModelBundleBuffer   = std::move(other.m_perModelBundleBuffer);
-		m_perModelBuffer         = std::move(other.m_perModelBuffer);
-		m_queueIndices3          = other.m_queueIndices3;
-		m_dispatchXCount         = other.m_dispatchXCount;
-		m_allocatedModelCount    = other.m_allocatedModelCount;
-		m_csPSOIndex             = other.m_csPSOIndex;
+		ModelManagerIndirect::operator=(std::move(other));
+
+		return *this;
+	}
+};
+
+// The Task shader reads the model index and the mesh details of each draw, so both the model
+// indices and the arguments written by the Compute shader are bound.
+class ModelManagerMSIndirect : public ModelManagerIndirect<IndirectArgumentsMS>
+{
+public:
+	ModelManagerMSIndirect(
+		VkDevice device, MemoryManager* memoryManager, QueueIndices3 queueIndices3,
+		std::uint32_t frameCount
+	) : ModelManagerIndirect{ device, memoryManager, queueIndices3, frameCount }
+	{}
+
+	static void SetGraphicsConstantRange(PipelineLayout& layout) noexcept;
+
+	void SetDescriptorBufferLayoutMS(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t msSetLayoutIndex
+	) const noexcept;
+	void SetDescriptorBuffersMS(
+		std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t msSetLayoutIndex
+	) const;
+
+private:
+	// The slots 2 to 5 are used by the Mesh Manager.
+	static constexpr std::uint32_t s_modelIndicesMSBindingSlot   = 7u;
+	static constexpr std::uint32_t s_argumentOutputMSBindingSlot = 8u;
+
+public:
+	ModelManagerMSIndirect(const ModelManagerMSIndirect&) = delete;
+	ModelManagerMSIndirect& operator=(const ModelManagerMSIndirect&) = delete;
+
+	ModelManagerMSIndirect(ModelManagerMSIndirect&& other) noexcept
+		: ModelManagerIndirect{ std::move(other) }
+	{}
+	ModelManagerMSIndirect& operator=(ModelManagerMSIndirect&& other) noexcept
+	{
+		ModelManagerIndirect::operator=(std::move(other));
 
 		return *this;
 	}
@@ -310,7 +552,8 @@ public:
 
 	void DrawPipeline(
 		size_t modelBundleIndex, size_t pipelineLocalIndex, const VKCommandBuffer& graphicsBuffer,
-		const MeshManagerMS& meshManager, VkPipelineLayout pipelineLayout
+		const MeshManagerMS& meshManager, VkPipelineLayout pipelineLayout,
+		const std::vector<std::uint8_t>* culledVisibilities
 	) const noexcept;
 
 public:
@@ -0,0 +1,106 @@
+#ifndef VK_PIPELINE_CACHE_HPP_
+#define VK_PIPELINE_CACHE_HPP_
+#include <vulkan/vulkan.hpp>
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace Terra
+{
+// The cache is shared between the graphics and the compute pipelines. Once a directory is set,
+// the cache is loaded from a file in it and written back when the cache is destroyed. The name
+// of the file has the pipeline cache UUID and the version of the driver, so a driver update
+// would just create a new file.
+class PipelineCache
+{
+	struct FileHeader
+	{
+		std::uint32_t                          magic;
+		std::uint32_t                          driverVersion;
+		std::uint32_t                          vendorID;
+		std::uint32_t                          deviceID;
+		std::array<std::uint8_t, VK_UUID_SIZE> pipelineCacheUUID;
+		std::uint64_t                          dataSize;
+	};
+
+public:
+	PipelineCache(VkDevice device);
+	~PipelineCache() noexcept;
+
+	// Creates an empty cache, which will only last until the cache is destroyed.
+	void Create(VkPhysicalDevice physicalDevice);
+
+	// If there is a valid cache file in the directory, its data will be loaded. The pipelines
+	// which have already been added to the cache will be kept.
+	void LoadFromDirectory(const std::wstring& directory);
+
+	// Writes the cache to the file in the directory. Does nothing if no directory was set.
+	[[nodiscard]]
+	bool Save() const;
+
+	// Only counts the pipelines which were created with the creation feedback.
+	void AddCreationFeedback(const VkPipelineCreationFeedback& feedback) noexcept;
+
+	[[nodiscard]]
+	VkPipelineCache Get() const noexcept { return m_pipelineCache; }
+	[[nodiscard]]
+	std::uint32_t GetHitCount() const noexcept { return m_hitCount.load(); }
+	[[nodiscard]]
+	std::uint32_t GetMissCount() const noexcept { return m_missCount.load(); }
+	[[nodiscard]]
+	const std::wstring& GetCacheFilePath() const noexcept { return m_cacheFilePath; }
+
+private:
+	void SelfDestruct() noexcept;
+
+	[[nodiscard]]
+	std::vector<std::uint8_t> LoadCacheData() const;
+	[[nodiscard]]
+	std::wstring GetCacheFileName() const;
+
+	[[nodiscard]]
+	bool IsHeaderValid(const FileHeader& header) const noexcept;
+
+	[[nodiscard]]
+	VkPipelineCache CreatePipelineCache(const std::vector<std::uint8_t>& initialData) const;
+
+private:
+	VkDevice                   m_device;
+	VkPipelineCache            m_pipelineCache;
+	FileHeader                 m_header;
+	std::wstring               m_cacheFilePath;
+	std::atomic<std::uint32_t> m_hitCount;
+	std::atomic<std::uint32_t> m_missCount;
+
+	static constexpr std::uint32_t s_fileMagic = 0x54504331u; // TPC1
+
+public:
+	PipelineCache(const PipelineCache&) = delete;
+	PipelineCache& operator=(const PipelineCache&) = delete;
+
+	PipelineCache(PipelineCache&& other) noexcept
+		: m_device{ other.m_device },
+		m_pipelineCache{ std::exchange(other.m_pipelineCache, VK_NULL_HANDLE) },
+		m_header{ other.m_header },
+		m_cacheFilePath{ std::move(other.m_cacheFilePath) },
+		m_hitCount{ other.m_hitCount.load() },
+		m_missCount{ other.m_missCount.load() }
+	{}
+	PipelineCache& operator=(PipelineCache&& other) noexcept
+	{
+		SelfDestruct();
+
+		m_device        = other.m_device;
+		m_pipelineCache = std::exchange(other.m_pipelineCache, VK_NULL_HANDLE);
+		m_header        = other.m_header;
+		m_cacheFilePath = std::move(other.m_cacheFilePath);
+		m_hitCount      = other.m_hitCount.load();
+		m_missCount     = other.m_missCount.load();
+
+		return *this;
+	}
+};
+}
+#endif
@@ -5,11 +5,18 @@
 #include <concepts>
 #include <algorithm>
 #include <type_traits>
+#include <future>
+#include <functional>
+#include <chrono>
+#include <memory>
+#include <ThreadPool.hpp>
 #include <VkPipelineLayout.hpp>
 #include <VkGraphicsPipelineVS.hpp>
 #include <VkGraphicsPipelineMS.hpp>
 #include <VkComputePipeline.hpp>
 #include <ReusableVector.hpp>
+#include <PipelineHashIndex.hpp>
+#include <PipelineManifest.hpp>
 
 namespace Terra
 {
@@ -24,17 +31,69 @@ public:
 
 public:
 	PipelineManager(VkDevice device)
-		: m_device{ device }, m_pipelineLayout{ VK_NULL_HANDLE }, m_shaderPath{}, m_pipelines{}
+		: m_device{ device }, m_pipelineLayout{ VK_NULL_HANDLE }, m_pipelineCache{ nullptr },
+		m_pipelineManifest{ nullptr }, m_threadPool{ nullptr },
+		m_shaderModules{ std::make_unique<ShaderModuleCache>(device) }, m_pipelineLibrary{},
+		m_pipelines{}, m_pipelineHashIndex{}, m_pendingPipelines{}, m_retiredPipelines{},
+		m_waitObjs{}, m_frameCount{ 0u }
 	{}
+	~PipelineManager() noexcept
+	{
+		// The compilations reference the shader modules.
+		WaitForPendingPipelines();
+	}
 
 	void SetPipelineLayout(VkPipelineLayout pipelineLayout) noexcept
 	{
 		m_pipelineLayout = pipelineLayout;
 	}
 
-	void SetShaderPath(std::wstring shaderPath) noexcept
+	// The cache isn't owned, as it is shared with the other pipeline managers.
+	void SetPipelineCache(PipelineCache* pipelineCache) noexcept
+	{
+		m_pipelineCache = pipelineCache;
+	}
+
+	// If set, every pipeline which is added is recorded in the manifest. The manifest isn't owned,
+	// as it is shared with the other pipeline managers.
+	void SetPipelineManifest(PipelineManifest* pipelineManifest) noexcept
+	{
+		m_pipelineManifest = pipelineManifest;
+	}
+
+	// If set, the pipelines are compiled in parallel on the pool.
+	void SetThreadPool(ThreadPool* threadPool) noexcept
+	{
+		m_threadPool = threadPool;
+	}
+
+	// The pipelines are linked from the parts in the library instead of being compiled as a
+	// whole. The fast linked pipelines are replaced by the optimised ones when they are ready,
+	// but the replaced ones are kept for a few frames, as they might still be in use.
+	void EnablePipelineLibrary(size_t frameCount) requires !std::is_same_v<Pipeline, ComputePipeline>
 	{
-		m_shaderPath = std::move(shaderPath);
+		// The pending optimised links would be using the old library.
+		WaitForPendingPipelines();
+
+		m_pipelineLibrary = std::make_unique<GraphicsPipelineLibrary>(m_device);
+		m_frameCount      = frameCount;
+	}
+
+	// The loaded shaders are only discarded if the path changes.
+	void SetShaderPath(std::wstring shaderPath)
+	{
+		if (shaderPath == m_shaderModules->GetShaderPath())
+			return;
+
+		// The pending compilations are still using the shader modules and the library parts
+		// which are about to be destroyed.
+		WaitForPendingPipelines();
+
+		// The parts of the library are keyed by the handles of the shader modules.
+		if (m_pipelineLibrary)
+			m_pipelineLibrary->Clear();
+
+		m_shaderModules->SetShaderPath(std::move(shaderPath));
 	}
 
 	void BindPipeline(size_t index, const VKCommandBuffer& commandBuffer) const noexcept
@@ -44,6 +103,16 @@ public:
 
 	void SetOverwritable(size_t pipelineIndex) noexcept
 	{
+		// Otherwise a pending compilation could be installed in the slot after it is reused.
+		WaitForPendingPipelines();
+
+		// So the pipeline can't be found anymore, as the slot could be reused by a different
+		// pipeline.
+		m_pipelineHashIndex.Remove(
+			m_pipelines[pipelineIndex].GetExternalPipeline().GetHash(),
+			static_cast<std::uint32_t>(pipelineIndex)
+		);
+
 		m_pipelines.MakeUnavailable(pipelineIndex);
 	}
 
@@ -60,14 +129,170 @@ public:
 		{
 			Pipeline pipeline{};
 
-			pipeline.Create(m_device, m_pipelineLayout, m_shaderPath, extPipeline);
+			pipeline.Create(
+				m_device, m_pipelineLayout, *m_shaderModules, extPipeline, m_pipelineCache,
+				m_pipelineLibrary.get()
+			);
+
+			psoIndex = static_cast<std::uint32_t>(AddPipeline(std::move(pipeline)));
 
-			psoIndex = static_cast<std::uint32_t>(m_pipelines.Add(std::move(pipeline)));
+			ScheduleOptimisedLink(psoIndex);
 		}
 
 		return psoIndex;
 	}
 
+	// The new pipelines are compiled in parallel and are ready when this returns.
+	[[nodiscard]]
+	std::vector<std::uint32_t> AddOrGetGraphicsPipelines(
+		const std::vector<PipelineExt>& extPipelines
+	) requires !std::is_same_v<Pipeline, ComputePipeline>
+	{
+		std::vector<std::uint32_t> psoIndices{};
+		psoIndices.reserve(std::size(extPipelines));
+
+		// The new pipelines must be added first, as adding could reallocate the pipelines.
+		std::vector<std::pair<size_t, const PipelineExt*>> newPipelines{};
+
+		for (const PipelineExt& extPipeline : extPipelines)
+		{
+			std::optional<std::uint32_t> oPSOIndex = TryToGetPSOIndex(extPipeline);
+
+			if (oPSOIndex)
+				psoIndices.emplace_back(oPSOIndex.value());
+			else
+			{
+				Pipeline pipeline{};
+
+				pipeline.SetExternalPipeline(extPipeline);
+
+				const size_t psoIndex = AddPipeline(std::move(pipeline));
+
+				psoIndices.emplace_back(static_cast<std::uint32_t>(psoIndex));
+				newPipelines.emplace_back(psoIndex, &extPipeline);
+			}
+		}
+
+		for (const auto& [psoIndex, extPipeline] : newPipelines)
+			RunOnPool(
+				[this, psoIndex, extPipeline]
+				{
+					m_pipelines[psoIndex].Create(
+						m_device, m_pipelineLayout, *m_shaderModules, *extPipeline,
+						m_pipelineCache, m_pipelineLibrary.get()
+					);
+				}
+			);
+
+		WaitForPool();
+
+		for (const auto& [psoIndex, _] : newPipelines)
+			ScheduleOptimisedLink(psoIndex);
+
+		return psoIndices;
+	}
+
+	// Returns the index straight away and compiles the pipeline on the pool. The pipeline can't
+	// be bound until it is ready, so the draws using it should be skipped until then.
+	[[nodiscard]]
+	std::uint32_t AddOrGetGraphicsPipelineAsync(
+		const PipelineExt& extPipeline
+	) requires !std::is_same_v<Pipeline, ComputePipeline>
+	{
+		std::optional<std::uint32_t> oPSOIndex = TryToGetPSOIndex(extPipeline);
+
+		if (oPSOIndex)
+			return oPSOIndex.value();
+
+		// A fast link shouldn't take long enough to be worth waiting for and the optimised link
+		// is done on the pool anyway.
+		if (!m_threadPool || m_pipelineLibrary)
+			return AddOrGetGraphicsPipeline(extPipeline);
+
+		// The slot only keeps the external pipeline, so it can be found, until the compiled
+		// one is installed.
+		Pipeline placeholderPipeline{};
+
+		placeholderPipeline.SetExternalPipeline(extPipeline);
+
+		const size_t psoIndex = AddPipeline(std::move(placeholderPipeline));
+
+		// The pending pipeline is on the heap, so it stays at the same address while the
+		// compilation is running. Nothing which is moved with the manager is captured either.
+		auto pendingPipeline = std::make_unique<PendingPipeline>(
+			psoIndex, Pipeline{}, extPipeline
+		);
+
+		pendingPipeline->waitObj = m_threadPool->SubmitWork(std::function{
+			[
+				pendingPipelinePtr = pendingPipeline.get(), device = m_device,
+				pipelineLayout = m_pipelineLayout, shaderModules = m_shaderModules.get(),
+				pipelineCache = m_pipelineCache
+			]
+			{
+				pendingPipelinePtr->pipeline.Create(
+					device, pipelineLayout, *shaderModules, pendingPipelinePtr->extPipeline,
+					pipelineCache, nullptr
+				);
+			}});
+
+		m_pendingPipelines.emplace_back(std::move(pendingPipeline));
+
+		return static_cast<std::uint32_t>(psoIndex);
+	}
+
+	// Installs the pipelines which have finished compiling. Should be called once per frame.
+	void UpdatePendingPipelines()
+	{
+		std::erase_if(
+			m_retiredPipelines,
+			[](RetiredPipeline& retiredPipeline)
+			{
+				const bool isUnused = retiredPipeline.remainingFrameCount == 0u;
+
+				if (!isUnused)
+					--retiredPipeline.remainingFrameCount;
+
+				return isUnused;
+			}
+		);
+
+		std::erase_if(
+			m_pendingPipelines,
+			[this](std::unique_ptr<PendingPipeline>& pendingPipeline)
+			{
+				using namespace std::chrono_literals;
+
+				const bool isReady
+					= pendingPipeline->waitObj.wait_for(0s) == std::future_status::ready;
+
+				if (isReady)
+					InstallPendingPipeline(*pendingPipeline);
+
+				return isReady;
+			}
+		);
+	}
+
+	void WaitForPendingPipelines()
+	{
+		for (std::unique_ptr<PendingPipeline>& pendingPipeline : m_pendingPipelines)
+		{
+			pendingPipeline->waitObj.wait();
+
+			InstallPendingPipeline(*pendingPipeline);
+		}
+
+		m_pendingPipelines.clear();
+	}
+
+	[[nodiscard]]
+	bool IsPipelineReady(size_t index) const noexcept
+		requires !std::is_same_v<Pipeline, ComputePipeline>
+	{
+		return m_pipelines[index].IsReady();
+	}
+
 	std::uint32_t AddOrGetComputePipeline(const PipelineExt& extPipeline)
 		requires std::is_same_v<Pipeline, ComputePipeline>
 	{
@@ -80,59 +305,223 @@ public:
 		{
 			Pipeline pipeline{};
 
-			pipeline.Create(m_device, m_pipelineLayout, extPipeline, m_shaderPath);
+			pipeline.Create(
+				m_device, m_pipelineLayout, extPipeline, *m_shaderModules, m_pipelineCache
+			);
 
-			psoIndex = static_cast<std::uint32_t>(m_pipelines.Add(std::move(pipeline)));
+			psoIndex = static_cast<std::uint32_t>(AddPipeline(std::move(pipeline)));
 		}
 
 		return psoIndex;
 	}
 
+	// Compiles the pipelines which haven't been added yet, so they would only need to be looked
+	// up when they are requested. Should be called after the layout and the shader path have
+	// been set. Taken by value, as they would usually be from the manifest, which is updated when
+	// the pipelines are added.
+	void WarmUpPipelines(std::vector<PipelineExt> extPipelines)
+	{
+		// There are only a few compute pipelines, so they aren't compiled on the pool.
+		if constexpr (std::is_same_v<Pipeline, ComputePipeline>)
+			for (const PipelineExt& extPipeline : extPipelines)
+				AddOrGetComputePipeline(extPipeline);
+		else
+		{
+			[[maybe_unused]] const std::vector<std::uint32_t> psoIndices
+				= AddOrGetGraphicsPipelines(extPipelines);
+		}
+	}
+
 	void RecreateAllGraphicsPipelines() requires !std::is_same_v<Pipeline, ComputePipeline>
 	{
-		for (Pipeline& pipeline : m_pipelines)
-			pipeline.Recreate(m_device, m_pipelineLayout, m_shaderPath);
+		RecreateAllPipelines();
 	}
 
 	void RecreateAllComputePipelines() requires std::is_same_v<Pipeline, ComputePipeline>
 	{
-		for (Pipeline& pipeline : m_pipelines)
-			pipeline.Recreate(m_device, m_pipelineLayout, m_shaderPath);
+		RecreateAllPipelines();
 	}
 
 	[[nodiscard]]
 	VkPipelineLayout GetLayout() const noexcept { return m_pipelineLayout; }
 
 	[[nodiscard]]
-	const std::wstring& GetShaderPath() const noexcept { return m_shaderPath; }
+	bool IsPipelineLibraryEnabled() const noexcept { return m_pipelineLibrary != nullptr; }
+
+	// The compilations and the optimised links which haven't been installed yet.
+	[[nodiscard]]
+	size_t GetPendingPipelineCount() const noexcept { return std::size(m_pendingPipelines); }
+
+	[[nodiscard]]
+	const std::wstring& GetShaderPath() const noexcept { return m_shaderModules->GetShaderPath(); }
 
 	const Pipeline& GetPipeline(size_t index) const noexcept { return m_pipelines[index]; }
 
 private:
-	[[nodiscard]]
-	std::optional<std::uint32_t> TryToGetPSOIndex(const PipelineExt& extPipeline) const noexcept
+	struct PendingPipeline
+	{
+		size_t            pipelineIndex;
+		Pipeline          pipeline;
+		PipelineExt       extPipeline;
+		std::future<void> waitObj;
+	};
+
+	struct RetiredPipeline
+	{
+		Pipeline pipeline;
+		size_t   remainingFrameCount;
+	};
+
+private:
+	void RecreateAllPipelines()
+	{
+		// The pending ones would have been compiled with the old layout.
+		WaitForPendingPipelines();
+
+		if constexpr (std::is_same_v<Pipeline, ComputePipeline>)
+			for (Pipeline& pipeline : m_pipelines)
+				RunOnPool(
+					[this, &pipeline]
+					{
+						pipeline.Recreate(
+							m_device, m_pipelineLayout, *m_shaderModules, m_pipelineCache
+						);
+					}
+				);
+		else
+		{
+			// The parts of the library have the old layout.
+			if (m_pipelineLibrary)
+				m_pipelineLibrary->Clear();
+
+			for (Pipeline& pipeline : m_pipelines)
+				RunOnPool(
+					[this, &pipeline]
+					{
+						pipeline.Recreate(
+							m_device, m_pipelineLayout, *m_shaderModules, m_pipelineCache,
+							m_pipelineLibrary.get()
+						);
+					}
+				);
+		}
+
+		WaitForPool();
+
+		if constexpr (!std::is_same_v<Pipeline, ComputePipeline>)
+		{
+			const size_t pipelineCount = std::size(m_pipelines.Get());
+
+			for (size_t index = 0u; index < pipelineCount; ++index)
+				if (m_pipelines[index].IsReady())
+					ScheduleOptimisedLink(index);
+		}
+	}
+
+	// The fast linked pipeline in the slot is used until the optimised one is installed.
+	void ScheduleOptimisedLink(size_t pipelineIndex)
+		requires !std::is_same_v<Pipeline, ComputePipeline>
 	{
-		std::optional<std::uint32_t> oPSOIndex{};
+		if (!m_pipelineLibrary || !m_threadPool)
+			return;
 
-		const std::vector<Pipeline>& pipelines = m_pipelines.Get();
+		auto pendingPipeline = std::make_unique<PendingPipeline>(
+			pipelineIndex, Pipeline{}, m_pipelines[pipelineIndex].GetExternalPipeline()
+		);
 
-		auto result = std::ranges::find_if(pipelines,
-			[&extPipeline](const Pipeline& pipeline)
+		pendingPipeline->waitObj = m_threadPool->SubmitWork(std::function{
+			[
+				pendingPipelinePtr = pendingPipeline.get(), device = m_device,
+				pipelineLayout = m_pipelineLayout, shaderModules = m_shaderModules.get(),
+				pipelineCache = m_pipelineCache, pipelineLibrary = m_pipelineLibrary.get()
+			]
 			{
-				return extPipeline == pipeline.GetExternalPipeline();
-			});
+				pendingPipelinePtr->pipeline.CreateOptimised(
+					device, pipelineLayout, *shaderModules, pendingPipelinePtr->extPipeline,
+					pipelineCache, *pipelineLibrary
+				);
+			}});
+
+		m_pendingPipelines.emplace_back(std::move(pendingPipeline));
+	}
+
+	void InstallPendingPipeline(PendingPipeline& pendingPipeline)
+	{
+		Pipeline& pipeline = m_pipelines[pendingPipeline.pipelineIndex];
+
+		// The replaced fast linked pipeline might still be used by the frames in flight.
+		if constexpr (!std::is_same_v<Pipeline, ComputePipeline>)
+			if (pipeline.IsReady())
+				m_retiredPipelines.emplace_back(
+					RetiredPipeline{ std::move(pipeline), m_frameCount }
+				);
+
+		pipeline = std::move(pendingPipeline.pipeline);
+	}
+
+	// Runs the work on the calling thread if there is no pool. The work must not add or remove
+	// any pipelines.
+	template<typename Work_t>
+	void RunOnPool(Work_t&& work)
+	{
+		if (m_threadPool)
+			m_waitObjs.emplace_back(m_threadPool->SubmitWork(std::function{ std::move(work) }));
+		else
+			work();
+	}
 
-		if (result != std::end(pipelines))
-			oPSOIndex = static_cast<std::uint32_t>(std::distance(std::begin(pipelines), result));
+	void WaitForPool()
+	{
+		for (std::future<void>& waitObj : m_waitObjs)
+			waitObj.wait();
 
-		return oPSOIndex;
+		m_waitObjs.clear();
+	}
+
+	// The index might be a reused slot, so the hash index is updated here as well. Every path
+	// which adds a pipeline goes through here, so it is recorded here too.
+	[[nodiscard]]
+	size_t AddPipeline(Pipeline&& pipeline)
+	{
+		const std::uint64_t pipelineHash = pipeline.GetExternalPipeline().GetHash();
+
+		if (m_pipelineManifest)
+			m_pipelineManifest->AddPipeline(pipeline.GetExternalPipeline());
+
+		const size_t psoIndex = m_pipelines.Add(std::move(pipeline));
+
+		m_pipelineHashIndex.Add(pipelineHash, static_cast<std::uint32_t>(psoIndex));
+
+		return psoIndex;
+	}
+
+	[[nodiscard]]
+	std::optional<std::uint32_t> TryToGetPSOIndex(const PipelineExt& extPipeline) const noexcept
+	{
+		return m_pipelineHashIndex.Find(
+			extPipeline.GetHash(),
+			[this, &extPipeline](std::uint32_t pipelineIndex)
+			{
+				return extPipeline == m_pipelines[pipelineIndex].GetExternalPipeline();
+			}
+		);
 	}
 
 private:
-	VkDevice                           m_device;
-	VkPipelineLayout                   m_pipelineLayout;
-	std::wstring                       m_shaderPath;
-	Callisto::ReusableVector<Pipeline> m_pipelines;
+	VkDevice                                      m_device;
+	VkPipelineLayout                              m_pipelineLayout;
+	PipelineCache*                                m_pipelineCache;
+	PipelineManifest*                             m_pipelineManifest;
+	ThreadPool*                                   m_threadPool;
+	// The pending compilations keep a pointer to these.
+	std::unique_ptr<ShaderModuleCache>            m_shaderModules;
+	std::unique_ptr<GraphicsPipelineLibrary>      m_pipelineLibrary;
+	Callisto::ReusableVector<Pipeline>            m_pipelines;
+	PipelineHashIndex                             m_pipelineHashIndex;
+	std::vector<std::unique_ptr<PendingPipeline>> m_pendingPipelines;
+	std::vector<RetiredPipeline>                  m_retiredPipelines;
+	std::vector<std::future<void>>                m_waitObjs;
+	size_t                                        m_frameCount;
 
 public:
 	PipelineManager(const PipelineManager&) = delete;
@@ -141,15 +530,36 @@ public:
 	PipelineManager(PipelineManager&& other) noexcept
 		: m_device{ other.m_device },
 		m_pipelineLayout{ other.m_pipelineLayout },
-		m_shaderPath{ std::move(other.m_shaderPath) },
-		m_pipelines{ std::move(other.m_pipelines) }
+		m_pipelineCache{ other.m_pipelineCache },
+		m_pipelineManifest{ other.m_pipelineManifest },
+		m_threadPool{ other.m_threadPool },
+		m_shaderModules{ std::move(other.m_shaderModules) },
+		m_pipelineLibrary{ std::move(other.m_pipelineLibrary) },
+		m_pipelines{ std::move(other.m_pipelines) },
+		m_pipelineHashIndex{ std::move(other.m_pipelineHashIndex) },
+		m_pendingPipelines{ std::move(other.m_pendingPipelines) },
+		m_retiredPipelines{ std::move(other.m_retiredPipelines) },
+		m_waitObjs{ std::move(other.m_waitObjs) },
+		m_frameCount{ other.m_frameCount }
 	{}
 	PipelineManager& operator=(PipelineManager&& other) noexcept
 	{
-		m_device         = other.m_device;
-		m_pipelineLayout = other.m_pipelineLayout;
-		m_shaderPath     = std::move(other.m_shaderPath);
-		m_pipelines      = std::move(other.m_pipelines);
+		// The pending pipelines of this one would be using the old shader modules.
+		WaitForPendingPipelines();
+
+		m_device            = other.m_device;
+		m_pipelineLayout    = other.m_pipelineLayout;
+		m_pipelineCache     = other.m_pipelineCache;
+		m_pipelineManifest  = other.m_pipelineManifest;
+		m_threadPool        = other.m_threadPool;
+		m_shaderModules     = std::move(other.m_shaderModules);
+		m_pipelineLibrary   = std::move(other.m_pipelineLibrary);
+		m_pipelines         = std::move(other.m_pipelines);
+		m_pipelineHashIndex = std::move(other.m_pipelineHashIndex);
+		m_pendingPipelines  = std::move(other.m_pendingPipelines);
+		m_retiredPipelines  = std::move(other.m_retiredPipelines);
+		m_waitObjs          = std::move(other.m_waitObjs);
+		m_frameCount        = other.m_frameCount;
 
 		return *this;
 	}
@@ -15,9 +15,14 @@
 #include <TemporaryDataBuffer.hpp>
 #include <Texture.hpp>
 #include <VkModelBuffer.hpp>
+#include <VkPipelineCache.hpp>
+#include <VkGpuProfiler.hpp>
+#include <CpuTracer.hpp>
 #include <VkPipelineManager.hpp>
+#include <PipelineManifest.hpp>
 #include <VkExternalRenderPass.hpp>
 #include <VkExternalResourceManager.hpp>
+#include <TerraException.hpp>
 
 namespace Terra
 {
@@ -119,6 +124,24 @@ public:
 
 	void RemoveTexture(size_t textureIndex);
 
+	[[nodiscard]]
+	MemoryManager* GetMemoryManager() const noexcept { return m_memoryManager.get(); }
+
+	// Should be set before adding the pipelines, so they can be loaded from the cache.
+	void SetPipelineCacheDirectory(const std::wstring& directory)
+	{
+		m_pipelineCache->LoadFromDirectory(directory);
+	}
+
+	[[nodiscard]]
+	const PipelineCache& GetPipelineCache() const noexcept { return *m_pipelineCache; }
+
+	[[nodiscard]]
+	auto&& GetGpuProfiler(this auto&& self) noexcept
+	{
+		return std::forward_like<decltype(self)>(self.m_gpuProfiler);
+	}
+
 private:
 	template<class Derived>
 	[[nodiscard]]
@@ -132,30 +155,31 @@ private:
 		std::optional<size_t> oFreeGlobalDescIndex
 			= self.m_textureManager.GetFreeGlobalDescriptorIndex<DescType>();
 
-		// If there is no free global index, increase the limit. Right now it should be possible to
-		// have 65535 bound textures at once. There could be more textures.
+		// If there is no free global index, increase the limit. The combined textures binding
+		// already has the max count of the device, so only the shared descriptor buffer needs
+		// to grow.
+		// The set layouts stay the same, so the pipelines don't need to be recreated.
 		if (!oFreeGlobalDescIndex)
 		{
 			self.m_textureManager.IncreaseMaximumBindingCount<TexDescType>();
 
-			for (VkDescriptorBuffer& descriptorBuffer : self.m_graphicsDescriptorBuffers)
-			{
-				const std::vector<VkDescriptorSetLayoutBinding> oldSetLayoutBindings
-					= descriptorBuffer.GetLayout(s_fragmentShaderSetLayoutIndex).GetBindings();
+			const std::uint32_t combinedTextureCount
+				= self.m_textureManager.GetCombinedTextureCount();
 
-				self.m_textureManager.SetDescriptorBufferLayout(
-					descriptorBuffer, s_combinedTextureBindingSlot, s_sampledTextureBindingSlot,
-					s_samplerBindingSlot, s_fragmentShaderSetLayoutIndex
-				);
+			oFreeGlobalDescIndex = self.m_textureManager.GetFreeGlobalDescriptorIndex<DescType>();
 
-				descriptorBuffer.RecreateSetLayout(
-					s_fragmentShaderSetLayoutIndex, oldSetLayoutBindings
+			if (!oFreeGlobalDescIndex)
+				throw Exception(
+					"Descriptor Error",
+					"The combined texture count has reached the limit of the device."
 				);
-			}
 
-			oFreeGlobalDescIndex = self.m_textureManager.GetFreeGlobalDescriptorIndex<DescType>();
+			self.m_sharedGraphicsDescriptorBuffer.SetVariableDescriptorCount(
+				s_fragmentShaderSetLayoutIndex, combinedTextureCount
+			);
 
-			self.ResetGraphicsPipeline();
+			// The old buffer could have been bound in any of the frames in flight.
+			self.m_descriptorRetirementFrameCount = std::size(self.m_graphicsDescriptorBuffers);
 		}
 
 		const auto freeGlobalDescIndex = static_cast<std::uint32_t>(oFreeGlobalDescIndex.value());
@@ -172,19 +196,16 @@ private:
 
 			self.m_textureManager.SetLocalDescriptorAvailability<DescType>(localCacheIndex, true);
 
-			for (VkDescriptorBuffer& descriptorBuffer : self.m_graphicsDescriptorBuffers)
-				descriptorBuffer.SetCombinedImageDescriptor(
-					localDescriptor, s_combinedTextureBindingSlot, s_fragmentShaderSetLayoutIndex,
-					freeGlobalDescIndex
-				);
+			self.m_sharedGraphicsDescriptorBuffer.SetCombinedImageDescriptor(
+				localDescriptor, s_combinedTextureBindingSlot, s_fragmentShaderSetLayoutIndex,
+				freeGlobalDescIndex
+			);
 		}
 		else
-			for (VkDescriptorBuffer& descriptorBuffer : self.m_graphicsDescriptorBuffers)
-				descriptorBuffer.SetCombinedImageDescriptor(
-					*textureView, *sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-					s_combinedTextureBindingSlot, s_fragmentShaderSetLayoutIndex,
-					freeGlobalDescIndex
-				);
+			self.m_sharedGraphicsDescriptorBuffer.SetCombinedImageDescriptor(
+				*textureView, *sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+				s_combinedTextureBindingSlot, s_fragmentShaderSetLayoutIndex, freeGlobalDescIndex
+			);
 
 		return freeGlobalDescIndex;
 	}
@@ -208,6 +229,32 @@ public:
 		size_t dstBufferOffset, size_t srcBufferOffset, size_t srcDataSizeInBytes
 	);
 
+	// Streaming. These can be called from any thread. The data is uploaded over the next
+	// frames, within the streaming budget, so a large upload doesn't stall a single frame.
+	[[nodiscard]]
+	std::uint64_t StreamExternalBufferGPUOnlyData(
+		std::uint32_t externalBufferIndex, std::shared_ptr<void> cpuData,
+		size_t srcDataSizeInBytes, size_t dstBufferOffset
+	);
+	[[nodiscard]]
+	bool IsStreamingRequestComplete(std::uint64_t requestID)
+	{
+		return m_stagingManager.IsStreamingRequestComplete(requestID);
+	}
+	// Returns the timeline semaphore value which would signal the completion of the request.
+	// Won't have a value, if the request hasn't been submitted yet or is already complete.
+	[[nodiscard]]
+	std::optional<StreamingUploadQueue::CompletionPoint> GetStreamingRequestCompletionPoint(
+		std::uint64_t requestID
+	) {
+		return m_stagingManager.GetStreamingRequestCompletionPoint(requestID);
+	}
+	// Should be called from the render thread.
+	void SetStreamingBudget(const StagingBufferManager::StreamingBudget& budget) noexcept
+	{
+		m_stagingManager.SetStreamingBudget(budget);
+	}
+
 	[[nodiscard]]
 	std::uint32_t AddExternalRenderPass()
 	{
@@ -270,6 +317,8 @@ public:
 protected:
 	// These descriptors are bound to the Fragment shader. So, they should be the same across
 	// all of the pipeline types. That's why we are going to bind them to their own setLayout.
+	// The textures don't change between the frames, so the Fragment shader set is only in the
+	// shared descriptor buffer. The other sets are in the descriptor buffer of each frame.
 	static constexpr std::uint32_t s_graphicsPipelineSetLayoutCount = 3u;
 	static constexpr std::uint32_t s_vertexShaderSetLayoutIndex     = 0u;
 	static constexpr std::uint32_t s_fragmentShaderSetLayoutIndex   = 1u;
@@ -277,35 +326,64 @@ protected:
 	// Set 0
 	static constexpr std::uint32_t s_modelBuffersGraphicsBindingSlot = 0u;
 	static constexpr std::uint32_t s_cameraBindingSlot               = 1u;
+	// The slots 2 to 5 are used by the VS Indirect and MS engines.
+	static constexpr std::uint32_t s_modelBuffersFragmentBindingSlot = 6u;
 
 	// Set 1
-	static constexpr std::uint32_t s_modelBuffersFragmentBindingSlot = 0u;
-
-	static constexpr std::uint32_t s_combinedTextureBindingSlot = 1u;
 	static constexpr std::uint32_t s_sampledTextureBindingSlot  = 2u;
 	static constexpr std::uint32_t s_samplerBindingSlot         = 3u;
+	// The variable count binding must have the largest binding number in its set.
+	static constexpr std::uint32_t s_combinedTextureBindingSlot = 4u;
+
+	static_assert(
+		s_combinedTextureBindingSlot > s_sampledTextureBindingSlot
+		&& s_combinedTextureBindingSlot > s_samplerBindingSlot,
+		"The combined textures binding must be the last one in the Fragment shader set."
+	);
+
+public:
+	// The shaders are built outside of this repo, so this must be bumped whenever a binding or
+	// an input the shaders read is changed. The shader directory should have a
+	// ShaderInterfaceVersion.txt file with the same number, so the old shaders aren't used.
+	// The shaders without the file are unversioned and can't be checked. The test shaders in
+	// test/shaders and their version file should be updated along with it.
+	// 2: The Fragment shader model buffers are in Set 0 binding 6 and the combined textures
+	//    are in Set 1 binding 4. The VS Individual vertex shader has no push constant. It reads
+	//    its model index from modelIndices[gl_InstanceIndex], with the model indices in Set 0
+	//    binding 2.
+	static constexpr std::uint32_t s_shaderInterfaceVersion = 2u;
+
+	// Throws if the version in the shader directory doesn't match. A missing version file
+	// only gives a warning.
+	static void CheckShaderInterfaceVersion(const std::wstring& shaderPath);
 
 protected:
-	std::shared_ptr<ThreadPool>      m_threadPool;
+	std::shared_ptr<ThreadPool>       m_threadPool;
 	// The pointer to this is shared in different places. So, if I make it a automatic
 	// member, the kept pointers would be invalid after a move.
-	std::unique_ptr<MemoryManager>   m_memoryManager;
-	VkGraphicsQueue                  m_graphicsQueue;
-	std::vector<VKSemaphore>         m_graphicsWait;
-	VkCommandQueue                   m_transferQueue;
-	std::vector<VKSemaphore>         m_transferWait;
-	StagingBufferManager             m_stagingManager;
-	VkExternalResourceManager        m_externalResourceManager;
-	std::vector<VkDescriptorBuffer>  m_graphicsDescriptorBuffers;
-	PipelineLayout                   m_graphicsPipelineLayout;
-	TextureStorage                   m_textureStorage;
-	TextureManager                   m_textureManager;
-	CameraManager                    m_cameraManager;
-	ViewportAndScissorManager        m_viewportAndScissors;
-	Callisto::TemporaryDataBufferGPU m_temporaryDataBuffer;
-	ExternalRenderPassContainer_t    m_renderPasses;
-	ExternalRenderPassSP_t           m_swapchainRenderPass;
-	bool                             m_gpuCopyNecessary;
+	std::unique_ptr<MemoryManager>    m_memoryManager;
+	// Shared by the pipeline managers.
+	std::unique_ptr<PipelineCache>    m_pipelineCache;
+	std::unique_ptr<PipelineManifest> m_pipelineManifest;
+	VkGraphicsQueue                   m_graphicsQueue;
+	std::vector<VKSemaphore>          m_graphicsWait;
+	VkCommandQueue                    m_transferQueue;
+	std::vector<VKSemaphore>          m_transferWait;
+	StagingBufferManager              m_stagingManager;
+	VkExternalResourceManager         m_externalResourceManager;
+	std::vector<VkDescriptorBuffer>   m_graphicsDescriptorBuffers;
+	VkDescriptorBuffer                m_sharedGraphicsDescriptorBuffer;
+	PipelineLayout                    m_graphicsPipelineLayout;
+	TextureStorage                    m_textureStorage;
+	TextureManager                    m_textureManager;
+	CameraManager                     m_cameraManager;
+	GpuProfiler                       m_gpuProfiler;
+	ViewportAndScissorManager         m_viewportAndScissors;
+	Callisto::TemporaryDataBufferGPU  m_temporaryDataBuffer;
+	ExternalRenderPassContainer_t     m_renderPasses;
+	ExternalRenderPassSP_t            m_swapchainRenderPass;
+	size_t                            m_descriptorRetirementFrameCount;
+	bool                              m_gpuCopyNecessary;
 
 public:
 	RenderEngine(const RenderEngine&) = delete;
@@ -314,6 +392,8 @@ public:
 	RenderEngine(RenderEngine&& other) noexcept
 		: m_threadPool{ std::move(other.m_threadPool) },
 		m_memoryManager{ std::move(other.m_memoryManager) },
+		m_pipelineCache{ std::move(other.m_pipelineCache) },
+		m_pipelineManifest{ std::move(other.m_pipelineManifest) },
 		m_graphicsQueue{ std::move(other.m_graphicsQueue) },
 		m_graphicsWait{ std::move(other.m_graphicsWait) },
 		m_transferQueue{ std::move(other.m_transferQueue) },
@@ -321,36 +401,44 @@ public:
 		m_stagingManager{ std::move(other.m_stagingManager) },
 		m_externalResourceManager{ std::move(other.m_externalResourceManager) },
 		m_graphicsDescriptorBuffers{ std::move(other.m_graphicsDescriptorBuffers) },
+		m_sharedGraphicsDescriptorBuffer{ std::move(other.m_sharedGraphicsDescriptorBuffer) },
 		m_graphicsPipelineLayout{ std::move(other.m_graphicsPipelineLayout) },
 		m_textureStorage{ std::move(other.m_textureStorage) },
 		m_textureManager{ std::move(other.m_textureManager) },
 		m_cameraManager{ std::move(other.m_cameraManager) },
+		m_gpuProfiler{ std::move(other.m_gpuProfiler) },
 		m_viewportAndScissors{ other.m_viewportAndScissors },
 		m_temporaryDataBuffer{ std::move(other.m_temporaryDataBuffer) },
 		m_renderPasses{ std::move(other.m_renderPasses) },
 		m_swapchainRenderPass{ std::move(other.m_swapchainRenderPass) },
+		m_descriptorRetirementFrameCount{ other.m_descriptorRetirementFrameCount },
 		m_gpuCopyNecessary{ other.m_gpuCopyNecessary }
 	{}
 	RenderEngine& operator=(RenderEngine&& other) noexcept
 	{
-		m_threadPool                = std::move(other.m_threadPool);
-		m_memoryManager             = std::move(other.m_memoryManager);
-		m_graphicsQueue             = std::move(other.m_graphicsQueue);
-		m_graphicsWait              = std::move(other.m_graphicsWait);
-		m_transferQueue             = std::move(other.m_transferQueue);
-		m_transferWait              = std::move(other.m_transferWait);
-		m_stagingManager            = std::move(other.m_stagingManager);
-		m_externalResourceManager   = std::move(other.m_externalResourceManager);
-		m_graphicsDescriptorBuffers = std::move(other.m_graphicsDescriptorBuffers);
-		m_graphicsPipelineLayout    = std::move(other.m_graphicsPipelineLayout);
-		m_textureStorage            = std::move(other.m_textureStorage);
-		m_textureManager            = std::move(other.m_textureManager);
-		m_cameraManager             = std::move(other.m_cameraManager);
-		m_viewportAndScissors       = other.m_viewportAndScissors;
-		m_temporaryDataBuffer       = std::move(other.m_temporaryDataBuffer);
-		m_renderPasses              = std::move(other.m_renderPasses);
-		m_swapchainRenderPass       = std::move(other.m_swapchainRenderPass);
-		m_gpuCopyNecessary          = other.m_gpuCopyNecessary;
+		m_threadPool                     = std::move(other.m_threadPool);
+		m_memoryManager                  = std::move(other.m_memoryManager);
+		m_pipelineCache                  = std::move(other.m_pipelineCache);
+		m_pipelineManifest               = std::move(other.m_pipelineManifest);
+		m_graphicsQueue                  = std::move(other.m_graphicsQueue);
+		m_graphicsWait                   = std::move(other.m_graphicsWait);
+		m_transferQueue                  = std::move(other.m_transferQueue);
+		m_transferWait                   = std::move(other.m_transferWait);
+		m_stagingManager                 = std::move(other.m_stagingManager);
+		m_externalResourceManager        = std::move(other.m_externalResourceManager);
+		m_graphicsDescriptorBuffers      = std::move(other.m_graphicsDescriptorBuffers);
+		m_sharedGraphicsDescriptorBuffer = std::move(other.m_sharedGraphicsDescriptorBuffer);
+		m_graphicsPipelineLayout         = std::move(other.m_graphicsPipelineLayout);
+		m_textureStorage                 = std::move(other.m_textureStorage);
+		m_textureManager                 = std::move(other.m_textureManager);
+		m_cameraManager                  = std::move(other.m_cameraManager);
+		m_gpuProfiler                    = std::move(other.m_gpuProfiler);
+		m_viewportAndScissors            = other.m_viewportAndScissors;
+		m_temporaryDataBuffer            = std::move(other.m_temporaryDataBuffer);
+		m_renderPasses                   = std::move(other.m_renderPasses);
+		m_swapchainRenderPass            = std::move(other.m_swapchainRenderPass);
+		m_descriptorRetirementFrameCount = other.m_descriptorRetirementFrameCount;
+		m_gpuCopyNecessary               = other.m_gpuCopyNecessary;
 
 		return *this;
 	}
@@ -383,11 +471,22 @@ public:
 		},
 		m_graphicsPipelineManager{ deviceManager.GetLogicalDevice() }
 	{
-		for (VkDescriptorBuffer& descriptorBuffer : m_graphicsDescriptorBuffers)
-			m_textureManager.SetDescriptorBufferLayout(
-				descriptorBuffer, s_combinedTextureBindingSlot, s_sampledTextureBindingSlot,
-				s_samplerBindingSlot, s_fragmentShaderSetLayoutIndex
-			);
+		m_modelBuffers.SetThreadPool(m_threadPool.get());
+		m_graphicsPipelineManager.SetPipelineCache(m_pipelineCache.get());
+		m_graphicsPipelineManager.SetThreadPool(m_threadPool.get());
+
+		// The extension is only enabled if the device supports it.
+		const bool isPipelineLibraryActive = deviceManager.ExtensionManager().IsExtensionActive(
+			DeviceExtension::VkExtGraphicsPipelineLibrary
+		);
+
+		if (isPipelineLibraryActive)
+			m_graphicsPipelineManager.EnablePipelineLibrary(frameCount);
+
+		m_textureManager.SetDescriptorBufferLayout(
+			m_sharedGraphicsDescriptorBuffer, s_combinedTextureBindingSlot,
+			s_sampledTextureBindingSlot, s_samplerBindingSlot, s_fragmentShaderSetLayoutIndex
+		);
 	}
 
 	void SetModelContainer(std::shared_ptr<ModelContainer> modelContainer) noexcept
@@ -401,6 +500,20 @@ public:
 		return m_graphicsPipelineManager.AddOrGetGraphicsPipeline(gfxPipeline);
 	}
 
+	[[nodiscard]]
+	std::vector<std::uint32_t> AddGraphicsPipelines(
+		const std::vector<ExternalGraphicsPipeline>& gfxPipelines
+	) {
+		return m_graphicsPipelineManager.AddOrGetGraphicsPipelines(gfxPipelines);
+	}
+
+	// The models using the pipeline won't be drawn until it has been compiled.
+	[[nodiscard]]
+	std::uint32_t AddGraphicsPipelineAsync(const ExternalGraphicsPipeline& gfxPipeline)
+	{
+		return m_graphicsPipelineManager.AddOrGetGraphicsPipelineAsync(gfxPipeline);
+	}
+
 	void ReconfigureModelPipelinesInBundle(
 		std::uint32_t modelBundleIndex, std::uint32_t decreasedModelsPipelineIndex,
 		std::uint32_t increasedModelsPipelineIndex
@@ -438,21 +551,32 @@ public:
 	{
 		// Wait for the previous Graphics command buffer to finish.
 		m_graphicsQueue.WaitForSubmission(frameIndex);
+		// The other queues of the frame should have been finished before the Graphics one, so
+		// all of the timestamps of the frame should be available.
+		m_gpuProfiler.ResolveFrame(frameIndex);
 		// It should be okay to clear the data now that the frame has finished
 		// its submission.
 		m_temporaryDataBuffer.Clear(frameIndex);
+		// Each wait finishes one of the frames which was in flight when the shared descriptor
+		// buffer was recreated.
+		if (m_descriptorRetirementFrameCount && !--m_descriptorRetirementFrameCount)
+			m_sharedGraphicsDescriptorBuffer.ReleaseRetiredBuffers();
 	}
 
-	void UpdateCamera(size_t frameIndex, const Camera& cameraData) const noexcept
+	void UpdateCamera(size_t frameIndex, const Camera& cameraData) noexcept
 	{
 		m_cameraManager.Update(static_cast<VkDeviceSize>(frameIndex), cameraData);
+
+		static_cast<Derived*>(this)->_updateCamera(cameraData);
 	}
 
-	void Update(size_t frameIndex) const noexcept
+	void Update(size_t frameIndex) noexcept
 	{
+		TERRA_CPU_TRACE_ZONE("Update");
+
 		// This should be fine. But putting this as a reminder, that
 		// the presentation engine might still be running and using some resources.
-		static_cast<Derived const*>(this)->_updatePerFrame(static_cast<VkDeviceSize>(frameIndex));
+		static_cast<Derived*>(this)->_updatePerFrame(static_cast<VkDeviceSize>(frameIndex));
 	}
 
 	[[nodiscard]]
@@ -462,6 +586,8 @@ public:
 	) {
 		VkSemaphore waitSemaphore = imageWaitSemaphore.Get();
 
+		m_graphicsPipelineManager.UpdatePendingPipelines();
+
 		waitSemaphore = static_cast<Derived*>(this)->ExecutePipelineStages(
 			frameIndex, renderTarget, renderArea, semaphoreCounter, waitSemaphore
 		);
@@ -489,21 +615,32 @@ protected:
 	void CreateGraphicsPipelineLayout()
 	{
 		if (!std::empty(m_graphicsDescriptorBuffers))
-			m_graphicsPipelineLayout.Create(m_graphicsDescriptorBuffers.front().GetValidLayouts());
+			m_graphicsPipelineLayout.Create(
+				VkDescriptorBuffer::GetValidLayouts(
+					m_graphicsDescriptorBuffers.front(), m_sharedGraphicsDescriptorBuffer
+				)
+			);
 
 		m_graphicsPipelineManager.SetPipelineLayout(m_graphicsPipelineLayout.Get());
 	}
 
-	void ResetGraphicsPipeline()
+	void _setShaderPath(const std::wstring& shaderPath)
 	{
-		CreateGraphicsPipelineLayout();
+		CheckShaderInterfaceVersion(shaderPath);
 
-		m_graphicsPipelineManager.RecreateAllGraphicsPipelines();
+		m_graphicsPipelineManager.SetShaderPath(shaderPath);
 	}
 
-	void _setShaderPath(const std::wstring& shaderPath)
+	void _setPipelineManifestDirectory(const std::wstring& directory)
 	{
-		m_graphicsPipelineManager.SetShaderPath(shaderPath);
+		m_pipelineManifest->LoadFromDirectory(directory, Derived::s_pipelineManifestFileName);
+
+		m_graphicsPipelineManager.SetPipelineManifest(m_pipelineManifest.get());
+	}
+
+	void WarmUpGraphicsPipelines()
+	{
+		m_graphicsPipelineManager.WarmUpPipelines(m_pipelineManifest->GetGraphicsPipelines());
 	}
 
 	void SetCommonGraphicsDescriptorBufferLayout(
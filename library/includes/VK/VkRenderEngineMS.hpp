@@ -48,6 +48,16 @@ public:
 		_setShaderPath(shaderPath);
 	}
 
+	// Should be set before adding the pipelines, so they are recorded. The recorded pipelines
+	// are compiled in FinaliseInitialisation.
+	void SetPipelineManifestDirectory(const std::wstring& directory)
+	{
+		_setPipelineManifestDirectory(directory);
+	}
+
+	// If enabled, the models are culled against the view frustum on the CPU before drawing.
+	void SetCPUCulling(bool value) noexcept { m_frustumCuller.SetEnabled(value); }
+
 private:
 	[[nodiscard]]
 	VkSemaphore ExecutePipelineStages(
@@ -68,11 +78,17 @@ private:
 	void SetGraphicsDescriptorBufferLayout();
 	void SetModelGraphicsDescriptors();
 
-	void _updatePerFrame(VkDeviceSize frameIndex) const noexcept
+	void _updatePerFrame(VkDeviceSize frameIndex) noexcept
 	{
 		m_modelBuffers.Update(frameIndex);
 	}
 
+	void _updateCamera(const Camera& cameraData) noexcept
+	{
+		if (m_frustumCuller.IsEnabled())
+			m_frustumCuller.SetFrustum(cameraData.GetViewFrustum(cameraData.GetViewMatrix()));
+	}
+
 	[[nodiscard]]
 	static std::vector<std::uint32_t> GetModelBuffersQueueFamilies(
 		[[maybe_unused]] const VkDeviceManager& deviceManager
@@ -94,16 +110,184 @@ private:
 		const VKCommandBuffer& graphicsCmdBuffer, const VkExternalRenderPass& renderPass
 	) const noexcept;
 
+private:
+	// The pipelines of the engines aren't compatible, so each engine has its own manifest.
+	static constexpr const wchar_t* s_pipelineManifestFileName = L"PipelineManifestMS.bin";
+
+private:
+	FrustumCuller m_frustumCuller;
+
 public:
 	RenderEngineMS(const RenderEngineMS&) = delete;
 	RenderEngineMS& operator=(const RenderEngineMS&) = delete;
 
 	RenderEngineMS(RenderEngineMS&& other) noexcept
-		: RenderEngineCommon{ std::move(other) }
+		: RenderEngineCommon{ std::move(other) },
+		m_frustumCuller{ std::move(other.m_frustumCuller) }
 	{}
 	RenderEngineMS& operator=(RenderEngineMS&& other) noexcept
 	{
 		RenderEngineCommon::operator=(std::move(other));
+		m_frustumCuller = std::move(other.m_frustumCuller);
+
+		return *this;
+	}
+};
+
+namespace RenderEngineMSIndirectDeviceExtension = RenderEngineMSDeviceExtension;
+
+// The models are culled in a Compute pass, which also writes the task dispatch arguments and a
+// draw count per pipeline. So, only a single draw is recorded for each pipeline of a bundle.
+// The models are only culled against the frustum, there is no Hi-Z occlusion culling like in
+// the VS Indirect engine.
+class RenderEngineMSIndirect : public
+	RenderEngineCommon
+	<
+		ModelManagerMSIndirect,
+		MeshManagerMSIndirect,
+		GraphicsPipelineMS,
+		RenderEngineMSIndirect
+	>
+{
+	friend class RenderEngineCommon
+		<
+			ModelManagerMSIndirect,
+			MeshManagerMSIndirect,
+			GraphicsPipelineMS,
+			RenderEngineMSIndirect
+		>;
+
+	using ComputePipeline_t = ComputePipeline;
+
+public:
+	RenderEngineMSIndirect(
+		const VkDeviceManager& deviceManager, std::shared_ptr<ThreadPool> threadPool,
+		size_t frameCount
+	);
+
+	void FinaliseInitialisation();
+
+	[[nodiscard]]
+	// Should wait for the device to be idle before calling this.
+	std::uint32_t AddModelBundle(std::shared_ptr<ModelBundle>&& modelBundle);
+
+	[[nodiscard]]
+	// Should wait for the device to be idle before calling this.
+	std::uint32_t AddMeshBundle(MeshBundleTemporaryData&& meshBundle);
+
+	void SetShaderPath(const std::wstring& shaderPath);
+	// Should be set before adding the pipelines, so they are recorded. The recorded pipelines
+	// are compiled in FinaliseInitialisation.
+	void SetPipelineManifestDirectory(const std::wstring& directory);
+
+	void SetDrawCountReadback(bool value) { m_modelManager.SetDrawCountReadback(value); }
+	// The number of the indirect draws in the last finished submission of the frame.
+	[[nodiscard]]
+	std::uint32_t GetDrawCount(size_t frameIndex) const noexcept
+	{
+		return m_modelManager.GetDrawCount(frameIndex);
+	}
+
+private:
+	[[nodiscard]]
+	VkSemaphore ExecutePipelineStages(
+		size_t frameIndex, const VKImageView& renderTarget, VkExtent2D renderArea,
+		std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
+	);
+
+	[[nodiscard]]
+	VkSemaphore GenericTransferStage(
+		size_t frameIndex, std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
+	);
+	[[nodiscard]]
+	VkSemaphore FrustumCullingStage(
+		size_t frameIndex, std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
+	);
+	[[nodiscard]]
+	VkSemaphore DrawingStage(
+		size_t frameIndex, const VKImageView& renderTarget, VkExtent2D renderArea,
+		std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
+	);
+
+	void SetGraphicsDescriptorBufferLayout();
+	void SetModelGraphicsDescriptors();
+
+	void SetComputeDescriptorBufferLayout();
+	void SetModelComputeDescriptors();
+
+	void CreateComputePipelineLayout();
+
+	void _updatePerFrame(VkDeviceSize frameIndex) noexcept;
+	// The models are culled in the compute pass.
+	void _updateCamera([[maybe_unused]] const Camera& cameraData) noexcept {}
+
+	[[nodiscard]]
+	static std::vector<std::uint32_t> GetModelBuffersQueueFamilies(
+		const VkDeviceManager& deviceManager
+	) noexcept {
+		return deviceManager
+			.GetQueueFamilyManager().GetComputeAndGraphicsIndices().ResolveQueueIndices();
+	}
+
+	[[nodiscard]]
+	static ModelManagerMSIndirect CreateModelManager(
+		const VkDeviceManager& deviceManager, MemoryManager* memoryManager, size_t frameCount
+	) {
+		return ModelManagerMSIndirect{
+			deviceManager.GetLogicalDevice(), memoryManager,
+			deviceManager.GetQueueFamilyManager().GetAllIndices(),
+			static_cast<std::uint32_t>(frameCount)
+		};
+	}
+
+private:
+	void DrawRenderPassPipelines(
+		size_t frameIndex, const VKCommandBuffer& graphicsCmdBuffer,
+		const VkExternalRenderPass& renderPass
+	) const noexcept;
+
+	void UpdateRenderPassPipelines(
+		size_t frameIndex, const VkExternalRenderPass& renderPass
+	) const noexcept;
+
+private:
+	// Compute
+	static constexpr std::uint32_t s_computePipelineSetLayoutCount = 1u;
+	static constexpr std::uint32_t s_computeShaderSetLayoutIndex   = 0u;
+
+	static constexpr std::uint32_t s_modelBuffersComputeBindingSlot = 0u;
+	static constexpr std::uint32_t s_cameraComputeBindingSlot       = 10u;
+
+	// The pipelines of the engines aren't compatible, so each engine has its own manifest.
+	static constexpr const wchar_t* s_pipelineManifestFileName = L"PipelineManifestMSIndirect.bin";
+
+private:
+	VkCommandQueue                     m_computeQueue;
+	std::vector<VKSemaphore>           m_computeWait;
+	std::vector<VkDescriptorBuffer>    m_computeDescriptorBuffers;
+	PipelineManager<ComputePipeline_t> m_computePipelineManager;
+	PipelineLayout                     m_computePipelineLayout;
+
+public:
+	RenderEngineMSIndirect(const RenderEngineMSIndirect&) = delete;
+	RenderEngineMSIndirect& operator=(const RenderEngineMSIndirect&) = delete;
+
+	RenderEngineMSIndirect(RenderEngineMSIndirect&& other) noexcept
+		: RenderEngineCommon{ std::move(other) },
+		m_computeQueue{ std::move(other.m_computeQueue) },
+		m_computeWait{ std::move(other.m_computeWait) },
+		m_computeDescriptorBuffers{ std::move(other.m_computeDescriptorBuffers) },
+		m_computePipelineManager{ std::move(other.m_computePipelineManager) },
+		m_computePipelineLayout{ std::move(other.m_computePipelineLayout) }
+	{}
+	RenderEngineMSIndirect& operator=(RenderEngineMSIndirect&& other) noexcept
+	{
+		RenderEngineCommon::operator=(std::move(other));
+		m_computeQueue             = std::move(other.m_computeQueue);
+		m_computeWait              = std::move(other.m_computeWait);
+		m_computeDescriptorBuffers = std::move(other.m_computeDescriptorBuffers);
+		m_computePipelineManager   = std::move(other.m_computePipelineManager);
+		m_computePipelineLayout    = std::move(other.m_computePipelineLayout);
 
 		return *this;
 	}
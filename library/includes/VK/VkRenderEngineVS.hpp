@@ -2,6 +2,7 @@
 #define VK_RENDER_ENGINE_VS_HPP_
 #include <VkRenderEngine.hpp>
 #include <VkModelManager.hpp>
+#include <VkHiZPyramid.hpp>
 
 namespace Terra
 {
@@ -45,6 +46,16 @@ public:
 		_setShaderPath(shaderPath);
 	}
 
+	// Should be set before adding the pipelines, so they are recorded. The recorded pipelines
+	// are compiled in FinaliseInitialisation.
+	void SetPipelineManifestDirectory(const std::wstring& directory)
+	{
+		_setPipelineManifestDirectory(directory);
+	}
+
+	// If enabled, the models are culled against the view frustum on the CPU before drawing.
+	void SetCPUCulling(bool value) noexcept { m_frustumCuller.SetEnabled(value); }
+
 private:
 	[[nodiscard]]
 	VkSemaphore ExecutePipelineStages(
@@ -65,11 +76,17 @@ private:
 	void SetGraphicsDescriptorBufferLayout();
 	void SetGraphicsDescriptors();
 
-	void _updatePerFrame(VkDeviceSize frameIndex) const noexcept
+	void _updatePerFrame(VkDeviceSize frameIndex) noexcept
 	{
 		m_modelBuffers.Update(frameIndex);
 	}
 
+	void _updateCamera(const Camera& cameraData) noexcept
+	{
+		if (m_frustumCuller.IsEnabled())
+			m_frustumCuller.SetFrustum(cameraData.GetViewFrustum(cameraData.GetViewMatrix()));
+	}
+
 	[[nodiscard]]
 	static std::vector<std::uint32_t> GetModelBuffersQueueFamilies(
 		[[maybe_unused]] const VkDeviceManager& deviceManager
@@ -79,28 +96,38 @@ private:
 
 	[[nodiscard]]
 	static ModelManagerVSIndividual CreateModelManager(
-		[[maybe_unused]] const VkDeviceManager& deviceManager,
-		[[maybe_unused]] MemoryManager* memoryManager,
-		[[maybe_unused]] size_t frameCount
+		const VkDeviceManager& deviceManager, MemoryManager* memoryManager, size_t frameCount
 	) {
-		return ModelManagerVSIndividual{};
+		return ModelManagerVSIndividual{
+			deviceManager.GetLogicalDevice(), memoryManager, static_cast<std::uint32_t>(frameCount)
+		};
 	}
 
 private:
 	void DrawRenderPassPipelines(
-		const VKCommandBuffer& graphicsCmdBuffer, const VkExternalRenderPass& renderPass
+		size_t frameIndex, const VKCommandBuffer& graphicsCmdBuffer,
+		const VkExternalRenderPass& renderPass
 	) const noexcept;
 
+private:
+	// The pipelines of the engines aren't compatible, so each engine has its own manifest.
+	static constexpr const wchar_t* s_pipelineManifestFileName = L"PipelineManifestVSIndividual.bin";
+
+private:
+	FrustumCuller m_frustumCuller;
+
 public:
 	RenderEngineVSIndividual(const RenderEngineVSIndividual&) = delete;
 	RenderEngineVSIndividual& operator=(const RenderEngineVSIndividual&) = delete;
 
 	RenderEngineVSIndividual(RenderEngineVSIndividual&& other) noexcept
-		: RenderEngineCommon{ std::move(other) }
+		: RenderEngineCommon{ std::move(other) },
+		m_frustumCuller{ std::move(other.m_frustumCuller) }
 	{}
 	RenderEngineVSIndividual& operator=(RenderEngineVSIndividual&& other) noexcept
 	{
 		RenderEngineCommon::operator=(std::move(other));
+		m_frustumCuller = std::move(other.m_frustumCuller);
 
 		return *this;
 	}
@@ -144,6 +171,29 @@ public:
 	std::uint32_t AddMeshBundle(MeshBundleTemporaryData&& meshBundle);
 
 	void SetShaderPath(const std::wstring& shaderPath);
+	// Should be set before adding the pipelines, so they are recorded. The recorded pipelines
+	// are compiled in FinaliseInitialisation.
+	void SetPipelineManifestDirectory(const std::wstring& directory);
+
+	// Enables the two phase occlusion culling. The texture should be the depth attachment of the
+	// render passes and must have been created with sampleTexture. If there are multiple
+	// render passes, only the depth of this one is used to cull the models of every pass. Should
+	// wait for the device to be idle before calling this and must be called again if the
+	// texture is recreated.
+	void SetOcclusionCullingDepth(std::uint32_t externalTextureIndex);
+	// Waits for the submitted frames to finish, as they might still be reading the pyramid.
+	void DisableOcclusionCulling();
+
+	void SetDrawCountReadback(bool value) { m_modelManager.SetDrawCountReadback(value); }
+	// The number of the indirect draws in the last finished submission of the frame.
+	[[nodiscard]]
+	std::uint32_t GetDrawCount(size_t frameIndex) const noexcept
+	{
+		return m_modelManager.GetDrawCount(frameIndex);
+	}
+
+	[[nodiscard]]
+	bool IsOcclusionCullingEnabled() const noexcept { return m_hiZPyramid.IsCreated(); }
 
 private:
 	[[nodiscard]]
@@ -165,6 +215,20 @@ private:
 		size_t frameIndex, const VKImageView& renderTarget, VkExtent2D renderArea,
 		std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
 	);
+	// With the occlusion culling, the culling and the drawing are done in two phases. In the
+	// first one, the models which were visible in the last frame are drawn and then the Hi-Z
+	// pyramid is built from the depth. In the second one, the rest are culled against the
+	// pyramid and drawn in the resumed passes by the normal DrawingStage.
+	[[nodiscard]]
+	VkSemaphore OcclusionCullingStage(
+		size_t frameIndex, std::uint32_t occlusionPhase, std::uint64_t& semaphoreCounter,
+		VkSemaphore waitSemaphore
+	);
+	[[nodiscard]]
+	VkSemaphore OcclusionDrawingStage(
+		size_t frameIndex, VkExtent2D renderArea, std::uint64_t& semaphoreCounter,
+		VkSemaphore waitSemaphore
+	);
 
 	void SetGraphicsDescriptorBufferLayout();
 	void SetModelGraphicsDescriptors();
@@ -174,7 +238,9 @@ private:
 
 	void CreateComputePipelineLayout();
 
-	void _updatePerFrame(VkDeviceSize frameIndex) const noexcept;
+	void _updatePerFrame(VkDeviceSize frameIndex) noexcept;
+	// The models are culled in the compute pass.
+	void _updateCamera([[maybe_unused]] const Camera& cameraData) noexcept {}
 
 	[[nodiscard]]
 	static std::vector<std::uint32_t> GetModelBuffersQueueFamilies(
@@ -212,13 +278,24 @@ private:
 
 	static constexpr std::uint32_t s_modelBuffersComputeBindingSlot = 0u;
 	static constexpr std::uint32_t s_cameraComputeBindingSlot       = 10u;
+	static constexpr std::uint32_t s_hiZPyramidComputeBindingSlot   = 12u;
+
+	// The pipelines of the engines aren't compatible, so each engine has its own manifest.
+	static constexpr const wchar_t* s_pipelineManifestFileName = L"PipelineManifestVSIndirect.bin";
 
 private:
+	// With the occlusion culling, the second half of the command buffers of the Compute queue
+	// are used for the second phase.
 	VkCommandQueue                     m_computeQueue;
 	std::vector<VKSemaphore>           m_computeWait;
 	std::vector<VkDescriptorBuffer>    m_computeDescriptorBuffers;
 	PipelineManager<ComputePipeline_t> m_computePipelineManager;
 	PipelineLayout                     m_computePipelineLayout;
+	// The command buffers of the first part of the drawing with the occlusion culling. They are
+	// submitted to the same queue as the ones of the Graphics queue.
+	VkCommandQueue                     m_occlusionGraphicsQueue;
+	std::vector<VKSemaphore>           m_occlusionGraphicsWait;
+	HiZPyramid                         m_hiZPyramid;
 
 public:
 	RenderEngineVSIndirect(const RenderEngineVSIndirect&) = delete;
@@ -230,7 +307,10 @@ public:
 		m_computeWait{ std::move(other.m_computeWait) },
 		m_computeDescriptorBuffers{ std::move(other.m_computeDescriptorBuffers) },
 		m_computePipelineManager{ std::move(other.m_computePipelineManager) },
-		m_computePipelineLayout{ std::move(other.m_computePipelineLayout) }
+		m_computePipelineLayout{ std::move(other.m_computePipelineLayout) },
+		m_occlusionGraphicsQueue{ std::move(other.m_occlusionGraphicsQueue) },
+		m_occlusionGraphicsWait{ std::move(other.m_occlusionGraphicsWait) },
+		m_hiZPyramid{ std::move(other.m_hiZPyramid) }
 	{}
 	RenderEngineVSIndirect& operator=(RenderEngineVSIndirect&& other) noexcept
 	{
@@ -240,6 +320,9 @@ public:
 		m_computeDescriptorBuffers = std::move(other.m_computeDescriptorBuffers);
 		m_computePipelineManager   = std::move(other.m_computePipelineManager);
 		m_computePipelineLayout    = std::move(other.m_computePipelineLayout);
+		m_occlusionGraphicsQueue   = std::move(other.m_occlusionGraphicsQueue);
+		m_occlusionGraphicsWait    = std::move(other.m_occlusionGraphicsWait);
+		m_hiZPyramid               = std::move(other.m_hiZPyramid);
 
 		return *this;
 	}
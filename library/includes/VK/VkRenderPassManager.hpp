@@ -178,7 +178,10 @@ public:
 class VkRenderPassManager
 {
 public:
-	VkRenderPassManager() : m_renderingInfoBuilder{}, m_startImageBarriers{} {}
+	VkRenderPassManager()
+		: m_renderingInfoBuilder{}, m_suspendingInfoBuilder{}, m_resumingInfoBuilder{},
+		m_startImageBarriers{}
+	{}
 
 	void AddColourAttachment(
 		const VKImageView& colourView, const VkClearColorValue& clearValue,
@@ -216,6 +219,14 @@ public:
 	) noexcept;
 
 	void StartPass(const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea) const noexcept;
+	// For a pass which is drawn in two parts. The first part stores all of the attachments and
+	// the second one loads them.
+	void StartPassToResume(
+		const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea
+	) const noexcept;
+	// The attachments should still be in the layouts the first part has left them in, so the
+	// start barriers aren't recorded.
+	void ResumePass(const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea) const noexcept;
 	void EndPass(const VKCommandBuffer& graphicsCmdBuffer) const noexcept;
 
 	void EndPassForSwapchain(
@@ -223,8 +234,18 @@ public:
 		const VKImageView& swapchainBackBuffer, const VkExtent3D& srcColourExtent
 	) const noexcept;
 
+private:
+	static void BeginRendering(
+		VkCommandBuffer cmdBuffer, const RenderingInfoBuilder& renderingInfoBuilder,
+		VkExtent2D renderArea
+	) noexcept;
+
 private:
 	RenderingInfoBuilder m_renderingInfoBuilder;
+	// The same attachments but with the store and the load ops of the two parts of a resumed
+	// pass.
+	RenderingInfoBuilder m_suspendingInfoBuilder;
+	RenderingInfoBuilder m_resumingInfoBuilder;
 	VkImageBarrier2_1    m_startImageBarriers;
 
 public:
@@ -233,12 +254,16 @@ public:
 
 	VkRenderPassManager(VkRenderPassManager&& other) noexcept
 		: m_renderingInfoBuilder{ std::move(other.m_renderingInfoBuilder) },
+		m_suspendingInfoBuilder{ std::move(other.m_suspendingInfoBuilder) },
+		m_resumingInfoBuilder{ std::move(other.m_resumingInfoBuilder) },
 		m_startImageBarriers{ std::move(other.m_startImageBarriers) }
 	{}
 	VkRenderPassManager& operator=(VkRenderPassManager&& other) noexcept
 	{
-		m_renderingInfoBuilder = std::move(other.m_renderingInfoBuilder);
-		m_startImageBarriers   = std::move(other.m_startImageBarriers);
+		m_renderingInfoBuilder  = std::move(other.m_renderingInfoBuilder);
+		m_suspendingInfoBuilder = std::move(other.m_suspendingInfoBuilder);
+		m_resumingInfoBuilder   = std::move(other.m_resumingInfoBuilder);
+		m_startImageBarriers    = std::move(other.m_startImageBarriers);
 
 		return *this;
 	}
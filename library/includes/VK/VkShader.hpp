@@ -2,9 +2,11 @@
 #define VK_SHADER_HPP_
 #include <vulkan/vulkan.hpp>
 #include <string>
-#include <vector>
 #include <utility>
-#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <Shader.hpp>
 
 namespace Terra
 {
@@ -24,9 +26,6 @@ private:
 	void SelfDestruct() noexcept;
 
 private:
-	[[nodiscard]]
-	static std::vector<char> LoadBinary(std::ifstream& shader);
-
 	void CreateShaderModule(VkDevice device, void const* binary, size_t binarySize);
 
 private:
@@ -51,5 +50,58 @@ public:
 		return *this;
 	}
 };
+
+// The shader modules are shared between the pipelines, so a shader file is only loaded once.
+// The modules are keyed by their names with the extension of the binary type, so they must be
+// cleared when the shader path changes. The pipelines can be compiled on multiple threads, so
+// the modules are accessed with a lock.
+class ShaderModuleCache
+{
+public:
+	ShaderModuleCache(VkDevice device)
+		: m_device{ device }, m_mutex{ std::make_unique<std::mutex>() }, m_shaderPath{},
+		m_shaders{}
+	{}
+
+	void SetShaderPath(std::wstring shaderPath);
+
+	// Returns a null handle if the shader couldn't be loaded.
+	[[nodiscard]]
+	VkShaderModule GetShaderModule(const ShaderName& shaderName, ShaderBinaryType binaryType);
+
+	void Clear() noexcept;
+
+	[[nodiscard]]
+	const std::wstring& GetShaderPath() const noexcept { return m_shaderPath; }
+	[[nodiscard]]
+	size_t GetShaderCount() const noexcept { return std::size(m_shaders); }
+
+private:
+	VkDevice                                   m_device;
+	// The cache must be movable.
+	std::unique_ptr<std::mutex>                m_mutex;
+	std::wstring                               m_shaderPath;
+	std::unordered_map<std::wstring, VkShader> m_shaders;
+
+public:
+	ShaderModuleCache(const ShaderModuleCache&) = delete;
+	ShaderModuleCache& operator=(const ShaderModuleCache&) = delete;
+
+	ShaderModuleCache(ShaderModuleCache&& other) noexcept
+		: m_device{ other.m_device },
+		m_mutex{ std::move(other.m_mutex) },
+		m_shaderPath{ std::move(other.m_shaderPath) },
+		m_shaders{ std::move(other.m_shaders) }
+	{}
+	ShaderModuleCache& operator=(ShaderModuleCache&& other) noexcept
+	{
+		m_device     = other.m_device;
+		m_mutex      = std::move(other.m_mutex);
+		m_shaderPath = std::move(other.m_shaderPath);
+		m_shaders    = std::move(other.m_shaders);
+
+		return *this;
+	}
+};
 }
 #endif
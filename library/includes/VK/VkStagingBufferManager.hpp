@@ -5,11 +5,226 @@
 #include <VkCommandQueue.hpp>
 #include <VkQueueFamilyManager.hpp>
 #include <vector>
+#include <deque>
+#include <span>
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <optional>
 #include <ThreadPool.hpp>
 #include <TemporaryDataBuffer.hpp>
 
 namespace Terra
 {
+// A persistent CPU visible buffer the uploads are sub-allocated from. The allocations are made
+// linearly and wrap around. The range of a submission is reclaimed once its timeline semaphore
+// has reached the signal value. If there isn't enough space, a larger buffer is created and the
+// old one is kept alive until the submissions which use it have finished.
+class StagingRingBuffer
+{
+	struct Submission
+	{
+		VkSemaphore   semaphore;
+		std::uint64_t signalValue;
+		VkDeviceSize  end;
+	};
+
+	// The buffer is kept alive as an object, so the allocations which are still pending can
+	// keep pointing to it.
+	struct RetiredBuffer
+	{
+		std::unique_ptr<Buffer> buffer;
+		VkSemaphore             semaphore;
+		std::uint64_t           signalValue;
+		// If the buffer still has allocations which haven't been submitted, the semaphore and
+		// the value will be set on the next submission.
+		bool                    isSubmitted;
+	};
+
+public:
+	struct Allocation
+	{
+		Buffer const* buffer;
+		VkDeviceSize  offset;
+		std::uint8_t* cpuHandle;
+	};
+
+public:
+	StagingRingBuffer(VkDevice device, MemoryManager* memoryManager);
+
+	// The offset will be aligned to s_allocationAlignment. The buffer of an allocation stays
+	// valid until its submission has finished, even if the ring buffer grows before that.
+	[[nodiscard]]
+	Allocation Allocate(VkDeviceSize size);
+
+	// The allocations made since the last submission will be reclaimed, once the timeline
+	// semaphore reaches the signal value.
+	void Submit(VkSemaphore timelineSemaphore, std::uint64_t signalValue);
+
+	// Reclaims the ranges of the finished submissions.
+	void Recycle();
+
+	[[nodiscard]]
+	VkDeviceSize Size() const noexcept { return m_buffer->BufferSize(); }
+
+	// Aligned for the texel size of any format used for the textures.
+	static constexpr VkDeviceSize s_allocationAlignment = 16u;
+
+private:
+	[[nodiscard]]
+	std::optional<VkDeviceSize> TryToAllocate(VkDeviceSize size) noexcept;
+
+	void Grow(VkDeviceSize minimumSize);
+
+	[[nodiscard]]
+	bool IsSemaphoreSignalled(VkSemaphore semaphore, std::uint64_t signalValue) const noexcept;
+
+private:
+	VkDevice                   m_device;
+	MemoryManager*             m_memoryManager;
+	std::unique_ptr<Buffer>    m_buffer;
+	std::deque<Submission>     m_submissions;
+	std::vector<RetiredBuffer> m_retiredBuffers;
+	VkDeviceSize               m_head;
+	VkDeviceSize               m_tail;
+	// If the allocations have wrapped around, the used part is [tail, end) and [0, head).
+	bool                       m_isWrapped;
+	bool                       m_hasPendingAllocations;
+
+	static constexpr VkDeviceSize s_initialSize = 8_MB;
+
+public:
+	StagingRingBuffer(const StagingRingBuffer&) = delete;
+	StagingRingBuffer& operator=(const StagingRingBuffer&) = delete;
+
+	StagingRingBuffer(StagingRingBuffer&& other) noexcept
+		: m_device{ other.m_device }, m_memoryManager{ other.m_memoryManager },
+		m_buffer{ std::move(other.m_buffer) },
+		m_submissions{ std::move(other.m_submissions) },
+		m_retiredBuffers{ std::move(other.m_retiredBuffers) },
+		m_head{ other.m_head }, m_tail{ other.m_tail }, m_isWrapped{ other.m_isWrapped },
+		m_hasPendingAllocations{ other.m_hasPendingAllocations }
+	{}
+
+	StagingRingBuffer& operator=(StagingRingBuffer&& other) noexcept
+	{
+		m_device                = other.m_device;
+		m_memoryManager         = other.m_memoryManager;
+		m_buffer                = std::move(other.m_buffer);
+		m_submissions           = std::move(other.m_submissions);
+		m_retiredBuffers        = std::move(other.m_retiredBuffers);
+		m_head                  = other.m_head;
+		m_tail                  = other.m_tail;
+		m_isWrapped             = other.m_isWrapped;
+		m_hasPendingAllocations = other.m_hasPendingAllocations;
+
+		return *this;
+	}
+};
+
+// The uploads can be added to this queue from any thread. The render thread takes them out
+// under a budget each frame. The requests are identified by increasing IDs and as they are taken
+// out in order, a request is complete once the submission of the last taken one has finished.
+class StreamingUploadQueue
+{
+public:
+	struct Request
+	{
+		std::shared_ptr<void> cpuData;
+		VkDeviceSize          bufferSize;
+		// Either the buffer or the texture will be the destination.
+		Buffer const*         bufferDst;
+		VkDeviceSize          bufferOffset;
+		VkTextureView const*  textureDst;
+		VkOffset3D            textureOffset;
+		std::uint32_t         mipLevelIndex;
+		QueueType             dstQueueType;
+		VkAccessFlagBits2     dstAccess;
+		VkPipelineStageFlags2 dstStage;
+	};
+
+	struct CompletionPoint
+	{
+		VkSemaphore   semaphore;
+		std::uint64_t signalValue;
+	};
+
+public:
+	StreamingUploadQueue(VkDevice device);
+
+	// Thread safe.
+	[[nodiscard]]
+	std::uint64_t Add(Request&& request);
+
+	// Thread safe. Should only be called from the render thread.
+	[[nodiscard]]
+	std::optional<Request> Pop();
+
+	// The requests taken out since the last submission will be complete, once the timeline
+	// semaphore reaches the signal value.
+	void Submit(VkSemaphore timelineSemaphore, std::uint64_t signalValue);
+
+	// Thread safe.
+	[[nodiscard]]
+	bool HasPendingRequests() const;
+	// Thread safe.
+	[[nodiscard]]
+	bool IsComplete(std::uint64_t requestID);
+	// Thread safe. Won't have a value, if the request hasn't been submitted yet or if it has
+	// already been completed.
+	[[nodiscard]]
+	std::optional<CompletionPoint> GetCompletionPoint(std::uint64_t requestID);
+
+private:
+	struct Submission
+	{
+		CompletionPoint completionPoint;
+		std::uint64_t   lastRequestID;
+	};
+
+private:
+	// Must be called with the mutex locked.
+	void UpdateCompletedRequests() noexcept;
+
+private:
+	VkDevice                    m_device;
+	// The queue must be movable.
+	std::unique_ptr<std::mutex> m_mutex;
+	std::deque<Request>         m_requests;
+	std::deque<Submission>      m_submissions;
+	// The IDs start from 1, so 0 would mean none.
+	std::uint64_t               m_lastAddedID;
+	std::uint64_t               m_lastPoppedID;
+	std::uint64_t               m_lastSubmittedID;
+	std::uint64_t               m_lastCompletedID;
+
+public:
+	StreamingUploadQueue(const StreamingUploadQueue&) = delete;
+	StreamingUploadQueue& operator=(const StreamingUploadQueue&) = delete;
+
+	StreamingUploadQueue(StreamingUploadQueue&& other) noexcept
+		: m_device{ other.m_device }, m_mutex{ std::move(other.m_mutex) },
+		m_requests{ std::move(other.m_requests) },
+		m_submissions{ std::move(other.m_submissions) },
+		m_lastAddedID{ other.m_lastAddedID }, m_lastPoppedID{ other.m_lastPoppedID },
+		m_lastSubmittedID{ other.m_lastSubmittedID }, m_lastCompletedID{ other.m_lastCompletedID }
+	{}
+
+	StreamingUploadQueue& operator=(StreamingUploadQueue&& other) noexcept
+	{
+		m_device          = other.m_device;
+		m_mutex           = std::move(other.m_mutex);
+		m_requests        = std::move(other.m_requests);
+		m_submissions     = std::move(other.m_submissions);
+		m_lastAddedID     = other.m_lastAddedID;
+		m_lastPoppedID    = other.m_lastPoppedID;
+		m_lastSubmittedID = other.m_lastSubmittedID;
+		m_lastCompletedID = other.m_lastCompletedID;
+
+		return *this;
+	}
+};
+
 class StagingBufferManager
 {
 public:
@@ -18,8 +233,9 @@ public:
 		VkQueueFamilyMananger const* queueFamilyManager
 	) : m_device{ device }, m_memoryManager{ memoryManager },
 		m_threadPool{ threadPool }, m_queueFamilyManager{ queueFamilyManager },
-		m_bufferInfo{}, m_tempBufferToBuffer{}, m_textureInfo{}, m_tempBufferToTexture{},
-		m_cpuTempBuffer{}
+		m_bufferInfo{}, m_textureInfo{}, m_cpuTempBuffer{},
+		m_stagingBuffer{ device, memoryManager }, m_streamingQueue{ device },
+		m_streamingBudget{ s_defaultStreamingBudget }
 	{}
 
 	// The destination info is required, when an ownership transfer is desired. Which
@@ -27,34 +243,134 @@ public:
 	StagingBufferManager& AddTextureView(
 		std::shared_ptr<void> cpuData, VkTextureView const* dst, const VkOffset3D& offset,
 		QueueType dstQueueType, VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage,
-		Callisto::TemporaryDataBufferGPU& tempDataBuffer, std::uint32_t mipLevelIndex = 0u
+		std::uint32_t mipLevelIndex = 0u
 	);
 	StagingBufferManager& AddBuffer(
 		std::shared_ptr<void> cpuData, VkDeviceSize bufferSize, Buffer const* dst,
 		VkDeviceSize offset, QueueType dstQueueType, VkAccessFlagBits2 dstAccess,
-		VkPipelineStageFlags2 dstStage, Callisto::TemporaryDataBufferGPU& tempDataBuffer
+		VkPipelineStageFlags2 dstStage
 	);
 	// If a resource has shared ownership, there is no need for ownership transfer.
 	StagingBufferManager& AddTextureView(
 		std::shared_ptr<void> cpuData, VkTextureView const* dst, const VkOffset3D& offset,
-		Callisto::TemporaryDataBufferGPU& tempDataBuffer, std::uint32_t mipLevelIndex = 0u
+		std::uint32_t mipLevelIndex = 0u
 	) {
 		return AddTextureView(
 			std::move(cpuData), dst, offset, QueueType::None, VK_ACCESS_2_NONE,
-			VK_PIPELINE_STAGE_2_NONE, tempDataBuffer, mipLevelIndex
+			VK_PIPELINE_STAGE_2_NONE, mipLevelIndex
 		);
 	}
 	StagingBufferManager& AddBuffer(
 		std::shared_ptr<void> cpuData, VkDeviceSize bufferSize, Buffer const* dst,
-		VkDeviceSize offset, Callisto::TemporaryDataBufferGPU& tempDataBuffer
+		VkDeviceSize offset
 	) {
 		return AddBuffer(
 			std::move(cpuData), bufferSize, dst, offset, QueueType::None, VK_ACCESS_2_NONE,
-			VK_PIPELINE_STAGE_2_NONE, tempDataBuffer
+			VK_PIPELINE_STAGE_2_NONE
+		);
+	}
+
+	// Instead of copying the data from a CPU buffer, these return a span in the mapped staging
+	// memory, which the data should be written into. The span stays valid until
+	// CopyAndClearQueuedBuffers is called.
+	[[nodiscard]]
+	std::span<std::uint8_t> AddTextureViewInPlace(
+		VkTextureView const* dst, const VkOffset3D& offset, QueueType dstQueueType,
+		VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage,
+		std::uint32_t mipLevelIndex = 0u
+	);
+	[[nodiscard]]
+	std::span<std::uint8_t> AddBufferInPlace(
+		VkDeviceSize bufferSize, Buffer const* dst, VkDeviceSize offset, QueueType dstQueueType,
+		VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage
+	);
+	[[nodiscard]]
+	std::span<std::uint8_t> AddTextureViewInPlace(
+		VkTextureView const* dst, const VkOffset3D& offset, std::uint32_t mipLevelIndex = 0u
+	) {
+		return AddTextureViewInPlace(
+			dst, offset, QueueType::None, VK_ACCESS_2_NONE, VK_PIPELINE_STAGE_2_NONE,
+			mipLevelIndex
+		);
+	}
+	[[nodiscard]]
+	std::span<std::uint8_t> AddBufferInPlace(
+		VkDeviceSize bufferSize, Buffer const* dst, VkDeviceSize offset
+	) {
+		return AddBufferInPlace(
+			bufferSize, dst, offset, QueueType::None, VK_ACCESS_2_NONE, VK_PIPELINE_STAGE_2_NONE
+		);
+	}
+
+	struct StreamingBudget
+	{
+		VkDeviceSize              bytesPerFrame;
+		std::chrono::microseconds timePerFrame;
+	};
+
+	// The streaming requests can be added from any thread. Instead of all of them being copied
+	// in the next frame, they are processed in order each frame, until either of the budgets
+	// is exceeded. At least one is processed per frame, so a request larger than the byte budget
+	// would still be copied. The returned ID can be used to check the completion. The
+	// destination must stay alive until the request has been completed.
+	[[nodiscard]]
+	std::uint64_t StreamTextureView(
+		std::shared_ptr<void> cpuData, VkTextureView const* dst, const VkOffset3D& offset,
+		QueueType dstQueueType, VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage,
+		std::uint32_t mipLevelIndex = 0u
+	);
+	[[nodiscard]]
+	std::uint64_t StreamBuffer(
+		std::shared_ptr<void> cpuData, VkDeviceSize bufferSize, Buffer const* dst,
+		VkDeviceSize offset, QueueType dstQueueType, VkAccessFlagBits2 dstAccess,
+		VkPipelineStageFlags2 dstStage
+	);
+	[[nodiscard]]
+	std::uint64_t StreamTextureView(
+		std::shared_ptr<void> cpuData, VkTextureView const* dst, const VkOffset3D& offset,
+		std::uint32_t mipLevelIndex = 0u
+	) {
+		return StreamTextureView(
+			std::move(cpuData), dst, offset, QueueType::None, VK_ACCESS_2_NONE,
+			VK_PIPELINE_STAGE_2_NONE, mipLevelIndex
+		);
+	}
+	[[nodiscard]]
+	std::uint64_t StreamBuffer(
+		std::shared_ptr<void> cpuData, VkDeviceSize bufferSize, Buffer const* dst,
+		VkDeviceSize offset
+	) {
+		return StreamBuffer(
+			std::move(cpuData), bufferSize, dst, offset, QueueType::None, VK_ACCESS_2_NONE,
+			VK_PIPELINE_STAGE_2_NONE
 		);
 	}
 
-	void CopyAndClearQueuedBuffers(const VKCommandBuffer& transferCmdBuffer);
+	void SetStreamingBudget(const StreamingBudget& budget) noexcept { m_streamingBudget = budget; }
+
+	[[nodiscard]]
+	bool HasPendingStreamingRequests() const
+	{
+		return m_streamingQueue.HasPendingRequests();
+	}
+	[[nodiscard]]
+	bool IsStreamingRequestComplete(std::uint64_t requestID)
+	{
+		return m_streamingQueue.IsComplete(requestID);
+	}
+	[[nodiscard]]
+	std::optional<StreamingUploadQueue::CompletionPoint> GetStreamingRequestCompletionPoint(
+		std::uint64_t requestID
+	) {
+		return m_streamingQueue.GetCompletionPoint(requestID);
+	}
+
+	// The transfer command buffer must be submitted with the timeline semaphore signalling the
+	// value. The staging memory of the copies is reclaimed once that value has been reached.
+	void CopyAndClearQueuedBuffers(
+		const VKCommandBuffer& transferCmdBuffer, const VKSemaphore& transferSemaphore,
+		std::uint64_t signalValue
+	);
 	// This function should be run after the Copy function. The ownership transfer is done via a
 	// barrier. So, I shouldn't need any extra syncing.
 	void ReleaseOwnership(
@@ -67,11 +383,15 @@ public:
 		std::uint32_t transferFamilyIndex
 	);
 
+	[[nodiscard]]
+	VkDeviceSize GetStagingBufferSize() const noexcept { return m_stagingBuffer.Size(); }
+
 private:
+	void ProcessStreamingRequests();
+	void AllocateStagingMemory();
 	void CopyCPU();
 	void CopyGPU(const VKCommandBuffer& transferCmdBuffer);
 
-	void CleanUpTempBuffers() noexcept;
 	void CleanUpBufferInfo() noexcept;
 
 	[[nodiscard]]
@@ -86,37 +406,46 @@ private:
 private:
 	struct BufferInfo
 	{
-		void const*           cpuHandle;
-		VkDeviceSize          bufferSize;
-		Buffer const*         dst;
-		VkDeviceSize          offset;
-		QueueType             dstQueueType;
-		VkAccessFlags2        dstAccess;
-		VkPipelineStageFlags2 dstStage;
+		// Null, if the data has been written into the staging memory directly.
+		void const*                   cpuHandle;
+		StagingRingBuffer::Allocation stagingAllocation;
+		VkDeviceSize                  bufferSize;
+		Buffer const*                 dst;
+		VkDeviceSize                  offset;
+		QueueType                     dstQueueType;
+		VkAccessFlags2                dstAccess;
+		VkPipelineStageFlags2         dstStage;
 	};
 
 	struct TextureInfo
 	{
-		void const*           cpuHandle;
-		VkDeviceSize          bufferSize;
-		VkTextureView const*  dst;
-		VkOffset3D            offset;
-		std::uint32_t         mipLevelIndex;
-		QueueType             dstQueueType;
-		VkAccessFlags2        dstAccess;
-		VkPipelineStageFlags2 dstStage;
+		// Null, if the data has been written into the staging memory directly.
+		void const*                   cpuHandle;
+		StagingRingBuffer::Allocation stagingAllocation;
+		VkDeviceSize                  bufferSize;
+		VkTextureView const*          dst;
+		VkOffset3D                    offset;
+		std::uint32_t                 mipLevelIndex;
+		QueueType                     dstQueueType;
+		VkAccessFlags2                dstAccess;
+		VkPipelineStageFlags2         dstStage;
 	};
 
 private:
-	VkDevice                             m_device;
-	MemoryManager*                       m_memoryManager;
-	ThreadPool*                          m_threadPool;
-	VkQueueFamilyMananger const*         m_queueFamilyManager;
-	std::vector<BufferInfo>              m_bufferInfo;
-	std::vector<std::shared_ptr<Buffer>> m_tempBufferToBuffer;
-	std::vector<TextureInfo>             m_textureInfo;
-	std::vector<std::shared_ptr<Buffer>> m_tempBufferToTexture;
-	Callisto::TemporaryDataBufferCPU     m_cpuTempBuffer;
+	VkDevice                         m_device;
+	MemoryManager*                   m_memoryManager;
+	ThreadPool*                      m_threadPool;
+	VkQueueFamilyMananger const*     m_queueFamilyManager;
+	std::vector<BufferInfo>          m_bufferInfo;
+	std::vector<TextureInfo>         m_textureInfo;
+	Callisto::TemporaryDataBufferCPU m_cpuTempBuffer;
+	StagingRingBuffer                m_stagingBuffer;
+	StreamingUploadQueue             m_streamingQueue;
+	StreamingBudget                  m_streamingBudget;
+
+	static constexpr StreamingBudget s_defaultStreamingBudget{
+		.bytesPerFrame = 32_MB, .timePerFrame = std::chrono::microseconds{ 2'000 }
+	};
 
 public:
 	StagingBufferManager(const StagingBufferManager&) = delete;
@@ -127,23 +456,25 @@ public:
 		m_threadPool{ other.m_threadPool },
 		m_queueFamilyManager{ other.m_queueFamilyManager },
 		m_bufferInfo{ std::move(other.m_bufferInfo) },
-		m_tempBufferToBuffer{ std::move(other.m_tempBufferToBuffer) },
 		m_textureInfo{ std::move(other.m_textureInfo) },
-		m_tempBufferToTexture{ std::move(other.m_tempBufferToTexture) },
-		m_cpuTempBuffer{ std::move(other.m_cpuTempBuffer) }
+		m_cpuTempBuffer{ std::move(other.m_cpuTempBuffer) },
+		m_stagingBuffer{ std::move(other.m_stagingBuffer) },
+		m_streamingQueue{ std::move(other.m_streamingQueue) },
+		m_streamingBudget{ other.m_streamingBudget }
 	{}
 
 	StagingBufferManager& operator=(StagingBufferManager&& other) noexcept
 	{
-		m_device              = other.m_device;
-		m_memoryManager       = other.m_memoryManager;
-		m_threadPool          = other.m_threadPool;
-		m_queueFamilyManager  = other.m_queueFamilyManager;
-		m_bufferInfo          = std::move(other.m_bufferInfo);
-		m_tempBufferToBuffer  = std::move(other.m_tempBufferToBuffer);
-		m_textureInfo         = std::move(other.m_textureInfo);
-		m_tempBufferToTexture = std::move(other.m_tempBufferToTexture);
-		m_cpuTempBuffer       = std::move(other.m_cpuTempBuffer);
+		m_device             = other.m_device;
+		m_memoryManager      = other.m_memoryManager;
+		m_threadPool         = other.m_threadPool;
+		m_queueFamilyManager = other.m_queueFamilyManager;
+		m_bufferInfo         = std::move(other.m_bufferInfo);
+		m_textureInfo        = std::move(other.m_textureInfo);
+		m_cpuTempBuffer      = std::move(other.m_cpuTempBuffer);
+		m_stagingBuffer      = std::move(other.m_stagingBuffer);
+		m_streamingQueue     = std::move(other.m_streamingQueue);
+		m_streamingBudget    = other.m_streamingBudget;
 
 		return *this;
 	}
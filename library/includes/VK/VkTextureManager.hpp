@@ -33,10 +33,7 @@ public:
 	}
 
 	[[nodiscard]]
-	size_t AddTexture(
-		STexture&& texture, StagingBufferManager& stagingBufferManager,
-		Callisto::TemporaryDataBufferGPU& tempBuffer
-	);
+	size_t AddTexture(STexture&& texture, StagingBufferManager& stagingBufferManager);
 	[[nodiscard]]
 	size_t AddSampler(const VkSamplerCreateInfoBuilder& builder);
 
@@ -186,8 +183,11 @@ class TextureManager
 	static constexpr std::uint32_t localSetLayoutCount = 1u;
 
 public:
-	TextureManager(VkDevice device, MemoryManager* memoryManager)
-		: m_availableIndicesCombinedTextures(s_combinedTextureDescriptorCount),
+	TextureManager(VkPhysicalDevice physicalDevice, VkDevice device, MemoryManager* memoryManager)
+		: m_maxCombinedTextureCount{ GetMaxCombinedTextureCount(physicalDevice) },
+		m_availableIndicesCombinedTextures(
+			std::min(s_combinedTextureDescriptorCount, m_maxCombinedTextureCount)
+		),
 		m_availableIndicesSampledTextures{}, m_availableIndicesSamplers{},
 		m_localDescBuffer{ device, memoryManager, localSetLayoutCount },
 		m_combinedTextureCaches{}, m_sampledTextureCaches{}, m_samplerCaches{}
@@ -197,9 +197,22 @@ public:
 		VkDescriptorBuffer& descriptorBuffer, std::uint32_t combinedTexturesBindingSlot,
 		std::uint32_t sampledTexturesBindingSlot, std::uint32_t samplersBindingSlot,
 		size_t setLayoutIndex
-	) const noexcept;
+	) const;
+
+	[[nodiscard]]
+	std::uint32_t GetCombinedTextureCount() const noexcept
+	{
+		return static_cast<std::uint32_t>(std::size(m_availableIndicesCombinedTextures));
+	}
 
 private:
+	[[nodiscard]]
+	static std::uint32_t GetMaxCombinedTextureCount(VkPhysicalDevice physicalDevice) noexcept;
+
+private:
+	// The combined texture binding is created with this count, but only the current count of
+	// descriptors are allocated in the descriptor buffers.
+	std::uint32_t            m_maxCombinedTextureCount;
 	Callisto::IndicesManager m_availableIndicesCombinedTextures;
 	Callisto::IndicesManager m_availableIndicesSampledTextures;
 	Callisto::IndicesManager m_availableIndicesSamplers;
@@ -249,14 +262,18 @@ private:
 
 public:
 	// Add new entries to the available indices container. After calling
-	// this, the descriptor buffer needs to be updated and recreated.
+	// this, the descriptor buffer needs to be updated and recreated. The combined textures
+	// only need the variable descriptor count of the descriptor buffers to be updated. And
+	// their count won't go above the max count.
 	template<TextureDescType DescType>
 	void IncreaseMaximumBindingCount() noexcept
 	{
 		if constexpr (DescType == TextureDescType::CombinedTexture)
 		{
-			const size_t newSize =
-				std::size(m_availableIndicesCombinedTextures) + s_combinedTextureDescriptorCount;
+			const size_t newSize = std::min<size_t>(
+				std::size(m_availableIndicesCombinedTextures) + s_combinedTextureDescriptorCount,
+				m_maxCombinedTextureCount
+			);
 			m_availableIndicesCombinedTextures.Resize(newSize);
 		}
 		else if constexpr (DescType == TextureDescType::SampledTexture)
@@ -371,7 +388,8 @@ public:
 	TextureManager& operator=(const TextureManager&) = delete;
 
 	TextureManager(TextureManager&& other) noexcept
-		: m_availableIndicesCombinedTextures{ std::move(other.m_availableIndicesCombinedTextures) },
+		: m_maxCombinedTextureCount{ other.m_maxCombinedTextureCount },
+		m_availableIndicesCombinedTextures{ std::move(other.m_availableIndicesCombinedTextures) },
 		m_availableIndicesSampledTextures{ std::move(other.m_availableIndicesSampledTextures) },
 		m_availableIndicesSamplers{ std::move(other.m_availableIndicesSamplers) },
 		m_localDescBuffer{ std::move(other.m_localDescBuffer) },
@@ -381,6 +399,7 @@ public:
 	{}
 	TextureManager& operator=(TextureManager&& other) noexcept
 	{
+		m_maxCombinedTextureCount          = other.m_maxCombinedTextureCount;
 		m_availableIndicesCombinedTextures = std::move(other.m_availableIndicesCombinedTextures);
 		m_availableIndicesSampledTextures  = std::move(other.m_availableIndicesSampledTextures);
 		m_availableIndicesSamplers         = std::move(other.m_availableIndicesSamplers);
@@ -164,6 +164,12 @@ public:
 
 		return *this;
 	}
+	VkSamplerCreateInfoBuilder& MipmapMode(VkSamplerMipmapMode mode) noexcept
+	{
+		m_createInfo.mipmapMode = mode;
+
+		return *this;
+	}
 	VkSamplerCreateInfoBuilder& AddressU(VkSamplerAddressMode mode) noexcept
 	{
 		m_createInfo.addressModeU = mode;
@@ -0,0 +1,77 @@
+#include <FrustumCuller.hpp>
+
+namespace Terra
+{
+FrustumCuller::FrustumCuller(ThreadPool* threadPool)
+	: m_threadPool{ threadPool }, m_planes{}, m_modelVisibilities{}, m_waitObjs{},
+	m_isEnabled{ false }
+{
+	// Zero planes don't cull anything, so everything is visible until a frustum is set.
+	m_planes.fill(DirectX::XMVectorZero());
+}
+
+void FrustumCuller::SetFrustum(const Frustum& frustum) noexcept
+{
+	using namespace DirectX;
+
+	m_planes[0u] = XMLoadFloat4(&frustum.leftP);
+	m_planes[1u] = XMLoadFloat4(&frustum.rightP);
+	m_planes[2u] = XMLoadFloat4(&frustum.bottomP);
+	m_planes[3u] = XMLoadFloat4(&frustum.topP);
+	m_planes[4u] = XMLoadFloat4(&frustum.nearP);
+	m_planes[5u] = XMLoadFloat4(&frustum.farP);
+}
+
+void FrustumCuller::Reset(size_t modelCount)
+{
+	m_modelVisibilities.assign(modelCount, 0u);
+}
+
+void FrustumCuller::Wait()
+{
+	for (auto& waitObj : m_waitObjs)
+		waitObj.wait();
+
+	m_waitObjs.clear();
+}
+
+bool FrustumCuller::IsInFrustum(
+	const AxisAlignedBoundingBox& aabb, const DirectX::XMMATRIX& modelMatrix,
+	const DirectX::XMFLOAT3& modelOffset
+) const noexcept {
+	using namespace DirectX;
+
+	const XMVECTOR maxAxes = XMLoadFloat4(&aabb.maxAxes);
+	const XMVECTOR minAxes = XMLoadFloat4(&aabb.minAxes);
+	const XMVECTOR half    = XMVectorReplicate(0.5f);
+
+	const XMVECTOR centre  = XMVectorMultiply(XMVectorAdd(maxAxes, minAxes), half);
+	const XMVECTOR extents = XMVectorMultiply(XMVectorSubtract(maxAxes, minAxes), half);
+
+	// The box is transformed with the absolute values of the matrix, so the new box in the world
+	// space encloses the transformed one.
+	const XMVECTOR worldCentre = XMVectorAdd(
+		XMVector3Transform(centre, modelMatrix), XMLoadFloat3(&modelOffset)
+	);
+
+	const XMMATRIX absoluteMatrix{
+		XMVectorAbs(modelMatrix.r[0]), XMVectorAbs(modelMatrix.r[1]),
+		XMVectorAbs(modelMatrix.r[2]), XMVectorZero()
+	};
+
+	const XMVECTOR worldExtents = XMVector3TransformNormal(extents, absoluteMatrix);
+
+	for (const XMVECTOR& plane : m_planes)
+	{
+		// If the centre is behind the plane by more than the box's extents projected on the
+		// plane normal, the whole box is outside.
+		const XMVECTOR distance = XMPlaneDotCoord(plane, worldCentre);
+		const XMVECTOR radius   = XMVector3Dot(XMVectorAbs(plane), worldExtents);
+
+		if (XMVectorGetX(XMVectorAdd(distance, radius)) < 0.f)
+			return false;
+	}
+
+	return true;
+}
+}
@@ -0,0 +1,369 @@
+#include <TLSFAllocator.hpp>
+#include <bit>
+#include <cassert>
+#include <algorithm>
+
+namespace Terra
+{
+[[nodiscard]]
+static constexpr size_t AlignUp(size_t value, size_t alignment) noexcept
+{
+	return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+TLSFAllocator::TLSFAllocator()
+	: m_blocks{}, m_availableBlockIndices{}, m_blockIndices{}, m_freeLists{},
+	m_secondLevelBitmaps{}, m_firstLevelBitmap{ 0u }, m_totalSize{ 0u }, m_availableSize{ 0u },
+	m_regionCount{ 0u }
+{
+	for (auto& secondLevelLists : m_freeLists)
+		secondLevelLists.fill(s_invalidIndex);
+}
+
+TLSFAllocator::ListIndex TLSFAllocator::GetInsertIndex(size_t size) noexcept
+{
+	if (size < (size_t{ 1u } << s_smallBlockShift))
+		return ListIndex{
+			.firstLevel  = 0u,
+			.secondLevel = static_cast<std::uint32_t>(size >> s_granularityShift)
+		};
+
+	const auto mostSignificantBit = static_cast<std::uint32_t>(std::bit_width(size) - 1u);
+
+	return ListIndex{
+		.firstLevel  = mostSignificantBit - s_smallBlockShift + 1u,
+		.secondLevel = static_cast<std::uint32_t>(
+			(size >> (mostSignificantBit - s_secondLevelShift)) ^ s_secondLevelCount
+		)
+	};
+}
+
+TLSFAllocator::ListIndex TLSFAllocator::GetSearchIndex(size_t size) noexcept
+{
+	// Round the size up to the next list, so any block in the list found would be large enough.
+	if (size >= (size_t{ 1u } << s_smallBlockShift))
+	{
+		const auto mostSignificantBit = static_cast<std::uint32_t>(std::bit_width(size) - 1u);
+
+		size += (size_t{ 1u } << (mostSignificantBit - s_secondLevelShift)) - 1u;
+	}
+
+	return GetInsertIndex(size);
+}
+
+std::uint32_t TLSFAllocator::FindFreeBlock(ListIndex listIndex) const noexcept
+{
+	if (listIndex.firstLevel >= s_firstLevelCount)
+		return s_invalidIndex;
+
+	std::uint32_t secondLevelBitmap
+		= m_secondLevelBitmaps[listIndex.firstLevel] & (~0u << listIndex.secondLevel);
+
+	if (!secondLevelBitmap)
+	{
+		// Look for the next non empty first level list.
+		if (listIndex.firstLevel + 1u >= s_firstLevelCount)
+			return s_invalidIndex;
+
+		const std::uint32_t firstLevelBitmap
+			= m_firstLevelBitmap & (~0u << (listIndex.firstLevel + 1u));
+
+		if (!firstLevelBitmap)
+			return s_invalidIndex;
+
+		listIndex.firstLevel = static_cast<std::uint32_t>(std::countr_zero(firstLevelBitmap));
+		secondLevelBitmap    = m_secondLevelBitmaps[listIndex.firstLevel];
+	}
+
+	listIndex.secondLevel = static_cast<std::uint32_t>(std::countr_zero(secondLevelBitmap));
+
+	return m_freeLists[listIndex.firstLevel][listIndex.secondLevel];
+}
+
+void TLSFAllocator::InsertFreeBlock(std::uint32_t blockIndex) noexcept
+{
+	Block& block              = m_blocks[blockIndex];
+	const ListIndex listIndex = GetInsertIndex(block.size);
+
+	std::uint32_t& listHead = m_freeLists[listIndex.firstLevel][listIndex.secondLevel];
+
+	block.isFree   = true;
+	block.prevFree = s_invalidIndex;
+	block.nextFree = listHead;
+
+	if (listHead != s_invalidIndex)
+		m_blocks[listHead].prevFree = blockIndex;
+
+	listHead = blockIndex;
+
+	m_secondLevelBitmaps[listIndex.firstLevel] |= 1u << listIndex.secondLevel;
+	m_firstLevelBitmap                         |= 1u << listIndex.firstLevel;
+}
+
+void TLSFAllocator::RemoveFreeBlock(std::uint32_t blockIndex) noexcept
+{
+	Block& block = m_blocks[blockIndex];
+
+	if (block.prevFree != s_invalidIndex)
+		m_blocks[block.prevFree].nextFree = block.nextFree;
+	else
+	{
+		// The block is the head of its list.
+		const ListIndex listIndex = GetInsertIndex(block.size);
+
+		m_freeLists[listIndex.firstLevel][listIndex.secondLevel] = block.nextFree;
+
+		if (block.nextFree == s_invalidIndex)
+		{
+			m_secondLevelBitmaps[listIndex.firstLevel] &= ~(1u << listIndex.secondLevel);
+
+			if (!m_secondLevelBitmaps[listIndex.firstLevel])
+				m_firstLevelBitmap &= ~(1u << listIndex.firstLevel);
+		}
+	}
+
+	if (block.nextFree != s_invalidIndex)
+		m_blocks[block.nextFree].prevFree = block.prevFree;
+
+	block.isFree   = false;
+	block.prevFree = s_invalidIndex;
+	block.nextFree = s_invalidIndex;
+}
+
+std::uint32_t TLSFAllocator::CreateBlock(const Block& block)
+{
+	std::uint32_t blockIndex = s_invalidIndex;
+
+	if (!std::empty(m_availableBlockIndices))
+	{
+		blockIndex = m_availableBlockIndices.back();
+		m_availableBlockIndices.pop_back();
+
+		m_blocks[blockIndex] = block;
+	}
+	else
+	{
+		blockIndex = static_cast<std::uint32_t>(std::size(m_blocks));
+
+		m_blocks.emplace_back(block);
+	}
+
+	m_blockIndices[block.offset] = blockIndex;
+
+	return blockIndex;
+}
+
+void TLSFAllocator::ReleaseBlock(std::uint32_t blockIndex) noexcept
+{
+	m_blockIndices.erase(m_blocks[blockIndex].offset);
+
+	m_availableBlockIndices.emplace_back(blockIndex);
+}
+
+std::uint32_t TLSFAllocator::SplitBlock(std::uint32_t blockIndex, size_t size)
+{
+	const Block& block = m_blocks[blockIndex];
+
+	// The reference might be invalidated after a new block is created.
+	const std::uint32_t newBlockIndex = CreateBlock(
+		Block{
+			.offset       = block.offset + size,
+			.size         = block.size - size,
+			.prevPhysical = blockIndex,
+			.nextPhysical = block.nextPhysical,
+			.prevFree     = s_invalidIndex,
+			.nextFree     = s_invalidIndex,
+			.isFree       = false
+		}
+	);
+
+	Block& splitBlock = m_blocks[blockIndex];
+
+	if (splitBlock.nextPhysical != s_invalidIndex)
+		m_blocks[splitBlock.nextPhysical].prevPhysical = newBlockIndex;
+
+	splitBlock.size         = size;
+	splitBlock.nextPhysical = newBlockIndex;
+
+	return newBlockIndex;
+}
+
+void TLSFAllocator::MergeWithNext(std::uint32_t blockIndex) noexcept
+{
+	Block& block                       = m_blocks[blockIndex];
+	const std::uint32_t nextBlockIndex = block.nextPhysical;
+	const Block& nextBlock             = m_blocks[nextBlockIndex];
+
+	block.size         += nextBlock.size;
+	block.nextPhysical  = nextBlock.nextPhysical;
+
+	if (block.nextPhysical != s_invalidIndex)
+		m_blocks[block.nextPhysical].prevPhysical = blockIndex;
+
+	ReleaseBlock(nextBlockIndex);
+}
+
+void TLSFAllocator::AddRegion(size_t start, size_t size)
+{
+	assert(start % s_granularity == 0u && "The region start isn't aligned to the granularity.");
+
+	size -= size % s_granularity;
+
+	if (!size)
+		return;
+
+	const std::uint32_t blockIndex = CreateBlock(
+		Block{
+			.offset       = start,
+			.size         = size,
+			.prevPhysical = s_invalidIndex,
+			.nextPhysical = s_invalidIndex,
+			.prevFree     = s_invalidIndex,
+			.nextFree     = s_invalidIndex,
+			.isFree       = false
+		}
+	);
+
+	InsertFreeBlock(blockIndex);
+
+	m_totalSize     += size;
+	m_availableSize += size;
+	++m_regionCount;
+}
+
+void TLSFAllocator::RemoveRegion(size_t start) noexcept
+{
+	auto result = m_blockIndices.find(start);
+
+	if (result == std::end(m_blockIndices))
+		return;
+
+	const std::uint32_t blockIndex = result->second;
+	const Block& block             = m_blocks[blockIndex];
+
+	assert(
+		block.isFree && block.prevPhysical == s_invalidIndex
+		&& block.nextPhysical == s_invalidIndex && "The region still has allocations."
+	);
+
+	const size_t regionSize = block.size;
+
+	RemoveFreeBlock(blockIndex);
+	ReleaseBlock(blockIndex);
+
+	m_totalSize     -= regionSize;
+	m_availableSize -= regionSize;
+	--m_regionCount;
+}
+
+std::optional<size_t> TLSFAllocator::AllocateN(size_t size, size_t alignment) noexcept
+{
+	size      = AlignUp(std::max(size, s_granularity), s_granularity);
+	alignment = std::max(alignment, s_granularity);
+
+	// Every block starts at a multiple of the granularity, so if the alignment is larger, the
+	// padding wouldn't be larger than this.
+	const size_t maximumPadding = alignment - s_granularity;
+
+	const std::uint32_t freeBlockIndex = FindFreeBlock(GetSearchIndex(size + maximumPadding));
+
+	if (freeBlockIndex == s_invalidIndex)
+		return {};
+
+	std::uint32_t blockIndex = freeBlockIndex;
+
+	RemoveFreeBlock(blockIndex);
+
+	// The block creation could fail with a bad_alloc, which will terminate, as there isn't any
+	// way to recover from that anyway.
+	{
+		const Block& block         = m_blocks[blockIndex];
+		const size_t alignedOffset = AlignUp(block.offset, alignment);
+
+		if (const size_t padding = alignedOffset - block.offset; padding)
+		{
+			// The previous physical block can't be free, as it would have been merged. So, the
+			// padding needs to be a block of its own.
+			const std::uint32_t alignedBlockIndex = SplitBlock(blockIndex, padding);
+
+			InsertFreeBlock(blockIndex);
+
+			blockIndex = alignedBlockIndex;
+		}
+	}
+
+	if (m_blocks[blockIndex].size - size >= s_granularity)
+		InsertFreeBlock(SplitBlock(blockIndex, size));
+
+	const Block& allocatedBlock = m_blocks[blockIndex];
+
+	m_availableSize -= allocatedBlock.size;
+
+	return allocatedBlock.offset;
+}
+
+std::optional<TLSFAllocator::Region> TLSFAllocator::Deallocate(size_t start) noexcept
+{
+	auto result = m_blockIndices.find(start);
+
+	if (result == std::end(m_blockIndices))
+		return {};
+
+	std::uint32_t blockIndex = result->second;
+
+	assert(!m_blocks[blockIndex].isFree && "The block has already been deallocated.");
+
+	m_availableSize += m_blocks[blockIndex].size;
+
+	if (const std::uint32_t nextBlockIndex = m_blocks[blockIndex].nextPhysical;
+		nextBlockIndex != s_invalidIndex && m_blocks[nextBlockIndex].isFree)
+	{
+		RemoveFreeBlock(nextBlockIndex);
+		MergeWithNext(blockIndex);
+	}
+
+	if (const std::uint32_t prevBlockIndex = m_blocks[blockIndex].prevPhysical;
+		prevBlockIndex != s_invalidIndex && m_blocks[prevBlockIndex].isFree)
+	{
+		RemoveFreeBlock(prevBlockIndex);
+		MergeWithNext(prevBlockIndex);
+
+		blockIndex = prevBlockIndex;
+	}
+
+	InsertFreeBlock(blockIndex);
+
+	const Block& freeBlock = m_blocks[blockIndex];
+
+	if (freeBlock.prevPhysical == s_invalidIndex && freeBlock.nextPhysical == s_invalidIndex)
+		return Region{ .start = freeBlock.offset, .size = freeBlock.size };
+
+	return {};
+}
+
+bool TLSFAllocator::IsAllocated(size_t start) const noexcept
+{
+	auto result = m_blockIndices.find(start);
+
+	return result != std::end(m_blockIndices) && !m_blocks[result->second].isFree;
+}
+
+size_t TLSFAllocator::LargestFreeBlockSize() const noexcept
+{
+	if (!m_firstLevelBitmap)
+		return 0u;
+
+	const auto firstLevel  = static_cast<std::uint32_t>(std::bit_width(m_firstLevelBitmap) - 1);
+	const auto secondLevel = static_cast<std::uint32_t>(
+		std::bit_width(m_secondLevelBitmaps[firstLevel]) - 1
+	);
+
+	size_t largestSize = 0u;
+
+	for (std::uint32_t blockIndex = m_freeLists[firstLevel][secondLevel];
+		blockIndex != s_invalidIndex; blockIndex = m_blocks[blockIndex].nextFree)
+		largestSize = std::max(largestSize, m_blocks[blockIndex].size);
+
+	return largestSize;
+}
+}
@@ -1,4 +1,5 @@
 #include <VKPipelineObject.hpp>
+#include <ExternalPipeline.hpp>
 
 namespace Terra
 {
@@ -12,16 +13,124 @@ void VkPipelineObject::SelfDestruct() noexcept
 	vkDestroyPipeline(m_device, m_pipeline, nullptr);
 }
 
-void VkPipelineObject::CreateGraphicsPipeline(const GraphicsPipelineBuilder& builder)
-{
+void VkPipelineObject::CreateGraphicsPipeline(
+	const GraphicsPipelineBuilder& builder, PipelineCache* pipelineCache
+) {
+	CreateGraphicsPipelineWithFeedback(*builder.GetRef(), pipelineCache);
+}
+
+void VkPipelineObject::CreateGraphicsPipelineLibrary(
+	const GraphicsPipelineBuilder& builder, VkGraphicsPipelineLibraryFlagBitsEXT libraryPart,
+	PipelineCache* pipelineCache
+) {
+	VkGraphicsPipelineCreateInfo createInfo = *builder.GetRef();
+
+	// The stages of the other parts aren't allowed.
+	std::vector<VkPipelineShaderStageCreateInfo> shaderStages{};
+
+	for (std::uint32_t index = 0u; index < createInfo.stageCount; ++index)
+	{
+		const VkPipelineShaderStageCreateInfo& shaderStage = createInfo.pStages[index];
+
+		const bool isFragmentStage = shaderStage.stage == VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		if ((libraryPart == VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT
+			&& !isFragmentStage)
+			|| (libraryPart == VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT
+			&& isFragmentStage))
+			shaderStages.emplace_back(shaderStage);
+	}
+
+	createInfo.stageCount = static_cast<std::uint32_t>(std::size(shaderStages));
+	createInfo.pStages    = std::data(shaderStages);
+
+	VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo{
+		.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+		.pNext = createInfo.pNext,
+		.flags = static_cast<VkGraphicsPipelineLibraryFlagsEXT>(libraryPart)
+	};
+
+	createInfo.pNext  = &libraryInfo;
+	// The link time optimisation info is kept, so the parts can be used in an optimised link.
+	createInfo.flags |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR
+		| VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+
+	CreateGraphicsPipelineWithFeedback(createInfo, pipelineCache);
+}
+
+void VkPipelineObject::LinkGraphicsPipeline(
+	const GraphicsPipelineBuilder& builder, const std::vector<VkPipeline>& libraries,
+	bool optimise, PipelineCache* pipelineCache
+) {
+	VkPipelineLibraryCreateInfoKHR libraryInfo{
+		.sType        = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+		.libraryCount = static_cast<std::uint32_t>(std::size(libraries)),
+		.pLibraries   = std::data(libraries)
+	};
+
+	VkPipelineCreateFlags linkFlags = builder.GetRef()->flags;
+
+	if (optimise)
+		linkFlags |= VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT;
+
+	VkGraphicsPipelineCreateInfo createInfo{
+		.sType              = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+		.pNext              = &libraryInfo,
+		.flags              = linkFlags,
+		.layout             = builder.GetRef()->layout,
+		.renderPass         = VK_NULL_HANDLE,
+		.subpass            = 0u,
+		.basePipelineHandle = VK_NULL_HANDLE,
+		.basePipelineIndex  = -1
+	};
+
+	CreateGraphicsPipelineWithFeedback(createInfo, pipelineCache);
+}
+
+void VkPipelineObject::CreateGraphicsPipelineWithFeedback(
+	VkGraphicsPipelineCreateInfo createInfo, PipelineCache* pipelineCache
+) {
+	VkPipelineCreationFeedback creationFeedback{};
+
+	VkPipelineCreationFeedbackCreateInfo feedbackInfo{
+		.sType                     = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+		.pNext                     = createInfo.pNext,
+		.pPipelineCreationFeedback = &creationFeedback
+	};
+
+	createInfo.pNext = &feedbackInfo;
+
 	vkCreateGraphicsPipelines(
-		m_device, VK_NULL_HANDLE, 1u, builder.GetRef(), nullptr, &m_pipeline
+		m_device, pipelineCache ? pipelineCache->Get() : VK_NULL_HANDLE, 1u, &createInfo, nullptr,
+		&m_pipeline
 	);
+
+	if (pipelineCache)
+		pipelineCache->AddCreationFeedback(creationFeedback);
 }
 
-void VkPipelineObject::CreateComputePipeline(const ComputePipelineBuilder& builder)
-{
-	vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1u, builder.GetRef(), nullptr, &m_pipeline);
+void VkPipelineObject::CreateComputePipeline(
+	const ComputePipelineBuilder& builder, PipelineCache* pipelineCache
+) {
+	VkComputePipelineCreateInfo createInfo = *builder.GetRef();
+
+	VkPipelineCreationFeedback creationFeedback{};
+
+	VkPipelineCreationFeedbackCreateInfo feedbackInfo{
+		.sType                     = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+		.pNext                     = createInfo.pNext,
+		.pPipelineCreationFeedback = &creationFeedback
+	};
+
+	createInfo.pNext = &feedbackInfo;
+
+	vkCreateComputePipelines(
+		m_device, pipelineCache ? pipelineCache->Get() : VK_NULL_HANDLE, 1u, &createInfo, nullptr,
+		&m_pipeline
+	);
+
+	if (pipelineCache)
+		pipelineCache->AddCreationFeedback(creationFeedback);
 }
 
 // Pipeline Builder Base
@@ -166,4 +275,108 @@ GraphicsPipelineBuilder& GraphicsPipelineBuilder::AddDynamicState(
 
 	return *this;
 }
+
+std::uint64_t GraphicsPipelineBuilder::GetLibraryPartHash(
+	VkGraphicsPipelineLibraryFlagBitsEXT libraryPart
+) const noexcept {
+	ExternalPipelineHash hash{};
+
+	hash.AddValue(libraryPart);
+	hash.AddValue(m_pipelineCreateInfo.flags);
+	hash.Add(std::data(m_dynamicStates), std::size(m_dynamicStates) * sizeof(VkDynamicState));
+
+	auto AddShaderStages = [&hash, this](bool fragmentStage)
+	{
+		for (const VkPipelineShaderStageCreateInfo& shaderStage : m_shaderStagesInfo)
+			if ((shaderStage.stage == VK_SHADER_STAGE_FRAGMENT_BIT) == fragmentStage)
+			{
+				hash.AddValue(shaderStage.stage);
+				hash.AddValue(shaderStage.module);
+			}
+	};
+
+	if (libraryPart == VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT)
+	{
+		if (HasVertexInput())
+		{
+			VkPipelineVertexInputStateCreateInfo vertexInput = m_vertexLayout.Get();
+
+			// The descriptions don't have any padding.
+			hash.Add(
+				vertexInput.pVertexBindingDescriptions,
+				vertexInput.vertexBindingDescriptionCount * sizeof(VkVertexInputBindingDescription)
+			);
+			hash.Add(
+				vertexInput.pVertexAttributeDescriptions,
+				vertexInput.vertexAttributeDescriptionCount
+				* sizeof(VkVertexInputAttributeDescription)
+			);
+			hash.AddValue(m_inputAssemblerInfo.topology);
+			hash.AddValue(m_inputAssemblerInfo.primitiveRestartEnable);
+		}
+	}
+	else if (libraryPart == VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT)
+	{
+		hash.AddValue(m_pipelineCreateInfo.layout);
+
+		AddShaderStages(false);
+
+		hash.AddValue(m_viewportInfo.viewportCount);
+		hash.AddValue(m_viewportInfo.scissorCount);
+		hash.AddValue(m_rasterizationInfo.depthClampEnable);
+		hash.AddValue(m_rasterizationInfo.rasterizerDiscardEnable);
+		hash.AddValue(m_rasterizationInfo.polygonMode);
+		hash.AddValue(m_rasterizationInfo.cullMode);
+		hash.AddValue(m_rasterizationInfo.frontFace);
+		hash.AddValue(m_rasterizationInfo.depthBiasEnable);
+		hash.AddValue(m_rasterizationInfo.depthBiasConstantFactor);
+		hash.AddValue(m_rasterizationInfo.depthBiasClamp);
+		hash.AddValue(m_rasterizationInfo.depthBiasSlopeFactor);
+		hash.AddValue(m_rasterizationInfo.lineWidth);
+		hash.AddValue(m_pipelineRenderingInfo.viewMask);
+	}
+	else if (libraryPart == VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT)
+	{
+		hash.AddValue(m_pipelineCreateInfo.layout);
+
+		AddShaderStages(true);
+
+		hash.AddValue(m_depthStencilStateInfo.depthTestEnable);
+		hash.AddValue(m_depthStencilStateInfo.depthWriteEnable);
+		hash.AddValue(m_depthStencilStateInfo.depthCompareOp);
+		hash.AddValue(m_depthStencilStateInfo.depthBoundsTestEnable);
+		hash.AddValue(m_depthStencilStateInfo.stencilTestEnable);
+		hash.AddValue(m_depthStencilStateInfo.front);
+		hash.AddValue(m_depthStencilStateInfo.back);
+		hash.AddValue(m_depthStencilStateInfo.minDepthBounds);
+		hash.AddValue(m_depthStencilStateInfo.maxDepthBounds);
+		hash.AddValue(m_multisampleInfo.rasterizationSamples);
+		hash.AddValue(m_multisampleInfo.sampleShadingEnable);
+		hash.AddValue(m_multisampleInfo.minSampleShading);
+		hash.AddValue(m_pipelineRenderingInfo.viewMask);
+	}
+	else if (libraryPart == VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT)
+	{
+		// The blend states don't have any padding.
+		hash.Add(
+			std::data(m_colourAttachmentStates),
+			std::size(m_colourAttachmentStates) * sizeof(VkPipelineColorBlendAttachmentState)
+		);
+		hash.Add(
+			std::data(m_colourAttachmentFormats),
+			std::size(m_colourAttachmentFormats) * sizeof(VkFormat)
+		);
+		hash.AddValue(m_colourStateInfo.logicOpEnable);
+		hash.AddValue(m_colourStateInfo.logicOp);
+		hash.Add(m_colourStateInfo.blendConstants, sizeof(m_colourStateInfo.blendConstants));
+		hash.AddValue(m_pipelineRenderingInfo.depthAttachmentFormat);
+		hash.AddValue(m_pipelineRenderingInfo.stencilAttachmentFormat);
+		hash.AddValue(m_pipelineRenderingInfo.viewMask);
+		hash.AddValue(m_multisampleInfo.rasterizationSamples);
+		hash.AddValue(m_multisampleInfo.alphaToCoverageEnable);
+		hash.AddValue(m_multisampleInfo.alphaToOneEnable);
+	}
+
+	return hash.Get();
+}
 }
@@ -27,8 +27,8 @@ static VkMemoryRequirements GetMemoryRequirements(VkDevice device, VkImage image
 // VkAllocator
 VkAllocator::VkAllocator(DeviceMemory&& memory, std::uint16_t id)
 	: m_memory{ std::move(memory) },
-	m_allocator{ 0u, static_cast<size_t>(m_memory.Size()), 256_B },
-	m_id{ id }
+	m_allocator{ 0u, static_cast<size_t>(m_memory.Size()), 256_B }, m_smallAllocator{},
+	m_requestedSize{ 0u }, m_id{ id }
 {}
 
 std::optional<VkDeviceSize> VkAllocator::Allocate(const VkMemoryRequirements& memoryReq) noexcept
@@ -43,14 +43,58 @@ std::optional<VkDeviceSize> VkAllocator::Allocate(const VkMemoryRequirements& me
 	return {};
 }
 
+std::optional<VkDeviceSize> VkAllocator::AllocateSmall(
+	const VkMemoryRequirements& memoryReq
+) noexcept {
+	const auto size      = static_cast<size_t>(memoryReq.size);
+	const auto alignment = static_cast<size_t>(memoryReq.alignment);
+
+	std::optional<size_t> allocationStart = m_smallAllocator.AllocateN(size, alignment);
+
+	if (!allocationStart)
+	{
+		// Add a new page from the buddy allocator. It is aligned to its size, so an allocation
+		// with an alignment below the page size wouldn't need any padding at the page start.
+		std::optional<size_t> pageStart = m_allocator.AllocateN(
+			static_cast<size_t>(s_smallTierPageSize), static_cast<size_t>(s_smallTierPageSize)
+		);
+
+		if (!pageStart)
+			return {};
+
+		m_smallAllocator.AddRegion(pageStart.value(), static_cast<size_t>(s_smallTierPageSize));
+
+		allocationStart = m_smallAllocator.AllocateN(size, alignment);
+	}
+
+	if (allocationStart)
+		return static_cast<VkDeviceSize>(allocationStart.value());
+
+	return {};
+}
+
 std::optional<VkDeviceSize> VkAllocator::AllocateBuffer(
 	VkDevice device, const VkMemoryRequirements& memoryReq, VkBuffer buffer
 ) noexcept {
-	std::optional<VkDeviceSize> allocationStart = Allocate(memoryReq);
+	std::optional<VkDeviceSize> allocationStart{};
+
+	// Only the buffers are sub-allocated, so the linear and the optimal resources never share a
+	// page. If the small tier can't get a new page, the buddy allocator might still have a
+	// block small enough.
+	if (memoryReq.size <= s_smallAllocationThreshold
+		&& memoryReq.alignment <= s_smallAllocationThreshold)
+		allocationStart = AllocateSmall(memoryReq);
+
+	if (!allocationStart)
+		allocationStart = Allocate(memoryReq);
 
 	if (allocationStart)
+	{
 		vkBindBufferMemory(device, buffer, m_memory.Memory(), allocationStart.value());
 
+		m_requestedSize += memoryReq.size;
+	}
+
 	return allocationStart;
 }
 
@@ -60,18 +104,61 @@ std::optional<VkDeviceSize> VkAllocator::AllocateImage(
 	std::optional<VkDeviceSize> allocationStart = Allocate(memoryReq);
 
 	if (allocationStart)
+	{
 		vkBindImageMemory(device, image, m_memory.Memory(), allocationStart.value());
 
+		m_requestedSize += memoryReq.size;
+	}
+
 	return allocationStart;
 }
 
 void VkAllocator::Deallocate(
 	VkDeviceSize startingAddress, VkDeviceSize bufferSize, VkDeviceSize alignment
 ) noexcept {
-	m_allocator.Deallocate(
-		static_cast<size_t>(startingAddress), static_cast<size_t>(bufferSize),
-		static_cast<size_t>(alignment)
-	);
+	m_requestedSize -= bufferSize;
+
+	// The pages and the buddy allocations don't overlap, so an allocation can't start at the same
+	// offset as a small one.
+	if (m_smallAllocator.IsAllocated(static_cast<size_t>(startingAddress)))
+	{
+		std::optional<TLSFAllocator::Region> freePage = m_smallAllocator.Deallocate(
+			static_cast<size_t>(startingAddress)
+		);
+
+		// Keep the last page, so allocating and freeing a single small buffer doesn't keep
+		// moving a page between the two tiers.
+		if (freePage && m_smallAllocator.RegionCount() > 1u)
+		{
+			const TLSFAllocator::Region page = freePage.value();
+
+			m_smallAllocator.RemoveRegion(page.start);
+			m_allocator.Deallocate(page.start, page.size, static_cast<size_t>(s_smallTierPageSize));
+		}
+	}
+	else
+		m_allocator.Deallocate(
+			static_cast<size_t>(startingAddress), static_cast<size_t>(bufferSize),
+			static_cast<size_t>(alignment)
+		);
+}
+
+MemoryFragmentationReport VkAllocator::GetFragmentationReport() const noexcept
+{
+	const VkDeviceSize smallTierSize  = m_smallAllocator.TotalSize();
+	const VkDeviceSize buddyUsedSize  = Size() - m_allocator.AvailableSize();
+	// The pages are allocated from the buddy allocator, so only their allocated blocks should
+	// be counted.
+	const VkDeviceSize buddyLargeSize  = buddyUsedSize - smallTierSize;
+
+	return MemoryFragmentationReport{
+		.totalSize                 = Size(),
+		.requestedSize             = m_requestedSize,
+		.reservedSize              = buddyLargeSize + m_smallAllocator.AllocatedSize(),
+		.smallTierSize             = smallTierSize,
+		.smallTierAvailableSize    = m_smallAllocator.AvailableSize(),
+		.largestSmallTierFreeBlock = m_smallAllocator.LargestFreeBlockSize()
+	};
 }
 
 // MemoryManager
@@ -79,7 +166,8 @@ MemoryManager::MemoryManager(
 	VkPhysicalDevice physicalDevice, VkDevice logicalDevice, VkDeviceSize initialBudgetGPU,
 	VkDeviceSize initialBudgetCPU
 ) : m_logicalDevice{ logicalDevice }, m_physicalDevice{ physicalDevice }, m_cpuAllocators{},
-	m_gpuAllocators{}, m_availableGPUIndices{}, m_availableCPUIndices{}
+	m_gpuAllocators{}, m_availableGPUIndices{}, m_availableCPUIndices{},
+	m_gpuGrowthPolicy{ s_defaultGPUGrowthPolicy }, m_cpuGrowthPolicy{ s_defaultCPUGrowthPolicy }
 {
 	{
 		// Try to allocate the CPU memory first, as it will be smaller and both types of memory might
@@ -182,10 +270,109 @@ VkDeviceSize MemoryManager::GetAvailableMemoryOfType(
 	return maxAvailableSize;
 }
 
+VkDeviceSize MemoryManager::GetHeapBudgetOfType(
+	VkMemoryPropertyFlagBits memoryType
+) const noexcept {
+	VkPhysicalDeviceMemoryBudgetPropertiesEXT memBudget
+	{
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT
+	};
+	VkPhysicalDeviceMemoryProperties2 memProp2
+	{
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+		.pNext = &memBudget
+	};
+
+	vkGetPhysicalDeviceMemoryProperties2(m_physicalDevice, &memProp2);
+
+	const VkPhysicalDeviceMemoryProperties memProp = memProp2.memoryProperties;
+	VkDeviceSize maxBudget = 0u;
+
+	for (size_t index = 0u; index < memProp.memoryTypeCount; ++index)
+		if (const auto& memType = memProp.memoryTypes[index]; memType.propertyFlags & memoryType)
+			maxBudget = std::max(maxBudget, memBudget.heapBudget[memType.heapIndex]);
+
+	return maxBudget;
+}
+
 VkDeviceSize MemoryManager::GetNewAllocationSize(VkMemoryPropertyFlagBits memoryType) const noexcept
 {
-	// Might add some algorithm here later.
-	return memoryType & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ? 2_GB : 100_MB;
+	const bool isCPUAccessible                 = memoryType & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	const std::vector<VkAllocator>& allocators = isCPUAccessible ? m_cpuAllocators : m_gpuAllocators;
+	const GrowthPolicy& policy                 = GetGrowthPolicy(memoryType);
+
+	VkDeviceSize largestAllocationSize = 0u;
+
+	for (const VkAllocator& allocator : allocators)
+		largestAllocationSize = std::max(largestAllocationSize, allocator.Size());
+
+	const auto grownSize = static_cast<VkDeviceSize>(
+		static_cast<double>(largestAllocationSize) * policy.growthFactor
+	);
+
+	// The budget might be shared with other processes, so only take a part of it, so the
+	// first overflow doesn't fail or cause evictions.
+	const auto budgetLimit = static_cast<VkDeviceSize>(
+		static_cast<double>(GetHeapBudgetOfType(memoryType)) * policy.maximumBudgetFraction
+	);
+
+	// If the limit is below the minimum size, the limit wins. The caller will still increase the
+	// size if the resource requires more.
+	const VkDeviceSize sizeLimit = std::min(policy.maximumSize, budgetLimit);
+
+	return std::min(std::max(grownSize, policy.minimumSize), sizeLimit);
+}
+
+void MemoryManager::SetGrowthPolicy(
+	VkMemoryPropertyFlagBits memoryType, const GrowthPolicy& policy
+) noexcept {
+	if (memoryType & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+		m_cpuGrowthPolicy = policy;
+	else
+		m_gpuGrowthPolicy = policy;
+}
+
+std::vector<MemoryManager::HeapBudget> MemoryManager::GetHeapBudgets() const
+{
+	VkPhysicalDeviceMemoryBudgetPropertiesEXT memBudget
+	{
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT
+	};
+	VkPhysicalDeviceMemoryProperties2 memProp2
+	{
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+		.pNext = &memBudget
+	};
+
+	vkGetPhysicalDeviceMemoryProperties2(m_physicalDevice, &memProp2);
+
+	const VkPhysicalDeviceMemoryProperties memProp = memProp2.memoryProperties;
+
+	std::vector<HeapBudget> heapBudgets(memProp.memoryHeapCount);
+
+	for (size_t index = 0u; index < memProp.memoryHeapCount; ++index)
+		heapBudgets[index] = HeapBudget{
+			.budget        = memBudget.heapBudget[index],
+			.usage         = memBudget.heapUsage[index],
+			.allocatedSize = 0u,
+			.flags         = memProp.memoryHeaps[index].flags
+		};
+
+	auto addAllocatedSizes = [&heapBudgets, &memProp](const std::vector<VkAllocator>& allocators)
+	{
+		for (const VkAllocator& allocator : allocators)
+		{
+			const std::uint32_t heapIndex
+				= memProp.memoryTypes[allocator.GetMemoryTypeIndex()].heapIndex;
+
+			heapBudgets[heapIndex].allocatedSize += allocator.Size();
+		}
+	};
+
+	addAllocatedSizes(m_cpuAllocators);
+	addAllocatedSizes(m_gpuAllocators);
+
+	return heapBudgets;
 }
 
 template<typename T>
@@ -347,6 +534,31 @@ void MemoryManager::Deallocate(
 	}
 }
 
+MemoryFragmentationReport MemoryManager::GetFragmentationReport(
+	VkMemoryPropertyFlagBits memoryType
+) const noexcept {
+	const bool isCPUAccessible                 = memoryType & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	const std::vector<VkAllocator>& allocators = isCPUAccessible ? m_cpuAllocators : m_gpuAllocators;
+
+	MemoryFragmentationReport combinedReport{};
+
+	for (const VkAllocator& allocator : allocators)
+	{
+		const MemoryFragmentationReport report = allocator.GetFragmentationReport();
+
+		combinedReport.totalSize              += report.totalSize;
+		combinedReport.requestedSize          += report.requestedSize;
+		combinedReport.reservedSize           += report.reservedSize;
+		combinedReport.smallTierSize          += report.smallTierSize;
+		combinedReport.smallTierAvailableSize += report.smallTierAvailableSize;
+		combinedReport.largestSmallTierFreeBlock = std::max(
+			combinedReport.largestSmallTierFreeBlock, report.largestSmallTierFreeBlock
+		);
+	}
+
+	return combinedReport;
+}
+
 std::uint16_t MemoryManager::GetID(bool cpu) noexcept
 {
 	std::vector<VkAllocator>& allocators        = cpu ? m_cpuAllocators : m_gpuAllocators;
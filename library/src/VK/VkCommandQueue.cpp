@@ -49,6 +49,15 @@ void VKCommandBuffer::Copy(
 	vkCmdCopyBuffer(m_commandBuffer, src.Get(), dst.Get(), 1u, builder.GetPtr());
 }
 
+void VKCommandBuffer::Copy(
+	const Buffer& src, const Buffer& dst, std::span<const VkBufferCopy> regions
+) const noexcept {
+	vkCmdCopyBuffer(
+		m_commandBuffer, src.Get(), dst.Get(), static_cast<std::uint32_t>(std::size(regions)),
+		std::data(regions)
+	);
+}
+
 void VKCommandBuffer::CopyWhole(
 	const Buffer& src, const Buffer& dst, BufferToBufferCopyBuilder& builder
 ) const noexcept {
@@ -105,6 +114,23 @@ void VKCommandBuffer::Copy(
 	);
 }
 
+void VKCommandBuffer::Copy(
+	const VkTextureView& src, const Buffer& dst, const BufferToImageCopyBuilder& builder
+) const noexcept {
+	vkCmdCopyImageToBuffer(
+		m_commandBuffer, src.GetTexture().Get(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst.Get(),
+		1u, builder.GetPtr()
+	);
+}
+
+void VKCommandBuffer::CopyWhole(
+	const VkTextureView& src, const Buffer& dst, BufferToImageCopyBuilder& builder
+) const noexcept {
+	Copy(
+		src, dst, builder.ImageExtent(src.GetTexture().GetExtent()).ImageAspectFlags(src.GetAspect())
+	);
+}
+
 void VKCommandBuffer::AcquireOwnership(
 	const Buffer& buffer,
 	std::uint32_t srcQueueFamilyIndex, std::uint32_t dstQueueFamilyIndex,
@@ -252,6 +278,8 @@ void VkGraphicsQueue::CreateCommandBuffers(std::uint32_t bufferCount)
 
 void VkGraphicsQueue::WaitForSubmission(size_t bufferIndex)
 {
+	TERRA_CPU_TRACE_ZONE("WaitForSubmission");
+
 	m_fences[bufferIndex].Wait();
 }
 
@@ -1,43 +1,42 @@
 #include <VkComputePipeline.hpp>
-#include <VkShader.hpp>
 
 namespace Terra
 {
 void ComputePipeline::Create(
 	VkDevice device, VkPipelineLayout computeLayout,
-	const ExternalComputePipeline& computeExtPipeline, const std::wstring& shaderPath
+	const ExternalComputePipeline& computeExtPipeline, ShaderModuleCache& shaderCache,
+	PipelineCache* pipelineCache
 ) {
 	m_computeExternalPipeline = computeExtPipeline;
 
 	m_computePipeline = _createComputePipeline(
-		device, computeLayout, m_computeExternalPipeline, shaderPath
+		device, computeLayout, m_computeExternalPipeline, shaderCache, pipelineCache
 	);
 }
 
 void ComputePipeline::Recreate(
-	VkDevice device, VkPipelineLayout computeLayout, const std::wstring& shaderPath
+	VkDevice device, VkPipelineLayout computeLayout, ShaderModuleCache& shaderCache,
+	PipelineCache* pipelineCache
 ) {
 	m_computePipeline = _createComputePipeline(
-		device, computeLayout, m_computeExternalPipeline, shaderPath
+		device, computeLayout, m_computeExternalPipeline, shaderCache, pipelineCache
 	);
 }
 
 std::unique_ptr<VkPipelineObject> ComputePipeline::_createComputePipeline(
 	VkDevice device, VkPipelineLayout computeLayout,
-	const ExternalComputePipeline& computeExtPipeline, const std::wstring& shaderPath
+	const ExternalComputePipeline& computeExtPipeline, ShaderModuleCache& shaderCache,
+	PipelineCache* pipelineCache
 ) {
-	auto cs            = std::make_unique<VkShader>(device);
-	const bool success = cs->Create(
-		shaderPath + computeExtPipeline.GetComputeShader().GetNameWithExtension(
-			s_shaderBytecodeType
-		)
+	VkShaderModule cs = shaderCache.GetShaderModule(
+		computeExtPipeline.GetComputeShader(), s_shaderBytecodeType
 	);
 
 	auto pso = std::make_unique<VkPipelineObject>(device);
 
-	if (success)
+	if (cs != VK_NULL_HANDLE)
 		pso->CreateComputePipeline(ComputePipelineBuilder{ computeLayout }
-			.SetComputeStage(cs->Get()));
+			.SetComputeStage(cs), pipelineCache);
 
 	return pso;
 }
@@ -1,4 +1,5 @@
 #include <VkDescriptorBuffer.hpp>
+#include <algorithm>
 
 namespace Terra
 {
@@ -11,7 +12,9 @@ VkDescriptorBuffer::VkDescriptorBuffer(
 	VkDevice device, MemoryManager* memoryManager, std::uint32_t setLayoutCount
 ) : m_device{ device }, m_memoryManager{ memoryManager }, m_setLayouts{},
 	m_bufferIndices{}, m_validOffsets{}, m_layoutOffsets(setLayoutCount, 0u),
-	m_descriptorBuffer{ device, memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT }
+	m_variableDescriptorCounts(setLayoutCount, 0u),
+	m_descriptorBuffer{ device, memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT },
+	m_retiredBuffers{}
 {
 	for (size_t index = 0u; index < setLayoutCount; ++index)
 		m_setLayouts.emplace_back(device);
@@ -28,11 +31,48 @@ VkDescriptorBuffer& VkDescriptorBuffer::AddBinding(
 	return *this;
 }
 
+void VkDescriptorBuffer::CreateSetLayouts()
+{
+	for (DescriptorSetLayout& setLayout : m_setLayouts)
+		if (!std::empty(setLayout.GetBindings()))
+			setLayout.Create();
+}
+
+VkDeviceSize VkDescriptorBuffer::GetLayoutSize(size_t setLayoutIndex) const noexcept
+{
+	using DescBuffer = VkDeviceExtension::VkExtDescriptorBuffer;
+
+	const DescriptorSetLayout& setLayout = m_setLayouts[setLayoutIndex];
+
+	VkDeviceSize layoutSize = 0u;
+
+	std::optional<VkDescriptorSetLayoutBinding> oVariableCountBinding
+		= setLayout.GetVariableCountBinding();
+
+	if (oVariableCountBinding)
+	{
+		// The variable count binding must be the last one in the layout, so the layout ends
+		// after its current descriptor count instead of its upper bound.
+		const VkDescriptorSetLayoutBinding& variableCountBinding = oVariableCountBinding.value();
+
+		const VkDeviceSize descriptorSize = GetDescriptorSize(variableCountBinding.descriptorType);
+		const VkDeviceSize alignment      = s_descriptorInfo.descriptorBufferOffsetAlignment;
+
+		layoutSize = GetBindingOffset(variableCountBinding.binding, setLayoutIndex)
+			+ descriptorSize * m_variableDescriptorCounts[setLayoutIndex];
+
+		// The next layout's offset must be aligned.
+		layoutSize = (layoutSize + alignment - 1u) / alignment * alignment;
+	}
+	else
+		DescBuffer::vkGetDescriptorSetLayoutSizeEXT(m_device, setLayout.Get(), &layoutSize);
+
+	return layoutSize;
+}
+
 void VkDescriptorBuffer::_createBuffer(
 	Buffer& descriptorBuffer, const std::vector<std::uint32_t>& queueFamilyIndices
 ) {
-	using DescBuffer = VkDeviceExtension::VkExtDescriptorBuffer;
-
 	VkDeviceSize layoutSizeInBytes = 0u;
 
 	const size_t layoutCount = std::size(m_setLayouts);
@@ -45,7 +85,7 @@ void VkDescriptorBuffer::_createBuffer(
 
 	for (size_t index = 0u; index < layoutCount; ++index)
 	{
-		DescriptorSetLayout& setLayout = m_setLayouts[index];
+		const DescriptorSetLayout& setLayout = m_setLayouts[index];
 
 		const size_t bindingCount      = std::size(setLayout.GetBindings());
 
@@ -53,11 +93,7 @@ void VkDescriptorBuffer::_createBuffer(
 
 		if (bindingCount)
 		{
-			setLayout.Create();
-
-			DescBuffer::vkGetDescriptorSetLayoutSizeEXT(
-				m_device, setLayout.Get(), &currentLayoutSize
-			);
+			currentLayoutSize = GetLayoutSize(index);
 
 			m_validOffsets[validLayoutCount] = layoutSizeInBytes;
 
@@ -78,6 +114,8 @@ void VkDescriptorBuffer::_createBuffer(
 
 void VkDescriptorBuffer::CreateBuffer(const std::vector<std::uint32_t>& queueFamilyIndices/* = {} */)
 {
+	CreateSetLayouts();
+
 	_createBuffer(m_descriptorBuffer, queueFamilyIndices);
 }
 
@@ -105,6 +143,8 @@ void VkDescriptorBuffer::RecreateSetLayout(
 		oldLayoutBindingOffsets[index] = GetBindingOffset(oldLayoutBinding.binding, setLayoutIndex);
 	}
 
+	CreateSetLayouts();
+
 	_createBuffer(newBuffer, queueFamilyIndices);
 
 	// It would be kinda useless to recreate when nothing was added or removed and the size is the
@@ -141,6 +181,9 @@ void VkDescriptorBuffer::RecreateSetLayout(
 
 				// We only need to copy the old bindings. As the new ones won't have any data in yet,
 				// hopefully.
+				const std::optional<VkDescriptorSetLayoutBinding> oVariableCountBinding
+					= m_setLayouts[setLayoutIndex].GetVariableCountBinding();
+
 				for (size_t bindingIndex = 0u; bindingIndex < oldBindingCount; ++bindingIndex)
 				{
 					const VkDescriptorSetLayoutBinding& oldLayoutBinding
@@ -153,8 +196,17 @@ void VkDescriptorBuffer::RecreateSetLayout(
 					);
 					const VkDeviceSize oldBindingOffset = oldLayoutBindingOffsets[bindingIndex];
 
+					// The variable count binding only has the space for its current count.
+					std::uint32_t oldDescriptorCount = oldLayoutBinding.descriptorCount;
+
+					if (oVariableCountBinding
+						&& oVariableCountBinding->binding == oldLayoutBinding.binding)
+						oldDescriptorCount = std::min(
+							oldDescriptorCount, m_variableDescriptorCounts[setLayoutIndex]
+						);
+
 					const VkDeviceSize descriptorSize   = GetDescriptorSize(oldLayoutBinding.descriptorType);
-					const VkDeviceSize oldTotalDescSize = descriptorSize * oldLayoutBinding.descriptorCount;
+					const VkDeviceSize oldTotalDescSize = descriptorSize * oldDescriptorCount;
 
 					memcpy(
 						newBuffer.CPUHandle() + newLayoutStart + newBindingOffset,
@@ -175,6 +227,52 @@ void VkDescriptorBuffer::RecreateSetLayout(
 	m_descriptorBuffer = std::move(newBuffer);
 }
 
+void VkDescriptorBuffer::SetVariableDescriptorCount(
+	size_t setLayoutIndex, std::uint32_t descriptorCount,
+	const std::vector<std::uint32_t>& queueFamilyIndices/* = {} */
+) {
+	m_variableDescriptorCounts[setLayoutIndex] = descriptorCount;
+
+	// Skip if this is called before the descriptorBuffer has been created.
+	if (m_descriptorBuffer.Get() == VK_NULL_HANDLE)
+		return;
+
+	Buffer newBuffer{ m_device, m_memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
+
+	const std::vector<VkDeviceSize> oldLayoutOffsets = m_layoutOffsets;
+	const VkDeviceSize oldBufferSize                 = m_descriptorBuffer.BufferSize();
+
+	_createBuffer(newBuffer, queueFamilyIndices);
+
+	const VkDeviceSize newBufferSize = newBuffer.BufferSize();
+
+	// The layouts are the same, so the binding offsets haven't changed and each layout can be
+	// copied as a whole. Only the end of the changed layout would be different.
+	const size_t layoutCount = std::size(m_setLayouts);
+
+	for (size_t index = 0u; index < layoutCount; ++index)
+	{
+		const bool isLastLayout     = index + 1u == layoutCount;
+
+		const VkDeviceSize oldStart = oldLayoutOffsets[index];
+		const VkDeviceSize newStart = m_layoutOffsets[index];
+		const VkDeviceSize oldEnd   = isLastLayout ? oldBufferSize : oldLayoutOffsets[index + 1u];
+		const VkDeviceSize newEnd   = isLastLayout ? newBufferSize : m_layoutOffsets[index + 1u];
+
+		const auto layoutSize = static_cast<size_t>(std::min(oldEnd - oldStart, newEnd - newStart));
+
+		if (layoutSize)
+			memcpy(
+				newBuffer.CPUHandle() + newStart, m_descriptorBuffer.CPUHandle() + oldStart,
+				layoutSize
+			);
+	}
+
+	m_retiredBuffers.emplace_back(std::move(m_descriptorBuffer));
+
+	m_descriptorBuffer = std::move(newBuffer);
+}
+
 std::vector<VkDescriptorSetLayout> VkDescriptorBuffer::GetValidLayouts() const noexcept
 {
 	std::vector<VkDescriptorSetLayout> validLayouts{};
@@ -188,6 +286,29 @@ std::vector<VkDescriptorSetLayout> VkDescriptorBuffer::GetValidLayouts() const n
 	return validLayouts;
 }
 
+std::vector<VkDescriptorSetLayout> VkDescriptorBuffer::GetValidLayouts(
+	const VkDescriptorBuffer& descriptorBuffer, const VkDescriptorBuffer& sharedDescriptorBuffer
+) noexcept {
+	std::vector<VkDescriptorSetLayout> validLayouts{};
+
+	const size_t layoutCount = std::size(descriptorBuffer.m_setLayouts);
+
+	validLayouts.reserve(layoutCount);
+
+	for (size_t index = 0u; index < layoutCount; ++index)
+	{
+		VkDescriptorSetLayout vkSetLayout = descriptorBuffer.m_setLayouts[index].Get();
+
+		if (vkSetLayout == VK_NULL_HANDLE)
+			vkSetLayout = sharedDescriptorBuffer.m_setLayouts[index].Get();
+
+		if (vkSetLayout != VK_NULL_HANDLE)
+			validLayouts.emplace_back(vkSetLayout);
+	}
+
+	return validLayouts;
+}
+
 void VkDescriptorBuffer::SetDescriptorBufferInfo(VkPhysicalDevice physicalDevice) noexcept
 {
 	VkPhysicalDeviceProperties2 physicalDeviceProp2{
@@ -274,4 +395,68 @@ void VkDescriptorBuffer::BindDescriptorBuffer(
 		std::data(bufferIndices), std::data(setLayoutOffsets)
 	);
 }
+
+void VkDescriptorBuffer::BindDescriptorBuffer(
+	const VkDescriptorBuffer& descriptorBuffer, const VkDescriptorBuffer& sharedDescriptorBuffer,
+	const VKCommandBuffer& cmdBuffer, VkPipelineBindPoint bindPoint,
+	const PipelineLayout& pipelineLayout
+) {
+	using DescBuffer = VkDeviceExtension::VkExtDescriptorBuffer;
+
+	// The device manager doesn't pick a device which can't bind both of them.
+	assert(
+		s_descriptorInfo.maxResourceDescriptorBufferBindings > 1u
+		&& "The device can't bind multiple resource descriptor buffers."
+	);
+
+	VkCommandBuffer commandBuffer = cmdBuffer.Get();
+
+	// The buffer index of the frame buffer is 0 and the shared one is 1.
+	const std::array bindingInfos
+	{
+		VkDescriptorBufferBindingInfoEXT{
+			.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
+			.address = descriptorBuffer.GpuPhysicalAddress(),
+			.usage   = VkDescriptorBuffer::GetFlags()
+		},
+		VkDescriptorBufferBindingInfoEXT{
+			.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
+			.address = sharedDescriptorBuffer.GpuPhysicalAddress(),
+			.usage   = VkDescriptorBuffer::GetFlags()
+		}
+	};
+
+	DescBuffer::vkCmdBindDescriptorBuffersEXT(
+		commandBuffer, static_cast<std::uint32_t>(std::size(bindingInfos)), std::data(bindingInfos)
+	);
+
+	const size_t layoutCount = std::size(descriptorBuffer.m_setLayouts);
+
+	std::vector<std::uint32_t> bufferIndices{};
+	std::vector<VkDeviceSize> setLayoutOffsets{};
+
+	bufferIndices.reserve(layoutCount);
+	setLayoutOffsets.reserve(layoutCount);
+
+	// The valid sets should progressively increase from the firstSet, same as the single buffer.
+	for (size_t index = 0u; index < layoutCount; ++index)
+		if (descriptorBuffer.m_setLayouts[index].Get() != VK_NULL_HANDLE)
+		{
+			bufferIndices.emplace_back(0u);
+			setLayoutOffsets.emplace_back(descriptorBuffer.m_layoutOffsets[index]);
+		}
+		else if (sharedDescriptorBuffer.m_setLayouts[index].Get() != VK_NULL_HANDLE)
+		{
+			bufferIndices.emplace_back(1u);
+			setLayoutOffsets.emplace_back(sharedDescriptorBuffer.m_layoutOffsets[index]);
+		}
+
+	constexpr std::uint32_t firstSet = 0u;
+	const auto setCount              = static_cast<std::uint32_t>(std::size(setLayoutOffsets));
+
+	DescBuffer::vkCmdSetDescriptorBufferOffsetsEXT(
+		commandBuffer, bindPoint, pipelineLayout.Get(), firstSet, setCount,
+		std::data(bufferIndices), std::data(setLayoutOffsets)
+	);
+}
 }
@@ -73,20 +73,57 @@ VkDeviceManager& VkDeviceManager::SetPhysicalDeviceAutomatic(VkInstance instance
 	return *this;
 }
 
+VkDeviceManager& VkDeviceManager::AddOptionalExtensions(
+	const std::vector<DeviceExtension>& extensions
+) {
+	// New managers, so the checks don't affect the extensions and features which are required.
+	VkDeviceExtensionManager optionalExtensionManager{};
+	optionalExtensionManager.AddExtensions(extensions);
+
+	if (!AreExtensionsSupported(m_physicalDevice, optionalExtensionManager.GetExtensionNames()))
+		return *this;
+
+	VkFeatureManager optionalFeatureManager{};
+
+	for (DeviceExtension extension : extensions)
+		optionalFeatureManager.SetExtensionFeatures(extension);
+
+	if (!optionalFeatureManager.CheckFeatureSupport(m_physicalDevice))
+		return *this;
+
+	m_extensionManager.AddExtensions(extensions);
+
+	for (DeviceExtension extension : extensions)
+		m_featureManager.SetExtensionFeatures(extension);
+
+	return *this;
+}
+
 VkDeviceManager& VkDeviceManager::SetPhysicalDevice(
 	VkPhysicalDevice device, VkSurfaceKHR surface
 ) {
-	if (!CheckExtensionAndFeatures(device) || !CheckSurfaceSupport(device, surface))
+	if (!CheckDeviceExtensionSupport(device) || !DoesDeviceSupportFeatures(device)
+		|| !CheckSurfaceSupport(device, surface))
 		throw Exception("Feature Error", "No GPU with all of the feature-support found.");
 
+	if (!DoesDeviceSupportLimits(device))
+		throw Exception(
+			"Feature Error", "The GPU can't bind multiple resource descriptor buffers."
+		);
+
 	return *this;
 }
 
 VkDeviceManager& VkDeviceManager::SetPhysicalDevice(VkPhysicalDevice device)
 {
-	if (!CheckExtensionAndFeatures(device))
+	if (!CheckDeviceExtensionSupport(device) || !DoesDeviceSupportFeatures(device))
 		throw Exception("Feature Error", "No GPU with all of the feature-support found.");
 
+	if (!DoesDeviceSupportLimits(device))
+		throw Exception(
+			"Feature Error", "The GPU can't bind multiple resource descriptor buffers."
+		);
+
 	return *this;
 }
 
@@ -157,6 +194,12 @@ bool VkDeviceManager::CheckDeviceType(
 
 bool VkDeviceManager::CheckDeviceExtensionSupport(VkPhysicalDevice device) const noexcept
 {
+	return AreExtensionsSupported(device, m_extensionManager.GetExtensionNames());
+}
+
+bool VkDeviceManager::AreExtensionsSupported(
+	VkPhysicalDevice device, const std::vector<const char*>& extensionNames
+) noexcept {
 	std::uint32_t extensionCount = 0;
 	vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
 
@@ -165,7 +208,7 @@ bool VkDeviceManager::CheckDeviceExtensionSupport(VkPhysicalDevice device) const
 		device, nullptr, &extensionCount, std::data(availableExtensions)
 	);
 
-	for (const char* requiredExtension : m_extensionManager.GetExtensionNames())
+	for (const char* requiredExtension : extensionNames)
 	{
 		bool found = false;
 		for (const VkExtensionProperties& extension : availableExtensions)
@@ -184,7 +227,8 @@ bool VkDeviceManager::CheckDeviceExtensionSupport(VkPhysicalDevice device) const
 
 bool VkDeviceManager::CheckExtensionAndFeatures(VkPhysicalDevice device) const noexcept
 {
-	return CheckDeviceExtensionSupport(device) && DoesDeviceSupportFeatures(device);
+	return CheckDeviceExtensionSupport(device) && DoesDeviceSupportFeatures(device)
+		&& DoesDeviceSupportLimits(device);
 }
 
 bool VkDeviceManager::CheckSurfaceSupport(
@@ -199,6 +243,27 @@ bool VkDeviceManager::DoesDeviceSupportFeatures(VkPhysicalDevice device) const n
 	return m_featureManager.CheckFeatureSupport(device);
 }
 
+bool VkDeviceManager::DoesDeviceSupportLimits(VkPhysicalDevice device) const noexcept
+{
+	if (!m_extensionManager.IsExtensionActive(DeviceExtension::VkExtDescriptorBuffer))
+		return true;
+
+	// The descriptor buffer of a frame and the shared one are bound together, but the spec
+	// only guarantees a single resource descriptor buffer binding.
+	VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptorBufferProperties{
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT
+	};
+
+	VkPhysicalDeviceProperties2 deviceProperties2{
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+		.pNext = &descriptorBufferProperties
+	};
+
+	vkGetPhysicalDeviceProperties2(device, &deviceProperties2);
+
+	return descriptorBufferProperties.maxResourceDescriptorBufferBindings > 1u;
+}
+
 VkPhysicalDevice VkDeviceManager::SelectPhysicalDeviceAutomatic(
 	const std::vector<VkPhysicalDevice>& devices, VkSurfaceKHR surface
 ) {
@@ -215,14 +280,15 @@ VkPhysicalDevice VkDeviceManager::SelectPhysicalDeviceAutomatic(
 		return VK_NULL_HANDLE;
 	};
 
-	VkPhysicalDevice suitableDevice = GetSuitableDevice(
-		devices, surface, VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU
-	);
+	VkPhysicalDevice suitableDevice = VK_NULL_HANDLE;
 
-	if (suitableDevice == VK_NULL_HANDLE)
-		suitableDevice = GetSuitableDevice(
-			devices, surface, VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU
-		);
+	for (VkPhysicalDeviceType deviceType : s_devicePreferenceOrder)
+	{
+		suitableDevice = GetSuitableDevice(devices, surface, deviceType);
+
+		if (suitableDevice != VK_NULL_HANDLE)
+			break;
+	}
 
 	return suitableDevice;
 }
@@ -242,14 +308,15 @@ VkPhysicalDevice VkDeviceManager::SelectPhysicalDeviceAutomatic(
 		return VK_NULL_HANDLE;
 	};
 
-	VkPhysicalDevice suitableDevice = GetSuitableDevice(
-		devices, VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU
-	);
+	VkPhysicalDevice suitableDevice = VK_NULL_HANDLE;
 
-	if (suitableDevice == VK_NULL_HANDLE)
-		suitableDevice = GetSuitableDevice(
-			devices, VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU
-		);
+	for (VkPhysicalDeviceType deviceType : s_devicePreferenceOrder)
+	{
+		suitableDevice = GetSuitableDevice(devices, deviceType);
+
+		if (suitableDevice != VK_NULL_HANDLE)
+			break;
+	}
 
 	return suitableDevice;
 }
@@ -10,7 +10,9 @@ static std::array deviceExtensionNameMap
 	"VK_EXT_mesh_shader",
 	"VK_KHR_swapchain",
 	"VK_EXT_memory_budget",
-	"VK_EXT_descriptor_buffer"
+	"VK_EXT_descriptor_buffer",
+	"VK_KHR_pipeline_library",
+	"VK_EXT_graphics_pipeline_library"
 };
 
 void VkDeviceExtensionManager::PopulateExtensionFunctions(VkDevice device) const noexcept
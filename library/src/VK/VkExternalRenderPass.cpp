@@ -361,6 +361,18 @@ void VkExternalRenderPass::StartPass(
 	m_renderPassManager.StartPass(graphicsCmdBuffer, renderArea);
 }
 
+void VkExternalRenderPass::StartPassToResume(
+	const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea
+) const noexcept {
+	m_renderPassManager.StartPassToResume(graphicsCmdBuffer, renderArea);
+}
+
+void VkExternalRenderPass::ResumePass(
+	const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea
+) const noexcept {
+	m_renderPassManager.ResumePass(graphicsCmdBuffer, renderArea);
+}
+
 void VkExternalRenderPass::EndPass(const VKCommandBuffer& graphicsCmdBuffer) const noexcept
 {
 	m_renderPassManager.EndPass(graphicsCmdBuffer);
@@ -111,16 +111,26 @@ void VkExternalResourceManager::UpdateDescriptor(
 }
 
 void VkExternalResourceManager::UploadExternalBufferGPUOnlyData(
-	StagingBufferManager& stagingBufferManager, Callisto::TemporaryDataBufferGPU& tempGPUBuffer,
-	std::uint32_t externalBufferIndex, std::shared_ptr<void> cpuData, size_t srcDataSizeInBytes,
-	size_t dstBufferOffset
+	StagingBufferManager& stagingBufferManager, std::uint32_t externalBufferIndex,
+	std::shared_ptr<void> cpuData, size_t srcDataSizeInBytes, size_t dstBufferOffset
 ) const {
 	stagingBufferManager.AddBuffer(
 		std::move(cpuData),
 		static_cast<VkDeviceSize>(srcDataSizeInBytes),
 		&m_resourceFactory.GetVkBuffer(static_cast<size_t>(externalBufferIndex)),
-		static_cast<VkDeviceSize>(dstBufferOffset),
-		tempGPUBuffer
+		static_cast<VkDeviceSize>(dstBufferOffset)
+	);
+}
+
+std::uint64_t VkExternalResourceManager::StreamExternalBufferGPUOnlyData(
+	StagingBufferManager& stagingBufferManager, std::uint32_t externalBufferIndex,
+	std::shared_ptr<void> cpuData, size_t srcDataSizeInBytes, size_t dstBufferOffset
+) const {
+	return stagingBufferManager.StreamBuffer(
+		std::move(cpuData),
+		static_cast<VkDeviceSize>(srcDataSizeInBytes),
+		&m_resourceFactory.GetVkBuffer(static_cast<size_t>(externalBufferIndex)),
+		static_cast<VkDeviceSize>(dstBufferOffset)
 	);
 }
 
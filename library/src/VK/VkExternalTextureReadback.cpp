@@ -0,0 +1,101 @@
+#include <VkExternalTextureReadback.hpp>
+#include <VkResourceBarriers2.hpp>
+
+namespace Terra
+{
+std::uint32_t ExternalTextureReadback::AddTexture(std::uint32_t externalTextureIndex)
+{
+	std::vector<Buffer> frameBuffers{};
+
+	for (std::uint32_t _ = 0u; _ < m_frameCount; ++_)
+		frameBuffers.emplace_back(m_device, m_memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	return static_cast<std::uint32_t>(
+		m_readbackDetails.Add(
+			ReadbackDetails{
+				.externalTextureIndex = externalTextureIndex,
+				.frameBuffers         = std::move(frameBuffers)
+			}
+		)
+	);
+}
+
+void ExternalTextureReadback::RemoveTexture(std::uint32_t readbackIndex) noexcept
+{
+	m_readbackDetails[readbackIndex].frameBuffers.clear();
+	m_readbackDetails.RemoveElement(readbackIndex);
+}
+
+void ExternalTextureReadback::RecordCopies(
+	size_t frameIndex, const VKCommandBuffer& graphicsCmdBuffer,
+	const VkExternalResourceFactory& resourceFactory
+) {
+	const size_t readbackCount = std::size(m_readbackDetails);
+
+	for (size_t index = 0u; index < readbackCount; ++index)
+	{
+		if (!m_readbackDetails.IsInUse(index))
+			continue;
+
+		ReadbackDetails& readbackDetails = m_readbackDetails[index];
+
+		VkExternalTexture const* externalTexture = resourceFactory.GetExternalTextureRP(
+			readbackDetails.externalTextureIndex
+		);
+
+		// The texture hasn't been used in a render pass yet, so there is nothing to copy.
+		if (externalTexture->GetCurrentLayoutState() == VK_IMAGE_LAYOUT_UNDEFINED)
+			continue;
+
+		RecordCopy(graphicsCmdBuffer, *externalTexture, readbackDetails.frameBuffers[frameIndex]);
+	}
+}
+
+void ExternalTextureReadback::RecordCopy(
+	const VKCommandBuffer& graphicsCmdBuffer, const VkExternalTexture& externalTexture,
+	Buffer& dstBuffer
+) {
+	const VkTextureView& textureView = externalTexture.GetTextureView();
+
+	const VkDeviceSize textureSize   = textureView.GetTexture().GetBufferSize();
+
+	// The texture might have been recreated with a different size after a resize.
+	if (dstBuffer.BufferSize() != textureSize)
+		dstBuffer.Create(textureSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, {});
+
+	// The state of an External texture is the state it was last transitioned to by a render
+	// pass, which should be its state at the end of a frame. So, transition it back to that
+	// after the copy.
+	const VkImageLayout currentLayout          = externalTexture.GetCurrentLayoutState();
+	const VkAccessFlagBits currentAccess       = externalTexture.GetCurrentAccessState();
+	const VkPipelineStageFlagBits currentStage = externalTexture.GetCurrentPipelineStage();
+
+	VkCommandBuffer cmdBuffer = graphicsCmdBuffer.Get();
+
+	VkImageBarrier2<>{}.AddMemoryBarrier(
+		ImageBarrierBuilder{}
+		.Image(textureView)
+		.StageMasks(currentStage, VK_PIPELINE_STAGE_2_TRANSFER_BIT)
+		.AccessMasks(currentAccess, VK_ACCESS_2_TRANSFER_READ_BIT)
+		.Layouts(currentLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
+	).RecordBarriers(cmdBuffer);
+
+	graphicsCmdBuffer.CopyWhole(textureView, dstBuffer);
+
+	VkImageBarrier2<>{}.AddMemoryBarrier(
+		ImageBarrierBuilder{}
+		.Image(textureView)
+		.StageMasks(VK_PIPELINE_STAGE_2_TRANSFER_BIT, currentStage)
+		.AccessMasks(VK_ACCESS_2_TRANSFER_READ_BIT, currentAccess)
+		.Layouts(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, currentLayout)
+	).RecordBarriers(cmdBuffer);
+
+	// Make the copied data visible to the host, once the fence of the frame is signalled.
+	VkBufferBarrier2<>{}.AddMemoryBarrier(
+		BufferBarrierBuilder{}
+		.Buffer(dstBuffer)
+		.StageMasks(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_PIPELINE_STAGE_2_HOST_BIT)
+		.AccessMasks(VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_2_HOST_READ_BIT)
+	).RecordBarriers(cmdBuffer);
+}
+}
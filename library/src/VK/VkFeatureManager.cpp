@@ -35,6 +35,9 @@ void VkFeatureManager::SetExtensionFeatures(DeviceExtension extension) noexcept
 
 	if (DeviceExtension::VkExtDescriptorBuffer == extension)
 		SetVkExtDescriptorBufferFeatures();
+
+	if (DeviceExtension::VkExtGraphicsPipelineLibrary == extension)
+		SetVkExtGraphicsPipelineLibraryFeatures();
 }
 
 void VkFeatureManager::SetBaseCoreFeatures() noexcept
@@ -117,6 +120,11 @@ void VkFeatureManager::Set1_2CoreFeatures() noexcept
 			core1_2Type, offsetof(VkPhysicalDeviceVulkan12Features, descriptorBindingPartiallyBound),
 			v1_2Features
 		);
+		AddMember(
+			core1_2Type,
+			offsetof(VkPhysicalDeviceVulkan12Features, descriptorBindingVariableDescriptorCount),
+			v1_2Features
+		);
 		AddMember(
 			core1_2Type, offsetof(VkPhysicalDeviceVulkan12Features, runtimeDescriptorArray), v1_2Features
 		);
@@ -126,6 +134,9 @@ void VkFeatureManager::Set1_2CoreFeatures() noexcept
 		AddMember(
 			core1_2Type, offsetof(VkPhysicalDeviceVulkan12Features, timelineSemaphore), v1_2Features
 		);
+		AddMember(
+			core1_2Type, offsetof(VkPhysicalDeviceVulkan12Features, hostQueryReset), v1_2Features
+		);
 
 		m_chainStructMembers.emplace_back(std::move(core1_2Type));
 	}
@@ -205,6 +216,31 @@ void VkFeatureManager::SetVkExtDescriptorBufferFeatures() noexcept
 	m_deviceFeatures2.AddToChain(std::move(pVkExtDescriptorBufferFeatures));
 }
 
+void VkFeatureManager::SetVkExtGraphicsPipelineLibraryFeatures() noexcept
+{
+	auto pVkExtGraphicsPipelineLibraryFeatures
+		= std::make_shared<VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>();
+	VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT& vkExtGraphicsPipelineLibraryFeatures
+		= *pVkExtGraphicsPipelineLibraryFeatures;
+
+	vkExtGraphicsPipelineLibraryFeatures.sType
+		= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+	{
+		MembersType graphicsPipelineLibraryType{};
+
+		AddMember(
+			graphicsPipelineLibraryType,
+			offsetof(VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT, graphicsPipelineLibrary),
+			vkExtGraphicsPipelineLibraryFeatures
+		);
+
+		m_chainStructMembers.emplace_back(std::move(graphicsPipelineLibraryType));
+	}
+
+	m_deviceFeatures2.AddToChain(std::move(pVkExtGraphicsPipelineLibraryFeatures));
+}
+
 bool VkFeatureManager::CheckFeatureSupport(VkPhysicalDevice device) const noexcept
 {
 	// This needs to be a new object, since it will be overwritten by the query.
@@ -238,6 +274,13 @@ bool VkFeatureManager::CheckFeatureSupportRecursive(
 			result        &= CheckMembers(chainMembers[memberIndex], *structObj);
 			break;
 		}
+		case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT:
+		{
+			auto structObj
+				= reinterpret_cast<VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT*>(structPtr);
+			result        &= CheckMembers(chainMembers[memberIndex], *structObj);
+			break;
+		}
 		case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT:
 		{
 			auto structObj = reinterpret_cast<VkPhysicalDeviceMeshShaderFeaturesEXT*>(structPtr);
@@ -0,0 +1,268 @@
+#include <VkGpuProfiler.hpp>
+#include <algorithm>
+
+namespace Terra
+{
+GpuProfiler::GpuProfiler(VkDevice device)
+	: m_device{ device }, m_queryPools{}, m_frameScopes{}, m_queryResults{}, m_timings{},
+	m_timestampMasks{}, m_timestampPeriod{ 1.0 }, m_trace{}, m_oTraceStartTimestamp{},
+	m_isCapturingTrace{ false }, m_isEnabled{ false }
+{}
+
+GpuProfiler::~GpuProfiler() noexcept
+{
+	SelfDestruct();
+}
+
+void GpuProfiler::SelfDestruct() noexcept
+{
+	for (VkQueryPool queryPool : m_queryPools)
+		vkDestroyQueryPool(m_device, queryPool, nullptr);
+
+	m_queryPools.clear();
+}
+
+void GpuProfiler::Create(
+	VkPhysicalDevice physicalDevice, const VkQueueFamilyMananger& queueFamilyManager,
+	size_t frameCount
+) {
+	VkPhysicalDeviceProperties properties{};
+
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	m_timestampPeriod = static_cast<double>(properties.limits.timestampPeriod);
+
+	std::uint32_t queueFamilyCount = 0u;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+
+	std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(
+		physicalDevice, &queueFamilyCount, std::data(queueFamilyProperties)
+	);
+
+	for (QueueType queueType : { TransferQueue, ComputeQueue, GraphicsQueue })
+	{
+		const std::uint32_t validBits
+			= queueFamilyProperties[queueFamilyManager.GetIndex(queueType)].timestampValidBits;
+
+		m_timestampMasks[GetQueueSlot(queueType)] = validBits >= 64u ?
+			std::numeric_limits<std::uint64_t>::max() : (std::uint64_t{ 1u } << validBits) - 1u;
+	}
+
+	constexpr std::uint32_t queryCount = s_maxScopeCount * 2u;
+
+	VkQueryPoolCreateInfo createInfo{
+		.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+		.queryType  = VK_QUERY_TYPE_TIMESTAMP,
+		.queryCount = queryCount
+	};
+
+	for (size_t index = 0u; index < frameCount; ++index)
+	{
+		VkQueryPool queryPool = VK_NULL_HANDLE;
+
+		vkCreateQueryPool(m_device, &createInfo, nullptr, &queryPool);
+
+		// The queries must be reset before their first use.
+		vkResetQueryPool(m_device, queryPool, 0u, queryCount);
+
+		m_queryPools.emplace_back(queryPool);
+		m_frameScopes.emplace_back().reserve(s_maxScopeCount);
+	}
+
+	// Each query has its value and its availability.
+	m_queryResults.resize(static_cast<size_t>(queryCount) * 2u, 0u);
+}
+
+void GpuProfiler::SetEnabled(bool value) noexcept
+{
+	m_isEnabled = value;
+
+	if (!m_isEnabled)
+		m_timings.clear();
+}
+
+std::optional<std::uint32_t> GpuProfiler::BeginScope(
+	const VKCommandBuffer& cmdBuffer, size_t frameIndex, QueueType queueType,
+	std::string_view name, std::uint32_t nameIndex /* = s_noNameIndex */
+) {
+	std::optional<std::uint32_t> oScopeIndex{};
+
+	if (!m_isEnabled || frameIndex >= std::size(m_frameScopes))
+		return oScopeIndex;
+
+	std::vector<Scope>& scopes = m_frameScopes[frameIndex];
+
+	if (std::size(scopes) >= s_maxScopeCount || m_timestampMasks[GetQueueSlot(queueType)] == 0u)
+		return oScopeIndex;
+
+	const auto scopeIndex          = static_cast<std::uint32_t>(std::size(scopes));
+	const std::uint32_t queryIndex = scopeIndex * 2u;
+
+	scopes.emplace_back(
+		Scope{
+			.name       = name,
+			.nameIndex  = nameIndex,
+			.queueType  = queueType,
+			.queryIndex = queryIndex
+		}
+	);
+
+	vkCmdWriteTimestamp2(
+		cmdBuffer.Get(), VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_queryPools[frameIndex],
+		queryIndex
+	);
+
+	oScopeIndex = scopeIndex;
+
+	return oScopeIndex;
+}
+
+void GpuProfiler::EndScope(
+	const VKCommandBuffer& cmdBuffer, size_t frameIndex, std::uint32_t scopeIndex
+) const noexcept {
+	const Scope& scope = m_frameScopes[frameIndex][scopeIndex];
+
+	vkCmdWriteTimestamp2(
+		cmdBuffer.Get(), VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_queryPools[frameIndex],
+		scope.queryIndex + 1u
+	);
+}
+
+void GpuProfiler::ResolveFrame(size_t frameIndex)
+{
+	if (frameIndex >= std::size(m_frameScopes))
+		return;
+
+	std::vector<Scope>& scopes = m_frameScopes[frameIndex];
+
+	if (std::empty(scopes))
+		return;
+
+	VkQueryPool queryPool = m_queryPools[frameIndex];
+	const auto queryCount = static_cast<std::uint32_t>(std::size(scopes) * 2u);
+
+	constexpr VkDeviceSize queryStride = sizeof(std::uint64_t) * 2u;
+
+	// Not waiting for the results, as the frame should have been finished. If a scope was
+	// recorded but never submitted, it won't be available and will be skipped.
+	vkGetQueryPoolResults(
+		m_device, queryPool, 0u, queryCount, queryCount * queryStride, std::data(m_queryResults),
+		queryStride, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+	);
+
+	auto isAvailable = [this](const Scope& scope) noexcept
+	{
+		const size_t resultIndex = static_cast<size_t>(scope.queryIndex) * 2u;
+
+		return m_queryResults[resultIndex + 1u] != 0u && m_queryResults[resultIndex + 3u] != 0u;
+	};
+
+	auto getTimestamp = [this](const Scope& scope, std::uint32_t queryOffset) noexcept
+	{
+		const size_t resultIndex = static_cast<size_t>(scope.queryIndex + queryOffset) * 2u;
+
+		return m_queryResults[resultIndex] & m_timestampMasks[GetQueueSlot(scope.queueType)];
+	};
+
+	std::uint64_t frameStartTimestamp = std::numeric_limits<std::uint64_t>::max();
+
+	for (const Scope& scope : scopes)
+		if (isAvailable(scope))
+			frameStartTimestamp = std::min(frameStartTimestamp, getTimestamp(scope, 0u));
+
+	m_timings.clear();
+
+	// The timestamp period is the nanoseconds per tick.
+	const double millisecondsPerTick = m_timestampPeriod / 1'000'000.0;
+
+	for (const Scope& scope : scopes)
+	{
+		if (!isAvailable(scope))
+			continue;
+
+		const std::uint64_t startTimestamp = getTimestamp(scope, 0u);
+		const std::uint64_t endTimestamp   = getTimestamp(scope, 1u);
+
+		const std::uint64_t durationTicks
+			= endTimestamp > startTimestamp ? endTimestamp - startTimestamp : 0u;
+
+		m_timings.emplace_back(
+			GpuScopeTiming{
+				.name                 = GetScopeName(scope),
+				.queueType            = scope.queueType,
+				.startMilliseconds    = static_cast<double>(
+					startTimestamp - frameStartTimestamp
+				) * millisecondsPerTick,
+				.durationMilliseconds = static_cast<double>(durationTicks) * millisecondsPerTick
+			}
+		);
+	}
+
+	if (m_isCapturingTrace && !std::empty(m_timings))
+		AddTraceEvents(frameStartTimestamp);
+
+	vkResetQueryPool(m_device, queryPool, 0u, queryCount);
+
+	scopes.clear();
+}
+
+std::string GpuProfiler::GetScopeName(const Scope& scope)
+{
+	std::string name{ scope.name };
+
+	if (scope.nameIndex != s_noNameIndex)
+	{
+		name += ' ';
+		name += std::to_string(scope.nameIndex);
+	}
+
+	return name;
+}
+
+void GpuProfiler::AddTraceEvents(std::uint64_t frameStartTimestamp)
+{
+	if (!m_oTraceStartTimestamp)
+		m_oTraceStartTimestamp = frameStartTimestamp;
+
+	const std::uint64_t traceStartTimestamp = m_oTraceStartTimestamp.value();
+
+	const double frameStartMicroseconds = frameStartTimestamp > traceStartTimestamp ?
+		static_cast<double>(frameStartTimestamp - traceStartTimestamp) * m_timestampPeriod
+		/ 1'000.0 : 0.0;
+
+	for (const GpuScopeTiming& timing : m_timings)
+		m_trace.AddEvent(
+			ChromeTrace::Event{
+				.name                 = timing.name,
+				.category             = "GPU",
+				.startMicroseconds    = frameStartMicroseconds + timing.startMilliseconds * 1'000.0,
+				.durationMicroseconds = timing.durationMilliseconds * 1'000.0,
+				.processID            = 0u,
+				.threadID             = static_cast<std::uint32_t>(GetQueueSlot(timing.queueType))
+			}
+		);
+}
+
+void GpuProfiler::StartTraceCapture()
+{
+	m_trace.Clear();
+
+	for (size_t index = 0u; index < std::size(s_queueNames); ++index)
+		m_trace.SetThreadName(0u, static_cast<std::uint32_t>(index), s_queueNames[index]);
+
+	m_oTraceStartTimestamp.reset();
+	m_isCapturingTrace = true;
+}
+
+bool GpuProfiler::SaveTraceCapture(const std::wstring& filePath)
+{
+	m_isCapturingTrace = false;
+
+	const bool saved = m_trace.SaveToFile(filePath);
+
+	m_trace.Clear();
+
+	return saved;
+}
+}
@@ -35,4 +35,14 @@ void ConfigurePipelineBuilder(
 			GetVkBlendState(graphicsExtPipeline.GetBlendState(index))
 		);
 }
+
+void CreateOrLinkGraphicsPipeline(
+	VkPipelineObject& pso, const GraphicsPipelineBuilder& builder, PipelineCache* pipelineCache,
+	GraphicsPipelineLibrary* pipelineLibrary, GraphicsPipelineLibrary::LinkType linkType
+) {
+	if (pipelineLibrary)
+		pipelineLibrary->LinkGraphicsPipeline(pso, builder, linkType, pipelineCache);
+	else
+		pso.CreateGraphicsPipeline(builder, pipelineCache);
+}
 }
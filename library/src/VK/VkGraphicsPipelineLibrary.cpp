@@ -0,0 +1,101 @@
+#include <VkGraphicsPipelineLibrary.hpp>
+#include <vector>
+
+namespace Terra
+{
+void GraphicsPipelineLibrary::LinkGraphicsPipeline(
+	VkPipelineObject& pipeline, const GraphicsPipelineBuilder& builder, LinkType linkType,
+	PipelineCache* pipelineCache
+) {
+	std::vector<std::shared_ptr<LibraryEntry>> libraryEntries{};
+	libraryEntries.reserve(std::size(s_libraryParts));
+
+	// The parts which are being compiled by the other threads are only waited for after the
+	// ones added by this thread have been compiled.
+	for (VkGraphicsPipelineLibraryFlagBitsEXT libraryPart : s_libraryParts)
+	{
+		// The Mesh Shader pipelines don't need the vertex input part.
+		if (libraryPart == VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT
+			&& !builder.HasVertexInput())
+			continue;
+
+		libraryEntries.emplace_back(GetOrCreateLibrary(builder, libraryPart, pipelineCache));
+	}
+
+	std::vector<VkPipeline> libraries{};
+	libraries.reserve(std::size(libraryEntries));
+
+	for (const std::shared_ptr<LibraryEntry>& libraryEntry : libraryEntries)
+	{
+		VkPipeline library = libraryEntry->handle.get();
+
+		if (library == VK_NULL_HANDLE)
+			return;
+
+		libraries.emplace_back(library);
+	}
+
+	pipeline.LinkGraphicsPipeline(
+		builder, libraries, linkType == LinkType::Optimised, pipelineCache
+	);
+}
+
+std::shared_ptr<GraphicsPipelineLibrary::LibraryEntry> GraphicsPipelineLibrary::GetOrCreateLibrary(
+	const GraphicsPipelineBuilder& builder, VkGraphicsPipelineLibraryFlagBitsEXT libraryPart,
+	PipelineCache* pipelineCache
+) {
+	const std::uint64_t libraryHash = builder.GetLibraryPartHash(libraryPart);
+
+	std::promise<VkPipeline> handlePromise{};
+	std::shared_ptr<LibraryEntry> libraryEntry{};
+
+	{
+		std::scoped_lock lock{ *m_mutex };
+
+		auto result = m_libraries.find(libraryHash);
+
+		if (result != std::end(m_libraries))
+			return result->second;
+
+		// Added before compiling, so the same part isn't compiled by multiple threads.
+		libraryEntry = std::make_shared<LibraryEntry>(
+			VkPipelineObject{ m_device }, handlePromise.get_future().share()
+		);
+
+		m_libraries.emplace(libraryHash, libraryEntry);
+	}
+
+	libraryEntry->library.CreateGraphicsPipelineLibrary(builder, libraryPart, pipelineCache);
+
+	VkPipeline libraryHandle = libraryEntry->library.Get();
+
+	// The failed ones aren't kept, so they would be compiled again.
+	if (libraryHandle == VK_NULL_HANDLE)
+	{
+		std::scoped_lock lock{ *m_mutex };
+
+		auto result = m_libraries.find(libraryHash);
+
+		if (result != std::end(m_libraries) && result->second == libraryEntry)
+			m_libraries.erase(result);
+	}
+
+	handlePromise.set_value(libraryHandle);
+
+	return libraryEntry;
+}
+
+void GraphicsPipelineLibrary::Clear() noexcept
+{
+	std::scoped_lock lock{ *m_mutex };
+
+	m_libraries.clear();
+}
+
+size_t GraphicsPipelineLibrary::GetLibraryCount() const noexcept
+{
+	std::scoped_lock lock{ *m_mutex };
+
+	return std::size(m_libraries);
+}
+}
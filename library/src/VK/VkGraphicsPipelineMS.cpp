@@ -1,39 +1,36 @@
 #include <VkGraphicsPipelineMS.hpp>
-#include <VkShader.hpp>
 
 namespace Terra
 {
 std::unique_ptr<VkPipelineObject> GraphicsPipelineMS::_createGraphicsPipeline(
 	VkDevice device, VkPipelineLayout graphicsLayout,
-	const std::wstring& shaderPath, const ExternalGraphicsPipeline& graphicsExtPipeline
+	ShaderModuleCache& shaderCache, const ExternalGraphicsPipeline& graphicsExtPipeline,
+	PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary,
+	GraphicsPipelineLibrary::LinkType linkType
 ) const {
 	constexpr const wchar_t* cullingTaskShaderName   = L"MeshShaderTSIndividual";
 	constexpr const wchar_t* noCullingTaskShaderName = L"MeshShaderTSIndividualNoCulling";
 
 	return CreateGraphicsPipelineMS(
-		device, graphicsLayout, s_shaderBytecodeType, shaderPath, graphicsExtPipeline,
-		graphicsExtPipeline.IsGPUCullingEnabled() ? cullingTaskShaderName : noCullingTaskShaderName
+		device, graphicsLayout, s_shaderBytecodeType, shaderCache, graphicsExtPipeline,
+		graphicsExtPipeline.IsGPUCullingEnabled() ? cullingTaskShaderName : noCullingTaskShaderName,
+		pipelineCache, pipelineLibrary, linkType
 	);
 }
 
 std::unique_ptr<VkPipelineObject> GraphicsPipelineMS::CreateGraphicsPipelineMS(
 	VkDevice device, VkPipelineLayout graphicsLayout,
-	ShaderBinaryType binaryType, const std::wstring& shaderPath,
-	const ExternalGraphicsPipeline& graphicsExtPipeline, const ShaderName& taskShader
+	ShaderBinaryType binaryType, ShaderModuleCache& shaderCache,
+	const ExternalGraphicsPipeline& graphicsExtPipeline, const ShaderName& taskShader,
+	PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary,
+	GraphicsPipelineLibrary::LinkType linkType
 ) {
-	auto ms              = std::make_unique<VkShader>(device);
-	const bool msSuccess = ms->Create(
-		shaderPath + graphicsExtPipeline.GetVertexShader().GetNameWithExtension(binaryType)
+	VkShaderModule ms = shaderCache.GetShaderModule(
+		graphicsExtPipeline.GetVertexShader(), binaryType
 	);
-
-	auto ts              = std::make_unique<VkShader>(device);
-	const bool tsSuccess = ts->Create(
-		shaderPath + taskShader.GetNameWithExtension(binaryType)
-	);
-
-	auto fs              = std::make_unique<VkShader>(device);
-	const bool fsSuccess = fs->Create(
-		shaderPath + graphicsExtPipeline.GetFragmentShader().GetNameWithExtension(binaryType)
+	VkShaderModule ts = shaderCache.GetShaderModule(taskShader, binaryType);
+	VkShaderModule fs = shaderCache.GetShaderModule(
+		graphicsExtPipeline.GetFragmentShader(), binaryType
 	);
 
 	GraphicsPipelineBuilder builder{ graphicsLayout };
@@ -42,11 +39,11 @@ std::unique_ptr<VkPipelineObject> GraphicsPipelineMS::CreateGraphicsPipelineMS(
 
 	auto pso = std::make_unique<VkPipelineObject>(device);
 
-	if (msSuccess && fsSuccess && tsSuccess)
+	if (ms != VK_NULL_HANDLE && fs != VK_NULL_HANDLE && ts != VK_NULL_HANDLE)
 	{
-		builder.SetTaskStage(ts->Get()).SetMeshStage(ms->Get(), fs->Get());
+		builder.SetTaskStage(ts).SetMeshStage(ms, fs);
 
-		pso->CreateGraphicsPipeline(builder);
+		CreateOrLinkGraphicsPipeline(*pso, builder, pipelineCache, pipelineLibrary, linkType);
 	}
 
 	return pso;
@@ -1,22 +1,19 @@
 #include <VkGraphicsPipelineVS.hpp>
-#include <VkShader.hpp>
 
 namespace Terra
 {
 // Vertex Shader
 static std::unique_ptr<VkPipelineObject> CreateGraphicsPipelineVS(
 	VkDevice device, VkPipelineLayout graphicsLayout,
-	ShaderBinaryType binaryType, const std::wstring& shaderPath,
-	const ExternalGraphicsPipeline& graphicsExtPipeline
+	ShaderBinaryType binaryType, ShaderModuleCache& shaderCache,
+	const ExternalGraphicsPipeline& graphicsExtPipeline, PipelineCache* pipelineCache,
+	GraphicsPipelineLibrary* pipelineLibrary, GraphicsPipelineLibrary::LinkType linkType
 ) {
-	auto vs              = std::make_unique<VkShader>(device);
-	const bool vsSuccess = vs->Create(
-		shaderPath + graphicsExtPipeline.GetVertexShader().GetNameWithExtension(binaryType)
+	VkShaderModule vs = shaderCache.GetShaderModule(
+		graphicsExtPipeline.GetVertexShader(), binaryType
 	);
-
-	auto fs              = std::make_unique<VkShader>(device);
-	const bool fsSuccess = fs->Create(
-		shaderPath + graphicsExtPipeline.GetFragmentShader().GetNameWithExtension(binaryType)
+	VkShaderModule fs = shaderCache.GetShaderModule(
+		graphicsExtPipeline.GetFragmentShader(), binaryType
 	);
 
 	GraphicsPipelineBuilder builder{ graphicsLayout };
@@ -33,11 +30,11 @@ static std::unique_ptr<VkPipelineObject> CreateGraphicsPipelineVS(
 
 	auto pso = std::make_unique<VkPipelineObject>(device);
 
-	if (vsSuccess && fsSuccess)
+	if (vs != VK_NULL_HANDLE && fs != VK_NULL_HANDLE)
 	{
-		builder.SetVertexStage(vs->Get(), fs->Get());
+		builder.SetVertexStage(vs, fs);
 
-		pso->CreateGraphicsPipeline(builder);
+		CreateOrLinkGraphicsPipeline(*pso, builder, pipelineCache, pipelineLibrary, linkType);
 	}
 
 	return pso;
@@ -46,20 +43,26 @@ static std::unique_ptr<VkPipelineObject> CreateGraphicsPipelineVS(
 // Indirect Draw
 std::unique_ptr<VkPipelineObject> GraphicsPipelineVSIndirectDraw::_createGraphicsPipeline(
 	VkDevice device, VkPipelineLayout graphicsLayout,
-	const std::wstring& shaderPath, const ExternalGraphicsPipeline& graphicsExtPipeline
+	ShaderModuleCache& shaderCache, const ExternalGraphicsPipeline& graphicsExtPipeline,
+	PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary,
+	GraphicsPipelineLibrary::LinkType linkType
 ) const {
 	return CreateGraphicsPipelineVS(
-		device, graphicsLayout, s_shaderBytecodeType, shaderPath, graphicsExtPipeline
+		device, graphicsLayout, s_shaderBytecodeType, shaderCache, graphicsExtPipeline,
+		pipelineCache, pipelineLibrary, linkType
 	);
 }
 
 // Individual Draw
 std::unique_ptr<VkPipelineObject> GraphicsPipelineVSIndividualDraw::_createGraphicsPipeline(
 	VkDevice device, VkPipelineLayout graphicsLayout,
-	const std::wstring& shaderPath, const ExternalGraphicsPipeline& graphicsExtPipeline
+	ShaderModuleCache& shaderCache, const ExternalGraphicsPipeline& graphicsExtPipeline,
+	PipelineCache* pipelineCache, GraphicsPipelineLibrary* pipelineLibrary,
+	GraphicsPipelineLibrary::LinkType linkType
 ) const {
 	return CreateGraphicsPipelineVS(
-		device, graphicsLayout, s_shaderBytecodeType, shaderPath, graphicsExtPipeline
+		device, graphicsLayout, s_shaderBytecodeType, shaderCache, graphicsExtPipeline,
+		pipelineCache, pipelineLibrary, linkType
 	);
 }
 }
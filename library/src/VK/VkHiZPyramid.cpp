@@ -0,0 +1,237 @@
+#include <VkHiZPyramid.hpp>
+#include <algorithm>
+#include <bit>
+#include <VkResourceBarriers2.hpp>
+
+namespace Terra
+{
+HiZPyramid::HiZPyramid(VkDevice device, MemoryManager* memoryManager)
+	: m_device{ device }, m_memoryManager{ memoryManager },
+	m_pyramid{ device, memoryManager, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT }, m_mipViews{},
+	m_sampler{ device }, m_descriptorBuffer{ device, memoryManager, s_setLayoutCount },
+	m_pipelineLayout{ device }, m_pipelineManager{ device }, m_depthTexture{ nullptr },
+	m_psoIndex{ 0u }
+{
+	m_descriptorBuffer.AddBinding(
+		s_depthBindingSlot, s_setLayoutIndex, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1u,
+		VK_SHADER_STAGE_COMPUTE_BIT
+	);
+	m_descriptorBuffer.AddBinding(
+		s_mipViewsBindingSlot, s_setLayoutIndex, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+		s_maxMipLevelCount, VK_SHADER_STAGE_COMPUTE_BIT
+	);
+
+	// The depth is read with the texel coordinates and the culling shader picks the mip level
+	// itself, so there shouldn't be any filtering.
+	m_sampler.Create(
+		VkSamplerCreateInfoBuilder{}
+		.MinFilter(VK_FILTER_NEAREST)
+		.MagFilter(VK_FILTER_NEAREST)
+		.MipmapMode(VK_SAMPLER_MIPMAP_MODE_NEAREST)
+		.AddressU(VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE)
+		.AddressV(VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE)
+		.AddressW(VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE)
+		.MaxLOD(static_cast<float>(s_maxMipLevelCount))
+	);
+}
+
+void HiZPyramid::SetShaderPath(const std::wstring& shaderPath)
+{
+	m_pipelineManager.SetShaderPath(shaderPath);
+}
+
+void HiZPyramid::SetPipelineCache(PipelineCache* pipelineCache) noexcept
+{
+	m_pipelineManager.SetPipelineCache(pipelineCache);
+}
+
+void HiZPyramid::CreatePipeline()
+{
+	if (m_descriptorBuffer.IsCreated())
+		return;
+
+	m_descriptorBuffer.CreateBuffer();
+
+	m_pipelineLayout.AddPushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, GetConstantBufferSize());
+
+	m_pipelineLayout.Create(m_descriptorBuffer.GetValidLayouts());
+
+	m_pipelineManager.SetPipelineLayout(m_pipelineLayout.Get());
+
+	m_psoIndex = m_pipelineManager.AddOrGetComputePipeline(ShaderName{ L"HiZPyramidCS" });
+}
+
+std::uint32_t HiZPyramid::GetMipLevelCount(std::uint32_t width, std::uint32_t height) noexcept
+{
+	// The last mip should be 1x1.
+	const std::uint32_t mipLevelCount = std::bit_width(std::max(width, height));
+
+	return std::min(mipLevelCount, s_maxMipLevelCount);
+}
+
+void HiZPyramid::SetDepthTexture(
+	const VkTextureView& depthTexture, const std::vector<std::uint32_t>& queueFamilyIndices
+) {
+	const VkExtent3D depthExtent = depthTexture.GetTexture().GetExtent();
+
+	const std::uint32_t width         = std::max(depthExtent.width / 2u, 1u);
+	const std::uint32_t height        = std::max(depthExtent.height / 2u, 1u);
+	const std::uint32_t mipLevelCount = GetMipLevelCount(width, height);
+
+	Destroy();
+
+	m_pyramid.CreateView2D(
+		width, height, s_pyramidFormat,
+		VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_ASPECT_COLOR_BIT,
+		VK_IMAGE_VIEW_TYPE_2D, queueFamilyIndices, 0u, mipLevelCount
+	);
+
+	m_mipViews.reserve(mipLevelCount);
+
+	for (std::uint32_t mipLevel = 0u; mipLevel < mipLevelCount; ++mipLevel)
+	{
+		VKImageView& mipView = m_mipViews.emplace_back(m_device);
+
+		mipView.CreateView(
+			m_pyramid.GetTexture().Get(), s_pyramidFormat, VK_IMAGE_ASPECT_COLOR_BIT,
+			VK_IMAGE_VIEW_TYPE_2D, mipLevel, 1u
+		);
+
+		m_descriptorBuffer.SetStorageImageDescriptor(
+			mipView, VK_IMAGE_LAYOUT_GENERAL, s_mipViewsBindingSlot, s_setLayoutIndex, mipLevel
+		);
+	}
+
+	m_descriptorBuffer.SetCombinedImageDescriptor(
+		depthTexture, m_sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, s_depthBindingSlot,
+		s_setLayoutIndex, 0u
+	);
+
+	m_depthTexture = &depthTexture;
+}
+
+void HiZPyramid::Destroy() noexcept
+{
+	m_mipViews.clear();
+	m_pyramid.Destroy();
+
+	m_depthTexture = nullptr;
+}
+
+void HiZPyramid::Build(const VKCommandBuffer& graphicsCmdBuffer) const noexcept
+{
+	VkCommandBuffer cmdBuffer = graphicsCmdBuffer.Get();
+
+	// The old content of the pyramid isn't needed. But it might still be read by the culling of
+	// the last frame, which the indirect draws of the last frame had waited for.
+	VkImageBarrier2<2u>{}
+	.AddMemoryBarrier(
+		ImageBarrierBuilder{}
+		.Image(*m_depthTexture)
+		.Layouts(
+			VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+		)
+		.AccessMasks(
+			VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT
+		)
+		.StageMasks(
+			VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT
+			| VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+			VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+		)
+	).AddMemoryBarrier(
+		ImageBarrierBuilder{}
+		.Image(m_pyramid)
+		.Layouts(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL)
+		.AccessMasks(VK_ACCESS_2_NONE, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT)
+		.StageMasks(
+			VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+		)
+	).RecordBarriers(cmdBuffer);
+
+	VkDescriptorBuffer::BindDescriptorBuffer(
+		m_descriptorBuffer, graphicsCmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout
+	);
+
+	m_pipelineManager.BindPipeline(m_psoIndex, graphicsCmdBuffer);
+
+	const VkExtent3D pyramidExtent = m_pyramid.GetTexture().GetExtent();
+	const auto mipLevelCount       = static_cast<std::uint32_t>(std::size(m_mipViews));
+
+	for (std::uint32_t mipLevel = 0u; mipLevel < mipLevelCount; ++mipLevel)
+	{
+		const ConstantData constantData
+		{
+			.mipLevel  = mipLevel,
+			.mipWidth  = std::max(pyramidExtent.width >> mipLevel, 1u),
+			.mipHeight = std::max(pyramidExtent.height >> mipLevel, 1u)
+		};
+
+		vkCmdPushConstants(
+			cmdBuffer, m_pipelineLayout.Get(), VK_SHADER_STAGE_COMPUTE_BIT, 0u,
+			GetConstantBufferSize(), &constantData
+		);
+
+		vkCmdDispatch(
+			cmdBuffer,
+			(constantData.mipWidth + s_threadGroupSize - 1u) / s_threadGroupSize,
+			(constantData.mipHeight + s_threadGroupSize - 1u) / s_threadGroupSize, 1u
+		);
+
+		// The next mip is reduced from this one. The last one is read by the culling shader on
+		// the Compute queue, which waits for the whole submission.
+		if (mipLevel + 1u < mipLevelCount)
+			VkImageBarrier2{}.AddMemoryBarrier(
+				ImageBarrierBuilder{}
+				.Image(m_mipViews[mipLevel])
+				.Layouts(VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL)
+				.AccessMasks(
+					VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+				)
+				.StageMasks(
+					VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+				)
+			).RecordBarriers(cmdBuffer);
+	}
+
+	// The depth should be back in the attachment layout for the second part of the passes.
+	VkImageBarrier2{}.AddMemoryBarrier(
+		ImageBarrierBuilder{}
+		.Image(*m_depthTexture)
+		.Layouts(
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL
+		)
+		.AccessMasks(
+			VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+			VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT
+			| VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+		)
+		.StageMasks(
+			VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT
+			| VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT
+		)
+	).RecordBarriers(cmdBuffer);
+}
+
+void HiZPyramid::SetDescriptorBufferLayout(
+	std::vector<VkDescriptorBuffer>& descriptorBuffers, std::uint32_t bindingSlot,
+	size_t setLayoutIndex, VkShaderStageFlags shaderStage
+) noexcept {
+	for (VkDescriptorBuffer& descriptorBuffer : descriptorBuffers)
+		descriptorBuffer.AddBinding(
+			bindingSlot, setLayoutIndex, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1u, shaderStage
+		);
+}
+
+void HiZPyramid::SetDescriptorBuffer(
+	std::vector<VkDescriptorBuffer>& descriptorBuffers, std::uint32_t bindingSlot,
+	size_t setLayoutIndex
+) const {
+	for (VkDescriptorBuffer& descriptorBuffer : descriptorBuffers)
+		descriptorBuffer.SetCombinedImageDescriptor(
+			m_pyramid, m_sampler, VK_IMAGE_LAYOUT_GENERAL, bindingSlot, setLayoutIndex, 0u
+		);
+}
+}
@@ -1,5 +1,4 @@
 #include <VkMeshBundleMS.hpp>
-#include <VectorToSharedPtr.hpp>
 
 namespace Terra
 {
@@ -33,12 +32,11 @@ void VkMeshBundleMS::_setMeshBundle(
 		sharedData   = sharedBuffer.AllocateAndGetSharedData(bufferSize, tempBuffer);
 		detailOffset = static_cast<std::uint32_t>(sharedData.offset / stride);
 
-		std::shared_ptr<std::uint8_t[]> tempDataBuffer = Callisto::CopyVectorToSharedPtr(elements);
-
-		stagingBufferMan.AddBuffer(
-			std::move(tempDataBuffer), bufferSize, sharedData.bufferData, sharedData.offset,
-			tempBuffer
+		std::span<std::uint8_t> stagingData = stagingBufferMan.AddBufferInPlace(
+			bufferSize, sharedData.bufferData, sharedData.offset
 		);
+
+		memcpy(std::data(stagingData), std::data(elements), bufferSize);
 	};
 
 	const std::vector<std::uint32_t>& vertexIndices   = meshBundle.indices;
@@ -97,11 +95,13 @@ void VkMeshBundleMS::SetMeshBundle(
 		perMeshBufferSize, tempBuffer
 	);
 
-	auto perMeshBufferData = std::make_shared<std::uint8_t[]>(perMeshBufferSize);
-
 	{
+		std::span<std::uint8_t> perMeshBufferData = stagingBufferMan.AddBufferInPlace(
+			perMeshBufferSize, m_perMeshSharedData.bufferData, m_perMeshSharedData.offset
+		);
+
 		size_t perMeshOffset             = 0u;
-		std::uint8_t* perMeshBufferStart = perMeshBufferData.get();
+		std::uint8_t* perMeshBufferStart = std::data(perMeshBufferData);
 
 		for (const MeshTemporaryDetailsMS& meshDetail : meshDetailsMS)
 		{
@@ -114,8 +114,6 @@ void VkMeshBundleMS::SetMeshBundle(
 	// Mesh Bundle Data
 	constexpr size_t perMeshBundleDataSize = sizeof(PerMeshBundleData);
 
-	auto perBundleData = std::make_shared<std::uint8_t[]>(perMeshBundleDataSize);
-
 	m_perMeshBundleSharedData = perMeshBundleSharedBuffer.AllocateAndGetSharedData(
 		perMeshBundleDataSize, tempBuffer
 	);
@@ -126,18 +124,13 @@ void VkMeshBundleMS::SetMeshBundle(
 			.meshOffset = static_cast<std::uint32_t>(m_perMeshSharedData.offset / perMeshStride)
 		};
 
-		memcpy(perBundleData.get(), &bundleData, perMeshBundleDataSize);
-	}
-
-	stagingBufferMan.AddBuffer(
-		std::move(perBundleData), perMeshBundleDataSize,
-		m_perMeshBundleSharedData.bufferData, m_perMeshBundleSharedData.offset, tempBuffer
-	);
+		std::span<std::uint8_t> perBundleData = stagingBufferMan.AddBufferInPlace(
+			perMeshBundleDataSize, m_perMeshBundleSharedData.bufferData,
+			m_perMeshBundleSharedData.offset
+		);
 
-	stagingBufferMan.AddBuffer(
-		std::move(perMeshBufferData), perMeshBufferSize,
-		m_perMeshSharedData.bufferData, m_perMeshSharedData.offset, tempBuffer
-	);
+		memcpy(std::data(perBundleData), &bundleData, perMeshBundleDataSize);
+	}
 
 	_setMeshBundle(
 		std::move(meshBundle),
@@ -160,10 +153,12 @@ void VkMeshBundleMS::ConfigureVertices(
 	);
 	verticesDetailOffset = static_cast<std::uint32_t>(verticesSharedData.offset / vertexStride);
 
-	auto verticesTempDataBuffer = std::make_shared<std::uint8_t[]>(vertexBufferSize);
+	std::span<std::uint8_t> verticesStagingData = stagingBufferMan.AddBufferInPlace(
+		vertexBufferSize, verticesSharedData.bufferData, verticesSharedData.offset
+	);
 
 	{
-		std::uint8_t* bufferStart = verticesTempDataBuffer.get();
+		std::uint8_t* bufferStart = std::data(verticesStagingData);
 		size_t bufferOffset       = 0u;
 
 		for (size_t index = 0u; index < vertexCount; ++index)
@@ -197,10 +192,5 @@ void VkMeshBundleMS::ConfigureVertices(
 			bufferOffset += vertexStride;
 		}
 	}
-
-	stagingBufferMan.AddBuffer(
-		std::move(verticesTempDataBuffer), vertexBufferSize, verticesSharedData.bufferData,
-		verticesSharedData.offset, tempBuffer
-	);
 }
 }
@@ -1,5 +1,4 @@
 #include <VkMeshBundleVS.hpp>
-#include <VectorToSharedPtr.hpp>
 
 namespace Terra
 {
@@ -26,15 +25,11 @@ void VkMeshBundleVS::_setMeshBundle(
 			vertexBufferSize, tempBuffer
 		);
 
-		std::shared_ptr<std::uint8_t[]> vertexBufferData = Callisto::CopyVectorToSharedPtr(
-			vertices
+		std::span<std::uint8_t> vertexBufferData = stagingBufferMan.AddBufferInPlace(
+			vertexBufferSize, m_vertexBufferSharedData.bufferData, m_vertexBufferSharedData.offset
 		);
 
-		stagingBufferMan.AddBuffer(
-			std::move(vertexBufferData), vertexBufferSize,
-			m_vertexBufferSharedData.bufferData, m_vertexBufferSharedData.offset,
-			tempBuffer
-		);
+		memcpy(std::data(vertexBufferData), std::data(vertices), vertexBufferSize);
 	}
 
 	// Index Buffer
@@ -49,13 +44,11 @@ void VkMeshBundleVS::_setMeshBundle(
 			indexBufferSize, tempBuffer
 		);
 
-		std::shared_ptr<std::uint8_t[]> indexBufferData = Callisto::CopyVectorToSharedPtr(indices);
-
-		stagingBufferMan.AddBuffer(
-			std::move(indexBufferData), indexBufferSize,
-			m_indexBufferSharedData.bufferData, m_indexBufferSharedData.offset,
-			tempBuffer
+		std::span<std::uint8_t> indexBufferData = stagingBufferMan.AddBufferInPlace(
+			indexBufferSize, m_indexBufferSharedData.bufferData, m_indexBufferSharedData.offset
 		);
+
+		memcpy(std::data(indexBufferData), std::data(indices), indexBufferSize);
 	}
 
 	m_bundleDetails = std::move(meshBundle.bundleDetails.meshTemporaryDetailsVS);
@@ -89,11 +82,13 @@ void VkMeshBundleVS::SetMeshBundle(
 		perMeshBufferSize, tempBuffer
 	);
 
-	auto perMeshBufferData = std::make_shared<std::uint8_t[]>(perMeshBufferSize);
-
 	{
+		std::span<std::uint8_t> perMeshBufferData = stagingBufferMan.AddBufferInPlace(
+			perMeshBufferSize, m_perMeshSharedData.bufferData, m_perMeshSharedData.offset
+		);
+
 		size_t perMeshOffset             = 0u;
-		std::uint8_t* perMeshBufferStart = perMeshBufferData.get();
+		std::uint8_t* perMeshBufferStart = std::data(perMeshBufferData);
 
 		for (const MeshTemporaryDetailsVS& meshDetail : meshDetailsVS)
 		{
@@ -106,8 +101,6 @@ void VkMeshBundleVS::SetMeshBundle(
 	// Mesh Bundle Data
 	constexpr size_t perMeshBundleDataSize = sizeof(PerMeshBundleData);
 
-	auto perBundleData  = std::make_shared<std::uint8_t[]>(perMeshBundleDataSize);
-
 	m_perMeshBundleSharedData = perMeshBundleSharedBuffer.AllocateAndGetSharedData(
 		perMeshBundleDataSize, tempBuffer
 	);
@@ -118,18 +111,13 @@ void VkMeshBundleVS::SetMeshBundle(
 			.meshOffset = static_cast<std::uint32_t>(m_perMeshSharedData.offset / perMeshStride)
 		};
 
-		memcpy(perBundleData.get(), &bundleData, perMeshBundleDataSize);
-	}
-
-	stagingBufferMan.AddBuffer(
-		std::move(perBundleData), perMeshBundleDataSize,
-		m_perMeshBundleSharedData.bufferData, m_perMeshBundleSharedData.offset, tempBuffer
-	);
+		std::span<std::uint8_t> perBundleData = stagingBufferMan.AddBufferInPlace(
+			perMeshBundleDataSize, m_perMeshBundleSharedData.bufferData,
+			m_perMeshBundleSharedData.offset
+		);
 
-	stagingBufferMan.AddBuffer(
-		std::move(perMeshBufferData), perMeshBufferSize,
-		m_perMeshSharedData.bufferData, m_perMeshSharedData.offset, tempBuffer
-	);
+		memcpy(std::data(perBundleData), &bundleData, perMeshBundleDataSize);
+	}
 
 	_setMeshBundle(
 		std::move(meshBundle), stagingBufferMan, vertexSharedBuffer, indexSharedBuffer, tempBuffer
@@ -1,4 +1,7 @@
 #include <VkModelBuffer.hpp>
+#include <algorithm>
+#include <array>
+#include <CpuTracer.hpp>
 
 namespace Terra
 {
@@ -39,6 +42,9 @@ void ModelBuffers::CreateBuffer(size_t modelCount)
 		// The fragment buffer should only be accessed by the graphics command queue.
 		m_fragmentModelBuffers.Create(modelBufferTotalSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, {});
 	}
+
+	// The new buffers don't have any data. So, every model must be written to every instance.
+	m_pendingFrameUpdates.assign(modelCount, m_bufferInstanceCount);
 }
 
 void ModelBuffers::SetDescriptorBuffer(
@@ -68,67 +74,175 @@ void ModelBuffers::SetFragmentDescriptorBuffer(
 	);
 }
 
-void ModelBuffers::Update(VkDeviceSize bufferIndex) const noexcept
-{
-	// Vertex Data
-	std::uint8_t* vertexBufferOffset
-		= m_vertexModelBuffers.CPUHandle() + bufferIndex * m_modelBuffersInstanceSize;
-	constexpr size_t vertexStrideSize = GetVertexStride();
-	size_t vertexModelOffset          = 0u;
+void ModelBuffers::UpdateModels(
+	size_t startIndex, size_t endIndex, std::uint8_t* vertexBufferStart,
+	std::uint8_t* fragmentBufferStart
+) noexcept {
+	using namespace DirectX;
 
-	// Fragment Data
-	std::uint8_t* fragmentBufferOffset
-		= m_fragmentModelBuffers.CPUHandle() + bufferIndex * m_modelBuffersFragmentInstanceSize;
+	constexpr size_t vertexStrideSize   = GetVertexStride();
 	constexpr size_t fragmentStrideSize = GetFragmentStride();
-	size_t fragmentModelOffset          = 0u;
 
-	const Callisto::ReusableVector<Model>& models = m_modelContainer->GetModels();
+	constexpr auto inUseFlag    = static_cast<std::uint8_t>(ModelState::InUse);
+	constexpr auto modifiedFlag = static_cast<std::uint8_t>(ModelState::Modified);
+	constexpr auto staleFlag    = static_cast<std::uint8_t>(ModelState::NormalMatrixStale);
+
+	ModelContainer& modelContainer         = *m_modelContainer;
+	std::vector<std::uint8_t>& modelStates = modelContainer.GetModelStates();
+
+	// A chunk is never larger than this, so the indices can be kept on the stack.
+	std::array<std::uint32_t, s_updateChunkSize> modelIndices;
+	size_t modelIndexCount = 0u;
+
+	// Only the states are accessed to find the models which need to be written.
+	for (size_t index = startIndex; index < endIndex; ++index)
+	{
+		std::uint8_t& modelState = modelStates[index];
+
+		if (!(modelState & inUseFlag))
+			continue;
+
+		std::uint32_t& pendingFrameUpdates = m_pendingFrameUpdates[index];
 
-	// All of the models will be here. Even after multiple models have been removed, there
-	// should be invalid models there. It is necessary to keep them to preserve the model indices,
-	// which is used to keep track of the models both on the CPU and the GPU side.
-	for (const Model& model : models)
+		if (modelState & modifiedFlag)
+		{
+			pendingFrameUpdates = m_bufferInstanceCount;
+
+			modelState &= static_cast<std::uint8_t>(~modifiedFlag);
+		}
+
+		if (!pendingFrameUpdates)
+			continue;
+
+		--pendingFrameUpdates;
+
+		modelIndices[modelIndexCount] = static_cast<std::uint32_t>(index);
+		++modelIndexCount;
+	}
+
+	// The normal matrices are calculated first, so the inverse and transpose kernels run back
+	// to back over the matrix arrays.
 	{
-		// Vertex Data
+		const std::vector<XMMATRIX>& modelMatrices = modelContainer.GetModelMatrices();
+		std::vector<XMMATRIX>& normalMatrices      = modelContainer.GetNormalMatrices();
+
+		for (size_t index = 0u; index < modelIndexCount; ++index)
 		{
-			using namespace DirectX;
+			const std::uint32_t modelIndex = modelIndices[index];
+			std::uint8_t& modelState       = modelStates[modelIndex];
+
+			if (modelState & staleFlag)
+			{
+				normalMatrices[modelIndex]
+					= ModelTransform::CalculateNormalMatrix(modelMatrices[modelIndex]);
+
+				modelState &= static_cast<std::uint8_t>(~staleFlag);
+			}
+		}
+	}
 
-			const XMMATRIX& modelMat = model.GetModelMatrix();
+	// Then each of the buffers is written sequentially, instead of interleaving the writes to
+	// the two buffers. The fragment data only needs the materials.
+	{
+		const std::vector<XMMATRIX>& modelMatrices      = modelContainer.GetModelMatrices();
+		const std::vector<XMMATRIX>& normalMatrices     = modelContainer.GetNormalMatrices();
+		const std::vector<XMFLOAT3>& modelOffsets       = modelContainer.GetModelOffsets();
+		const std::vector<float>& modelScales           = modelContainer.GetModelScales();
+		const std::vector<ModelMaterialData>& materials = modelContainer.GetMaterials();
+		const std::vector<std::uint32_t>& meshIndices   = modelContainer.GetMeshIndices();
+
+		for (size_t index = 0u; index < modelIndexCount; ++index)
+		{
+			const std::uint32_t modelIndex = modelIndices[index];
 
 			const ModelVertexData modelVertexData
 			{
-				.modelMatrix   = modelMat,
-				// The normal matrix is the transpose of the inversed model matrix. Not doing
-				// this to flip to Column major.
-				.normalMatrix  = XMMatrixTranspose(XMMatrixInverse(nullptr, modelMat)),
-				.modelOffset   = model.GetModelOffset(),
-				.materialIndex = model.GetMaterialIndex(),
-				.meshIndex     = model.GetMeshIndex(),
-				.modelScale    = model.GetModelScale()
+				.modelMatrix   = modelMatrices[modelIndex],
+				.normalMatrix  = normalMatrices[modelIndex],
+				.modelOffset   = modelOffsets[modelIndex],
+				.materialIndex = materials[modelIndex].materialIndex,
+				.meshIndex     = meshIndices[modelIndex],
+				.modelScale    = modelScales[modelIndex]
 			};
 
-			memcpy(vertexBufferOffset + vertexModelOffset, &modelVertexData, vertexStrideSize);
+			memcpy(
+				vertexBufferStart + modelIndex * vertexStrideSize, &modelVertexData,
+				vertexStrideSize
+			);
 		}
 
-		// Fragment Data
+		for (size_t index = 0u; index < modelIndexCount; ++index)
 		{
+			const std::uint32_t modelIndex    = modelIndices[index];
+			const ModelMaterialData& material = materials[modelIndex];
+
 			const ModelFragmentData modelFragmentData
 			{
-				.diffuseTexUVInfo  = model.GetDiffuseUVInfo(),
-				.specularTexUVInfo = model.GetSpecularUVInfo(),
-				.diffuseTexIndex   = model.GetDiffuseIndex(),
-				.specularTexIndex  = model.GetSpecularIndex()
+				.diffuseTexUVInfo  = material.diffuseUVInfo,
+				.specularTexUVInfo = material.specularUVInfo,
+				.diffuseTexIndex   = material.diffuseIndex,
+				.specularTexIndex  = material.specularIndex
 			};
 
 			memcpy(
-				fragmentBufferOffset + fragmentModelOffset, &modelFragmentData,
+				fragmentBufferStart + modelIndex * fragmentStrideSize, &modelFragmentData,
 				fragmentStrideSize
 			);
 		}
+	}
+}
+
+void ModelBuffers::Update(VkDeviceSize bufferIndex) noexcept
+{
+	TERRA_CPU_TRACE_ZONE("ModelBuffers::Update");
+
+	// Vertex Data
+	std::uint8_t* vertexBufferOffset
+		= m_vertexModelBuffers.CPUHandle() + bufferIndex * m_modelBuffersInstanceSize;
+
+	// Fragment Data
+	std::uint8_t* fragmentBufferOffset
+		= m_fragmentModelBuffers.CPUHandle() + bufferIndex * m_modelBuffersFragmentInstanceSize;
+
+	// The model indices are used to keep track of the models both on the CPU and the GPU side,
+	// so the index of a model is also its index in the buffers. The removed models don't need
+	// to be written, as they won't be accessed. If the buffers haven't been extended for the
+	// newly added models yet, they can't be written either.
+	const size_t modelCount = std::min(
+		m_modelContainer->GetModelCount(), std::size(m_pendingFrameUpdates)
+	);
+
+	if (!m_threadPool || modelCount <= s_updateChunkSize)
+	{
+		for (size_t index = 0u; index < modelCount; index += s_updateChunkSize)
+			UpdateModels(
+				index, std::min(index + s_updateChunkSize, modelCount), vertexBufferOffset,
+				fragmentBufferOffset
+			);
 
-		// The offsets need to be always increased to keep them consistent.
-		vertexModelOffset   += vertexStrideSize;
-		fragmentModelOffset += fragmentStrideSize;
+		return;
 	}
+
+	// Making it static, so dynamic allocation happens less.
+	static std::vector<std::future<void>> waitObjs{};
+
+	// Each chunk only accesses its own models and their parts of the buffers, so they can be
+	// updated asynchronously.
+	for (size_t index = 0u; index < modelCount; index += s_updateChunkSize)
+		waitObjs.emplace_back(m_threadPool->SubmitWork(std::function{
+			[this, index, modelCount, vertexBufferOffset, fragmentBufferOffset]
+			{
+				TERRA_CPU_TRACE_ZONE("ModelBuffers::UpdateModels");
+
+				UpdateModels(
+					index, std::min(index + s_updateChunkSize, modelCount), vertexBufferOffset,
+					fragmentBufferOffset
+				);
+			}}));
+
+	for (auto& waitObj : waitObjs)
+		waitObj.wait();
+
+	waitObjs.clear();
 }
 }
@@ -19,79 +19,142 @@ VkDrawIndexedIndirectCommand PipelineModelsBase::GetDrawIndexedIndirectCommand(
 }
 
 // Pipeline Models VS Individual
-void PipelineModelsVSIndividual::DrawModel(
-	const Model& model, std::uint32_t modelIndexInBuffer, VkCommandBuffer graphicsCmdBuffer,
-	VkPipelineLayout pipelineLayout, const VkMeshBundleVS& meshBundle
-) const noexcept {
-	if (!model.IsVisible())
-		return;
-
-	constexpr std::uint32_t pushConstantSize = GetConstantBufferSize();
-
-	vkCmdPushConstants(
-		graphicsCmdBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0u,
-		pushConstantSize, &modelIndexInBuffer
-	);
-
-	const MeshTemporaryDetailsVS& meshDetailsVS = meshBundle.GetMeshDetails(model.GetMeshIndex());
-	const VkDrawIndexedIndirectCommand meshArgs = GetDrawIndexedIndirectCommand(meshDetailsVS);
-
-	vkCmdDrawIndexed(
-		graphicsCmdBuffer, meshArgs.indexCount, meshArgs.instanceCount,
-		meshArgs.firstIndex, meshArgs.vertexOffset, meshArgs.firstInstance
-	);
-}
-
-void PipelineModelsVSIndividual::Draw(
-	const VKCommandBuffer& graphicsBuffer, VkPipelineLayout pipelineLayout,
-	const VkMeshBundleVS& meshBundle, const Callisto::ReusableVector<Model>& models,
+PipelineModelsVSIndividual::ArgumentOffsets PipelineModelsVSIndividual::UpdateArguments(
+	std::uint8_t* argumentBufferStart, std::uint8_t* instanceBufferStart,
+	ArgumentOffsets offsets, std::vector<std::uint64_t>& instanceKeys,
+	const VkMeshBundleVS& meshBundle, const ModelContainer& modelContainer,
+	const std::vector<std::uint8_t>& modelVisibilities,
 	const std::vector<std::uint32_t>& modelIndicesInContainer,
 	const PipelineModelBundle& pipelineBundle
-) const noexcept {
+) noexcept {
 	const std::vector<std::uint32_t>& pipelineModelIndicesInBundle
 		= pipelineBundle.GetModelIndicesInBundle();
 
-	VkCommandBuffer cmdBuffer = graphicsBuffer.Get();
+	const std::vector<std::uint32_t>& meshIndices = modelContainer.GetMeshIndices();
+
+	m_argumentOffset = offsets.argumentOffset;
+	m_drawCount      = 0u;
+	m_instanceCount  = 0u;
+
+	// The mesh index is in the upper half of a key, so sorting the keys puts the models with
+	// the same mesh next to each other.
+	instanceKeys.clear();
 
 	for (size_t modelIndexInBundle : pipelineModelIndicesInBundle)
 	{
 		const std::uint32_t modelIndexInContainer = modelIndicesInContainer[modelIndexInBundle];
 
-		DrawModel(
-			models[modelIndexInContainer], modelIndexInContainer, cmdBuffer, pipelineLayout,
-			meshBundle
+		if (!modelVisibilities[modelIndexInContainer])
+			continue;
+
+		instanceKeys.emplace_back(
+			static_cast<std::uint64_t>(meshIndices[modelIndexInContainer]) << 32u
+			| modelIndexInContainer
+		);
+	}
+
+	std::ranges::sort(instanceKeys);
+
+	constexpr size_t argumentStride = GetArgumentStride();
+	constexpr size_t instanceStride = GetInstanceStride();
+
+	auto currentArgumentOffset  = static_cast<size_t>(offsets.argumentOffset);
+	std::uint32_t instanceIndex = offsets.instanceOffset;
+
+	const size_t instanceKeyCount = std::size(instanceKeys);
+
+	for (size_t groupStart = 0u; groupStart < instanceKeyCount;)
+	{
+		const auto meshIndex = static_cast<std::uint32_t>(instanceKeys[groupStart] >> 32u);
+
+		VkDrawIndexedIndirectCommand meshArgs = GetDrawIndexedIndirectCommand(
+			meshBundle.GetMeshDetails(meshIndex)
 		);
+
+		// The vertex shader uses the instance index to get the model index from the instance
+		// buffer.
+		meshArgs.firstInstance = instanceIndex;
+
+		size_t groupEnd = groupStart;
+
+		for (; groupEnd < instanceKeyCount; ++groupEnd)
+		{
+			const std::uint64_t instanceKey = instanceKeys[groupEnd];
+
+			if (static_cast<std::uint32_t>(instanceKey >> 32u) != meshIndex)
+				break;
+
+			const auto modelIndexInContainer = static_cast<std::uint32_t>(instanceKey);
+
+			memcpy(
+				instanceBufferStart + instanceIndex * instanceStride, &modelIndexInContainer,
+				instanceStride
+			);
+
+			++instanceIndex;
+		}
+
+		meshArgs.instanceCount = static_cast<std::uint32_t>(groupEnd - groupStart);
+
+		memcpy(argumentBufferStart + currentArgumentOffset, &meshArgs, argumentStride);
+
+		currentArgumentOffset += argumentStride;
+		++m_drawCount;
+
+		groupStart = groupEnd;
 	}
+
+	m_instanceCount = instanceIndex - offsets.instanceOffset;
+
+	return ArgumentOffsets{
+		.argumentOffset = static_cast<VkDeviceSize>(currentArgumentOffset),
+		.instanceOffset = instanceIndex
+	};
+}
+
+void PipelineModelsVSIndividual::Draw(
+	const VKCommandBuffer& graphicsBuffer, const Buffer& argumentBuffer
+) const noexcept {
+	if (!m_drawCount)
+		return;
+
+	constexpr auto argumentStride = static_cast<std::uint32_t>(GetArgumentStride());
+
+	vkCmdDrawIndexedIndirect(
+		graphicsBuffer.Get(), argumentBuffer.Get(), m_argumentOffset, m_drawCount,
+		argumentStride
+	);
 }
 
 // Pipeline Models MS Individual
+PipelineModelsMSIndividual::MeshDetails PipelineModelsMSIndividual::GetMeshDetails(
+	const MeshTemporaryDetailsMS& meshDetailsMS
+) noexcept {
+	return MeshDetails
+	{
+		.meshletCount  = meshDetailsMS.meshletCount,
+		.meshletOffset = meshDetailsMS.meshletOffset,
+		.indexOffset   = meshDetailsMS.indexOffset,
+		.primOffset    = meshDetailsMS.primitiveOffset,
+		.vertexOffset  = meshDetailsMS.vertexOffset
+	};
+}
+
 void PipelineModelsMSIndividual::DrawModel(
-	const Model& model, std::uint32_t modelIndexInBuffer, VkCommandBuffer graphicsCmdBuffer,
+	std::uint32_t meshIndex, std::uint32_t modelIndexInBuffer, VkCommandBuffer graphicsCmdBuffer,
 	VkPipelineLayout pipelineLayout, const VkMeshBundleMS& meshBundle
 ) const noexcept {
 	using MS = VkDeviceExtension::VkExtMeshShader;
 
-	if (!model.IsVisible())
-		return;
-
 	constexpr std::uint32_t pushConstantSize    = GetConstantBufferSize();
 
 	constexpr std::uint32_t constBufferOffset   = VkMeshBundleMS::GetConstantBufferSize();
 
-	const MeshTemporaryDetailsMS& meshDetailsMS = meshBundle.GetMeshDetails(
-		model.GetMeshIndex()
-	);
+	const MeshTemporaryDetailsMS& meshDetailsMS = meshBundle.GetMeshDetails(meshIndex);
 
 	const ModelDetails modelConstants
 	{
-		.meshDetails = MeshDetails
-			{
-				.meshletCount  = meshDetailsMS.meshletCount,
-				.meshletOffset = meshDetailsMS.meshletOffset,
-				.indexOffset   = meshDetailsMS.indexOffset,
-				.primOffset    = meshDetailsMS.primitiveOffset,
-				.vertexOffset  = meshDetailsMS.vertexOffset
-			},
+		.meshDetails      = GetMeshDetails(meshDetailsMS),
 		.modelBufferIndex = modelIndexInBuffer
 	};
 
@@ -106,9 +169,7 @@ void PipelineModelsMSIndividual::DrawModel(
 	// Mesh Shader workGroups. On Nvdia we can have a maximum of 32 invocations active
 	// in a subGroup and 64 on AMD. So, a workGroup will be able to work on 32/64
 	// meshlets concurrently.
-	const std::uint32_t taskGroupCount = DivRoundUp(
-		meshDetailsMS.meshletCount, s_taskInvocationCount
-	);
+	const std::uint32_t taskGroupCount = GetTaskGroupCount(meshDetailsMS.meshletCount);
 
 	MS::vkCmdDrawMeshTasksEXT(graphicsCmdBuffer, taskGroupCount, 1u, 1u);
 	// It might be worth checking if we are reaching the Group Count Limit and if needed
@@ -117,7 +178,8 @@ void PipelineModelsMSIndividual::DrawModel(
 
 void PipelineModelsMSIndividual::Draw(
 	const VKCommandBuffer& graphicsBuffer, VkPipelineLayout pipelineLayout,
-	const VkMeshBundleMS& meshBundle, const Callisto::ReusableVector<Model>& models,
+	const VkMeshBundleMS& meshBundle, const ModelContainer& modelContainer,
+	const std::vector<std::uint8_t>& modelVisibilities,
 	const std::vector<std::uint32_t>& modelIndicesInContainer,
 	const PipelineModelBundle& pipelineBundle
 ) const noexcept {
@@ -126,24 +188,107 @@ void PipelineModelsMSIndividual::Draw(
 
 	VkCommandBuffer cmdBuffer = graphicsBuffer.Get();
 
+	const std::vector<std::uint32_t>& meshIndices = modelContainer.GetMeshIndices();
+
 	for (size_t modelIndexInBundle : pipelineModelIndicesInBundle)
 	{
 		const std::uint32_t modelIndexInContainer = modelIndicesInContainer[modelIndexInBundle];
 
+		if (!modelVisibilities[modelIndexInContainer])
+			continue;
+
 		DrawModel(
-			models[modelIndexInContainer], modelIndexInContainer, cmdBuffer, pipelineLayout,
+			meshIndices[modelIndexInContainer], modelIndexInContainer, cmdBuffer, pipelineLayout,
 			meshBundle
 		);
 	}
 }
 
+// Indirect Arguments VS
+IndirectArgumentsVS::Argument_t IndirectArgumentsVS::GetArgument(
+	const MeshBundle_t& meshBundle, std::uint32_t meshIndex
+) noexcept {
+	return PipelineModelsBase::GetDrawIndexedIndirectCommand(meshBundle.GetMeshDetails(meshIndex));
+}
+
+void IndirectArgumentsVS::BindMeshBundle(
+	const VKCommandBuffer& graphicsBuffer, [[maybe_unused]] VkPipelineLayout pipelineLayout,
+	const MeshBundle_t& meshBundle
+) noexcept {
+	meshBundle.Bind(graphicsBuffer);
+}
+
+void IndirectArgumentsVS::DrawIndirectCount(
+	VkCommandBuffer graphicsCmdBuffer, const SharedBufferData& argumentSharedData,
+	const SharedBufferData& counterSharedData, std::uint32_t maxDrawCount
+) noexcept {
+	constexpr auto strideSize = static_cast<std::uint32_t>(sizeof(Argument_t));
+
+	vkCmdDrawIndexedIndirectCount(
+		graphicsCmdBuffer,
+		argumentSharedData.bufferData->Get(), argumentSharedData.offset,
+		counterSharedData.bufferData->Get(), counterSharedData.offset,
+		maxDrawCount, strideSize
+	);
+}
+
+// Indirect Arguments MS
+IndirectArgumentsMS::Argument_t IndirectArgumentsMS::GetArgument(
+	const MeshBundle_t& meshBundle, std::uint32_t meshIndex
+) noexcept {
+	const MeshTemporaryDetailsMS& meshDetailsMS = meshBundle.GetMeshDetails(meshIndex);
+
+	// Same as the Individual one, each Task shader invocation processes a meshlet.
+	const Argument_t meshArgs
+	{
+		.command     = VkDrawMeshTasksIndirectCommandEXT
+			{
+				.groupCountX = PipelineModelsMSIndividual::GetTaskGroupCount(
+					meshDetailsMS.meshletCount
+				),
+				.groupCountY = 1u,
+				.groupCountZ = 1u
+			},
+		.meshDetails = PipelineModelsMSIndividual::GetMeshDetails(meshDetailsMS)
+	};
+
+	return meshArgs;
+}
+
+void IndirectArgumentsMS::BindMeshBundle(
+	const VKCommandBuffer& graphicsBuffer, VkPipelineLayout pipelineLayout,
+	const MeshBundle_t& meshBundle
+) noexcept {
+	ModelBundleMSIndividual::SetMeshBundleConstants(
+		graphicsBuffer.Get(), pipelineLayout, meshBundle
+	);
+}
+
+void IndirectArgumentsMS::DrawIndirectCount(
+	VkCommandBuffer graphicsCmdBuffer, const SharedBufferData& argumentSharedData,
+	const SharedBufferData& counterSharedData, std::uint32_t maxDrawCount
+) noexcept {
+	using MS = VkDeviceExtension::VkExtMeshShader;
+
+	constexpr auto strideSize = static_cast<std::uint32_t>(sizeof(Argument_t));
+
+	MS::vkCmdDrawMeshTasksIndirectCountEXT(
+		graphicsCmdBuffer,
+		argumentSharedData.bufferData->Get(), argumentSharedData.offset,
+		counterSharedData.bufferData->Get(), counterSharedData.offset,
+		maxDrawCount, strideSize
+	);
+}
+
 // Pipeline Models CS Indirect
-PipelineModelsCSIndirect::PipelineModelsCSIndirect()
+template<class Arguments_t>
+PipelineModelsCSIndirect<Arguments_t>::PipelineModelsCSIndirect()
 	: PipelineModelsBase{}, m_perPipelineSharedData{ nullptr, 0u, 0u },
 	m_perModelSharedData{ nullptr, 0u, 0u }, m_argumentInputSharedData{}
 {}
 
-void PipelineModelsCSIndirect::ResetCullingData() const noexcept
+template<class Arguments_t>
+void PipelineModelsCSIndirect<Arguments_t>::ResetCullingData() const noexcept
 {
 	// Before destroying an object the model count needs to be set to 0,
 	// so the models aren't processed in the compute shader anymore.
@@ -159,7 +304,8 @@ void PipelineModelsCSIndirect::ResetCullingData() const noexcept
 	}
 }
 
-size_t PipelineModelsCSIndirect::GetAddableModelCount(
+template<class Arguments_t>
+size_t PipelineModelsCSIndirect<Arguments_t>::GetAddableModelCount(
 	const std::vector<PipelineModelBundle>& pipelineBundles
 ) const noexcept {
 	constexpr size_t perModelStride = sizeof(PerModelData);
@@ -173,7 +319,8 @@ size_t PipelineModelsCSIndirect::GetAddableModelCount(
 	return allocatedModelCount > currentModelCount ? allocatedModelCount - currentModelCount : 0u;
 }
 
-size_t PipelineModelsCSIndirect::GetNewModelCount(
+template<class Arguments_t>
+size_t PipelineModelsCSIndirect<Arguments_t>::GetNewModelCount(
 	const std::vector<PipelineModelBundle>& pipelineBundles
 ) const noexcept {
 	constexpr size_t perModelStride = sizeof(PerModelData);
@@ -187,10 +334,11 @@ size_t PipelineModelsCSIndirect::GetNewModelCount(
 	return allocatedModelCount < currentModelCount ?  currentModelCount - allocatedModelCount : 0u;
 }
 
-void PipelineModelsCSIndirect::UpdateNonPerFrameData(
+template<class Arguments_t>
+void PipelineModelsCSIndirect<Arguments_t>::UpdateNonPerFrameData(
 	std::uint32_t modelBundleIndex, const std::vector<PipelineModelBundle>& pipelineBundles
 ) noexcept {
-	constexpr size_t argumentStrideSize = sizeof(VkDrawIndexedIndirectCommand);
+	constexpr size_t argumentStrideSize = sizeof(Argument_t);
 	constexpr size_t perModelStride     = sizeof(PerModelData);
 	constexpr size_t perPipelineStride  = sizeof(PerPipelineData);
 
@@ -251,7 +399,8 @@ void PipelineModelsCSIndirect::UpdateNonPerFrameData(
 	}
 }
 
-void PipelineModelsCSIndirect::AllocateBuffers(
+template<class Arguments_t>
+void PipelineModelsCSIndirect<Arguments_t>::AllocateBuffers(
 	const std::vector<PipelineModelBundle>& pipelineBundles,
 	std::vector<SharedBufferCPU>& argumentInputSharedBuffers,
 	SharedBufferCPU& perPipelineSharedBuffer, SharedBufferCPU& perModelSharedBuffer
@@ -261,7 +410,7 @@ void PipelineModelsCSIndirect::AllocateBuffers(
 	if (!modelCount)
 		return;
 
-	constexpr size_t argumentStrideSize = sizeof(VkDrawIndexedIndirectCommand);
+	constexpr size_t argumentStrideSize = sizeof(Argument_t);
 	constexpr size_t perModelStride     = sizeof(PerModelData);
 	constexpr auto perPipelineDataSize  = static_cast<VkDeviceSize>(sizeof(PerPipelineData));
 
@@ -310,9 +459,10 @@ void PipelineModelsCSIndirect::AllocateBuffers(
 	}
 }
 
-void PipelineModelsCSIndirect::Update(
-	size_t frameIndex, const VkMeshBundleVS& meshBundle, bool skipCulling,
-	const Callisto::ReusableVector<Model>& models,
+template<class Arguments_t>
+void PipelineModelsCSIndirect<Arguments_t>::Update(
+	size_t frameIndex, const MeshBundle_t& meshBundle, bool skipCulling,
+	const ModelContainer& modelContainer,
 	const std::vector<std::uint32_t>& modelIndicesInContainer,
 	const PipelineModelBundle& pipelineBundle
 ) const noexcept {
@@ -329,7 +479,7 @@ void PipelineModelsCSIndirect::Update(
 	std::uint8_t* argumentInputStart  = argumentInputSharedData.bufferData->CPUHandle();
 	std::uint8_t* perModelBufferStart = m_perModelSharedData.bufferData->CPUHandle();
 
-	constexpr size_t argumentStride = sizeof(VkDrawIndexedIndirectCommand);
+	constexpr size_t argumentStride = sizeof(Argument_t);
 	auto argumentOffset             = static_cast<size_t>(argumentInputSharedData.offset);
 
 	constexpr size_t perModelStride = sizeof(PerModelData);
@@ -340,19 +490,17 @@ void PipelineModelsCSIndirect::Update(
 	std::uint32_t skipCullingFlag
 		= skipCulling ? static_cast<std::uint32_t>(ModelFlag::SkipCulling) : 0u;
 
+	const std::vector<std::uint8_t>& visibilities = modelContainer.GetVisibilities();
+	const std::vector<std::uint32_t>& meshIndices = modelContainer.GetMeshIndices();
+
 	for (std::uint32_t modelIndexInBundle : pipelineModelIndicesInBundle)
 	{
 		const std::uint32_t modelIndexInContainer = modelIndicesInContainer[modelIndexInBundle];
 
-		const Model& model = models[modelIndexInContainer];
-
-		const MeshTemporaryDetailsVS& meshDetailsVS = meshBundle.GetMeshDetails(
-			model.GetMeshIndex()
+		const Argument_t meshArgs = Arguments_t::GetArgument(
+			meshBundle, meshIndices[modelIndexInContainer]
 		);
 
-		const VkDrawIndexedIndirectCommand meshArgs
-			= PipelineModelsBase::GetDrawIndexedIndirectCommand(meshDetailsVS);
-
 		memcpy(argumentInputStart + argumentOffset, &meshArgs, argumentStride);
 
 		argumentOffset += argumentStride;
@@ -360,7 +508,7 @@ void PipelineModelsCSIndirect::Update(
 		// Model Flags
 		std::uint32_t modelFlags = skipCullingFlag;
 
-		if (model.IsVisible())
+		if (visibilities[modelIndexInContainer])
 			modelFlags |= static_cast<std::uint32_t>(ModelFlag::Visibility);
 
 		memcpy(
@@ -378,7 +526,8 @@ void PipelineModelsCSIndirect::Update(
 	}
 }
 
-void PipelineModelsCSIndirect::RelinquishMemory(
+template<class Arguments_t>
+void PipelineModelsCSIndirect<Arguments_t>::RelinquishMemory(
 	std::vector<SharedBufferCPU>& argumentInputSharedBuffers,
 	SharedBufferCPU& perPipelineSharedBuffer, SharedBufferCPU& perModelSharedBuffer
 ) noexcept {
@@ -415,18 +564,20 @@ void PipelineModelsCSIndirect::RelinquishMemory(
 	}
 }
 
-// Pipeline Models VS Indirect
-PipelineModelsVSIndirect::PipelineModelsVSIndirect()
+// Pipeline Models Draw Indirect
+template<class Arguments_t>
+PipelineModelsDrawIndirect<Arguments_t>::PipelineModelsDrawIndirect()
 	:  m_argumentOutputSharedData{},
 	m_counterSharedData{}, m_modelIndicesSharedData{}, m_modelCount{ 0u }, m_modelOffset{ 0u }
 {}
 
-void PipelineModelsVSIndirect::AllocateBuffers(
+template<class Arguments_t>
+void PipelineModelsDrawIndirect<Arguments_t>::AllocateBuffers(
 	std::vector<SharedBufferGPUWriteOnly>& argumentOutputSharedBuffers,
 	std::vector<SharedBufferGPUWriteOnly>& counterSharedBuffers,
 	std::vector<SharedBufferGPUWriteOnly>& modelIndicesSharedBuffers
 ) {
-	constexpr size_t argStrideSize      = sizeof(VkDrawIndexedIndirectCommand);
+	constexpr size_t argStrideSize      = sizeof(Argument_t);
 	constexpr size_t indexStrideSize    = sizeof(std::uint32_t);
 	const auto argumentOutputBufferSize = static_cast<VkDeviceSize>(m_modelCount * argStrideSize);
 	const auto modelIndiceBufferSize = static_cast<VkDeviceSize>(m_modelCount * indexStrideSize);
@@ -511,11 +662,10 @@ void PipelineModelsVSIndirect::AllocateBuffers(
 	}
 }
 
-void PipelineModelsVSIndirect::Draw(
+template<class Arguments_t>
+void PipelineModelsDrawIndirect<Arguments_t>::Draw(
 	size_t frameIndex, const VKCommandBuffer& graphicsBuffer, VkPipelineLayout pipelineLayout
 ) const noexcept {
-	constexpr auto strideSize = static_cast<std::uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
-
 	VkCommandBuffer cmdBuffer = graphicsBuffer.Get();
 
 	if (!m_modelCount)
@@ -525,23 +675,19 @@ void PipelineModelsVSIndirect::Draw(
 		constexpr auto pushConstantSize = GetConstantBufferSize();
 
 		vkCmdPushConstants(
-			cmdBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0u,
-			pushConstantSize, &m_modelOffset
+			cmdBuffer, pipelineLayout, Arguments_t::s_constantShaderStages,
+			Arguments_t::s_modelOffsetConstantOffset, pushConstantSize, &m_modelOffset
 		);
 	}
 
-	const SharedBufferData& argumentOutputSharedData = m_argumentOutputSharedData[frameIndex];
-	const SharedBufferData& counterSharedData        = m_counterSharedData[frameIndex];
-
-	vkCmdDrawIndexedIndirectCount(
-		cmdBuffer,
-		argumentOutputSharedData.bufferData->Get(), argumentOutputSharedData.offset,
-		counterSharedData.bufferData->Get(), counterSharedData.offset,
-		m_modelCount, strideSize
+	Arguments_t::DrawIndirectCount(
+		cmdBuffer, m_argumentOutputSharedData[frameIndex], m_counterSharedData[frameIndex],
+		m_modelCount
 	);
 }
 
-void PipelineModelsVSIndirect::RelinquishMemory(
+template<class Arguments_t>
+void PipelineModelsDrawIndirect<Arguments_t>::RelinquishMemory(
 	std::vector<SharedBufferGPUWriteOnly>& argumentOutputSharedBuffers,
 	std::vector<SharedBufferGPUWriteOnly>& counterSharedBuffers,
 	std::vector<SharedBufferGPUWriteOnly>& modelIndicesSharedBuffers
@@ -593,27 +739,69 @@ void PipelineModelsVSIndirect::RelinquishMemory(
 }
 
 // Model Bundle VS Individual
+PipelineModelsVSIndividual::ArgumentOffsets ModelBundleVSIndividual::UpdateArguments(
+	std::uint8_t* argumentBufferStart, std::uint8_t* instanceBufferStart,
+	PipelineModelsVSIndividual::ArgumentOffsets offsets,
+	std::vector<std::uint64_t>& instanceKeys, const VkMeshBundleVS& meshBundle,
+	const std::vector<std::uint8_t>* culledVisibilities
+) noexcept {
+	const ModelContainer& modelContainer = *m_modelBundle->GetModelContainer();
+
+	const std::vector<std::uint8_t>& modelVisibilities
+		= culledVisibilities ? *culledVisibilities : modelContainer.GetVisibilities();
+
+	const std::vector<std::uint32_t>& modelIndicesInContainer
+		= m_modelBundle->GetIndicesInContainer();
+
+	const size_t pipelineCount = std::size(m_pipelines);
+
+	for (size_t index = 0u; index < pipelineCount; ++index)
+	{
+		if (!m_pipelines.IsInUse(index))
+			continue;
+
+		offsets = m_pipelines[index].UpdateArguments(
+			argumentBufferStart, instanceBufferStart, offsets, instanceKeys, meshBundle,
+			modelContainer, modelVisibilities, modelIndicesInContainer,
+			m_modelBundle->GetPipeline(index)
+		);
+	}
+
+	return offsets;
+}
+
+size_t ModelBundleVSIndividual::GetArgumentCount() const noexcept
+{
+	const size_t pipelineCount = std::size(m_pipelines);
+
+	size_t argumentCount = 0u;
+
+	for (size_t index = 0u; index < pipelineCount; ++index)
+		if (m_pipelines.IsInUse(index))
+			argumentCount += m_modelBundle->GetPipeline(index).GetModelCount();
+
+	return argumentCount;
+}
+
+void ModelBundleVSIndividual::ResetDrawCounts() noexcept
+{
+	const size_t pipelineCount = std::size(m_pipelines);
+
+	for (size_t index = 0u; index < pipelineCount; ++index)
+		if (m_pipelines.IsInUse(index))
+			m_pipelines[index].ResetDrawCount();
+}
+
 void ModelBundleVSIndividual::DrawPipeline(
 	size_t pipelineLocalIndex, const VKCommandBuffer& graphicsBuffer,
-	VkPipelineLayout pipelineLayout, const VkMeshBundleVS& meshBundle
+	const VkMeshBundleVS& meshBundle, const Buffer& argumentBuffer
 ) const noexcept {
 	if (!m_pipelines.IsInUse(pipelineLocalIndex))
 		return;
 
 	meshBundle.Bind(graphicsBuffer);
 
-	const Callisto::ReusableVector<Model>& models
-		= m_modelBundle->GetModelContainer()->GetModels();
-
-	const std::vector<std::uint32_t>& modelIndicesInContainer
-		= m_modelBundle->GetIndicesInContainer();
-
-	const PipelineModelsVSIndividual& vkPipeline = m_pipelines[pipelineLocalIndex];
-
-	vkPipeline.Draw(
-		graphicsBuffer, pipelineLayout, meshBundle, models, modelIndicesInContainer,
-		m_modelBundle->GetPipeline(pipelineLocalIndex)
-	);
+	m_pipelines[pipelineLocalIndex].Draw(graphicsBuffer, argumentBuffer);
 }
 
 // Model Bundle MS Individual
@@ -635,15 +823,18 @@ void ModelBundleMSIndividual::SetMeshBundleConstants(
 
 void ModelBundleMSIndividual::DrawPipeline(
 	size_t pipelineLocalIndex, const VKCommandBuffer& graphicsBuffer,
-	VkPipelineLayout pipelineLayout, const VkMeshBundleMS& meshBundle
+	VkPipelineLayout pipelineLayout, const VkMeshBundleMS& meshBundle,
+	const std::vector<std::uint8_t>* culledVisibilities
 ) const noexcept {
 	if (!m_pipelines.IsInUse(pipelineLocalIndex))
 		return;
 
 	SetMeshBundleConstants(graphicsBuffer.Get(), pipelineLayout, meshBundle);
 
-	const Callisto::ReusableVector<Model>& models
-		= m_modelBundle->GetModelContainer()->GetModels();
+	const ModelContainer& modelContainer = *m_modelBundle->GetModelContainer();
+
+	const std::vector<std::uint8_t>& modelVisibilities
+		= culledVisibilities ? *culledVisibilities : modelContainer.GetVisibilities();
 
 	const std::vector<std::uint32_t>& modelIndicesInContainer
 		= m_modelBundle->GetIndicesInContainer();
@@ -651,13 +842,14 @@ void ModelBundleMSIndividual::DrawPipeline(
 	const PipelineModelsMSIndividual& vkPipeline = m_pipelines[pipelineLocalIndex];
 
 	vkPipeline.Draw(
-		graphicsBuffer, pipelineLayout, meshBundle, models, modelIndicesInContainer,
-		m_modelBundle->GetPipeline(pipelineLocalIndex)
+		graphicsBuffer, pipelineLayout, meshBundle, modelContainer, modelVisibilities,
+		modelIndicesInContainer, m_modelBundle->GetPipeline(pipelineLocalIndex)
 	);
 }
 
-// Model Bundle VS Indirect
-void ModelBundleVSIndirect::AddNewPipelinesFromBundle(
+// Model Bundle Indirect
+template<class Arguments_t>
+void ModelBundleIndirect<Arguments_t>::AddNewPipelinesFromBundle(
 	std::uint32_t modelBundleIndex, std::vector<SharedBufferCPU>& argumentInputSharedBuffers,
 	SharedBufferCPU& perPipelineSharedBuffer, SharedBufferCPU& perModelDataCSBuffer,
 	std::vector<SharedBufferGPUWriteOnly>& argumentOutputSharedBuffers,
@@ -669,12 +861,12 @@ void ModelBundleVSIndirect::AddNewPipelinesFromBundle(
 
 	for (size_t index = currentPipelineCount; index < pipelinesInBundle; ++index)
 	{
-		const size_t pipelineLocalIndex = _addPipeline(static_cast<std::uint32_t>(index));
+		const size_t pipelineLocalIndex = this->_addPipeline(static_cast<std::uint32_t>(index));
 
 		// Since the cs pipeline is a Reusable vector, it can reuse old pipelines
-		// in that case we don't need to create a new vs pipeline.
-		if (pipelineLocalIndex >= std::size(m_vsPipelines))
-			m_vsPipelines.emplace_back(PipelineModelsVSIndirect{});
+		// in that case we don't need to create a new draw pipeline.
+		if (pipelineLocalIndex >= std::size(m_drawPipelines))
+			m_drawPipelines.emplace_back(PipelineModelsDrawIndirect<Arguments_t>{});
 
 		SetupPipelineBuffers(
 			static_cast<std::uint32_t>(pipelineLocalIndex), modelBundleIndex,
@@ -684,7 +876,8 @@ void ModelBundleVSIndirect::AddNewPipelinesFromBundle(
 	}
 }
 
-void ModelBundleVSIndirect::CleanupData(
+template<class Arguments_t>
+void ModelBundleIndirect<Arguments_t>::CleanupData(
 	std::vector<SharedBufferCPU>& argumentInputSharedBuffers,
 	SharedBufferCPU& perPipelineSharedBuffer, SharedBufferCPU& perModelDataCSBuffer,
 	std::vector<SharedBufferGPUWriteOnly>& argumentOutputSharedBuffers,
@@ -699,10 +892,11 @@ void ModelBundleVSIndirect::CleanupData(
 			argumentOutputSharedBuffers, counterSharedBuffers, modelIndicesSharedBuffers
 		);
 
-	operator=(ModelBundleVSIndirect{});
+	operator=(ModelBundleIndirect{});
 }
 
-void ModelBundleVSIndirect::RemovePipeline(
+template<class Arguments_t>
+void ModelBundleIndirect<Arguments_t>::RemovePipeline(
 	size_t pipelineLocalIndex, std::vector<SharedBufferCPU>& argumentInputSharedBuffers,
 	SharedBufferCPU& perPipelineSharedBuffer, SharedBufferCPU& perModelDataCSBuffer,
 	std::vector<SharedBufferGPUWriteOnly>& argumentOutputSharedBuffers,
@@ -710,7 +904,7 @@ void ModelBundleVSIndirect::RemovePipeline(
 	std::vector<SharedBufferGPUWriteOnly>& modelIndicesSharedBuffers
 ) noexcept {
 	// CS
-	PipelineModelsCSIndirect& csPipeline = m_pipelines[pipelineLocalIndex];
+	PipelineModelsCSIndirect<Arguments_t>& csPipeline = m_pipelines[pipelineLocalIndex];
 
 	csPipeline.ResetCullingData();
 
@@ -719,18 +913,19 @@ void ModelBundleVSIndirect::RemovePipeline(
 	);
 	// The cleanup will be done in _removePipeline
 
-	// VS
-	PipelineModelsVSIndirect& vsPipeline = m_vsPipelines[pipelineLocalIndex];
+	// Draw
+	PipelineModelsDrawIndirect<Arguments_t>& drawPipeline = m_drawPipelines[pipelineLocalIndex];
 
-	vsPipeline.RelinquishMemory(
+	drawPipeline.RelinquishMemory(
 		argumentOutputSharedBuffers, counterSharedBuffers, modelIndicesSharedBuffers
 	);
-	vsPipeline.CleanupData();
+	drawPipeline.CleanupData();
 
-	_removePipeline(pipelineLocalIndex);
+	this->_removePipeline(pipelineLocalIndex);
 }
 
-size_t ModelBundleVSIndirect::GetLocalPipelineIndex(std::uint32_t pipelineIndex)
+template<class Arguments_t>
+size_t ModelBundleIndirect<Arguments_t>::GetLocalPipelineIndex(std::uint32_t pipelineIndex)
 {
 	auto pipelineLocalIndex = std::numeric_limits<size_t>::max();
 
@@ -746,7 +941,8 @@ size_t ModelBundleVSIndirect::GetLocalPipelineIndex(std::uint32_t pipelineIndex)
 	return pipelineLocalIndex;
 }
 
-void ModelBundleVSIndirect::ReconfigureModels(
+template<class Arguments_t>
+void ModelBundleIndirect<Arguments_t>::ReconfigureModels(
 	std::uint32_t modelBundleIndex, std::uint32_t decreasedModelsPipelineIndex,
 	std::uint32_t increasedModelsPipelineIndex,
 	std::vector<SharedBufferCPU>& argumentInputSharedBuffers,
@@ -783,11 +979,13 @@ void ModelBundleVSIndirect::ReconfigureModels(
 
 	// Need to update the model count on the decreased pipeline. So, the Compute Shader
 	// doesn't process the moved model and the Vertex shader doesn't draw it.
-	PipelineModelsCSIndirect& csPipeline = m_pipelines[decreasedPipelineLocalIndex];
+	PipelineModelsCSIndirect<Arguments_t>& csPipeline = m_pipelines[decreasedPipelineLocalIndex];
 
 	csPipeline.UpdateNonPerFrameData(modelBundleIndex, pipelines);
 
-	m_vsPipelines[decreasedPipelineLocalIndex].SetModelCount(csPipeline.GetModelCount(pipelines));
+	m_drawPipelines[decreasedPipelineLocalIndex].SetModelCount(
+		csPipeline.GetModelCount(pipelines)
+	);
 
 	SetupPipelineBuffers(
 		increasedPipelineLocalIndex, modelBundleIndex, argumentInputSharedBuffers,
@@ -796,7 +994,8 @@ void ModelBundleVSIndirect::ReconfigureModels(
 	);
 }
 
-size_t ModelBundleVSIndirect::FindAddableStartIndex(
+template<class Arguments_t>
+size_t ModelBundleIndirect<Arguments_t>::FindAddableStartIndex(
 	size_t pipelineLocalIndex, size_t modelCount
 ) const noexcept {
 	auto addableStartIndex   = std::numeric_limits<size_t>::max();
@@ -807,7 +1006,7 @@ size_t ModelBundleVSIndirect::FindAddableStartIndex(
 
 	for (size_t index = pipelineLocalIndex; index > 0u; --index)
 	{
-		const PipelineModelsCSIndirect& pipeline = m_pipelines[index];
+		const PipelineModelsCSIndirect<Arguments_t>& pipeline = m_pipelines[index];
 
 		const size_t currentAddableModel = pipeline.GetAddableModelCount(pipelines);
 
@@ -828,7 +1027,7 @@ size_t ModelBundleVSIndirect::FindAddableStartIndex(
 	{
 		const size_t index = 0u;
 
-		const PipelineModelsCSIndirect& pipeline = m_pipelines[index];
+		const PipelineModelsCSIndirect<Arguments_t>& pipeline = m_pipelines[index];
 
 		const size_t currentAddableModel = pipeline.GetAddableModelCount(pipelines);
 
@@ -844,7 +1043,8 @@ size_t ModelBundleVSIndirect::FindAddableStartIndex(
 	return addableStartIndex;
 }
 
-void ModelBundleVSIndirect::ResizePreviousPipelines(
+template<class Arguments_t>
+void ModelBundleIndirect<Arguments_t>::ResizePreviousPipelines(
 	size_t addableStartIndex, size_t pipelineLocalIndex, std::uint32_t modelBundleIndex,
 	std::vector<SharedBufferCPU>& argumentInputSharedBuffers,
 	SharedBufferCPU& perPipelineSharedBuffer, SharedBufferCPU& perModelDataCSBuffer,
@@ -856,8 +1056,8 @@ void ModelBundleVSIndirect::ResizePreviousPipelines(
 
 	for (size_t index = addableStartIndex; index < pipelineLocalIndex; ++index)
 	{
-		PipelineModelsCSIndirect& csPipeline = m_pipelines[index];
-		PipelineModelsVSIndirect& vsPipeline = m_vsPipelines[index];
+		PipelineModelsCSIndirect<Arguments_t>& csPipeline = m_pipelines[index];
+		PipelineModelsDrawIndirect<Arguments_t>& drawPipeline = m_drawPipelines[index];
 
 		csPipeline.AllocateBuffers(
 			pipelines, argumentInputSharedBuffers, perPipelineSharedBuffer, perModelDataCSBuffer
@@ -865,15 +1065,16 @@ void ModelBundleVSIndirect::ResizePreviousPipelines(
 
 		csPipeline.UpdateNonPerFrameData(modelBundleIndex, pipelines);
 
-		vsPipeline.SetModelCount(csPipeline.GetModelCount(pipelines));
+		drawPipeline.SetModelCount(csPipeline.GetModelCount(pipelines));
 
-		vsPipeline.AllocateBuffers(
+		drawPipeline.AllocateBuffers(
 			argumentOutputSharedBuffers, counterSharedBuffers, modelIndicesSharedBuffers
 		);
 	}
 }
 
-void ModelBundleVSIndirect::RecreateFollowingPipelines(
+template<class Arguments_t>
+void ModelBundleIndirect<Arguments_t>::RecreateFollowingPipelines(
 	size_t pipelineLocalIndex, std::uint32_t modelBundleIndex,
 	std::vector<SharedBufferCPU>& argumentInputSharedBuffers,
 	SharedBufferCPU& perPipelineSharedBuffer, SharedBufferCPU& perModelDataCSBuffer,
@@ -887,8 +1088,8 @@ void ModelBundleVSIndirect::RecreateFollowingPipelines(
 
 	for (size_t index = pipelineLocalIndex; index < pipelineCount; ++index)
 	{
-		PipelineModelsCSIndirect& csPipeline = m_pipelines[index];
-		PipelineModelsVSIndirect& vsPipeline = m_vsPipelines[index];
+		PipelineModelsCSIndirect<Arguments_t>& csPipeline = m_pipelines[index];
+		PipelineModelsDrawIndirect<Arguments_t>& drawPipeline = m_drawPipelines[index];
 
 		// CS
 		// Must free the memory first, otherwise the buffers of the current pipeline
@@ -903,20 +1104,21 @@ void ModelBundleVSIndirect::RecreateFollowingPipelines(
 
 		csPipeline.UpdateNonPerFrameData(modelBundleIndex, pipelines);
 
-		// VS
-		vsPipeline.RelinquishMemory(
+		// Draw
+		drawPipeline.RelinquishMemory(
 			argumentOutputSharedBuffers, counterSharedBuffers, modelIndicesSharedBuffers
 		);
 
-		vsPipeline.SetModelCount(csPipeline.GetModelCount(pipelines));
+		drawPipeline.SetModelCount(csPipeline.GetModelCount(pipelines));
 
-		vsPipeline.AllocateBuffers(
+		drawPipeline.AllocateBuffers(
 			argumentOutputSharedBuffers, counterSharedBuffers, modelIndicesSharedBuffers
 		);
 	}
 }
 
-void ModelBundleVSIndirect::SetupPipelineBuffers(
+template<class Arguments_t>
+void ModelBundleIndirect<Arguments_t>::SetupPipelineBuffers(
 	std::uint32_t pipelineLocalIndex, std::uint32_t modelBundleIndex,
 	std::vector<SharedBufferCPU>& argumentInputSharedBuffers,
 	SharedBufferCPU& perPipelineSharedBuffer, SharedBufferCPU& perModelDataCSBuffer,
@@ -924,7 +1126,7 @@ void ModelBundleVSIndirect::SetupPipelineBuffers(
 	std::vector<SharedBufferGPUWriteOnly>& counterSharedBuffers,
 	std::vector<SharedBufferGPUWriteOnly>& modelIndicesSharedBuffers
 ) {
-	PipelineModelsCSIndirect& pipeline = m_pipelines[pipelineLocalIndex];
+	PipelineModelsCSIndirect<Arguments_t>& pipeline = m_pipelines[pipelineLocalIndex];
 
 	const std::vector<PipelineModelBundle>& pipelines = m_modelBundle->GetPipelines();
 
@@ -939,11 +1141,11 @@ void ModelBundleVSIndirect::SetupPipelineBuffers(
 
 		pipeline.UpdateNonPerFrameData(modelBundleIndex, pipelines);
 
-		PipelineModelsVSIndirect& vsPipeline = m_vsPipelines[pipelineLocalIndex];
+		PipelineModelsDrawIndirect<Arguments_t>& drawPipeline = m_drawPipelines[pipelineLocalIndex];
 
-		vsPipeline.SetModelCount(pipeline.GetModelCount(pipelines));
+		drawPipeline.SetModelCount(pipeline.GetModelCount(pipelines));
 
-		vsPipeline.AllocateBuffers(
+		drawPipeline.AllocateBuffers(
 			argumentOutputSharedBuffers, counterSharedBuffers, modelIndicesSharedBuffers
 		);
 	}
@@ -973,38 +1175,48 @@ void ModelBundleVSIndirect::SetupPipelineBuffers(
 	}
 }
 
-void ModelBundleVSIndirect::UpdatePipeline(
-	size_t pipelineLocalIndex, size_t frameIndex, const VkMeshBundleVS& meshBundle,
+template<class Arguments_t>
+void ModelBundleIndirect<Arguments_t>::UpdatePipeline(
+	size_t pipelineLocalIndex, size_t frameIndex, const MeshBundle_t& meshBundle,
 	bool skipCulling
 ) const noexcept {
 	if (!m_pipelines.IsInUse(pipelineLocalIndex))
 		return;
 
-	const Callisto::ReusableVector<Model>& models
-		= m_modelBundle->GetModelContainer()->GetModels();
+	const ModelContainer& modelContainer = *m_modelBundle->GetModelContainer();
 
 	const std::vector<std::uint32_t>& modelIndicesInContainer
 		= m_modelBundle->GetIndicesInContainer();
 
-	const PipelineModelsCSIndirect& vkPipeline = m_pipelines[pipelineLocalIndex];
+	const PipelineModelsCSIndirect<Arguments_t>& vkPipeline = m_pipelines[pipelineLocalIndex];
 
 	vkPipeline.Update(
-		frameIndex, meshBundle, skipCulling, models, modelIndicesInContainer,
+		frameIndex, meshBundle, skipCulling, modelContainer, modelIndicesInContainer,
 		m_modelBundle->GetPipeline(pipelineLocalIndex)
 	);
 }
 
-void ModelBundleVSIndirect::DrawPipeline(
+template<class Arguments_t>
+void ModelBundleIndirect<Arguments_t>::DrawPipeline(
 	size_t pipelineLocalIndex, size_t frameIndex, const VKCommandBuffer& graphicsBuffer,
-	VkPipelineLayout pipelineLayout, const VkMeshBundleVS& meshBundle
+	VkPipelineLayout pipelineLayout, const MeshBundle_t& meshBundle
 ) const noexcept {
 	if (!m_pipelines.IsInUse(pipelineLocalIndex))
 		return;
 
-	meshBundle.Bind(graphicsBuffer);
+	Arguments_t::BindMeshBundle(graphicsBuffer, pipelineLayout, meshBundle);
 
-	const PipelineModelsVSIndirect& pipeline = m_vsPipelines[pipelineLocalIndex];
+	const PipelineModelsDrawIndirect<Arguments_t>& pipeline = m_drawPipelines[pipelineLocalIndex];
 
 	pipeline.Draw(frameIndex, graphicsBuffer, pipelineLayout);
 }
+
+// The definitions of the Indirect classes are here, so they have to be instantiated for both
+// of the paths.
+template class PipelineModelsCSIndirect<IndirectArgumentsVS>;
+template class PipelineModelsCSIndirect<IndirectArgumentsMS>;
+template class PipelineModelsDrawIndirect<IndirectArgumentsVS>;
+template class PipelineModelsDrawIndirect<IndirectArgumentsMS>;
+template class ModelBundleIndirect<IndirectArgumentsVS>;
+template class ModelBundleIndirect<IndirectArgumentsMS>;
 }
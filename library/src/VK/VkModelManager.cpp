@@ -6,17 +6,103 @@
 namespace Terra
 {
 // Model Manager VS Individual
-void ModelManagerVSIndividual::SetGraphicsConstantRange(PipelineLayout& layout) noexcept
+ModelManagerVSIndividual::ModelManagerVSIndividual(
+	VkDevice device, MemoryManager* memoryManager, std::uint32_t frameCount
+) : ModelManagerCommon{}, m_argumentBuffers{}, m_instanceBuffers{}, m_instanceKeys{}
 {
-	// Push constants needs to be serialised according to the shader stages
-	constexpr std::uint32_t pushConstantSize = PipelineModelsVSIndividual::GetConstantBufferSize();
+	for (size_t _ = 0u; _ < frameCount; ++_)
+	{
+		m_argumentBuffers.emplace_back(device, memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		m_instanceBuffers.emplace_back(device, memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+	}
+}
 
-	layout.AddPushConstantRange(VK_SHADER_STAGE_VERTEX_BIT, pushConstantSize);
+void ModelManagerVSIndividual::SetDescriptorBufferLayoutVS(
+	std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
+) const noexcept {
+	for (VkDescriptorBuffer& descriptorBuffer : descriptorBuffers)
+		descriptorBuffer.AddBinding(
+			s_instanceIndicesVSBindingSlot, vsSetLayoutIndex, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			1u, VK_SHADER_STAGE_VERTEX_BIT
+		);
+}
+
+void ModelManagerVSIndividual::UpdateDrawArguments(
+	size_t frameIndex, const MeshManagerVSIndividual& meshManager,
+	const std::vector<std::uint8_t>* culledVisibilities,
+	VkDescriptorBuffer& descriptorBuffer, size_t vsSetLayoutIndex
+) {
+	TERRA_CPU_TRACE_ZONE("UpdateDrawArguments");
+
+	const size_t bundleCount = std::size(m_modelBundles);
+
+	size_t argumentCount = 0u;
+
+	for (size_t index = 0u; index < bundleCount; ++index)
+		if (m_modelBundles.IsInUse(index))
+			argumentCount += m_modelBundles[index].GetArgumentCount();
+
+	// Without any arguments, the pipelines wouldn't be updated and would keep their old draws.
+	if (!argumentCount)
+	{
+		for (size_t index = 0u; index < bundleCount; ++index)
+			if (m_modelBundles.IsInUse(index))
+				m_modelBundles[index].ResetDrawCounts();
+
+		return;
+	}
+
+	Buffer& argumentBuffer = m_argumentBuffers[frameIndex];
+
+	const auto argumentBufferSize = static_cast<VkDeviceSize>(
+		argumentCount * PipelineModelsVSIndividual::GetArgumentStride()
+	);
+
+	if (argumentBuffer.BufferSize() < argumentBufferSize)
+		argumentBuffer.Create(argumentBufferSize, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, {});
+
+	Buffer& instanceBuffer = m_instanceBuffers[frameIndex];
+
+	const auto instanceBufferSize = static_cast<VkDeviceSize>(
+		argumentCount * PipelineModelsVSIndividual::GetInstanceStride()
+	);
+
+	if (instanceBuffer.BufferSize() < instanceBufferSize)
+	{
+		instanceBuffer.Create(instanceBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, {});
+
+		descriptorBuffer.SetStorageBufferDescriptor(
+			instanceBuffer, s_instanceIndicesVSBindingSlot, vsSetLayoutIndex, 0u
+		);
+	}
+
+	std::uint8_t* argumentBufferStart = argumentBuffer.CPUHandle();
+	std::uint8_t* instanceBufferStart = instanceBuffer.CPUHandle();
+
+	PipelineModelsVSIndividual::ArgumentOffsets offsets{
+		.argumentOffset = 0u,
+		.instanceOffset = 0u
+	};
+
+	for (size_t index = 0u; index < bundleCount; ++index)
+	{
+		if (!m_modelBundles.IsInUse(index))
+			continue;
+
+		ModelBundleVSIndividual& modelBundle = m_modelBundles[index];
+
+		const VkMeshBundleVS& meshBundle = meshManager.GetBundle(modelBundle.GetMeshBundleIndex());
+
+		offsets = modelBundle.UpdateArguments(
+			argumentBufferStart, instanceBufferStart, offsets, m_instanceKeys, meshBundle,
+			culledVisibilities
+		);
+	}
 }
 
 void ModelManagerVSIndividual::DrawPipeline(
-	size_t modelBundleIndex, size_t pipelineLocalIndex, const VKCommandBuffer& graphicsBuffer,
-	const MeshManagerVSIndividual& meshManager, VkPipelineLayout pipelineLayout
+	size_t frameIndex, size_t modelBundleIndex, size_t pipelineLocalIndex,
+	const VKCommandBuffer& graphicsBuffer, const MeshManagerVSIndividual& meshManager
 ) const noexcept {
 	if (!m_modelBundles.IsInUse(modelBundleIndex))
 		return;
@@ -27,14 +113,17 @@ void ModelManagerVSIndividual::DrawPipeline(
 	const VkMeshBundleVS& meshBundle = meshManager.GetBundle(modelBundle.GetMeshBundleIndex());
 
 	// Model
-	modelBundle.DrawPipeline(pipelineLocalIndex, graphicsBuffer, pipelineLayout, meshBundle);
+	modelBundle.DrawPipeline(
+		pipelineLocalIndex, graphicsBuffer, meshBundle, m_argumentBuffers[frameIndex]
+	);
 }
 
-// Model Manager VS Indirect.
-ModelManagerVSIndirect::ModelManagerVSIndirect(
+// Model Manager Indirect.
+template<class Arguments_t>
+ModelManagerIndirect<Arguments_t>::ModelManagerIndirect(
 	VkDevice device, MemoryManager* memoryManager, QueueIndices3 queueIndices3,
 	std::uint32_t frameCount
-) : ModelManager{}, m_argumentInputBuffers{}, m_argumentOutputBuffers{},
+) : ModelManager<ModelBundle_t>{}, m_argumentInputBuffers{}, m_argumentOutputBuffers{},
 	m_modelIndicesBuffers{},
 	m_perPipelineBuffer{
 		device, memoryManager, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
@@ -48,7 +137,10 @@ ModelManagerVSIndirect::ModelManagerVSIndirect(
 		device, memoryManager, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 		queueIndices3.ResolveQueueIndices<QueueIndicesTC>()
 	}, m_queueIndices3{ queueIndices3 }, m_dispatchXCount{ 0u }, m_allocatedModelCount{ 0u },
-	m_csPSOIndex{ 0u }
+	m_csPSOIndex{ 0u },
+	m_modelVisibilityBuffer{ device, memoryManager, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT },
+	m_drawCountReadbackBuffers{}, m_occlusionCSPSOIndex{ 0u }, m_clearModelVisibility{ false },
+	m_drawCountReadback{ false }
 {
 	for (size_t _ = 0u; _ < frameCount; ++_)
 	{
@@ -77,17 +169,15 @@ ModelManagerVSIndirect::ModelManagerVSIndirect(
 				m_queueIndices3.ResolveQueueIndices<QueueIndicesCG>()
 			}
 		);
+		// Only created if the readback is enabled.
+		m_drawCountReadbackBuffers.emplace_back(
+			device, memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+		);
 	}
 }
 
-void ModelManagerVSIndirect::SetGraphicsConstantRange(PipelineLayout& layout) noexcept
-{
-	constexpr std::uint32_t pushConstantSize = PipelineModelsVSIndirect::GetConstantBufferSize();
-
-	layout.AddPushConstantRange(VK_SHADER_STAGE_VERTEX_BIT, pushConstantSize);
-}
-
-void ModelManagerVSIndirect::SetComputeConstantRange(PipelineLayout& layout) noexcept
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::SetComputeConstantRange(PipelineLayout& layout) noexcept
 {
 	// Push constants needs to be serialised according to the shader stages
 	constexpr std::uint32_t pushConstantSize = GetConstantBufferSize();
@@ -95,7 +185,8 @@ void ModelManagerVSIndirect::SetComputeConstantRange(PipelineLayout& layout) noe
 	layout.AddPushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, pushConstantSize);
 }
 
-void ModelManagerVSIndirect::ReconfigureModels(
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::ReconfigureModels(
 	std::uint32_t bundleIndex, std::uint32_t decreasedModelsPipelineIndex,
 	std::uint32_t increasedModelsPipelineIndex
 ) {
@@ -106,7 +197,8 @@ void ModelManagerVSIndirect::ReconfigureModels(
 	);
 }
 
-void ModelManagerVSIndirect::UpdateAllocatedModelCount() noexcept
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::UpdateAllocatedModelCount() noexcept
 {
 	// We can't reduce the amount of allocated model count, as we don't deallocate. We only
 	// make the memory available for something else. So, if a bundle from the middle is freed
@@ -115,7 +207,7 @@ void ModelManagerVSIndirect::UpdateAllocatedModelCount() noexcept
 	// in some freed memory. We should set the model count to the total allocated model count, that
 	// way it won't skip the last ones and also not unnecessarily add extra ones.
 	m_allocatedModelCount = static_cast<std::uint32_t>(
-		m_perModelBuffer.Size() / PipelineModelsCSIndirect::GetPerModelStride()
+		m_perModelBuffer.Size() / PipelineModelsCSIndirect<Arguments_t>::GetPerModelStride()
 	);
 
 	// ThreadBlockSize is the number of threads in a thread group. If the allocated model count
@@ -126,13 +218,15 @@ void ModelManagerVSIndirect::UpdateAllocatedModelCount() noexcept
 	);
 }
 
-std::uint32_t ModelManagerVSIndirect::AddModelBundle(std::shared_ptr<ModelBundle>&& modelBundle)
-{
-	const size_t bundleIndex  = m_modelBundles.Add(ModelBundleVSIndirect{});
+template<class Arguments_t>
+std::uint32_t ModelManagerIndirect<Arguments_t>::AddModelBundle(
+	std::shared_ptr<ModelBundle>&& modelBundle
+) {
+	const size_t bundleIndex  = m_modelBundles.Add(ModelBundle_t{});
 
 	const auto bundleIndexU32 = static_cast<std::uint32_t>(bundleIndex);
 
-	ModelBundleVSIndirect& localModelBundle = m_modelBundles[bundleIndex];
+	ModelBundle_t& localModelBundle = m_modelBundles[bundleIndex];
 
 	localModelBundle.SetModelBundle(std::move(modelBundle));
 
@@ -147,15 +241,21 @@ std::uint32_t ModelManagerVSIndirect::AddModelBundle(std::shared_ptr<ModelBundle
 
 	UpdateAllocatedModelCount();
 
+	UpdateModelVisibilityBuffer();
+
+	if (m_drawCountReadback)
+		UpdateDrawCountReadbackBuffers();
+
 	return bundleIndexU32;
 }
 
-std::shared_ptr<ModelBundle> ModelManagerVSIndirect::RemoveModelBundle(
+template<class Arguments_t>
+std::shared_ptr<ModelBundle> ModelManagerIndirect<Arguments_t>::RemoveModelBundle(
 	std::uint32_t bundleIndex
 ) noexcept {
 	const size_t bundleIndexST = bundleIndex;
 
-	ModelBundleVSIndirect& localModelBundle = m_modelBundles[bundleIndexST];
+	ModelBundle_t& localModelBundle = m_modelBundles[bundleIndexST];
 
 	std::shared_ptr<ModelBundle> modelBundle = localModelBundle.GetModelBundle();
 
@@ -169,58 +269,8 @@ std::shared_ptr<ModelBundle> ModelManagerVSIndirect::RemoveModelBundle(
 	return modelBundle;
 }
 
-void ModelManagerVSIndirect::UpdatePipelinePerFrame(
-	VkDeviceSize frameIndex, size_t modelBundleIndex, size_t pipelineLocalIndex,
-	const MeshManagerVSIndirect& meshManager, bool skipCulling
-) const noexcept {
-	std::uint8_t* bufferOffsetPtr = m_perModelBundleBuffer.GetInstancePtr(frameIndex);
-	constexpr size_t strideSize   = sizeof(PerModelBundleData);
-
-	if (!m_modelBundles.IsInUse(modelBundleIndex))
-		return;
-
-	const VkDeviceSize bufferOffset       = strideSize * modelBundleIndex;
-
-	const ModelBundleVSIndirect& vsBundle = m_modelBundles[modelBundleIndex];
-
-	const std::uint32_t meshBundleIndex   = vsBundle.GetMeshBundleIndex();
-
-	const VkMeshBundleVS& meshBundle      = meshManager.GetBundle(meshBundleIndex);
-
-	vsBundle.UpdatePipeline(
-		pipelineLocalIndex, static_cast<size_t>(frameIndex), meshBundle, skipCulling
-	);
-
-	memcpy(bufferOffsetPtr + bufferOffset, &meshBundleIndex, strideSize);
-}
-
-void ModelManagerVSIndirect::SetDescriptorBufferLayoutVS(
-	std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
-) const noexcept {
-	for (VkDescriptorBuffer& descriptorBuffer : descriptorBuffers)
-		descriptorBuffer.AddBinding(
-			s_modelIndicesVSBindingSlot, vsSetLayoutIndex, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u,
-			VK_SHADER_STAGE_VERTEX_BIT
-		);
-}
-
-void ModelManagerVSIndirect::SetDescriptorBuffersVS(
-	std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
-) const {
-	const size_t frameCount = std::size(descriptorBuffers);
-
-	for (size_t index = 0u; index < frameCount; ++index)
-	{
-		VkDescriptorBuffer& descriptorBuffer = descriptorBuffers[index];
-
-		descriptorBuffer.SetStorageBufferDescriptor(
-			m_modelIndicesBuffers[index].GetBuffer(), s_modelIndicesVSBindingSlot,
-			vsSetLayoutIndex, 0u
-		);
-	}
-}
-
-void ModelManagerVSIndirect::SetDescriptorBufferLayoutCS(
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::SetDescriptorBufferLayoutCS(
 	std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t csSetLayoutIndex
 ) const noexcept {
 	for (VkDescriptorBuffer& descriptorBuffer : descriptorBuffers)
@@ -253,10 +303,15 @@ void ModelManagerVSIndirect::SetDescriptorBufferLayoutCS(
 			s_modelIndicesVSCSBindingSlot, csSetLayoutIndex, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u,
 			VK_SHADER_STAGE_COMPUTE_BIT
 		);
+		descriptorBuffer.AddBinding(
+			s_modelVisibilityBindingSlot, csSetLayoutIndex, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u,
+			VK_SHADER_STAGE_COMPUTE_BIT
+		);
 	}
 }
 
-void ModelManagerVSIndirect::SetDescriptorBuffersCS(
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::SetDescriptorBuffersCS(
 	std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t csSetLayoutIndex
 ) const {
 	const size_t frameCount = std::size(descriptorBuffers);
@@ -290,10 +345,16 @@ void ModelManagerVSIndirect::SetDescriptorBuffersCS(
 		m_perModelBundleBuffer.SetDescriptorBuffer(
 			descriptorBuffer, s_perModelBundleBindingSlot, csSetLayoutIndex
 		);
+
+		if (m_modelVisibilityBuffer.BufferSize())
+			descriptorBuffer.SetStorageBufferDescriptor(
+				m_modelVisibilityBuffer, s_modelVisibilityBindingSlot, csSetLayoutIndex, 0u
+			);
 	}
 }
 
-void ModelManagerVSIndirect::Dispatch(
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::Dispatch(
 	const VKCommandBuffer& computeBuffer,
 	const PipelineManager<ComputePipeline_t>& pipelineManager
 ) const noexcept {
@@ -308,7 +369,8 @@ void ModelManagerVSIndirect::Dispatch(
 
 		const ConstantData constantData
 		{
-			.allocatedModelCount = m_allocatedModelCount
+			.allocatedModelCount = m_allocatedModelCount,
+			.occlusionPhase      = 0u
 		};
 
 		vkCmdPushConstants(
@@ -320,24 +382,123 @@ void ModelManagerVSIndirect::Dispatch(
 	vkCmdDispatch(cmdBuffer, m_dispatchXCount, 1u, 1u);
 }
 
-void ModelManagerVSIndirect::DrawPipeline(
-	size_t frameIndex, size_t modelBundleIndex, size_t pipelineLocalIndex,
-	const VKCommandBuffer& graphicsBuffer, const MeshManagerVSIndirect& meshManager,
-	VkPipelineLayout pipelineLayout
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::DispatchOcclusion(
+	const VKCommandBuffer& computeBuffer,
+	const PipelineManager<ComputePipeline_t>& pipelineManager, std::uint32_t occlusionPhase
+) {
+	VkCommandBuffer cmdBuffer = computeBuffer.Get();
+
+	if (occlusionPhase == 0u)
+	{
+		// The new models shouldn't be drawn in the first phase, as they weren't tested yet.
+		if (m_clearModelVisibility)
+		{
+			vkCmdFillBuffer(cmdBuffer, m_modelVisibilityBuffer.Get(), 0u, VK_WHOLE_SIZE, 0u);
+
+			m_clearModelVisibility = false;
+		}
+
+		// The visibilities were written by the second phase of the last frame, which might be
+		// in a different submission.
+		VkBufferBarrier2{}.AddMemoryBarrier(
+			BufferBarrierBuilder{}
+			.Buffer(m_modelVisibilityBuffer, m_modelVisibilityBuffer.BufferSize())
+			.AccessMasks(
+				VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT,
+				VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT
+			)
+			.StageMasks(
+				VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+				VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+			)
+		).RecordBarriers(cmdBuffer);
+	}
+
+	pipelineManager.BindPipeline(m_occlusionCSPSOIndex, computeBuffer);
+
+	{
+		constexpr auto pushConstantSize = GetConstantBufferSize();
+
+		const ConstantData constantData
+		{
+			.allocatedModelCount = m_allocatedModelCount,
+			.occlusionPhase      = occlusionPhase
+		};
+
+		vkCmdPushConstants(
+			cmdBuffer, pipelineManager.GetLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0u,
+			pushConstantSize, &constantData
+		);
+	}
+
+	vkCmdDispatch(cmdBuffer, m_dispatchXCount, 1u, 1u);
+}
+
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::SetDrawCountReadback(bool value)
+{
+	m_drawCountReadback = value;
+
+	if (m_drawCountReadback)
+		UpdateDrawCountReadbackBuffers();
+}
+
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::CopyDrawCounts(
+	const VKCommandBuffer& computeBuffer, size_t frameIndex, std::uint32_t occlusionPhase
 ) const noexcept {
-	if (!m_modelBundles.IsInUse(modelBundleIndex))
-		return;
+	const Buffer& readbackBuffer   = m_drawCountReadbackBuffers[frameIndex];
+	const VkDeviceSize counterSize = m_counterResetBuffer.BufferSize();
 
-	const ModelBundleVSIndirect& modelBundle = m_modelBundles[modelBundleIndex];
+	if (!readbackBuffer.BufferSize())
+		return;
 
-	const VkMeshBundleVS& meshBundle = meshManager.GetBundle(modelBundle.GetMeshBundleIndex());
+	const SharedBufferGPUWriteOnly& counterBuffer = m_counterBuffers[frameIndex];
+	VkCommandBuffer cmdBuffer                     = computeBuffer.Get();
 
-	modelBundle.DrawPipeline(
-		pipelineLocalIndex, frameIndex, graphicsBuffer, pipelineLayout, meshBundle
+	VkBufferBarrier2{}.AddMemoryBarrier(
+		BufferBarrierBuilder{}
+		.Buffer(counterBuffer.GetBuffer(), counterSize)
+		.AccessMasks(VK_ACCESS_2_SHADER_WRITE_BIT, VK_ACCESS_2_TRANSFER_READ_BIT)
+		.StageMasks(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_TRANSFER_BIT)
+	).RecordBarriers(cmdBuffer);
+
+	computeBuffer.Copy(
+		counterBuffer.GetBuffer(), readbackBuffer,
+		BufferToBufferCopyBuilder{}.Size(counterSize).DstOffset(counterSize * occlusionPhase)
 	);
+
+	// Without the occlusion culling, there is no second phase.
+	if (occlusionPhase == 0u)
+		vkCmdFillBuffer(cmdBuffer, readbackBuffer.Get(), counterSize, counterSize, 0u);
+}
+
+template<class Arguments_t>
+std::uint32_t ModelManagerIndirect<Arguments_t>::GetDrawCount(size_t frameIndex) const noexcept
+{
+	const Buffer& readbackBuffer = m_drawCountReadbackBuffers[frameIndex];
+
+	const std::uint8_t* bufferStart = readbackBuffer.CPUHandle();
+	const VkDeviceSize bufferSize   = readbackBuffer.BufferSize();
+	constexpr size_t counterSize    = sizeof(std::uint32_t);
+
+	std::uint32_t drawCount = 0u;
+
+	for (VkDeviceSize offset = 0u; offset < bufferSize; offset += counterSize)
+	{
+		std::uint32_t counter = 0u;
+
+		memcpy(&counter, bufferStart + offset, counterSize);
+
+		drawCount += counter;
+	}
+
+	return drawCount;
 }
 
-void ModelManagerVSIndirect::ResetCounterBuffer(
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::ResetCounterBuffer(
 	const VKCommandBuffer& computeCmdBuffer, size_t frameIndex
 ) const noexcept {
 	const SharedBufferGPUWriteOnly& counterBuffer = m_counterBuffers[frameIndex];
@@ -352,7 +513,42 @@ void ModelManagerVSIndirect::ResetCounterBuffer(
 	).RecordBarriers(computeCmdBuffer.Get());
 }
 
-void ModelManagerVSIndirect::UpdateCounterResetValues()
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::UpdateModelVisibilityBuffer()
+{
+	const VkDeviceSize visibilityBufferSize
+		= static_cast<VkDeviceSize>(m_allocatedModelCount) * sizeof(std::uint32_t);
+
+	if (visibilityBufferSize > m_modelVisibilityBuffer.BufferSize())
+	{
+		// The old visibilities aren't kept, so every model will be drawn in the second phase of
+		// the next frame.
+		m_modelVisibilityBuffer.Create(
+			visibilityBufferSize,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, {}
+		);
+
+		m_clearModelVisibility = true;
+	}
+}
+
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::UpdateDrawCountReadbackBuffers()
+{
+	const VkDeviceSize readbackBufferSize
+		= m_counterResetBuffer.BufferSize() * s_drawCountPhaseCount;
+
+	for (Buffer& readbackBuffer : m_drawCountReadbackBuffers)
+		if (readbackBufferSize > readbackBuffer.BufferSize())
+		{
+			readbackBuffer.Create(readbackBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, {});
+
+			memset(readbackBuffer.CPUHandle(), 0, static_cast<size_t>(readbackBufferSize));
+		}
+}
+
+template<class Arguments_t>
+void ModelManagerIndirect<Arguments_t>::UpdateCounterResetValues()
 {
 	if (!std::empty(m_counterBuffers))
 	{
@@ -379,6 +575,96 @@ void ModelManagerVSIndirect::UpdateCounterResetValues()
 	}
 }
 
+// The definitions are here, so they have to be instantiated for both of the paths.
+template class ModelManagerIndirect<IndirectArgumentsVS>;
+template class ModelManagerIndirect<IndirectArgumentsMS>;
+
+// Model Manager VS Indirect.
+void ModelManagerVSIndirect::SetGraphicsConstantRange(PipelineLayout& layout) noexcept
+{
+	constexpr std::uint32_t pushConstantSize = PipelineModelsVSIndirect::GetConstantBufferSize();
+
+	layout.AddPushConstantRange(VK_SHADER_STAGE_VERTEX_BIT, pushConstantSize);
+}
+
+void ModelManagerVSIndirect::SetDescriptorBufferLayoutVS(
+	std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
+) const noexcept {
+	for (VkDescriptorBuffer& descriptorBuffer : descriptorBuffers)
+		descriptorBuffer.AddBinding(
+			s_modelIndicesVSBindingSlot, vsSetLayoutIndex, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u,
+			VK_SHADER_STAGE_VERTEX_BIT
+		);
+}
+
+void ModelManagerVSIndirect::SetDescriptorBuffersVS(
+	std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t vsSetLayoutIndex
+) const {
+	const size_t frameCount = std::size(descriptorBuffers);
+
+	for (size_t index = 0u; index < frameCount; ++index)
+	{
+		VkDescriptorBuffer& descriptorBuffer = descriptorBuffers[index];
+
+		descriptorBuffer.SetStorageBufferDescriptor(
+			m_modelIndicesBuffers[index].GetBuffer(), s_modelIndicesVSBindingSlot,
+			vsSetLayoutIndex, 0u
+		);
+	}
+}
+
+// Model Manager MS Indirect.
+void ModelManagerMSIndirect::SetGraphicsConstantRange(PipelineLayout& layout) noexcept
+{
+	// The model offset is after the constants of the mesh bundle.
+	constexpr std::uint32_t modelConstantSize = PipelineModelsMSIndirect::GetConstantBufferSize();
+	constexpr std::uint32_t meshConstantSize  = VkMeshBundleMS::GetConstantBufferSize();
+
+	layout.AddPushConstantRange(
+		VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT,
+		modelConstantSize + meshConstantSize
+	);
+}
+
+void ModelManagerMSIndirect::SetDescriptorBufferLayoutMS(
+	std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t msSetLayoutIndex
+) const noexcept {
+	constexpr VkShaderStageFlags shaderStages
+		= VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+
+	for (VkDescriptorBuffer& descriptorBuffer : descriptorBuffers)
+	{
+		descriptorBuffer.AddBinding(
+			s_modelIndicesMSBindingSlot, msSetLayoutIndex, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u,
+			shaderStages
+		);
+		descriptorBuffer.AddBinding(
+			s_argumentOutputMSBindingSlot, msSetLayoutIndex, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			1u, shaderStages
+		);
+	}
+}
+
+void ModelManagerMSIndirect::SetDescriptorBuffersMS(
+	std::vector<VkDescriptorBuffer>& descriptorBuffers, size_t msSetLayoutIndex
+) const {
+	const size_t frameCount = std::size(descriptorBuffers);
+
+	for (size_t index = 0u; index < frameCount; ++index)
+	{
+		VkDescriptorBuffer& descriptorBuffer = descriptorBuffers[index];
+
+		descriptorBuffer.SetStorageBufferDescriptor(
+			m_modelIndicesBuffers[index].GetBuffer(), s_modelIndicesMSBindingSlot,
+			msSetLayoutIndex, 0u
+		);
+		descriptorBuffer.SetStorageBufferDescriptor(
+			m_argumentOutputBuffers[index].GetBuffer(), s_argumentOutputMSBindingSlot,
+			msSetLayoutIndex, 0u
+		);
+	}
+}
+
 // Model Manager MS.
 void ModelManagerMS::SetGraphicsConstantRange(PipelineLayout& layout) noexcept
 {
@@ -396,7 +682,7 @@ void ModelManagerMS::SetGraphicsConstantRange(PipelineLayout& layout) noexcept
 void ModelManagerMS::DrawPipeline(
 	size_t modelBundleIndex, size_t pipelineLocalIndex,
 	const VKCommandBuffer& graphicsBuffer, const MeshManagerMS& meshManager,
-	VkPipelineLayout pipelineLayout
+	VkPipelineLayout pipelineLayout, const std::vector<std::uint8_t>* culledVisibilities
 ) const noexcept {
 	if (!m_modelBundles.IsInUse(modelBundleIndex))
 		return;
@@ -407,6 +693,8 @@ void ModelManagerMS::DrawPipeline(
 	const VkMeshBundleMS& meshBundle = meshManager.GetBundle(modelBundle.GetMeshBundleIndex());
 
 	// Model
-	modelBundle.DrawPipeline(pipelineLocalIndex, graphicsBuffer, pipelineLayout, meshBundle);
+	modelBundle.DrawPipeline(
+		pipelineLocalIndex, graphicsBuffer, pipelineLayout, meshBundle, culledVisibilities
+	);
 }
 }
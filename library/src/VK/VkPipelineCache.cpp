@@ -0,0 +1,202 @@
+#include <VkPipelineCache.hpp>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <algorithm>
+
+namespace Terra
+{
+PipelineCache::PipelineCache(VkDevice device)
+	: m_device{ device }, m_pipelineCache{ VK_NULL_HANDLE }, m_header{}, m_cacheFilePath{},
+	m_hitCount{ 0u }, m_missCount{ 0u }
+{}
+
+PipelineCache::~PipelineCache() noexcept
+{
+	SelfDestruct();
+}
+
+void PipelineCache::SelfDestruct() noexcept
+{
+	if (m_pipelineCache != VK_NULL_HANDLE)
+	{
+		// Failing to write the file isn't an error, the pipelines would just be compiled again
+		// on the next launch.
+		[[maybe_unused]] const bool saved = Save();
+
+		vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+	}
+}
+
+void PipelineCache::Create(VkPhysicalDevice physicalDevice)
+{
+	VkPhysicalDeviceProperties properties{};
+
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	m_header = FileHeader{
+		.magic         = s_fileMagic,
+		.driverVersion = properties.driverVersion,
+		.vendorID      = properties.vendorID,
+		.deviceID      = properties.deviceID,
+		.dataSize      = 0u
+	};
+
+	std::ranges::copy(properties.pipelineCacheUUID, std::begin(m_header.pipelineCacheUUID));
+
+	m_pipelineCache = CreatePipelineCache({});
+}
+
+void PipelineCache::LoadFromDirectory(const std::wstring& directory)
+{
+	m_cacheFilePath = (std::filesystem::path{ directory } / GetCacheFileName()).wstring();
+
+	const std::vector<std::uint8_t> cacheData = LoadCacheData();
+
+	if (std::empty(cacheData))
+		return;
+
+	VkPipelineCache loadedCache = CreatePipelineCache(cacheData);
+
+	// The current cache is kept if the driver rejects the data.
+	if (loadedCache == VK_NULL_HANDLE)
+		return;
+
+	// Keeping the pipelines which were compiled before the directory was set.
+	if (m_pipelineCache != VK_NULL_HANDLE)
+	{
+		vkMergePipelineCaches(m_device, loadedCache, 1u, &m_pipelineCache);
+
+		vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+	}
+
+	m_pipelineCache = loadedCache;
+}
+
+bool PipelineCache::Save() const
+{
+	if (std::empty(m_cacheFilePath) || m_pipelineCache == VK_NULL_HANDLE)
+		return false;
+
+	size_t dataSize = 0u;
+
+	vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, nullptr);
+
+	std::vector<std::uint8_t> cacheData(dataSize);
+
+	vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, std::data(cacheData));
+
+	std::ofstream cacheFile{
+		std::filesystem::path{ m_cacheFilePath }, std::ios_base::binary | std::ios_base::trunc
+	};
+
+	if (!cacheFile.is_open())
+		return false;
+
+	FileHeader header = m_header;
+	header.dataSize   = static_cast<std::uint64_t>(dataSize);
+
+	cacheFile.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+	cacheFile.write(
+		reinterpret_cast<const char*>(std::data(cacheData)), static_cast<std::streamsize>(dataSize)
+	);
+
+	return cacheFile.good();
+}
+
+std::vector<std::uint8_t> PipelineCache::LoadCacheData() const
+{
+	std::vector<std::uint8_t> cacheData{};
+
+	std::ifstream cacheFile{ std::filesystem::path{ m_cacheFilePath }, std::ios_base::binary };
+
+	if (!cacheFile.is_open())
+		return cacheData;
+
+	FileHeader header{};
+
+	cacheFile.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+
+	// The driver should also reject an incompatible cache, but a file from a different
+	// driver shouldn't be loaded at all.
+	if (!cacheFile.good() || !IsHeaderValid(header))
+		return cacheData;
+
+	// The size is read from the file, so it shouldn't be allocated before checking it against
+	// the rest of the file. A truncated or a corrupted file would be discarded.
+	const std::streamoff dataStart = cacheFile.tellg();
+
+	cacheFile.seekg(0, std::ios_base::end);
+
+	const std::streamoff fileEnd = cacheFile.tellg();
+
+	if (dataStart < 0 || fileEnd < dataStart
+		|| static_cast<std::uint64_t>(fileEnd - dataStart) != header.dataSize)
+		return cacheData;
+
+	cacheFile.seekg(dataStart);
+
+	cacheData.resize(static_cast<size_t>(header.dataSize));
+
+	cacheFile.read(
+		reinterpret_cast<char*>(std::data(cacheData)),
+		static_cast<std::streamsize>(header.dataSize)
+	);
+
+	if (static_cast<std::uint64_t>(cacheFile.gcount()) != header.dataSize)
+		cacheData.clear();
+
+	return cacheData;
+}
+
+std::wstring PipelineCache::GetCacheFileName() const
+{
+	constexpr const wchar_t* hexDigits = L"0123456789abcdef";
+
+	std::wstring fileName = L"PipelineCache_";
+
+	for (std::uint8_t value : m_header.pipelineCacheUUID)
+	{
+		fileName.push_back(hexDigits[value >> 4u]);
+		fileName.push_back(hexDigits[value & 0xFu]);
+	}
+
+	fileName += L"_" + std::to_wstring(m_header.driverVersion) + L".bin";
+
+	return fileName;
+}
+
+bool PipelineCache::IsHeaderValid(const FileHeader& header) const noexcept
+{
+	return header.magic == s_fileMagic && header.driverVersion == m_header.driverVersion
+		&& header.vendorID == m_header.vendorID && header.deviceID == m_header.deviceID
+		&& header.pipelineCacheUUID == m_header.pipelineCacheUUID;
+}
+
+VkPipelineCache PipelineCache::CreatePipelineCache(
+	const std::vector<std::uint8_t>& initialData
+) const {
+	VkPipelineCacheCreateInfo createInfo{
+		.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+		.initialDataSize = std::size(initialData),
+		.pInitialData    = std::data(initialData)
+	};
+
+	VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+
+	vkCreatePipelineCache(m_device, &createInfo, nullptr, &pipelineCache);
+
+	return pipelineCache;
+}
+
+void PipelineCache::AddCreationFeedback(const VkPipelineCreationFeedback& feedback) noexcept
+{
+	if (!(feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT))
+		return;
+
+	if (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT)
+		++m_hitCount;
+	else
+		++m_missCount;
+}
+}
@@ -1,4 +1,8 @@
 #include <VkRenderEngine.hpp>
+#include <TerraException.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
 
 namespace Terra
 {
@@ -9,6 +13,38 @@ void RenderEngineDeviceExtension::SetDeviceExtensions(
 	extensionManager.AddExtensions(MemoryManager::GetRequiredExtensions());
 }
 
+void RenderEngine::CheckShaderInterfaceVersion(const std::wstring& shaderPath)
+{
+	const std::filesystem::path versionFilePath
+		= std::filesystem::path{ shaderPath } / L"ShaderInterfaceVersion.txt";
+
+	// The shaders built before the version file was added can't be checked, so they are
+	// treated as unversioned and only warned about.
+	if (!std::filesystem::exists(versionFilePath))
+	{
+		std::cerr << "Shader Warning: The shader directory doesn't have a "
+			"ShaderInterfaceVersion.txt file, so the shaders are treated as unversioned.\n";
+
+		return;
+	}
+
+	std::ifstream versionFile{ versionFilePath };
+
+	std::uint32_t shaderInterfaceVersion = 0u;
+
+	if (!(versionFile >> shaderInterfaceVersion))
+		throw Exception(
+			"Shader Error", "The ShaderInterfaceVersion.txt file doesn't have a version number."
+		);
+
+	if (shaderInterfaceVersion != s_shaderInterfaceVersion)
+		throw Exception(
+			"Shader Error",
+			"The shaders were built for interface version " + std::to_string(shaderInterfaceVersion)
+			+ " but the renderer needs version " + std::to_string(s_shaderInterfaceVersion) + "."
+		);
+}
+
 RenderEngine::RenderEngine(
 	const VkDeviceManager& deviceManager, std::shared_ptr<ThreadPool> threadPool, size_t frameCount
 ) : RenderEngine {
@@ -25,6 +61,8 @@ RenderEngine::RenderEngine(
 	size_t frameCount
 ) : m_threadPool{ std::move(threadPool) },
 	m_memoryManager{ std::make_unique<MemoryManager>(physicalDevice, logicalDevice, 20_MB, 400_KB) },
+	m_pipelineCache{ std::make_unique<PipelineCache>(logicalDevice) },
+	m_pipelineManifest{ std::make_unique<PipelineManifest>() },
 	m_graphicsQueue{
 		logicalDevice,
 		queueFamilyManager->GetQueue(QueueType::GraphicsQueue),
@@ -38,15 +76,23 @@ RenderEngine::RenderEngine(
 	m_stagingManager{ logicalDevice, m_memoryManager.get(), m_threadPool.get(), queueFamilyManager},
 	m_externalResourceManager{ logicalDevice, m_memoryManager.get() },
 	m_graphicsDescriptorBuffers{},
+	m_sharedGraphicsDescriptorBuffer{
+		logicalDevice, m_memoryManager.get(), s_graphicsPipelineSetLayoutCount
+	},
 	m_graphicsPipelineLayout{ logicalDevice },
 	m_textureStorage{ logicalDevice, m_memoryManager.get() },
-	m_textureManager{ logicalDevice, m_memoryManager.get() },
+	m_textureManager{ physicalDevice, logicalDevice, m_memoryManager.get() },
 	m_cameraManager{ logicalDevice, m_memoryManager.get() },
+	m_gpuProfiler{ logicalDevice },
 	m_viewportAndScissors{}, m_temporaryDataBuffer{}, m_renderPasses{}, m_swapchainRenderPass{},
-	m_gpuCopyNecessary{ false }
+	m_descriptorRetirementFrameCount{ 0u }, m_gpuCopyNecessary{ false }
 {
 	VkDescriptorBuffer::SetDescriptorBufferInfo(physicalDevice);
 
+	m_pipelineCache->Create(physicalDevice);
+
+	m_gpuProfiler.Create(physicalDevice, *queueFamilyManager, frameCount);
+
 	for (size_t _ = 0u; _ < frameCount; ++_)
 	{
 		m_graphicsDescriptorBuffers.emplace_back(
@@ -69,9 +115,7 @@ RenderEngine::RenderEngine(
 
 size_t RenderEngine::AddTextureAsCombined(STexture&& texture)
 {
-	const size_t textureIndex = m_textureStorage.AddTexture(
-		std::move(texture), m_stagingManager, m_temporaryDataBuffer
-	);
+	const size_t textureIndex = m_textureStorage.AddTexture(std::move(texture), m_stagingManager);
 
 	m_gpuCopyNecessary = true;
 
@@ -86,11 +130,11 @@ void RenderEngine::UnbindCombinedTexture(
 	static constexpr VkDescriptorType DescType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 
 	assert(
-		!std::empty(m_graphicsDescriptorBuffers)
+		m_sharedGraphicsDescriptorBuffer.IsCreated()
 		&& "The Descriptor Buffers should be created before calling this."
 	);
 
-	void const* globalDescriptor = m_graphicsDescriptorBuffers.front().GetDescriptor<DescType>(
+	void const* globalDescriptor = m_sharedGraphicsDescriptorBuffer.GetDescriptor<DescType>(
 		s_combinedTextureBindingSlot, s_fragmentShaderSetLayoutIndex, bindingIndex
 	);
 
@@ -136,11 +180,10 @@ void RenderEngine::RebindExternalTexture(
 
 	VKSampler const* sampler         = m_textureStorage.GetSamplerPtr(samplerIndex);
 
-	for (VkDescriptorBuffer& descriptorBuffer : m_graphicsDescriptorBuffers)
-		descriptorBuffer.SetCombinedImageDescriptor(
-			*textureView, *sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-			s_combinedTextureBindingSlot, s_fragmentShaderSetLayoutIndex, bindingIndex
-		);
+	m_sharedGraphicsDescriptorBuffer.SetCombinedImageDescriptor(
+		*textureView, *sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		s_combinedTextureBindingSlot, s_fragmentShaderSetLayoutIndex, bindingIndex
+	);
 }
 
 void RenderEngine::RemoveTexture(size_t textureIndex)
@@ -169,8 +212,18 @@ void RenderEngine::UploadExternalBufferGPUOnlyData(
 	size_t dstBufferOffset
 ) {
 	m_externalResourceManager.UploadExternalBufferGPUOnlyData(
-		m_stagingManager, m_temporaryDataBuffer,
-		externalBufferIndex, std::move(cpuData), srcDataSizeInBytes, dstBufferOffset
+		m_stagingManager, externalBufferIndex, std::move(cpuData), srcDataSizeInBytes,
+		dstBufferOffset
+	);
+}
+
+std::uint64_t RenderEngine::StreamExternalBufferGPUOnlyData(
+	std::uint32_t externalBufferIndex, std::shared_ptr<void> cpuData, size_t srcDataSizeInBytes,
+	size_t dstBufferOffset
+) {
+	return m_externalResourceManager.StreamExternalBufferGPUOnlyData(
+		m_stagingManager, externalBufferIndex, std::move(cpuData), srcDataSizeInBytes,
+		dstBufferOffset
 	);
 }
 
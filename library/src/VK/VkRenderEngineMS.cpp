@@ -12,7 +12,8 @@ void RenderEngineMSDeviceExtension::SetDeviceExtensions(
 
 RenderEngineMS::RenderEngineMS(
 	const VkDeviceManager& deviceManager, std::shared_ptr<ThreadPool> threadPool, size_t frameCount
-) : RenderEngineCommon{ deviceManager, std::move(threadPool), frameCount }
+) : RenderEngineCommon{ deviceManager, std::move(threadPool), frameCount },
+	m_frustumCuller{ m_threadPool.get() }
 {
 	SetGraphicsDescriptorBufferLayout();
 
@@ -26,6 +27,8 @@ void RenderEngineMS::FinaliseInitialisation()
 	for (VkDescriptorBuffer& descriptorBuffer : m_graphicsDescriptorBuffers)
 		descriptorBuffer.CreateBuffer();
 
+	m_sharedGraphicsDescriptorBuffer.CreateBuffer();
+
 	ModelManagerMS::SetGraphicsConstantRange(m_graphicsPipelineLayout);
 
 	CreateGraphicsPipelineLayout();
@@ -33,6 +36,8 @@ void RenderEngineMS::FinaliseInitialisation()
 	m_cameraManager.SetDescriptorBufferGraphics(
 		m_graphicsDescriptorBuffers, s_cameraBindingSlot, s_vertexShaderSetLayoutIndex
 	);
+
+	WarmUpGraphicsPipelines();
 }
 
 void RenderEngineMS::SetGraphicsDescriptorBufferLayout()
@@ -53,7 +58,7 @@ void RenderEngineMS::SetGraphicsDescriptorBufferLayout()
 			VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT
 		);
 		descriptorBuffer.AddBinding(
-			s_modelBuffersFragmentBindingSlot, s_fragmentShaderSetLayoutIndex,
+			s_modelBuffersFragmentBindingSlot, s_vertexShaderSetLayoutIndex,
 			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_FRAGMENT_BIT
 		);
 	}
@@ -87,7 +92,7 @@ void RenderEngineMS::SetModelGraphicsDescriptors()
 		);
 		m_modelBuffers.SetFragmentDescriptorBuffer(
 			descriptorBuffer, frameIndex, s_modelBuffersFragmentBindingSlot,
-			s_fragmentShaderSetLayoutIndex
+			s_vertexShaderSetLayoutIndex
 		);
 	}
 }
@@ -124,32 +129,41 @@ std::uint32_t RenderEngineMS::AddMeshBundle(MeshBundleTemporaryData&& meshBundle
 VkSemaphore RenderEngineMS::GenericTransferStage(
 	size_t frameIndex, std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
 ) {
+	TERRA_CPU_TRACE_ZONE("GenericTransferStage");
+
 	// Transfer Phase
 
 	// If the Transfer stage isn't executed, pass the waitSemaphore on.
 	VkSemaphore signalledSemaphore = waitSemaphore;
 
-	// Only execute this stage if copying is necessary.
-	if (m_gpuCopyNecessary)
+	// Only execute this stage if copying is necessary. The streaming requests are processed
+	// in every frame, until the queue is empty.
+	if (m_gpuCopyNecessary || m_stagingManager.HasPendingStreamingRequests())
 	{
 		const VKCommandBuffer& transferCmdBuffer = m_transferQueue.GetCommandBuffer(frameIndex);
 
+		const VKSemaphore& transferWaitSemaphore = m_transferWait[frameIndex];
+
 		{
 			const CommandBufferScope transferCmdBufferScope{ transferCmdBuffer };
+			const GpuProfilerScope transferProfilerScope{
+				m_gpuProfiler, transferCmdBufferScope, frameIndex, TransferQueue,
+				"GenericTransferStage"
+			};
 
 			// Need to copy the old buffers first to avoid empty data being copied over
 			// the queued data.
 			m_externalResourceManager.CopyQueuedBuffers(transferCmdBufferScope);
 			m_meshManager.CopyOldBuffers(transferCmdBufferScope);
-			m_stagingManager.CopyAndClearQueuedBuffers(transferCmdBufferScope);
+			m_stagingManager.CopyAndClearQueuedBuffers(
+				transferCmdBufferScope, transferWaitSemaphore, semaphoreCounter
+			);
 
 			m_stagingManager.ReleaseOwnership(
 				transferCmdBufferScope, m_transferQueue.GetFamilyIndex()
 			);
 		}
 
-		const VKSemaphore& transferWaitSemaphore = m_transferWait[frameIndex];
-
 		{
 			QueueSubmitBuilder<1u, 1u> transferSubmitBuilder{};
 			transferSubmitBuilder
@@ -177,8 +191,15 @@ void RenderEngineMS::DrawRenderPassPipelines(
 	const std::vector<VkExternalRenderPass::PipelineDetails>& pipelineDetails
 		= renderPass.GetPipelineDetails();
 
+	const std::vector<std::uint8_t>* culledVisibilities
+		= m_frustumCuller.IsEnabled() ? &m_frustumCuller.GetModelVisibilities() : nullptr;
+
 	for (const VkExternalRenderPass::PipelineDetails& details : pipelineDetails)
 	{
+		// The pipeline might still be compiling.
+		if (!m_graphicsPipelineManager.IsPipelineReady(details.pipelineGlobalIndex))
+			continue;
+
 		const std::vector<std::uint32_t>& bundleIndices        = details.modelBundleIndices;
 		const std::vector<std::uint32_t>& pipelineLocalIndices = details.pipelineLocalIndices;
 
@@ -189,7 +210,8 @@ void RenderEngineMS::DrawRenderPassPipelines(
 		for (size_t index = 0u; index < bundleCount; ++index)
 			m_modelManager.DrawPipeline(
 				bundleIndices[index], pipelineLocalIndices[index],
-				graphicsCmdBuffer, m_meshManager, m_graphicsPipelineLayout.Get()
+				graphicsCmdBuffer, m_meshManager, m_graphicsPipelineLayout.Get(),
+				culledVisibilities
 			);
 	}
 }
@@ -198,11 +220,20 @@ VkSemaphore RenderEngineMS::DrawingStage(
 	size_t frameIndex, const VKImageView& renderTarget, VkExtent2D renderArea,
 	std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
 ) {
+	TERRA_CPU_TRACE_ZONE("DrawingStage");
+
+	// The models must be culled before the draws are recorded.
+	if (m_frustumCuller.IsEnabled())
+		m_modelManager.CullModels(m_frustumCuller, m_meshManager);
+
 	// Graphics Phase
 	const VKCommandBuffer& graphicsCmdBuffer = m_graphicsQueue.GetCommandBuffer(frameIndex);
 
 	{
 		const CommandBufferScope graphicsCmdBufferScope{ graphicsCmdBuffer };
+		const GpuProfilerScope graphicsProfilerScope{
+			m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue, "DrawingStage"
+		};
 
 		m_stagingManager.AcquireOwnership(
 			graphicsCmdBufferScope, m_graphicsQueue.GetFamilyIndex(),
@@ -214,8 +245,8 @@ VkSemaphore RenderEngineMS::DrawingStage(
 		m_viewportAndScissors.BindViewportAndScissor(graphicsCmdBufferScope);
 
 		VkDescriptorBuffer::BindDescriptorBuffer(
-			m_graphicsDescriptorBuffers[frameIndex], graphicsCmdBufferScope,
-			VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipelineLayout
+			m_graphicsDescriptorBuffers[frameIndex], m_sharedGraphicsDescriptorBuffer,
+			graphicsCmdBufferScope, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipelineLayout
 		);
 
 		// Normal passes
@@ -227,6 +258,10 @@ VkSemaphore RenderEngineMS::DrawingStage(
 				continue;
 
 			const VkExternalRenderPass& renderPass = *m_renderPasses[index];
+			const GpuProfilerScope renderPassProfilerScope{
+				m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue, "RenderPass",
+				static_cast<std::uint32_t>(index)
+			};
 
 			renderPass.StartPass(graphicsCmdBufferScope, renderArea);
 
@@ -239,6 +274,10 @@ VkSemaphore RenderEngineMS::DrawingStage(
 		if (m_swapchainRenderPass)
 		{
 			const VkExternalRenderPass& renderPass = *m_swapchainRenderPass;
+			const GpuProfilerScope renderPassProfilerScope{
+				m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue,
+				"SwapchainRenderPass"
+			};
 
 			renderPass.StartPass(graphicsCmdBufferScope, renderArea);
 
@@ -272,4 +311,534 @@ VkSemaphore RenderEngineMS::DrawingStage(
 
 	return graphicsWaitSemaphore.Get();
 }
+
+// MS Indirect
+RenderEngineMSIndirect::RenderEngineMSIndirect(
+	const VkDeviceManager& deviceManager, std::shared_ptr<ThreadPool> threadPool, size_t frameCount
+) : RenderEngineCommon{ deviceManager, std::move(threadPool), frameCount },
+	m_computeQueue{
+		deviceManager.GetLogicalDevice(),
+		deviceManager.GetQueueFamilyManager().GetQueue(QueueType::ComputeQueue),
+		deviceManager.GetQueueFamilyManager().GetIndex(QueueType::ComputeQueue)
+	}, m_computeWait{}, m_computeDescriptorBuffers{},
+	m_computePipelineManager{ deviceManager.GetLogicalDevice() },
+	m_computePipelineLayout{ deviceManager.GetLogicalDevice() }
+{
+	m_computePipelineManager.SetPipelineCache(m_pipelineCache.get());
+	m_computePipelineManager.SetThreadPool(m_threadPool.get());
+
+	// Graphics Descriptors.
+	// The layout shouldn't change throughout the runtime.
+	SetGraphicsDescriptorBufferLayout();
+
+	m_cameraManager.CreateBuffer(
+		deviceManager.GetQueueFamilyManager().GetComputeAndGraphicsIndices().ResolveQueueIndices(),
+		static_cast<std::uint32_t>(frameCount)
+	);
+
+	// Compute stuffs.
+	VkDevice device = deviceManager.GetLogicalDevice();
+
+	for (size_t _ = 0u; _ < frameCount; ++_)
+	{
+		m_computeDescriptorBuffers.emplace_back(
+			device, m_memoryManager.get(), s_computePipelineSetLayoutCount
+		);
+
+		// Let's make all of the non graphics semaphores, timeline semaphores.
+		m_computeWait.emplace_back(device).Create(true);
+	}
+
+	m_computeQueue.CreateCommandBuffers(static_cast<std::uint32_t>(frameCount));
+
+	// Compute Descriptors.
+	SetComputeDescriptorBufferLayout();
+}
+
+void RenderEngineMSIndirect::CreateComputePipelineLayout()
+{
+	if (!std::empty(m_computeDescriptorBuffers))
+		m_computePipelineLayout.Create(m_computeDescriptorBuffers.front().GetValidLayouts());
+
+	m_computePipelineManager.SetPipelineLayout(m_computePipelineLayout.Get());
+}
+
+void RenderEngineMSIndirect::FinaliseInitialisation()
+{
+	m_externalResourceManager.SetGraphicsDescriptorLayout(m_graphicsDescriptorBuffers);
+
+	// Graphics
+	for (VkDescriptorBuffer& descriptorBuffer : m_graphicsDescriptorBuffers)
+		descriptorBuffer.CreateBuffer();
+
+	m_sharedGraphicsDescriptorBuffer.CreateBuffer();
+
+	ModelManagerMSIndirect::SetGraphicsConstantRange(m_graphicsPipelineLayout);
+
+	CreateGraphicsPipelineLayout();
+
+	m_cameraManager.SetDescriptorBufferGraphics(
+		m_graphicsDescriptorBuffers, s_cameraBindingSlot, s_vertexShaderSetLayoutIndex
+	);
+
+	// Compute
+	for (VkDescriptorBuffer& descriptorBuffer : m_computeDescriptorBuffers)
+		descriptorBuffer.CreateBuffer();
+
+	ModelManagerMSIndirect::SetComputeConstantRange(m_computePipelineLayout);
+
+	CreateComputePipelineLayout();
+
+	m_cameraManager.SetDescriptorBufferCompute(
+		m_computeDescriptorBuffers, s_cameraComputeBindingSlot, s_computeShaderSetLayoutIndex
+	);
+
+	assert(
+		!std::empty(m_computePipelineManager.GetShaderPath())
+		&& "The shader path should be set before calling this function."
+	);
+
+	// Add the Frustum Culling Shader.
+	const std::uint32_t frustumCSOIndex = m_computePipelineManager.AddOrGetComputePipeline(
+		ShaderName{ L"MeshShaderCSIndirect" }
+	);
+
+	m_modelManager.SetCSPSOIndex(frustumCSOIndex);
+
+	WarmUpGraphicsPipelines();
+
+	m_computePipelineManager.WarmUpPipelines(m_pipelineManifest->GetComputePipelines());
+}
+
+void RenderEngineMSIndirect::SetGraphicsDescriptorBufferLayout()
+{
+	// The layout shouldn't change throughout the runtime.
+	m_meshManager.SetDescriptorBufferLayout(
+		m_graphicsDescriptorBuffers, s_vertexShaderSetLayoutIndex
+	);
+	SetCommonGraphicsDescriptorBufferLayout(
+		VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT
+	);
+
+	m_modelManager.SetDescriptorBufferLayoutMS(
+		m_graphicsDescriptorBuffers, s_vertexShaderSetLayoutIndex
+	);
+
+	for (VkDescriptorBuffer& descriptorBuffer : m_graphicsDescriptorBuffers)
+	{
+		descriptorBuffer.AddBinding(
+			s_modelBuffersGraphicsBindingSlot, s_vertexShaderSetLayoutIndex,
+			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u,
+			VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT
+		);
+		descriptorBuffer.AddBinding(
+			s_modelBuffersFragmentBindingSlot, s_vertexShaderSetLayoutIndex,
+			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_FRAGMENT_BIT
+		);
+	}
+}
+
+void RenderEngineMSIndirect::SetComputeDescriptorBufferLayout()
+{
+	m_modelManager.SetDescriptorBufferLayoutCS(
+		m_computeDescriptorBuffers, s_computeShaderSetLayoutIndex
+	);
+	m_meshManager.SetDescriptorBufferLayoutCS(
+		m_computeDescriptorBuffers, s_computeShaderSetLayoutIndex
+	);
+
+	m_cameraManager.SetDescriptorBufferLayoutCompute(
+		m_computeDescriptorBuffers, s_cameraComputeBindingSlot, s_computeShaderSetLayoutIndex
+	);
+
+	for (VkDescriptorBuffer& descriptorBuffer : m_computeDescriptorBuffers)
+		descriptorBuffer.AddBinding(
+			s_modelBuffersComputeBindingSlot, s_computeShaderSetLayoutIndex,
+			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_COMPUTE_BIT
+		);
+}
+
+VkSemaphore RenderEngineMSIndirect::ExecutePipelineStages(
+	size_t frameIndex, const VKImageView& renderTarget, VkExtent2D renderArea,
+	std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
+) {
+	waitSemaphore = GenericTransferStage(frameIndex, semaphoreCounter, waitSemaphore);
+
+	waitSemaphore = FrustumCullingStage(frameIndex, semaphoreCounter, waitSemaphore);
+
+	waitSemaphore = DrawingStage(
+		frameIndex, renderTarget, renderArea, semaphoreCounter, waitSemaphore
+	);
+
+	return waitSemaphore;
+}
+
+void RenderEngineMSIndirect::SetModelGraphicsDescriptors()
+{
+	m_modelManager.SetDescriptorBuffersMS(
+		m_graphicsDescriptorBuffers, s_vertexShaderSetLayoutIndex
+	);
+
+	const size_t frameCount = std::size(m_graphicsDescriptorBuffers);
+
+	for (size_t index = 0u; index < frameCount; ++index)
+	{
+		VkDescriptorBuffer& descriptorBuffer = m_graphicsDescriptorBuffers[index];
+		const auto frameIndex                = static_cast<VkDeviceSize>(index);
+
+		m_modelBuffers.SetDescriptorBuffer(
+			descriptorBuffer, frameIndex, s_modelBuffersGraphicsBindingSlot,
+			s_vertexShaderSetLayoutIndex
+		);
+		m_modelBuffers.SetFragmentDescriptorBuffer(
+			descriptorBuffer, frameIndex, s_modelBuffersFragmentBindingSlot,
+			s_vertexShaderSetLayoutIndex
+		);
+	}
+}
+
+void RenderEngineMSIndirect::SetModelComputeDescriptors()
+{
+	m_modelManager.SetDescriptorBuffersCS(
+		m_computeDescriptorBuffers, s_computeShaderSetLayoutIndex
+	);
+
+	const size_t frameCount = std::size(m_computeDescriptorBuffers);
+
+	for (size_t index = 0u; index < frameCount; ++index)
+	{
+		VkDescriptorBuffer& descriptorBuffer = m_computeDescriptorBuffers[index];
+		const auto frameIndex                = static_cast<VkDeviceSize>(index);
+
+		m_modelBuffers.SetDescriptorBuffer(
+			descriptorBuffer, frameIndex, s_modelBuffersComputeBindingSlot,
+			s_computeShaderSetLayoutIndex
+		);
+	}
+}
+
+void RenderEngineMSIndirect::UpdateRenderPassPipelines(
+	size_t frameIndex, const VkExternalRenderPass& renderPass
+) const noexcept {
+	TERRA_CPU_TRACE_ZONE("UpdateRenderPassPipelines");
+
+	const std::vector<VkExternalRenderPass::PipelineDetails>& pipelineDetails
+		= renderPass.GetPipelineDetails();
+
+	for (const VkExternalRenderPass::PipelineDetails& details : pipelineDetails)
+	{
+		const std::vector<std::uint32_t>& bundleIndices        = details.modelBundleIndices;
+		const std::vector<std::uint32_t>& pipelineLocalIndices = details.pipelineLocalIndices;
+
+		const GraphicsPipelineMS& vkPipeline
+			= m_graphicsPipelineManager.GetPipeline(details.pipelineGlobalIndex);
+
+		const size_t bundleCount = std::size(bundleIndices);
+
+		for (size_t index = 0u; index < bundleCount; ++index)
+			m_modelManager.UpdatePipelinePerFrame(
+				frameIndex, bundleIndices[index], pipelineLocalIndices[index], m_meshManager,
+				!vkPipeline.GetExternalPipeline().IsGPUCullingEnabled()
+			);
+	}
+}
+
+void RenderEngineMSIndirect::_updatePerFrame(VkDeviceSize frameIndex) noexcept
+{
+	m_modelBuffers.Update(frameIndex);
+
+	// Normal passes
+	const size_t renderPassCount = std::size(m_renderPasses);
+
+	for (size_t index = 0u; index < renderPassCount; ++index)
+	{
+		if (!m_renderPasses.IsInUse(index))
+			continue;
+
+		UpdateRenderPassPipelines(frameIndex, *m_renderPasses[index]);
+	}
+
+	// The one for the swapchain
+	if (m_swapchainRenderPass)
+		UpdateRenderPassPipelines(frameIndex, *m_swapchainRenderPass);
+}
+
+void RenderEngineMSIndirect::SetShaderPath(const std::wstring& shaderPath)
+{
+	_setShaderPath(shaderPath);
+
+	m_computePipelineManager.SetShaderPath(shaderPath);
+}
+
+void RenderEngineMSIndirect::SetPipelineManifestDirectory(const std::wstring& directory)
+{
+	_setPipelineManifestDirectory(directory);
+
+	m_computePipelineManager.SetPipelineManifest(m_pipelineManifest.get());
+}
+
+std::uint32_t RenderEngineMSIndirect::AddModelBundle(std::shared_ptr<ModelBundle>&& modelBundle)
+{
+	m_modelBuffers.ExtendModelBuffers();
+
+	const std::uint32_t index = m_modelManager.AddModelBundle(std::move(modelBundle));
+
+	// After new models have been added, the ModelBuffer might get recreated. So, it will have
+	// a new object. So, we should set that new object as the descriptor.
+	SetModelGraphicsDescriptors();
+	SetModelComputeDescriptors();
+
+	m_gpuCopyNecessary = true;
+
+	return index;
+}
+
+std::uint32_t RenderEngineMSIndirect::AddMeshBundle(MeshBundleTemporaryData&& meshBundle)
+{
+	const std::uint32_t index = m_meshManager.AddMeshBundle(
+		std::move(meshBundle), m_stagingManager, m_temporaryDataBuffer
+	);
+
+	m_meshManager.SetDescriptorBuffers(m_graphicsDescriptorBuffers, s_vertexShaderSetLayoutIndex);
+	m_meshManager.SetDescriptorBuffersCS(
+		m_computeDescriptorBuffers, s_computeShaderSetLayoutIndex
+	);
+
+	m_gpuCopyNecessary = true;
+
+	return index;
+}
+
+VkSemaphore RenderEngineMSIndirect::GenericTransferStage(
+	size_t frameIndex, std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
+) {
+	TERRA_CPU_TRACE_ZONE("GenericTransferStage");
+
+	// Transfer Phase
+
+	// If the Transfer stage isn't executed, pass the waitSemaphore on.
+	VkSemaphore signalledSemaphore = waitSemaphore;
+
+	// The streaming requests are processed in every frame, until the queue is empty.
+	if (m_gpuCopyNecessary || m_stagingManager.HasPendingStreamingRequests())
+	{
+		const VKCommandBuffer& transferCmdBuffer = m_transferQueue.GetCommandBuffer(frameIndex);
+
+		const VKSemaphore& transferWaitSemaphore = m_transferWait[frameIndex];
+
+		{
+			const CommandBufferScope transferCmdBufferScope{ transferCmdBuffer };
+			const GpuProfilerScope transferProfilerScope{
+				m_gpuProfiler, transferCmdBufferScope, frameIndex, TransferQueue,
+				"GenericTransferStage"
+			};
+
+			// Need to copy the old buffers first to avoid empty data being copied over
+			// the queued data.
+			m_externalResourceManager.CopyQueuedBuffers(transferCmdBufferScope);
+			m_meshManager.CopyOldBuffers(transferCmdBufferScope);
+			m_stagingManager.CopyAndClearQueuedBuffers(
+				transferCmdBufferScope, transferWaitSemaphore, semaphoreCounter
+			);
+
+			m_stagingManager.ReleaseOwnership(
+				transferCmdBufferScope, m_transferQueue.GetFamilyIndex()
+			);
+		}
+
+		{
+			QueueSubmitBuilder<1u, 1u> transferSubmitBuilder{};
+			transferSubmitBuilder
+				.SignalSemaphore(transferWaitSemaphore, semaphoreCounter)
+				.WaitSemaphore(waitSemaphore, VK_PIPELINE_STAGE_TRANSFER_BIT)
+				.CommandBuffer(transferCmdBuffer);
+
+			m_transferQueue.SubmitCommandBuffer(transferSubmitBuilder);
+
+			m_temporaryDataBuffer.SetUsed(frameIndex);
+		}
+
+		// Since this is the first stage for now. The receiving semaphore won't be a timeline one.
+		// So, no need to increase it.
+		m_gpuCopyNecessary = false;
+		signalledSemaphore = transferWaitSemaphore.Get();
+	}
+
+	return signalledSemaphore;
+}
+
+VkSemaphore RenderEngineMSIndirect::FrustumCullingStage(
+	size_t frameIndex, std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
+) {
+	TERRA_CPU_TRACE_ZONE("FrustumCullingStage");
+
+	// Compute Phase
+	const VKCommandBuffer& computeCmdBuffer = m_computeQueue.GetCommandBuffer(frameIndex);
+
+	{
+		const CommandBufferScope computeCmdBufferScope{ computeCmdBuffer };
+		const GpuProfilerScope computeProfilerScope{
+			m_gpuProfiler, computeCmdBufferScope, frameIndex, ComputeQueue, "FrustumCullingStage"
+		};
+
+		m_stagingManager.AcquireOwnership(
+			computeCmdBufferScope, m_computeQueue.GetFamilyIndex(),
+			m_transferQueue.GetFamilyIndex()
+		);
+
+		m_modelManager.ResetCounterBuffer(
+			computeCmdBuffer, static_cast<VkDeviceSize>(frameIndex)
+		);
+
+		VkDescriptorBuffer::BindDescriptorBuffer(
+			m_computeDescriptorBuffers[frameIndex], computeCmdBufferScope,
+			VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipelineLayout
+		);
+
+		m_modelManager.Dispatch(computeCmdBufferScope, m_computePipelineManager);
+
+		if (m_modelManager.IsDrawCountReadbackEnabled())
+			m_modelManager.CopyDrawCounts(computeCmdBufferScope, frameIndex, 0u);
+	}
+
+	const VKSemaphore& computeWaitSemaphore = m_computeWait[frameIndex];
+
+	{
+		const std::uint64_t oldSemaphoreCounterValue = semaphoreCounter;
+		++semaphoreCounter;
+
+		QueueSubmitBuilder<1u, 1u> computeSubmitBuilder{};
+		computeSubmitBuilder
+			.SignalSemaphore(computeWaitSemaphore, semaphoreCounter)
+			.WaitSemaphore(
+				waitSemaphore, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, oldSemaphoreCounterValue
+			).CommandBuffer(computeCmdBuffer);
+
+		m_computeQueue.SubmitCommandBuffer(computeSubmitBuilder);
+	}
+
+	return computeWaitSemaphore.Get();
+}
+
+void RenderEngineMSIndirect::DrawRenderPassPipelines(
+	size_t frameIndex, const VKCommandBuffer& graphicsCmdBuffer,
+	const VkExternalRenderPass& renderPass
+) const noexcept {
+	const std::vector<VkExternalRenderPass::PipelineDetails>& pipelineDetails
+		= renderPass.GetPipelineDetails();
+
+	for (const VkExternalRenderPass::PipelineDetails& details : pipelineDetails)
+	{
+		// The pipeline might still be compiling.
+		if (!m_graphicsPipelineManager.IsPipelineReady(details.pipelineGlobalIndex))
+			continue;
+
+		const std::vector<std::uint32_t>& bundleIndices        = details.modelBundleIndices;
+		const std::vector<std::uint32_t>& pipelineLocalIndices = details.pipelineLocalIndices;
+
+		m_graphicsPipelineManager.BindPipeline(details.pipelineGlobalIndex, graphicsCmdBuffer);
+
+		const size_t bundleCount = std::size(bundleIndices);
+
+		for (size_t index = 0u; index < bundleCount; ++index)
+			m_modelManager.DrawPipeline(
+				frameIndex, bundleIndices[index], pipelineLocalIndices[index],
+				graphicsCmdBuffer, m_meshManager, m_graphicsPipelineLayout.Get()
+			);
+	}
+}
+
+VkSemaphore RenderEngineMSIndirect::DrawingStage(
+	size_t frameIndex, const VKImageView& renderTarget, VkExtent2D renderArea,
+	std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
+) {
+	TERRA_CPU_TRACE_ZONE("DrawingStage");
+
+	// Graphics Phase
+	const VKCommandBuffer& graphicsCmdBuffer = m_graphicsQueue.GetCommandBuffer(frameIndex);
+
+	{
+		const CommandBufferScope graphicsCmdBufferScope{ graphicsCmdBuffer };
+		const GpuProfilerScope graphicsProfilerScope{
+			m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue, "DrawingStage"
+		};
+
+		m_stagingManager.AcquireOwnership(
+			graphicsCmdBufferScope, m_graphicsQueue.GetFamilyIndex(),
+			m_transferQueue.GetFamilyIndex()
+		);
+
+		m_textureStorage.TransitionQueuedTextures(graphicsCmdBufferScope);
+
+		m_viewportAndScissors.BindViewportAndScissor(graphicsCmdBufferScope);
+
+		VkDescriptorBuffer::BindDescriptorBuffer(
+			m_graphicsDescriptorBuffers[frameIndex], m_sharedGraphicsDescriptorBuffer,
+			graphicsCmdBufferScope, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipelineLayout
+		);
+
+		// Normal passes
+		const size_t renderPassCount = std::size(m_renderPasses);
+
+		for (size_t index = 0u; index < renderPassCount; ++index)
+		{
+			if (!m_renderPasses.IsInUse(index))
+				continue;
+
+			const VkExternalRenderPass& renderPass = *m_renderPasses[index];
+			const GpuProfilerScope renderPassProfilerScope{
+				m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue, "RenderPass",
+				static_cast<std::uint32_t>(index)
+			};
+
+			renderPass.StartPass(graphicsCmdBufferScope, renderArea);
+
+			DrawRenderPassPipelines(frameIndex, graphicsCmdBufferScope, renderPass);
+
+			renderPass.EndPass(graphicsCmdBufferScope);
+		}
+
+		// The one for the swapchain
+		if (m_swapchainRenderPass)
+		{
+			const VkExternalRenderPass& renderPass = *m_swapchainRenderPass;
+			const GpuProfilerScope renderPassProfilerScope{
+				m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue,
+				"SwapchainRenderPass"
+			};
+
+			renderPass.StartPass(graphicsCmdBufferScope, renderArea);
+
+			DrawRenderPassPipelines(frameIndex, graphicsCmdBufferScope, renderPass);
+
+			renderPass.EndPassForSwapchain(
+				graphicsCmdBufferScope, renderTarget,
+				m_externalResourceManager.GetResourceFactory()
+			);
+		}
+	}
+
+	const VKSemaphore& graphicsWaitSemaphore = m_graphicsWait[frameIndex];
+
+	{
+		const std::uint64_t oldSemaphoreCounterValue = semaphoreCounter;
+		++semaphoreCounter;
+
+		// The arguments and the counts written by the Compute pass are read by the indirect
+		// draws.
+		QueueSubmitBuilder<1u, 1u> graphicsSubmitBuilder{};
+		graphicsSubmitBuilder
+			.SignalSemaphore(graphicsWaitSemaphore)
+			.WaitSemaphore(
+				waitSemaphore, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, oldSemaphoreCounterValue
+			).CommandBuffer(graphicsCmdBuffer);
+
+		VKFence& signalFence = m_graphicsQueue.GetFence(frameIndex);
+		signalFence.Reset();
+
+		m_graphicsQueue.SubmitCommandBuffer(graphicsSubmitBuilder, signalFence);
+	}
+
+	return graphicsWaitSemaphore.Get();
+}
 }
@@ -6,7 +6,8 @@ namespace Terra
 // VS Individual
 RenderEngineVSIndividual::RenderEngineVSIndividual(
 	const VkDeviceManager& deviceManager, std::shared_ptr<ThreadPool> threadPool, size_t frameCount
-) : RenderEngineCommon{ deviceManager, std::move(threadPool), frameCount }
+) : RenderEngineCommon{ deviceManager, std::move(threadPool), frameCount },
+	m_frustumCuller{ m_threadPool.get() }
 {
 	SetGraphicsDescriptorBufferLayout();
 
@@ -20,13 +21,17 @@ void RenderEngineVSIndividual::FinaliseInitialisation()
 	for (VkDescriptorBuffer& descriptorBuffer : m_graphicsDescriptorBuffers)
 		descriptorBuffer.CreateBuffer();
 
-	ModelManagerVSIndividual::SetGraphicsConstantRange(m_graphicsPipelineLayout);
+	m_sharedGraphicsDescriptorBuffer.CreateBuffer();
 
+	// The model indices are read from the instance buffer with the instance index of the
+	// draws, so there are no push constants.
 	CreateGraphicsPipelineLayout();
 
 	m_cameraManager.SetDescriptorBufferGraphics(
 		m_graphicsDescriptorBuffers, s_cameraBindingSlot, s_vertexShaderSetLayoutIndex
 	);
+
+	WarmUpGraphicsPipelines();
 }
 
 VkSemaphore RenderEngineVSIndividual::ExecutePipelineStages(
@@ -56,10 +61,14 @@ void RenderEngineVSIndividual::SetGraphicsDescriptorBufferLayout()
 			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_VERTEX_BIT
 		);
 		descriptorBuffer.AddBinding(
-			s_modelBuffersFragmentBindingSlot, s_fragmentShaderSetLayoutIndex,
+			s_modelBuffersFragmentBindingSlot, s_vertexShaderSetLayoutIndex,
 			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_FRAGMENT_BIT
 		);
 	}
+
+	m_modelManager.SetDescriptorBufferLayoutVS(
+		m_graphicsDescriptorBuffers, s_vertexShaderSetLayoutIndex
+	);
 }
 
 void RenderEngineVSIndividual::SetGraphicsDescriptors()
@@ -77,7 +86,7 @@ void RenderEngineVSIndividual::SetGraphicsDescriptors()
 		);
 		m_modelBuffers.SetFragmentDescriptorBuffer(
 			descriptorBuffer, frameIndex, s_modelBuffersFragmentBindingSlot,
-			s_fragmentShaderSetLayoutIndex
+			s_vertexShaderSetLayoutIndex
 		);
 	}
 }
@@ -110,31 +119,40 @@ std::uint32_t RenderEngineVSIndividual::AddMeshBundle(MeshBundleTemporaryData&&
 VkSemaphore RenderEngineVSIndividual::GenericTransferStage(
 	size_t frameIndex, std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
 ) {
+	TERRA_CPU_TRACE_ZONE("GenericTransferStage");
+
 	// Transfer Phase
 
 	// If the Transfer stage isn't executed, pass the waitSemaphore on.
 	VkSemaphore signalledSemaphore = waitSemaphore;
 
-	if (m_gpuCopyNecessary)
+	// The streaming requests are processed in every frame, until the queue is empty.
+	if (m_gpuCopyNecessary || m_stagingManager.HasPendingStreamingRequests())
 	{
 		const VKCommandBuffer& transferCmdBuffer = m_transferQueue.GetCommandBuffer(frameIndex);
 
+		const VKSemaphore& transferWaitSemaphore = m_transferWait[frameIndex];
+
 		{
 			const CommandBufferScope transferCmdBufferScope{ transferCmdBuffer };
+			const GpuProfilerScope transferProfilerScope{
+				m_gpuProfiler, transferCmdBufferScope, frameIndex, TransferQueue,
+				"GenericTransferStage"
+			};
 
 			// Need to copy the old buffers first to avoid empty data being copied over
 			// the queued data.
 			m_externalResourceManager.CopyQueuedBuffers(transferCmdBufferScope);
 			m_meshManager.CopyOldBuffers(transferCmdBufferScope);
-			m_stagingManager.CopyAndClearQueuedBuffers(transferCmdBufferScope);
+			m_stagingManager.CopyAndClearQueuedBuffers(
+				transferCmdBufferScope, transferWaitSemaphore, semaphoreCounter
+			);
 
 			m_stagingManager.ReleaseOwnership(
 				transferCmdBufferScope, m_transferQueue.GetFamilyIndex()
 			);
 		}
 
-		const VKSemaphore& transferWaitSemaphore = m_transferWait[frameIndex];
-
 		{
 			QueueSubmitBuilder<1u, 1u> transferSubmitBuilder{};
 			transferSubmitBuilder
@@ -157,13 +175,18 @@ VkSemaphore RenderEngineVSIndividual::GenericTransferStage(
 }
 
 void RenderEngineVSIndividual::DrawRenderPassPipelines(
-	const VKCommandBuffer& graphicsCmdBuffer, const VkExternalRenderPass& renderPass
+	size_t frameIndex, const VKCommandBuffer& graphicsCmdBuffer,
+	const VkExternalRenderPass& renderPass
 ) const noexcept {
 	const std::vector<VkExternalRenderPass::PipelineDetails>& pipelineDetails
 		= renderPass.GetPipelineDetails();
 
 	for (const VkExternalRenderPass::PipelineDetails& details : pipelineDetails)
 	{
+		// The pipeline might still be compiling.
+		if (!m_graphicsPipelineManager.IsPipelineReady(details.pipelineGlobalIndex))
+			continue;
+
 		const std::vector<std::uint32_t>& bundleIndices        = details.modelBundleIndices;
 		const std::vector<std::uint32_t>& pipelineLocalIndices = details.pipelineLocalIndices;
 
@@ -173,8 +196,8 @@ void RenderEngineVSIndividual::DrawRenderPassPipelines(
 
 		for (size_t index = 0u; index < bundleCount; ++index)
 			m_modelManager.DrawPipeline(
-				bundleIndices[index], pipelineLocalIndices[index],
-				graphicsCmdBuffer, m_meshManager, m_graphicsPipelineLayout.Get()
+				frameIndex, bundleIndices[index], pipelineLocalIndices[index],
+				graphicsCmdBuffer, m_meshManager
 			);
 	}
 }
@@ -183,11 +206,26 @@ VkSemaphore RenderEngineVSIndividual::DrawingStage(
 	size_t frameIndex, const VKImageView& renderTarget, VkExtent2D renderArea,
 	std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
 ) {
+	TERRA_CPU_TRACE_ZONE("DrawingStage");
+
+	// The models must be culled before the draws are recorded.
+	if (m_frustumCuller.IsEnabled())
+		m_modelManager.CullModels(m_frustumCuller, m_meshManager);
+
+	m_modelManager.UpdateDrawArguments(
+		frameIndex, m_meshManager,
+		m_frustumCuller.IsEnabled() ? &m_frustumCuller.GetModelVisibilities() : nullptr,
+		m_graphicsDescriptorBuffers[frameIndex], s_vertexShaderSetLayoutIndex
+	);
+
 	// Graphics Phase
 	const VKCommandBuffer& graphicsCmdBuffer = m_graphicsQueue.GetCommandBuffer(frameIndex);
 
 	{
 		const CommandBufferScope graphicsCmdBufferScope{ graphicsCmdBuffer };
+		const GpuProfilerScope graphicsProfilerScope{
+			m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue, "DrawingStage"
+		};
 
 		m_stagingManager.AcquireOwnership(
 			graphicsCmdBufferScope, m_graphicsQueue.GetFamilyIndex(),
@@ -199,8 +237,8 @@ VkSemaphore RenderEngineVSIndividual::DrawingStage(
 		m_viewportAndScissors.BindViewportAndScissor(graphicsCmdBufferScope);
 
 		VkDescriptorBuffer::BindDescriptorBuffer(
-			m_graphicsDescriptorBuffers[frameIndex], graphicsCmdBufferScope,
-			VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipelineLayout
+			m_graphicsDescriptorBuffers[frameIndex], m_sharedGraphicsDescriptorBuffer,
+			graphicsCmdBufferScope, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipelineLayout
 		);
 
 		// Normal passes
@@ -212,10 +250,14 @@ VkSemaphore RenderEngineVSIndividual::DrawingStage(
 				continue;
 
 			const VkExternalRenderPass& renderPass = *m_renderPasses[index];
+			const GpuProfilerScope renderPassProfilerScope{
+				m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue, "RenderPass",
+				static_cast<std::uint32_t>(index)
+			};
 
 			renderPass.StartPass(graphicsCmdBufferScope, renderArea);
 
-			DrawRenderPassPipelines(graphicsCmdBufferScope, renderPass);
+			DrawRenderPassPipelines(frameIndex, graphicsCmdBufferScope, renderPass);
 
 			renderPass.EndPass(graphicsCmdBufferScope);
 		}
@@ -224,10 +266,14 @@ VkSemaphore RenderEngineVSIndividual::DrawingStage(
 		if (m_swapchainRenderPass)
 		{
 			const VkExternalRenderPass& renderPass = *m_swapchainRenderPass;
+			const GpuProfilerScope renderPassProfilerScope{
+				m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue,
+				"SwapchainRenderPass"
+			};
 
 			renderPass.StartPass(graphicsCmdBufferScope, renderArea);
 
-			DrawRenderPassPipelines(graphicsCmdBufferScope, renderPass);
+			DrawRenderPassPipelines(frameIndex, graphicsCmdBufferScope, renderPass);
 
 			renderPass.EndPassForSwapchain(
 				graphicsCmdBufferScope, renderTarget,
@@ -268,8 +314,19 @@ RenderEngineVSIndirect::RenderEngineVSIndirect(
 		deviceManager.GetQueueFamilyManager().GetIndex(QueueType::ComputeQueue)
 	}, m_computeWait{}, m_computeDescriptorBuffers{},
 	m_computePipelineManager{ deviceManager.GetLogicalDevice() },
-	m_computePipelineLayout{ deviceManager.GetLogicalDevice() }
+	m_computePipelineLayout{ deviceManager.GetLogicalDevice() },
+	m_occlusionGraphicsQueue{
+		deviceManager.GetLogicalDevice(),
+		deviceManager.GetQueueFamilyManager().GetQueue(QueueType::GraphicsQueue),
+		deviceManager.GetQueueFamilyManager().GetIndex(QueueType::GraphicsQueue)
+	}, m_occlusionGraphicsWait{},
+	m_hiZPyramid{ deviceManager.GetLogicalDevice(), m_memoryManager.get() }
 {
+	m_computePipelineManager.SetPipelineCache(m_pipelineCache.get());
+	m_computePipelineManager.SetThreadPool(m_threadPool.get());
+
+	m_hiZPyramid.SetPipelineCache(m_pipelineCache.get());
+
 	// Graphics Descriptors.
 	// The layout shouldn't change throughout the runtime.
 	SetGraphicsDescriptorBufferLayout();
@@ -290,11 +347,14 @@ RenderEngineVSIndirect::RenderEngineVSIndirect(
 
 		// Let's make all of the non graphics semaphores, timeline semaphores.
 		m_computeWait.emplace_back(device).Create(true);
+		m_occlusionGraphicsWait.emplace_back(device).Create(true);
 	}
 
 	const auto frameCountU32 = static_cast<std::uint32_t>(frameCount);
 
-	m_computeQueue.CreateCommandBuffers(frameCountU32);
+	// The second half is for the second phase of the occlusion culling.
+	m_computeQueue.CreateCommandBuffers(frameCountU32 * 2u);
+	m_occlusionGraphicsQueue.CreateCommandBuffers(frameCountU32);
 
 	// Compute Descriptors.
 	SetComputeDescriptorBufferLayout();
@@ -316,6 +376,8 @@ void RenderEngineVSIndirect::FinaliseInitialisation()
 	for (VkDescriptorBuffer& descriptorBuffer : m_graphicsDescriptorBuffers)
 		descriptorBuffer.CreateBuffer();
 
+	m_sharedGraphicsDescriptorBuffer.CreateBuffer();
+
 	ModelManagerVSIndirect::SetGraphicsConstantRange(m_graphicsPipelineLayout);
 
 	CreateGraphicsPipelineLayout();
@@ -347,6 +409,10 @@ void RenderEngineVSIndirect::FinaliseInitialisation()
 	);
 
 	m_modelManager.SetCSPSOIndex(frustumCSOIndex);
+
+	WarmUpGraphicsPipelines();
+
+	m_computePipelineManager.WarmUpPipelines(m_pipelineManifest->GetComputePipelines());
 }
 
 void RenderEngineVSIndirect::SetGraphicsDescriptorBufferLayout()
@@ -365,7 +431,7 @@ void RenderEngineVSIndirect::SetGraphicsDescriptorBufferLayout()
 			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_VERTEX_BIT
 		);
 		descriptorBuffer.AddBinding(
-			s_modelBuffersFragmentBindingSlot, s_fragmentShaderSetLayoutIndex,
+			s_modelBuffersFragmentBindingSlot, s_vertexShaderSetLayoutIndex,
 			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_FRAGMENT_BIT
 		);
 	}
@@ -389,6 +455,11 @@ void RenderEngineVSIndirect::SetComputeDescriptorBufferLayout()
 			s_modelBuffersComputeBindingSlot, s_computeShaderSetLayoutIndex,
 			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_COMPUTE_BIT
 		);
+
+	HiZPyramid::SetDescriptorBufferLayout(
+		m_computeDescriptorBuffers, s_hiZPyramidComputeBindingSlot, s_computeShaderSetLayoutIndex,
+		VK_SHADER_STAGE_COMPUTE_BIT
+	);
 }
 
 VkSemaphore RenderEngineVSIndirect::ExecutePipelineStages(
@@ -397,7 +468,18 @@ VkSemaphore RenderEngineVSIndirect::ExecutePipelineStages(
 ) {
 	waitSemaphore = GenericTransferStage(frameIndex, semaphoreCounter, waitSemaphore);
 
-	waitSemaphore = FrustumCullingStage(frameIndex, semaphoreCounter, waitSemaphore);
+	if (IsOcclusionCullingEnabled())
+	{
+		waitSemaphore = OcclusionCullingStage(frameIndex, 0u, semaphoreCounter, waitSemaphore);
+
+		waitSemaphore = OcclusionDrawingStage(
+			frameIndex, renderArea, semaphoreCounter, waitSemaphore
+		);
+
+		waitSemaphore = OcclusionCullingStage(frameIndex, 1u, semaphoreCounter, waitSemaphore);
+	}
+	else
+		waitSemaphore = FrustumCullingStage(frameIndex, semaphoreCounter, waitSemaphore);
 
 	waitSemaphore = DrawingStage(
 		frameIndex, renderTarget, renderArea, semaphoreCounter, waitSemaphore
@@ -425,7 +507,7 @@ void RenderEngineVSIndirect::SetModelGraphicsDescriptors()
 		);
 		m_modelBuffers.SetFragmentDescriptorBuffer(
 			descriptorBuffer, frameIndex, s_modelBuffersFragmentBindingSlot,
-			s_fragmentShaderSetLayoutIndex
+			s_vertexShaderSetLayoutIndex
 		);
 	}
 }
@@ -453,6 +535,8 @@ void RenderEngineVSIndirect::SetModelComputeDescriptors()
 void RenderEngineVSIndirect::UpdateRenderPassPipelines(
 	size_t frameIndex, const VkExternalRenderPass& renderPass
 ) const noexcept {
+	TERRA_CPU_TRACE_ZONE("UpdateRenderPassPipelines");
+
 	const std::vector<VkExternalRenderPass::PipelineDetails>& pipelineDetails
 		= renderPass.GetPipelineDetails();
 
@@ -474,7 +558,7 @@ void RenderEngineVSIndirect::UpdateRenderPassPipelines(
 	}
 }
 
-void RenderEngineVSIndirect::_updatePerFrame(VkDeviceSize frameIndex) const noexcept
+void RenderEngineVSIndirect::_updatePerFrame(VkDeviceSize frameIndex) noexcept
 {
 	m_modelBuffers.Update(frameIndex);
 
@@ -499,6 +583,53 @@ void RenderEngineVSIndirect::SetShaderPath(const std::wstring& shaderPath)
 	_setShaderPath(shaderPath);
 
 	m_computePipelineManager.SetShaderPath(shaderPath);
+	m_hiZPyramid.SetShaderPath(shaderPath);
+}
+
+void RenderEngineVSIndirect::SetPipelineManifestDirectory(const std::wstring& directory)
+{
+	_setPipelineManifestDirectory(directory);
+
+	m_computePipelineManager.SetPipelineManifest(m_pipelineManifest.get());
+}
+
+void RenderEngineVSIndirect::SetOcclusionCullingDepth(std::uint32_t externalTextureIndex)
+{
+	// The shaders are only loaded once the culling is enabled, so they aren't needed otherwise.
+	m_modelManager.SetOcclusionCSPSOIndex(
+		m_computePipelineManager.AddOrGetComputePipeline(
+			ShaderName{ L"VertexShaderCSIndirectOcclusion" }
+		)
+	);
+
+	m_hiZPyramid.CreatePipeline();
+
+	const VkTextureView& depthTexture
+		= m_externalResourceManager.GetResourceFactory().GetVkTextureView(externalTextureIndex);
+
+	// The pyramid is built on the Graphics queue and read on the Compute queue.
+	const QueueIndicesCG queueIndices{
+		.compute  = m_computeQueue.GetFamilyIndex(),
+		.graphics = m_graphicsQueue.GetFamilyIndex()
+	};
+
+	m_hiZPyramid.SetDepthTexture(depthTexture, queueIndices.ResolveQueueIndices());
+
+	m_hiZPyramid.SetDescriptorBuffer(
+		m_computeDescriptorBuffers, s_hiZPyramidComputeBindingSlot, s_computeShaderSetLayoutIndex
+	);
+}
+
+void RenderEngineVSIndirect::DisableOcclusionCulling()
+{
+	if (!IsOcclusionCullingEnabled())
+		return;
+
+	// The Graphics submission of a frame waits for its Compute submission, so once the Graphics
+	// queue is finished, the culling shaders aren't reading the pyramid either.
+	m_graphicsQueue.WaitForQueueToFinish();
+
+	m_hiZPyramid.Destroy();
 }
 
 std::uint32_t RenderEngineVSIndirect::AddModelBundle(std::shared_ptr<ModelBundle>&& modelBundle)
@@ -535,31 +666,40 @@ std::uint32_t RenderEngineVSIndirect::AddMeshBundle(MeshBundleTemporaryData&& me
 VkSemaphore RenderEngineVSIndirect::GenericTransferStage(
 	size_t frameIndex, std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
 ) {
+	TERRA_CPU_TRACE_ZONE("GenericTransferStage");
+
 	// Transfer Phase
 
 	// If the Transfer stage isn't executed, pass the waitSemaphore on.
 	VkSemaphore signalledSemaphore = waitSemaphore;
 
-	if (m_gpuCopyNecessary)
+	// The streaming requests are processed in every frame, until the queue is empty.
+	if (m_gpuCopyNecessary || m_stagingManager.HasPendingStreamingRequests())
 	{
 		const VKCommandBuffer& transferCmdBuffer = m_transferQueue.GetCommandBuffer(frameIndex);
 
+		const VKSemaphore& transferWaitSemaphore = m_transferWait[frameIndex];
+
 		{
 			const CommandBufferScope transferCmdBufferScope{ transferCmdBuffer };
+			const GpuProfilerScope transferProfilerScope{
+				m_gpuProfiler, transferCmdBufferScope, frameIndex, TransferQueue,
+				"GenericTransferStage"
+			};
 
 			// Need to copy the old buffers first to avoid empty data being copied over
 			// the queued data.
 			m_externalResourceManager.CopyQueuedBuffers(transferCmdBufferScope);
 			m_meshManager.CopyOldBuffers(transferCmdBufferScope);
-			m_stagingManager.CopyAndClearQueuedBuffers(transferCmdBufferScope);
+			m_stagingManager.CopyAndClearQueuedBuffers(
+				transferCmdBufferScope, transferWaitSemaphore, semaphoreCounter
+			);
 
 			m_stagingManager.ReleaseOwnership(
 				transferCmdBufferScope, m_transferQueue.GetFamilyIndex()
 			);
 		}
 
-		const VKSemaphore& transferWaitSemaphore = m_transferWait[frameIndex];
-
 		{
 			QueueSubmitBuilder<1u, 1u> transferSubmitBuilder{};
 			transferSubmitBuilder
@@ -584,11 +724,16 @@ VkSemaphore RenderEngineVSIndirect::GenericTransferStage(
 VkSemaphore RenderEngineVSIndirect::FrustumCullingStage(
 	size_t frameIndex, std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
 ) {
+	TERRA_CPU_TRACE_ZONE("FrustumCullingStage");
+
 // Compute Phase
 	const VKCommandBuffer& computeCmdBuffer = m_computeQueue.GetCommandBuffer(frameIndex);
 
 	{
 		const CommandBufferScope computeCmdBufferScope{ computeCmdBuffer };
+		const GpuProfilerScope computeProfilerScope{
+			m_gpuProfiler, computeCmdBufferScope, frameIndex, ComputeQueue, "FrustumCullingStage"
+		};
 
 		m_stagingManager.AcquireOwnership(
 			computeCmdBufferScope, m_computeQueue.GetFamilyIndex(),
@@ -605,6 +750,9 @@ VkSemaphore RenderEngineVSIndirect::FrustumCullingStage(
 		);
 
 		m_modelManager.Dispatch(computeCmdBufferScope, m_computePipelineManager);
+
+		if (m_modelManager.IsDrawCountReadbackEnabled())
+			m_modelManager.CopyDrawCounts(computeCmdBufferScope, frameIndex, 0u);
 	}
 
 	const VKSemaphore& computeWaitSemaphore = m_computeWait[frameIndex];
@@ -626,6 +774,152 @@ VkSemaphore RenderEngineVSIndirect::FrustumCullingStage(
 	return computeWaitSemaphore.Get();
 }
 
+VkSemaphore RenderEngineVSIndirect::OcclusionCullingStage(
+	size_t frameIndex, std::uint32_t occlusionPhase, std::uint64_t& semaphoreCounter,
+	VkSemaphore waitSemaphore
+) {
+	TERRA_CPU_TRACE_ZONE("OcclusionCullingStage");
+
+	const size_t frameCount     = std::size(m_computeWait);
+	const size_t cmdBufferIndex = occlusionPhase == 0u ? frameIndex : frameCount + frameIndex;
+
+	const VKCommandBuffer& computeCmdBuffer = m_computeQueue.GetCommandBuffer(cmdBufferIndex);
+
+	{
+		const CommandBufferScope computeCmdBufferScope{ computeCmdBuffer };
+		const GpuProfilerScope computeProfilerScope{
+			m_gpuProfiler, computeCmdBufferScope, frameIndex, ComputeQueue,
+			"OcclusionCullingStage", occlusionPhase
+		};
+
+		if (occlusionPhase == 0u)
+			m_stagingManager.AcquireOwnership(
+				computeCmdBufferScope, m_computeQueue.GetFamilyIndex(),
+				m_transferQueue.GetFamilyIndex()
+			);
+
+		m_modelManager.ResetCounterBuffer(
+			computeCmdBuffer, static_cast<VkDeviceSize>(frameIndex)
+		);
+
+		VkDescriptorBuffer::BindDescriptorBuffer(
+			m_computeDescriptorBuffers[frameIndex], computeCmdBufferScope,
+			VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipelineLayout
+		);
+
+		m_modelManager.DispatchOcclusion(
+			computeCmdBufferScope, m_computePipelineManager, occlusionPhase
+		);
+
+		if (m_modelManager.IsDrawCountReadbackEnabled())
+			m_modelManager.CopyDrawCounts(computeCmdBufferScope, frameIndex, occlusionPhase);
+	}
+
+	const VKSemaphore& computeWaitSemaphore = m_computeWait[frameIndex];
+
+	{
+		const std::uint64_t oldSemaphoreCounterValue = semaphoreCounter;
+		++semaphoreCounter;
+
+		// In the second phase, the counters which were read by the first part of the drawing
+		// are reset with a copy and the pyramid is read in the shader.
+		const VkPipelineStageFlagBits waitStage = occlusionPhase == 0u ?
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+		QueueSubmitBuilder<1u, 1u> computeSubmitBuilder{};
+		computeSubmitBuilder
+			.SignalSemaphore(computeWaitSemaphore, semaphoreCounter)
+			.WaitSemaphore(waitSemaphore, waitStage, oldSemaphoreCounterValue)
+			.CommandBuffer(computeCmdBuffer);
+
+		m_computeQueue.SubmitCommandBuffer(computeSubmitBuilder);
+	}
+
+	return computeWaitSemaphore.Get();
+}
+
+VkSemaphore RenderEngineVSIndirect::OcclusionDrawingStage(
+	size_t frameIndex, VkExtent2D renderArea, std::uint64_t& semaphoreCounter,
+	VkSemaphore waitSemaphore
+) {
+	TERRA_CPU_TRACE_ZONE("OcclusionDrawingStage");
+
+	const VKCommandBuffer& graphicsCmdBuffer = m_occlusionGraphicsQueue.GetCommandBuffer(
+		frameIndex
+	);
+
+	{
+		const CommandBufferScope graphicsCmdBufferScope{ graphicsCmdBuffer };
+		const GpuProfilerScope graphicsProfilerScope{
+			m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue,
+			"OcclusionDrawingStage"
+		};
+
+		m_stagingManager.AcquireOwnership(
+			graphicsCmdBufferScope, m_graphicsQueue.GetFamilyIndex(),
+			m_transferQueue.GetFamilyIndex()
+		);
+
+		m_textureStorage.TransitionQueuedTextures(graphicsCmdBufferScope);
+
+		m_viewportAndScissors.BindViewportAndScissor(graphicsCmdBufferScope);
+
+		VkDescriptorBuffer::BindDescriptorBuffer(
+			m_graphicsDescriptorBuffers[frameIndex], m_sharedGraphicsDescriptorBuffer,
+			graphicsCmdBufferScope, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipelineLayout
+		);
+
+		// Every attachment is stored, so the passes can be resumed in the DrawingStage.
+		const size_t renderPassCount = std::size(m_renderPasses);
+
+		for (size_t index = 0u; index < renderPassCount; ++index)
+		{
+			if (!m_renderPasses.IsInUse(index))
+				continue;
+
+			const VkExternalRenderPass& renderPass = *m_renderPasses[index];
+
+			renderPass.StartPassToResume(graphicsCmdBufferScope, renderArea);
+
+			DrawRenderPassPipelines(frameIndex, graphicsCmdBufferScope, renderPass);
+
+			renderPass.EndPass(graphicsCmdBufferScope);
+		}
+
+		// The swapchain copy is done after the second part.
+		if (m_swapchainRenderPass)
+		{
+			const VkExternalRenderPass& renderPass = *m_swapchainRenderPass;
+
+			renderPass.StartPassToResume(graphicsCmdBufferScope, renderArea);
+
+			DrawRenderPassPipelines(frameIndex, graphicsCmdBufferScope, renderPass);
+
+			renderPass.EndPass(graphicsCmdBufferScope);
+		}
+
+		m_hiZPyramid.Build(graphicsCmdBufferScope);
+	}
+
+	const VKSemaphore& graphicsWaitSemaphore = m_occlusionGraphicsWait[frameIndex];
+
+	{
+		const std::uint64_t oldSemaphoreCounterValue = semaphoreCounter;
+		++semaphoreCounter;
+
+		QueueSubmitBuilder<1u, 1u> graphicsSubmitBuilder{};
+		graphicsSubmitBuilder
+			.SignalSemaphore(graphicsWaitSemaphore, semaphoreCounter)
+			.WaitSemaphore(
+				waitSemaphore, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, oldSemaphoreCounterValue
+			).CommandBuffer(graphicsCmdBuffer);
+
+		m_occlusionGraphicsQueue.SubmitCommandBuffer(graphicsSubmitBuilder);
+	}
+
+	return graphicsWaitSemaphore.Get();
+}
+
 void RenderEngineVSIndirect::DrawRenderPassPipelines(
 	size_t frameIndex, const VKCommandBuffer& graphicsCmdBuffer,
 	const VkExternalRenderPass& renderPass
@@ -635,6 +929,10 @@ void RenderEngineVSIndirect::DrawRenderPassPipelines(
 
 	for (const VkExternalRenderPass::PipelineDetails& details : pipelineDetails)
 	{
+		// The pipeline might still be compiling.
+		if (!m_graphicsPipelineManager.IsPipelineReady(details.pipelineGlobalIndex))
+			continue;
+
 		const std::vector<std::uint32_t>& bundleIndices        = details.modelBundleIndices;
 		const std::vector<std::uint32_t>& pipelineLocalIndices = details.pipelineLocalIndices;
 
@@ -654,24 +952,35 @@ VkSemaphore RenderEngineVSIndirect::DrawingStage(
 	size_t frameIndex, const VKImageView& renderTarget, VkExtent2D renderArea,
 	std::uint64_t& semaphoreCounter, VkSemaphore waitSemaphore
 ) {
+	TERRA_CPU_TRACE_ZONE("DrawingStage");
+
 	// Graphics Phase
 	const VKCommandBuffer& graphicsCmdBuffer = m_graphicsQueue.GetCommandBuffer(frameIndex);
 
 	{
 		const CommandBufferScope graphicsCmdBufferScope{ graphicsCmdBuffer };
+		const GpuProfilerScope graphicsProfilerScope{
+			m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue, "DrawingStage"
+		};
 
-		m_stagingManager.AcquireOwnership(
-			graphicsCmdBufferScope, m_graphicsQueue.GetFamilyIndex(),
-			m_transferQueue.GetFamilyIndex()
-		);
+		// With the occlusion culling, the passes were started in the OcclusionDrawingStage.
+		const bool resumePasses = IsOcclusionCullingEnabled();
 
-		m_textureStorage.TransitionQueuedTextures(graphicsCmdBufferScope);
+		if (!resumePasses)
+		{
+			m_stagingManager.AcquireOwnership(
+				graphicsCmdBufferScope, m_graphicsQueue.GetFamilyIndex(),
+				m_transferQueue.GetFamilyIndex()
+			);
+
+			m_textureStorage.TransitionQueuedTextures(graphicsCmdBufferScope);
+		}
 
 		m_viewportAndScissors.BindViewportAndScissor(graphicsCmdBufferScope);
 
 		VkDescriptorBuffer::BindDescriptorBuffer(
-			m_graphicsDescriptorBuffers[frameIndex], graphicsCmdBufferScope,
-			VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipelineLayout
+			m_graphicsDescriptorBuffers[frameIndex], m_sharedGraphicsDescriptorBuffer,
+			graphicsCmdBufferScope, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipelineLayout
 		);
 
 		// Normal passes
@@ -683,8 +992,15 @@ VkSemaphore RenderEngineVSIndirect::DrawingStage(
 				continue;
 
 			const VkExternalRenderPass& renderPass = *m_renderPasses[index];
+			const GpuProfilerScope renderPassProfilerScope{
+				m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue, "RenderPass",
+				static_cast<std::uint32_t>(index)
+			};
 
-			renderPass.StartPass(graphicsCmdBufferScope, renderArea);
+			if (resumePasses)
+				renderPass.ResumePass(graphicsCmdBufferScope, renderArea);
+			else
+				renderPass.StartPass(graphicsCmdBufferScope, renderArea);
 
 			DrawRenderPassPipelines(frameIndex, graphicsCmdBufferScope, renderPass);
 
@@ -695,8 +1011,15 @@ VkSemaphore RenderEngineVSIndirect::DrawingStage(
 		if (m_swapchainRenderPass)
 		{
 			const VkExternalRenderPass& renderPass = *m_swapchainRenderPass;
-
-			renderPass.StartPass(graphicsCmdBufferScope, renderArea);
+			const GpuProfilerScope renderPassProfilerScope{
+				m_gpuProfiler, graphicsCmdBufferScope, frameIndex, GraphicsQueue,
+				"SwapchainRenderPass"
+			};
+
+			if (resumePasses)
+				renderPass.ResumePass(graphicsCmdBufferScope, renderArea);
+			else
+				renderPass.StartPass(graphicsCmdBufferScope, renderArea);
 
 			DrawRenderPassPipelines(frameIndex, graphicsCmdBufferScope, renderPass);
 
@@ -7,6 +7,12 @@ void VkRenderPassManager::AddColourAttachment(
 	VkAttachmentStoreOp storeOP
 ) noexcept {
 	m_renderingInfoBuilder.AddColourAttachment(colourView, clearValue, loadOp, storeOP);
+	m_suspendingInfoBuilder.AddColourAttachment(
+		colourView, clearValue, loadOp, VK_ATTACHMENT_STORE_OP_STORE
+	);
+	m_resumingInfoBuilder.AddColourAttachment(
+		colourView, clearValue, VK_ATTACHMENT_LOAD_OP_LOAD, storeOP
+	);
 }
 
 void VkRenderPassManager::SetBarrierImageView(
@@ -27,6 +33,12 @@ void VkRenderPassManager::SetDepthAttachment(
 	VkAttachmentLoadOp loadOp, VkAttachmentStoreOp storeOP
 ) noexcept {
 	m_renderingInfoBuilder.SetDepthAttachment(depthView, clearValue, loadOp, storeOP);
+	m_suspendingInfoBuilder.SetDepthAttachment(
+		depthView, clearValue, loadOp, VK_ATTACHMENT_STORE_OP_STORE
+	);
+	m_resumingInfoBuilder.SetDepthAttachment(
+		depthView, clearValue, VK_ATTACHMENT_LOAD_OP_LOAD, storeOP
+	);
 
 	SetBarrierImageView(barrierIndex, depthView);
 }
@@ -34,11 +46,14 @@ void VkRenderPassManager::SetDepthAttachment(
 void VkRenderPassManager::SetDepthClearColour(const VkClearDepthStencilValue& clearColour) noexcept
 {
 	m_renderingInfoBuilder.SetDepthClearColour(clearColour);
+	m_suspendingInfoBuilder.SetDepthClearColour(clearColour);
 }
 
 void VkRenderPassManager::SetDepthView(std::uint32_t barrierIndex, const VKImageView& depthView) noexcept
 {
 	m_renderingInfoBuilder.SetDepthView(depthView);
+	m_suspendingInfoBuilder.SetDepthView(depthView);
+	m_resumingInfoBuilder.SetDepthView(depthView);
 
 	SetBarrierImageView(barrierIndex, depthView);
 }
@@ -48,6 +63,12 @@ void VkRenderPassManager::SetStencilAttachment(
 	VkAttachmentLoadOp loadOp, VkAttachmentStoreOp storeOP
 ) noexcept {
 	m_renderingInfoBuilder.SetStencilAttachment(stencilView, clearValue, loadOp, storeOP);
+	m_suspendingInfoBuilder.SetStencilAttachment(
+		stencilView, clearValue, loadOp, VK_ATTACHMENT_STORE_OP_STORE
+	);
+	m_resumingInfoBuilder.SetStencilAttachment(
+		stencilView, clearValue, VK_ATTACHMENT_LOAD_OP_LOAD, storeOP
+	);
 
 	SetBarrierImageView(barrierIndex, stencilView);
 }
@@ -55,12 +76,15 @@ void VkRenderPassManager::SetStencilAttachment(
 void VkRenderPassManager::SetStencilClearColour(const VkClearDepthStencilValue& clearColour) noexcept
 {
 	m_renderingInfoBuilder.SetStencilClearColour(clearColour);
+	m_suspendingInfoBuilder.SetStencilClearColour(clearColour);
 }
 
 void VkRenderPassManager::SetStencilView(
 	std::uint32_t barrierIndex, const VKImageView& stencilView
 ) noexcept {
 	m_renderingInfoBuilder.SetStencilView(stencilView);
+	m_suspendingInfoBuilder.SetStencilView(stencilView);
+	m_resumingInfoBuilder.SetStencilView(stencilView);
 
 	SetBarrierImageView(barrierIndex, stencilView);
 }
@@ -69,6 +93,8 @@ void VkRenderPassManager::SetColourView(
 	size_t colourAttachmentIndex, std::uint32_t barrierIndex, const VKImageView& colourView
 ) noexcept {
 	m_renderingInfoBuilder.SetColourView(colourAttachmentIndex, colourView);
+	m_suspendingInfoBuilder.SetColourView(colourAttachmentIndex, colourView);
+	m_resumingInfoBuilder.SetColourView(colourAttachmentIndex, colourView);
 
 	SetBarrierImageView(barrierIndex, colourView);
 }
@@ -77,6 +103,7 @@ void VkRenderPassManager::SetColourClearValue(
 	size_t colourAttachmentIndex, const VkClearColorValue& clearValue
 ) noexcept {
 	m_renderingInfoBuilder.SetColourClearValue(colourAttachmentIndex, clearValue);
+	m_suspendingInfoBuilder.SetColourClearValue(colourAttachmentIndex, clearValue);
 }
 
 void VkRenderPassManager::StartPass(const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea) const noexcept
@@ -86,7 +113,31 @@ void VkRenderPassManager::StartPass(const VKCommandBuffer& graphicsCmdBuffer, Vk
 	if (m_startImageBarriers.GetCount())
 		m_startImageBarriers.RecordBarriers(cmdBuffer);
 
-	VkRenderingInfo renderingInfo = m_renderingInfoBuilder.BuildRenderingInfo(renderArea);
+	BeginRendering(cmdBuffer, m_renderingInfoBuilder, renderArea);
+}
+
+void VkRenderPassManager::StartPassToResume(
+	const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea
+) const noexcept {
+	VkCommandBuffer cmdBuffer = graphicsCmdBuffer.Get();
+
+	if (m_startImageBarriers.GetCount())
+		m_startImageBarriers.RecordBarriers(cmdBuffer);
+
+	BeginRendering(cmdBuffer, m_suspendingInfoBuilder, renderArea);
+}
+
+void VkRenderPassManager::ResumePass(
+	const VKCommandBuffer& graphicsCmdBuffer, VkExtent2D renderArea
+) const noexcept {
+	BeginRendering(graphicsCmdBuffer.Get(), m_resumingInfoBuilder, renderArea);
+}
+
+void VkRenderPassManager::BeginRendering(
+	VkCommandBuffer cmdBuffer, const RenderingInfoBuilder& renderingInfoBuilder,
+	VkExtent2D renderArea
+) noexcept {
+	VkRenderingInfo renderingInfo = renderingInfoBuilder.BuildRenderingInfo(renderArea);
 
 	vkCmdBeginRendering(cmdBuffer, &renderingInfo);
 }
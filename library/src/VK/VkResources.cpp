@@ -217,7 +217,10 @@ VkDeviceSize Texture::GetBufferSize() const noexcept
 		{ VK_FORMAT_B8G8R8A8_SNORM, 4u },
 		{ VK_FORMAT_B8G8R8A8_UINT,  4u },
 		{ VK_FORMAT_B8G8R8A8_SINT,  4u },
-		{ VK_FORMAT_B8G8R8A8_SRGB,  4u }
+		{ VK_FORMAT_B8G8R8A8_SRGB,  4u },
+		{ VK_FORMAT_R16G16B16A16_SFLOAT, 8u },
+		{ VK_FORMAT_R8_UNORM,            1u },
+		{ VK_FORMAT_R16_SFLOAT,          2u }
 	};
 
 	const VkFormat textureFormat = Format();
@@ -1,8 +1,124 @@
 #include <VkShader.hpp>
 #include <TerraException.hpp>
+#include <filesystem>
+
+#ifdef TERRA_WIN32
+#include <CleanWin.hpp>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace Terra
 {
+// Maps the whole file as read only, so the binary can be passed to the driver without copying
+// it into a buffer first.
+class MappedFile
+{
+public:
+	MappedFile(const std::filesystem::path& filePath);
+	~MappedFile() noexcept;
+
+	[[nodiscard]]
+	bool IsMapped() const noexcept { return m_data != nullptr; }
+
+	[[nodiscard]]
+	void const* GetData() const noexcept { return m_data; }
+	[[nodiscard]]
+	size_t GetSize() const noexcept { return m_size; }
+
+private:
+#ifdef TERRA_WIN32
+	HANDLE      m_file;
+	HANDLE      m_mapping;
+#else
+	int         m_file;
+#endif
+	void const* m_data;
+	size_t      m_size;
+
+public:
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+};
+
+#ifdef TERRA_WIN32
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+	: m_file{ INVALID_HANDLE_VALUE }, m_mapping{ nullptr }, m_data{ nullptr }, m_size{ 0u }
+{
+	m_file = CreateFileW(
+		filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+	);
+
+	if (m_file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER fileSize{};
+
+	if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart == 0)
+		return;
+
+	m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+
+	if (!m_mapping)
+		return;
+
+	m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0u, 0u, 0u);
+
+	if (m_data)
+		m_size = static_cast<size_t>(fileSize.QuadPart);
+}
+
+MappedFile::~MappedFile() noexcept
+{
+	if (m_data)
+		UnmapViewOfFile(m_data);
+
+	if (m_mapping)
+		CloseHandle(m_mapping);
+
+	if (m_file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file);
+}
+#else
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+	: m_file{ -1 }, m_data{ nullptr }, m_size{ 0u }
+{
+	m_file = open(filePath.c_str(), O_RDONLY);
+
+	if (m_file == -1)
+		return;
+
+	struct stat fileStat{};
+
+	if (fstat(m_file, &fileStat) != 0 || fileStat.st_size == 0)
+		return;
+
+	const auto fileSize = static_cast<size_t>(fileStat.st_size);
+
+	void* data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, m_file, 0);
+
+	if (data == MAP_FAILED)
+		return;
+
+	m_data = data;
+	m_size = fileSize;
+}
+
+MappedFile::~MappedFile() noexcept
+{
+	if (m_data)
+		munmap(const_cast<void*>(m_data), m_size);
+
+	if (m_file != -1)
+		close(m_file);
+}
+#endif
+
+// Shader
 VkShader::~VkShader() noexcept
 {
 	SelfDestruct();
@@ -15,15 +131,14 @@ void VkShader::SelfDestruct() noexcept
 
 bool VkShader::Create(const std::wstring& fileName)
 {
-	std::ifstream shader{ fileName.c_str(), std::ios_base::binary | std::ios_base::ate };
+	MappedFile shader{ std::filesystem::path{ fileName } };
 
 	bool success = false;
 
-	if (shader.is_open())
+	if (shader.IsMapped())
 	{
-		std::vector<char> byteCode = LoadBinary(shader);
-
-		CreateShaderModule(m_device, std::data(byteCode), std::size(byteCode));
+		// The mapping is page aligned, so it satisfies the alignment of the SPIR-V words.
+		CreateShaderModule(m_device, shader.GetData(), shader.GetSize());
 
 		success = true;
 	}
@@ -43,15 +158,50 @@ void VkShader::CreateShaderModule(
 	vkCreateShaderModule(device, &createInfo, nullptr, &m_shaderBinary);
 }
 
-std::vector<char> VkShader::LoadBinary(std::ifstream& shader)
+// Shader Module Cache
+void ShaderModuleCache::SetShaderPath(std::wstring shaderPath)
+{
+	std::scoped_lock lock{ *m_mutex };
+
+	if (shaderPath == m_shaderPath)
+		return;
+
+	// The same names would be pointing to different files now.
+	m_shaders.clear();
+
+	m_shaderPath = std::move(shaderPath);
+}
+
+void ShaderModuleCache::Clear() noexcept
 {
-	const auto shaderSize = static_cast<size_t>(shader.tellg());
-	shader.seekg(0u);
+	std::scoped_lock lock{ *m_mutex };
+
+	m_shaders.clear();
+}
+
+VkShaderModule ShaderModuleCache::GetShaderModule(
+	const ShaderName& shaderName, ShaderBinaryType binaryType
+) {
+	std::wstring shaderKey = shaderName.GetNameWithExtension(binaryType);
+
+	// Holding the lock while loading, so the same file isn't loaded by multiple threads.
+	std::scoped_lock lock{ *m_mutex };
+
+	auto result = m_shaders.find(shaderKey);
+
+	if (result != std::end(m_shaders))
+		return result->second.Get();
+
+	VkShader shader{ m_device };
+
+	// The failed ones aren't kept, so they would be loaded again if the file is added later.
+	if (!shader.Create(m_shaderPath + shaderKey))
+		return VK_NULL_HANDLE;
+
+	VkShaderModule shaderModule = shader.Get();
 
-	std::vector<char> byteCode{};
-	byteCode.resize(shaderSize);
-	shader.read(std::data(byteCode), static_cast<std::streamsize>(shaderSize));
+	m_shaders.emplace(std::move(shaderKey), std::move(shader));
 
-	return byteCode;
+	return shaderModule;
 }
 }
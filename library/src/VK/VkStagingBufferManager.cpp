@@ -2,13 +2,323 @@
 #include <ranges>
 #include <algorithm>
 #include <cassert>
+#include <CpuTracer.hpp>
 
 namespace Terra
 {
+// Staging Ring Buffer
+StagingRingBuffer::StagingRingBuffer(VkDevice device, MemoryManager* memoryManager)
+	: m_device{ device }, m_memoryManager{ memoryManager },
+	m_buffer{
+		std::make_unique<Buffer>(device, memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+	},
+	m_submissions{}, m_retiredBuffers{}, m_head{ 0u }, m_tail{ 0u }, m_isWrapped{ false },
+	m_hasPendingAllocations{ false }
+{}
+
+[[nodiscard]]
+static constexpr VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) noexcept
+{
+	return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+std::optional<VkDeviceSize> StagingRingBuffer::TryToAllocate(VkDeviceSize size) noexcept
+{
+	const VkDeviceSize bufferSize = m_buffer->BufferSize();
+
+	if (!m_isWrapped)
+	{
+		const VkDeviceSize allocationStart = AlignUp(m_head, s_allocationAlignment);
+
+		if (allocationStart + size <= bufferSize)
+		{
+			m_head = allocationStart + size;
+
+			return allocationStart;
+		}
+
+		// Wrap around. The head must never reach the tail, as then there would be no way to
+		// tell a full buffer from an empty one.
+		if (size < m_tail)
+		{
+			m_head      = size;
+			m_isWrapped = true;
+
+			return 0u;
+		}
+	}
+	else
+	{
+		const VkDeviceSize allocationStart = AlignUp(m_head, s_allocationAlignment);
+
+		if (allocationStart + size < m_tail)
+		{
+			m_head = allocationStart + size;
+
+			return allocationStart;
+		}
+	}
+
+	return {};
+}
+
+void StagingRingBuffer::Grow(VkDeviceSize minimumSize)
+{
+	const VkDeviceSize newSize = std::max(
+		{ s_initialSize, m_buffer->BufferSize() * 2u, AlignUp(minimumSize, s_allocationAlignment) }
+	);
+
+	const bool isInUse = m_hasPendingAllocations || !std::empty(m_submissions);
+
+	if (isInUse)
+	{
+		RetiredBuffer retiredBuffer{
+			.buffer      = std::move(m_buffer),
+			.semaphore   = VK_NULL_HANDLE,
+			.signalValue = 0u,
+			.isSubmitted = !m_hasPendingAllocations
+		};
+
+		// The last submission would be the last one to finish using the buffer.
+		if (retiredBuffer.isSubmitted)
+		{
+			const Submission& lastSubmission = m_submissions.back();
+
+			retiredBuffer.semaphore   = lastSubmission.semaphore;
+			retiredBuffer.signalValue = lastSubmission.signalValue;
+		}
+
+		m_retiredBuffers.emplace_back(std::move(retiredBuffer));
+
+		m_buffer = std::make_unique<Buffer>(
+			m_device, m_memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+		);
+	}
+
+	m_buffer->Create(newSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, {});
+
+	m_submissions.clear();
+
+	m_head      = 0u;
+	m_tail      = 0u;
+	m_isWrapped = false;
+}
+
+StagingRingBuffer::Allocation StagingRingBuffer::Allocate(VkDeviceSize size)
+{
+	std::optional<VkDeviceSize> allocationStart = TryToAllocate(size);
+
+	// The finished submissions might not have been reclaimed yet, if the allocation was made
+	// in place.
+	if (!allocationStart)
+	{
+		Recycle();
+
+		allocationStart = TryToAllocate(size);
+	}
+
+	if (!allocationStart)
+	{
+		Grow(size);
+
+		allocationStart = TryToAllocate(size);
+	}
+
+	m_hasPendingAllocations = true;
+
+	const VkDeviceSize offset = allocationStart.value();
+
+	return Allocation{
+		.buffer    = m_buffer.get(),
+		.offset    = offset,
+		.cpuHandle = m_buffer->CPUHandle() + offset
+	};
+}
+
+void StagingRingBuffer::Submit(VkSemaphore timelineSemaphore, std::uint64_t signalValue)
+{
+	for (RetiredBuffer& retiredBuffer : m_retiredBuffers)
+		if (!retiredBuffer.isSubmitted)
+		{
+			retiredBuffer.semaphore   = timelineSemaphore;
+			retiredBuffer.signalValue = signalValue;
+			retiredBuffer.isSubmitted = true;
+		}
+
+	if (!m_hasPendingAllocations)
+		return;
+
+	m_submissions.emplace_back(
+		Submission{ .semaphore = timelineSemaphore, .signalValue = signalValue, .end = m_head }
+	);
+
+	m_hasPendingAllocations = false;
+}
+
+bool StagingRingBuffer::IsSemaphoreSignalled(
+	VkSemaphore semaphore, std::uint64_t signalValue
+) const noexcept {
+	std::uint64_t currentValue = 0u;
+
+	vkGetSemaphoreCounterValue(m_device, semaphore, &currentValue);
+
+	return currentValue >= signalValue;
+}
+
+void StagingRingBuffer::Recycle()
+{
+	while (!std::empty(m_submissions))
+	{
+		const Submission& submission = m_submissions.front();
+
+		if (!IsSemaphoreSignalled(submission.semaphore, submission.signalValue))
+			break;
+
+		// If the end is before the tail, the allocations of this submission have wrapped around.
+		if (submission.end < m_tail)
+			m_isWrapped = false;
+
+		m_tail = submission.end;
+
+		m_submissions.pop_front();
+	}
+
+	// Start from the beginning again if nothing is in use, so the allocations don't need to
+	// wrap around.
+	if (std::empty(m_submissions) && !m_hasPendingAllocations)
+	{
+		m_head      = 0u;
+		m_tail      = 0u;
+		m_isWrapped = false;
+	}
+
+	std::erase_if(
+		m_retiredBuffers,
+		[this](const RetiredBuffer& retiredBuffer)
+		{
+			return retiredBuffer.isSubmitted
+				&& IsSemaphoreSignalled(retiredBuffer.semaphore, retiredBuffer.signalValue);
+		}
+	);
+}
+
+// Streaming Upload Queue
+StreamingUploadQueue::StreamingUploadQueue(VkDevice device)
+	: m_device{ device }, m_mutex{ std::make_unique<std::mutex>() }, m_requests{},
+	m_submissions{}, m_lastAddedID{ 0u }, m_lastPoppedID{ 0u }, m_lastSubmittedID{ 0u },
+	m_lastCompletedID{ 0u }
+{}
+
+std::uint64_t StreamingUploadQueue::Add(Request&& request)
+{
+	std::scoped_lock lock{ *m_mutex };
+
+	m_requests.emplace_back(std::move(request));
+
+	return ++m_lastAddedID;
+}
+
+std::optional<StreamingUploadQueue::Request> StreamingUploadQueue::Pop()
+{
+	std::scoped_lock lock{ *m_mutex };
+
+	if (std::empty(m_requests))
+		return {};
+
+	Request request = std::move(m_requests.front());
+
+	m_requests.pop_front();
+
+	++m_lastPoppedID;
+
+	return request;
+}
+
+void StreamingUploadQueue::Submit(VkSemaphore timelineSemaphore, std::uint64_t signalValue)
+{
+	std::scoped_lock lock{ *m_mutex };
+
+	if (m_lastPoppedID == m_lastSubmittedID)
+		return;
+
+	m_submissions.emplace_back(
+		Submission{
+			.completionPoint = CompletionPoint{
+				.semaphore = timelineSemaphore, .signalValue = signalValue
+			},
+			.lastRequestID   = m_lastPoppedID
+		}
+	);
+
+	m_lastSubmittedID = m_lastPoppedID;
+}
+
+bool StreamingUploadQueue::HasPendingRequests() const
+{
+	std::scoped_lock lock{ *m_mutex };
+
+	return !std::empty(m_requests);
+}
+
+void StreamingUploadQueue::UpdateCompletedRequests() noexcept
+{
+	while (!std::empty(m_submissions))
+	{
+		const Submission& submission = m_submissions.front();
+
+		std::uint64_t currentValue = 0u;
+
+		vkGetSemaphoreCounterValue(
+			m_device, submission.completionPoint.semaphore, &currentValue
+		);
+
+		if (currentValue < submission.completionPoint.signalValue)
+			break;
+
+		m_lastCompletedID = submission.lastRequestID;
+
+		m_submissions.pop_front();
+	}
+}
+
+bool StreamingUploadQueue::IsComplete(std::uint64_t requestID)
+{
+	std::scoped_lock lock{ *m_mutex };
+
+	if (requestID > m_lastCompletedID)
+		UpdateCompletedRequests();
+
+	return requestID <= m_lastCompletedID;
+}
+
+std::optional<StreamingUploadQueue::CompletionPoint> StreamingUploadQueue::GetCompletionPoint(
+	std::uint64_t requestID
+) {
+	std::scoped_lock lock{ *m_mutex };
+
+	if (requestID <= m_lastCompletedID || requestID > m_lastSubmittedID)
+		return {};
+
+	// The submissions are in order, so the first one which has a last ID larger than or
+	// equal to the request ID would have it.
+	auto result = std::ranges::find_if(
+		m_submissions, [requestID](const Submission& submission)
+		{
+			return requestID <= submission.lastRequestID;
+		}
+	);
+
+	if (result == std::end(m_submissions))
+		return {};
+
+	return result->completionPoint;
+}
+
+// Staging Buffer Manager
 StagingBufferManager& StagingBufferManager::AddTextureView(
 	std::shared_ptr<void> cpuData, VkTextureView const* dst, const VkOffset3D& offset,
 	QueueType dstQueueType, VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage,
-	Callisto::TemporaryDataBufferGPU& tempDataBuffer, std::uint32_t mipLevelIndex/* = 0u */
+	std::uint32_t mipLevelIndex/* = 0u */
 ) {
 	const VkDeviceSize bufferSize = dst->GetTexture().GetBufferSize();
 
@@ -19,71 +329,241 @@ StagingBufferManager& StagingBufferManager::AddTextureView(
 
 	m_textureInfo.emplace_back(
 		TextureInfo{
-			.cpuHandle     = cpuData.get(),
-			.bufferSize    = bufferSize,
-			.dst           = dst,
-			.offset        = offset,
-			.mipLevelIndex = mipLevelIndex,
-			.dstQueueType  = dstQueueType,
-			.dstAccess     = dstAccess,
-			.dstStage      = dstStage
+			.cpuHandle         = cpuData.get(),
+			.stagingAllocation = {},
+			.bufferSize        = bufferSize,
+			.dst               = dst,
+			.offset            = offset,
+			.mipLevelIndex     = mipLevelIndex,
+			.dstQueueType      = dstQueueType,
+			.dstAccess         = dstAccess,
+			.dstStage          = dstStage
 		}
 	);
 
 	m_cpuTempBuffer.Add(std::move(cpuData));
 
-	auto tempBuffer = std::make_shared<Buffer>(
-		m_device, m_memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-	);
+	return *this;
+}
 
-	m_tempBufferToTexture.emplace_back(tempBuffer);
+StagingBufferManager& StagingBufferManager::AddBuffer(
+	std::shared_ptr<void> cpuData, VkDeviceSize bufferSize, Buffer const* dst, VkDeviceSize offset,
+	QueueType dstQueueType, VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage
+) {
+	assert(
+		!CheckForDuplicateBufferOwnershipTransfer(dst, dstQueueType)
+		&& "The same buffer is being added for copy more than once back to back."
+	);
 
-	tempBuffer->Create(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, {});
+	m_bufferInfo.emplace_back(
+		BufferInfo{
+			.cpuHandle         = cpuData.get(),
+			.stagingAllocation = {},
+			.bufferSize        = bufferSize,
+			.dst               = dst,
+			.offset            = offset,
+			.dstQueueType      = dstQueueType,
+			.dstAccess         = dstAccess,
+			.dstStage          = dstStage
+		}
+	);
 
-	tempDataBuffer.Add(std::move(tempBuffer));
+	m_cpuTempBuffer.Add(std::move(cpuData));
 
 	return *this;
 }
 
-StagingBufferManager& StagingBufferManager::AddBuffer(
-	std::shared_ptr<void> cpuData, VkDeviceSize bufferSize, Buffer const* dst, VkDeviceSize offset,
-	QueueType dstQueueType, VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage,
-	Callisto::TemporaryDataBufferGPU& tempDataBuffer
+std::span<std::uint8_t> StagingBufferManager::AddTextureViewInPlace(
+	VkTextureView const* dst, const VkOffset3D& offset, QueueType dstQueueType,
+	VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage,
+	std::uint32_t mipLevelIndex/* = 0u */
+) {
+	const VkDeviceSize bufferSize = dst->GetTexture().GetBufferSize();
+
+	assert(
+		!CheckForDuplicateTextureViewOwnershipTransfer(dst, dstQueueType)
+		&& "The same texture is being added for copy more than once back to back."
+	);
+
+	const StagingRingBuffer::Allocation stagingAllocation = m_stagingBuffer.Allocate(bufferSize);
+
+	m_textureInfo.emplace_back(
+		TextureInfo{
+			.cpuHandle         = nullptr,
+			.stagingAllocation = stagingAllocation,
+			.bufferSize        = bufferSize,
+			.dst               = dst,
+			.offset            = offset,
+			.mipLevelIndex     = mipLevelIndex,
+			.dstQueueType      = dstQueueType,
+			.dstAccess         = dstAccess,
+			.dstStage          = dstStage
+		}
+	);
+
+	return std::span<std::uint8_t>{ stagingAllocation.cpuHandle, bufferSize };
+}
+
+std::span<std::uint8_t> StagingBufferManager::AddBufferInPlace(
+	VkDeviceSize bufferSize, Buffer const* dst, VkDeviceSize offset, QueueType dstQueueType,
+	VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage
 ) {
 	assert(
 		!CheckForDuplicateBufferOwnershipTransfer(dst, dstQueueType)
 		&& "The same buffer is being added for copy more than once back to back."
 	);
 
+	const StagingRingBuffer::Allocation stagingAllocation = m_stagingBuffer.Allocate(bufferSize);
+
 	m_bufferInfo.emplace_back(
 		BufferInfo{
-			.cpuHandle    = cpuData.get(),
-			.bufferSize   = bufferSize,
-			.dst          = dst,
-			.offset       = offset,
-			.dstQueueType = dstQueueType,
-			.dstAccess    = dstAccess,
-			.dstStage     = dstStage
+			.cpuHandle         = nullptr,
+			.stagingAllocation = stagingAllocation,
+			.bufferSize        = bufferSize,
+			.dst               = dst,
+			.offset            = offset,
+			.dstQueueType      = dstQueueType,
+			.dstAccess         = dstAccess,
+			.dstStage          = dstStage
 		}
 	);
 
-	m_cpuTempBuffer.Add(std::move(cpuData));
+	return std::span<std::uint8_t>{ stagingAllocation.cpuHandle, bufferSize };
+}
 
-	auto tempBuffer = std::make_shared<Buffer>(
-		m_device, m_memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+std::uint64_t StagingBufferManager::StreamTextureView(
+	std::shared_ptr<void> cpuData, VkTextureView const* dst, const VkOffset3D& offset,
+	QueueType dstQueueType, VkAccessFlagBits2 dstAccess, VkPipelineStageFlags2 dstStage,
+	std::uint32_t mipLevelIndex/* = 0u */
+) {
+	return m_streamingQueue.Add(
+		StreamingUploadQueue::Request{
+			.cpuData       = std::move(cpuData),
+			.bufferSize    = dst->GetTexture().GetBufferSize(),
+			.bufferDst     = nullptr,
+			.bufferOffset  = 0u,
+			.textureDst    = dst,
+			.textureOffset = offset,
+			.mipLevelIndex = mipLevelIndex,
+			.dstQueueType  = dstQueueType,
+			.dstAccess     = dstAccess,
+			.dstStage      = dstStage
+		}
 	);
+}
 
-	m_tempBufferToBuffer.emplace_back(tempBuffer);
+std::uint64_t StagingBufferManager::StreamBuffer(
+	std::shared_ptr<void> cpuData, VkDeviceSize bufferSize, Buffer const* dst,
+	VkDeviceSize offset, QueueType dstQueueType, VkAccessFlagBits2 dstAccess,
+	VkPipelineStageFlags2 dstStage
+) {
+	return m_streamingQueue.Add(
+		StreamingUploadQueue::Request{
+			.cpuData       = std::move(cpuData),
+			.bufferSize    = bufferSize,
+			.bufferDst     = dst,
+			.bufferOffset  = offset,
+			.textureDst    = nullptr,
+			.textureOffset = {},
+			.mipLevelIndex = 0u,
+			.dstQueueType  = dstQueueType,
+			.dstAccess     = dstAccess,
+			.dstStage      = dstStage
+		}
+	);
+}
 
-	tempBuffer->Create(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, {});
+void StagingBufferManager::ProcessStreamingRequests()
+{
+	using Clock = std::chrono::steady_clock;
 
-	tempDataBuffer.Add(std::move(tempBuffer));
+	const Clock::time_point startTime = Clock::now();
+	VkDeviceSize processedSize        = 0u;
 
-	return *this;
+	// The data is copied here on this thread, instead of with the thread pool in CopyCPU, so
+	// the time of the copying is included in the budget.
+	while (processedSize < m_streamingBudget.bytesPerFrame
+		&& Clock::now() - startTime < m_streamingBudget.timePerFrame)
+	{
+		std::optional<StreamingUploadQueue::Request> request = m_streamingQueue.Pop();
+
+		if (!request)
+			break;
+
+		const VkDeviceSize bufferSize = request->bufferSize;
+
+		std::span<std::uint8_t> stagingData{};
+
+		if (request->textureDst)
+			stagingData = AddTextureViewInPlace(
+				request->textureDst, request->textureOffset, request->dstQueueType,
+				request->dstAccess, request->dstStage, request->mipLevelIndex
+			);
+		else
+			stagingData = AddBufferInPlace(
+				bufferSize, request->bufferDst, request->bufferOffset, request->dstQueueType,
+				request->dstAccess, request->dstStage
+			);
+
+		memcpy(std::data(stagingData), request->cpuData.get(), bufferSize);
+
+		processedSize += bufferSize;
+	}
+}
+
+void StagingBufferManager::AllocateStagingMemory()
+{
+	// The whole batch is allocated in one go, so the ring buffer would only grow once, if
+	// it doesn't have enough space.
+	VkDeviceSize totalSize = 0u;
+
+	// The ones which were added in place already have their staging memory.
+	auto AddAlignedSize = [&totalSize]<typename T>(const std::vector<T>& infos) noexcept
+	{
+		for (const T& info : infos)
+			if (info.cpuHandle)
+				totalSize = AlignUp(totalSize, StagingRingBuffer::s_allocationAlignment)
+					+ info.bufferSize;
+	};
+
+	AddAlignedSize(m_bufferInfo);
+	AddAlignedSize(m_textureInfo);
+
+	if (totalSize == 0u)
+		return;
+
+	const StagingRingBuffer::Allocation batchAllocation = m_stagingBuffer.Allocate(totalSize);
+
+	VkDeviceSize batchOffset = 0u;
+
+	auto SetStagingAllocations = [&batchOffset, &batchAllocation]<typename T>(
+		std::vector<T>& infos
+	) noexcept {
+		for (T& info : infos)
+		{
+			if (!info.cpuHandle)
+				continue;
+
+			batchOffset = AlignUp(batchOffset, StagingRingBuffer::s_allocationAlignment);
+
+			info.stagingAllocation = StagingRingBuffer::Allocation{
+				.buffer    = batchAllocation.buffer,
+				.offset    = batchAllocation.offset + batchOffset,
+				.cpuHandle = batchAllocation.cpuHandle + batchOffset
+			};
+
+			batchOffset += info.bufferSize;
+		}
+	};
+
+	SetStagingAllocations(m_bufferInfo);
+	SetStagingAllocations(m_textureInfo);
 }
 
 void StagingBufferManager::CopyCPU()
 {
+	TERRA_CPU_TRACE_ZONE("StagingBufferManager::CopyCPU");
+
 	struct Batch
 	{
 		size_t startIndex;
@@ -105,12 +585,19 @@ void StagingBufferManager::CopyCPU()
 		{
 			const BufferInfo& bufferInfo = m_bufferInfo[index];
 
-			tasks.emplace_back([&bufferInfo, &tempBuffer = m_tempBufferToBuffer[index]]
+			// The in place ones don't have anything to copy, but the tasks must still match
+			// the indices.
+			tasks.emplace_back([&bufferInfo]
 				{
-					memcpy(tempBuffer->CPUHandle(), bufferInfo.cpuHandle, bufferInfo.bufferSize);
+					if (bufferInfo.cpuHandle)
+						memcpy(
+							bufferInfo.stagingAllocation.cpuHandle, bufferInfo.cpuHandle,
+							bufferInfo.bufferSize
+						);
 				});
 
-			currentBatchSize += bufferInfo.bufferSize;
+			if (bufferInfo.cpuHandle)
+				currentBatchSize += bufferInfo.bufferSize;
 
 			if (currentBatchSize >= batchSize)
 			{
@@ -135,12 +622,17 @@ void StagingBufferManager::CopyCPU()
 		{
 			const TextureInfo& textureInfo = m_textureInfo[index];
 
-			tasks.emplace_back([&textureInfo, &tempBuffer = m_tempBufferToTexture[index]]
+			tasks.emplace_back([&textureInfo]
 				{
-					memcpy(tempBuffer->CPUHandle(), textureInfo.cpuHandle, textureInfo.bufferSize);
+					if (textureInfo.cpuHandle)
+						memcpy(
+							textureInfo.stagingAllocation.cpuHandle, textureInfo.cpuHandle,
+							textureInfo.bufferSize
+						);
 				});
 
-			currentBatchSize += textureInfo.bufferSize;
+			if (textureInfo.cpuHandle)
+				currentBatchSize += textureInfo.bufferSize;
 
 			if (currentBatchSize >= batchSize)
 			{
@@ -171,6 +663,8 @@ void StagingBufferManager::CopyCPU()
 		waitObjs.emplace_back(m_threadPool->SubmitWork(std::function{
 			[&tTasks = tasks, batch]
 			{
+				TERRA_CPU_TRACE_ZONE("StagingBufferManager::CopyCPU Batch");
+
 				for (size_t index = batch.startIndex; index <= batch.endIndex; ++index)
 				{
 					tTasks[index]();
@@ -190,64 +684,122 @@ void StagingBufferManager::CopyCPU()
 
 void StagingBufferManager::CopyGPU(const VKCommandBuffer& transferCmdBuffer)
 {
+	// Making these static, so dynamic allocation happens less.
+	static std::vector<size_t>       sortedIndices{};
+	static std::vector<VkBufferCopy> copyRegions{};
+
 	// Assuming the command buffer has been reset before this.
-	for(size_t index = 0u; index < std::size(m_bufferInfo); ++index)
 	{
-		const BufferInfo& bufferInfo = m_bufferInfo[index];
-		const Buffer& tempBuffer     = *m_tempBufferToBuffer[index];
+		// The copies to the same destination are batched into a single command. The sort is
+		// stable, so the copies to the same destination stay in the order they were added.
+		for (size_t index = 0u; index < std::size(m_bufferInfo); ++index)
+			sortedIndices.emplace_back(index);
+
+		std::ranges::stable_sort(
+			sortedIndices, std::less<Buffer const*>{},
+			[&bufferInfos = m_bufferInfo](size_t index) { return bufferInfos[index].dst; }
+		);
+
+		Buffer const* currentSrc      = nullptr;
+		Buffer const* currentDst      = nullptr;
+		VkDeviceSize  currentDstStart = 0u;
+		VkDeviceSize  currentDstEnd   = 0u;
+
+		auto RecordCopyRegions = [&transferCmdBuffer, &currentSrc, &currentDst]
+		{
+			if (!std::empty(copyRegions))
+				transferCmdBuffer.Copy(*currentSrc, *currentDst, copyRegions);
+
+			copyRegions.clear();
+		};
+
+		for (size_t index : sortedIndices)
+		{
+			const BufferInfo& bufferInfo = m_bufferInfo[index];
+
+			Buffer const* src            = bufferInfo.stagingAllocation.buffer;
+			const VkDeviceSize regionEnd = bufferInfo.offset + bufferInfo.bufferSize;
+
+			// The regions of a single copy command must not overlap. As the regions are mostly
+			// added in order, only the range of the current batch is checked.
+			const bool isOverlapping = !std::empty(copyRegions)
+				&& bufferInfo.offset < currentDstEnd && regionEnd > currentDstStart;
+
+			if (src != currentSrc || bufferInfo.dst != currentDst || isOverlapping)
+			{
+				RecordCopyRegions();
 
-		BufferToBufferCopyBuilder bufferBuilder = BufferToBufferCopyBuilder{}
-			.Size(bufferInfo.bufferSize).DstOffset(bufferInfo.offset);
+				currentSrc      = src;
+				currentDst      = bufferInfo.dst;
+				currentDstStart = bufferInfo.offset;
+				currentDstEnd   = regionEnd;
+			}
+
+			// The size must be used instead of the whole source, as the destination might have
+			// a smaller reserved size than the alignment, for example.
+			copyRegions.emplace_back(
+				VkBufferCopy{
+					.srcOffset = bufferInfo.stagingAllocation.offset,
+					.dstOffset = bufferInfo.offset,
+					.size      = bufferInfo.bufferSize
+				}
+			);
 
-		// I am making a new buffer for each copy but if the buffer alignment for example is
-		// 16 bytes and the buffer size is 4bytes, copyWhole would be wrong as it would go over
-		// the reserved size in the destination buffer.
-		transferCmdBuffer.Copy(tempBuffer, *bufferInfo.dst, bufferBuilder);
+			currentDstStart = std::min(currentDstStart, bufferInfo.offset);
+			currentDstEnd   = std::max(currentDstEnd, regionEnd);
+		}
+
+		RecordCopyRegions();
+
+		sortedIndices.clear();
 	}
 
 	for(size_t index = 0u; index < std::size(m_textureInfo); ++index)
 	{
 		const TextureInfo& textureInfo = m_textureInfo[index];
-		const Buffer& tempBuffer       = *m_tempBufferToTexture[index];
 
 		BufferToImageCopyBuilder bufferBuilder = BufferToImageCopyBuilder{}
-			.ImageOffset(textureInfo.offset).ImageMipLevel(textureInfo.mipLevelIndex);
+			.ImageOffset(textureInfo.offset).ImageMipLevel(textureInfo.mipLevelIndex)
+			.BufferOffet(textureInfo.stagingAllocation.offset);
 
 		// CopyWhole would not be a problem for textures, as the destination buffer would be a texture
 		// and will be using the dimension of the texture instead of its size to copy. And there should
 		// be only a single texture in a texture buffer.
-		transferCmdBuffer.CopyWhole(tempBuffer, *textureInfo.dst, bufferBuilder);
+		transferCmdBuffer.CopyWhole(
+			*textureInfo.stagingAllocation.buffer, *textureInfo.dst, bufferBuilder
+		);
 	}
 }
 
-void StagingBufferManager::CopyAndClearQueuedBuffers(const VKCommandBuffer& transferCmdBuffer)
-{
-	// Since these are first copied to temp buffers and those are
+void StagingBufferManager::CopyAndClearQueuedBuffers(
+	const VKCommandBuffer& transferCmdBuffer, const VKSemaphore& transferSemaphore,
+	std::uint64_t signalValue
+) {
+	// Since these are first copied to the staging buffer and that is
 	// copied on the GPU, we don't need any cpu synchronisation.
 	// But we should wait on some semaphores from other queues which
 	// are already running before we submit these copy commands.
+	ProcessStreamingRequests();
+
 	if (!std::empty(m_textureInfo) || !std::empty(m_bufferInfo))
 	{
+		m_stagingBuffer.Recycle();
+
+		AllocateStagingMemory();
+
 		CopyCPU();
 		CopyGPU(transferCmdBuffer);
 
+		m_stagingBuffer.Submit(transferSemaphore.Get(), signalValue);
+		m_streamingQueue.Submit(transferSemaphore.Get(), signalValue);
+
 		// Now that the cpu copying is done. We can clear the tempData.
 		m_cpuTempBuffer.Clear();
 
-		// It's okay to clean the Temp buffers up here. As we have another instance in the
-		// global tempBuffer and that one should be deleted after the resources have been
-		// copied on the GPU.
-		CleanUpTempBuffers();
 		CleanUpBufferInfo();
 	}
 }
 
-void StagingBufferManager::CleanUpTempBuffers() noexcept
-{
-	m_tempBufferToBuffer.clear();
-	m_tempBufferToTexture.clear();
-}
-
 void StagingBufferManager::CleanUpBufferInfo() noexcept
 {
 	// Any bufferInfo with QueueType::None would mean that resource has shared access. And doesn't
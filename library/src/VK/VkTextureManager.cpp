@@ -5,8 +5,7 @@ namespace Terra
 {
 // Texture storage
 size_t TextureStorage::AddTexture(
-	STexture&& texture, StagingBufferManager& stagingBufferManager,
-	Callisto::TemporaryDataBufferGPU& tempBuffer
+	STexture&& texture, StagingBufferManager& stagingBufferManager
 ) {
 	const size_t index = m_textures.Add(
 		VkTextureView{ m_device, m_memoryManager, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT }
@@ -22,7 +21,7 @@ size_t TextureStorage::AddTexture(
 
 	stagingBufferManager.AddTextureView(
 		std::move(texture.data), textureViewPtr, {}, QueueType::GraphicsQueue,
-		VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, tempBuffer
+		VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT
 	);
 
 	// Should be fine because of the deque.
@@ -152,22 +151,49 @@ std::vector<std::uint32_t> TextureStorage::GetAndRemoveCombinedCacheDetailsSampl
 }
 
 // Texture Manager
+std::uint32_t TextureManager::GetMaxCombinedTextureCount(VkPhysicalDevice physicalDevice) noexcept
+{
+	VkPhysicalDeviceProperties deviceProperties{};
+	vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+
+	const VkPhysicalDeviceLimits& limits = deviceProperties.limits;
+
+	// Some drivers report the limits as the max of a uint32, so the count is capped. Otherwise,
+	// the unused part of the range would still be reserved in the descriptor layouts.
+	constexpr std::uint32_t maxCombinedTextureCount = 1u << 20u;
+
+	return std::min({
+		limits.maxPerStageDescriptorSamplers, limits.maxPerStageDescriptorSampledImages,
+		limits.maxDescriptorSetSamplers, limits.maxDescriptorSetSampledImages,
+		maxCombinedTextureCount
+	});
+}
+
 void TextureManager::SetDescriptorBufferLayout(
 	VkDescriptorBuffer& descriptorBuffer, std::uint32_t combinedTexturesBindingSlot,
 	std::uint32_t sampledTexturesBindingSlot, std::uint32_t samplersBindingSlot,
 	size_t setLayoutIndex
-) const noexcept {
+) const {
 	const auto combinedDescCount = static_cast<std::uint32_t>(
 		std::size(m_availableIndicesCombinedTextures)
 	);
 
+	// The combined textures binding is created with the max count, so the layouts and the
+	// pipelines don't need to be recreated when more textures are bound. Only the current count
+	// is allocated in the descriptor buffer. A variable count binding must have the largest
+	// binding number in its layout, so its slot should be after the other two.
 	if (combinedDescCount)
+	{
 		descriptorBuffer.AddBinding(
 			combinedTexturesBindingSlot, setLayoutIndex, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-			combinedDescCount, VK_SHADER_STAGE_FRAGMENT_BIT,
+			m_maxCombinedTextureCount, VK_SHADER_STAGE_FRAGMENT_BIT,
 			VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+			| VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT
 		);
 
+		descriptorBuffer.SetVariableDescriptorCount(setLayoutIndex, combinedDescCount);
+	}
+
 	const auto sampledDescCount = static_cast<std::uint32_t>(
 		std::size(m_availableIndicesSampledTextures)
 	);
@@ -0,0 +1,201 @@
+#ifndef CHROME_TRACE_HPP_
+#define CHROME_TRACE_HPP_
+#include <vector>
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <filesystem>
+#include <charconv>
+#include <type_traits>
+#include <cstdint>
+
+// Keeps timed events in the Trace Event Format, which can be opened in chrome://tracing or
+// Perfetto. Each event is a complete one, so it has a start and a duration. The processes and
+// the threads are only used to put the events on separate rows, they don't need to be real.
+class ChromeTrace
+{
+public:
+	struct Event
+	{
+		std::string   name;
+		std::string   category;
+		double        startMicroseconds;
+		double        durationMicroseconds;
+		std::uint32_t processID;
+		std::uint32_t threadID;
+	};
+
+private:
+	struct ThreadName
+	{
+		std::uint32_t processID;
+		std::uint32_t threadID;
+		std::string   name;
+	};
+
+public:
+	ChromeTrace() : m_events{}, m_threadNames{} {}
+
+	void AddEvent(Event&& event)
+	{
+		m_events.emplace_back(std::move(event));
+	}
+
+	void SetThreadName(std::uint32_t processID, std::uint32_t threadID, std::string name)
+	{
+		for (ThreadName& threadName : m_threadNames)
+			if (threadName.processID == processID && threadName.threadID == threadID)
+			{
+				threadName.name = std::move(name);
+
+				return;
+			}
+
+		m_threadNames.emplace_back(
+			ThreadName{ .processID = processID, .threadID = threadID, .name = std::move(name) }
+		);
+	}
+
+	void Clear() noexcept
+	{
+		m_events.clear();
+	}
+
+	[[nodiscard]]
+	std::string Serialise() const
+	{
+		std::string trace{ "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" };
+
+		bool isFirstEvent = true;
+
+		for (const ThreadName& threadName : m_threadNames)
+		{
+			WriteSeparator(trace, isFirstEvent);
+
+			trace += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":";
+			WriteNumber(trace, threadName.processID);
+			trace += ",\"tid\":";
+			WriteNumber(trace, threadName.threadID);
+			trace += ",\"args\":{\"name\":";
+			WriteString(trace, threadName.name);
+			trace += "}}";
+		}
+
+		for (const Event& event : m_events)
+		{
+			WriteSeparator(trace, isFirstEvent);
+
+			trace += "{\"name\":";
+			WriteString(trace, event.name);
+			trace += ",\"cat\":";
+			WriteString(trace, event.category);
+			trace += ",\"ph\":\"X\",\"ts\":";
+			WriteNumber(trace, event.startMicroseconds);
+			trace += ",\"dur\":";
+			WriteNumber(trace, event.durationMicroseconds);
+			trace += ",\"pid\":";
+			WriteNumber(trace, event.processID);
+			trace += ",\"tid\":";
+			WriteNumber(trace, event.threadID);
+			trace += "}";
+		}
+
+		trace += "\n]}\n";
+
+		return trace;
+	}
+
+	[[nodiscard]]
+	bool SaveToFile(const std::wstring& filePath) const
+	{
+		std::ofstream traceFile{ std::filesystem::path{ filePath }, std::ios_base::binary };
+
+		if (!traceFile)
+			return false;
+
+		const std::string trace = Serialise();
+
+		traceFile.write(std::data(trace), static_cast<std::streamsize>(std::size(trace)));
+
+		return static_cast<bool>(traceFile);
+	}
+
+	[[nodiscard]]
+	size_t GetEventCount() const noexcept { return std::size(m_events); }
+	[[nodiscard]]
+	const std::vector<Event>& GetEvents() const noexcept { return m_events; }
+
+private:
+	static void WriteSeparator(std::string& trace, bool& isFirstEvent)
+	{
+		trace += isFirstEvent ? "\n" : ",\n";
+
+		isFirstEvent = false;
+	}
+
+	template<typename T>
+	static void WriteNumber(std::string& trace, T number)
+	{
+		char buffer[32]{};
+
+		std::to_chars_result result{};
+
+		// The trace timestamps are in microseconds, so the nanoseconds are kept.
+		if constexpr (std::is_floating_point_v<T>)
+			result = std::to_chars(
+				std::begin(buffer), std::end(buffer), number, std::chars_format::fixed, 3
+			);
+		else
+			result = std::to_chars(std::begin(buffer), std::end(buffer), number);
+
+		trace.append(buffer, result.ptr);
+	}
+
+	static void WriteString(std::string& trace, std::string_view str)
+	{
+		static constexpr char hexDigits[] = "0123456789abcdef";
+
+		trace += '"';
+
+		for (char character : str)
+		{
+			if (character == '"' || character == '\\')
+			{
+				trace += '\\';
+				trace += character;
+			}
+			else if (static_cast<unsigned char>(character) < 0x20u)
+			{
+				const auto code = static_cast<unsigned char>(character);
+
+				trace += "\\u00";
+				trace += hexDigits[code >> 4u];
+				trace += hexDigits[code & 0xFu];
+			}
+			else
+				trace += character;
+		}
+
+		trace += '"';
+	}
+
+private:
+	std::vector<Event>      m_events;
+	std::vector<ThreadName> m_threadNames;
+
+public:
+	ChromeTrace(const ChromeTrace&) = delete;
+	ChromeTrace& operator=(const ChromeTrace&) = delete;
+
+	ChromeTrace(ChromeTrace&& other) noexcept
+		: m_events{ std::move(other.m_events) }, m_threadNames{ std::move(other.m_threadNames) }
+	{}
+	ChromeTrace& operator=(ChromeTrace&& other) noexcept
+	{
+		m_events      = std::move(other.m_events);
+		m_threadNames = std::move(other.m_threadNames);
+
+		return *this;
+	}
+};
+#endif
@@ -0,0 +1,288 @@
+#ifndef CPU_TRACER_HPP_
+#define CPU_TRACER_HPP_
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ChromeTrace.hpp>
+
+// Keeps the last zones of each thread in a ring buffer which only that thread writes to, so
+// recording a zone doesn't lock anything. The mutex is only locked when a thread records its
+// first zone and when the zones are collected. The zones can be collected from any thread while
+// the others are still recording. The ones which were overwritten while being read are dropped.
+class CpuTracer
+{
+public:
+	static constexpr size_t s_zonesPerThread = 4096u;
+
+private:
+	struct ZoneSlot
+	{
+		std::atomic<const char*>   name;
+		std::atomic<std::uint64_t> startNanoseconds;
+		std::atomic<std::uint64_t> endNanoseconds;
+	};
+
+	struct Zone
+	{
+		const char*   name;
+		std::uint64_t startNanoseconds;
+		std::uint64_t endNanoseconds;
+	};
+
+	class ThreadBuffer
+	{
+		// The slot after the last written one might be being written by the owner, so it is
+		// never collected.
+		static constexpr size_t s_slotCount = s_zonesPerThread + 1u;
+
+	public:
+		ThreadBuffer(std::uint32_t threadID) : m_zones{}, m_writeIndex{ 0u }, m_threadID{ threadID }
+		{}
+
+		// Must only be called from the thread which owns the buffer.
+		void AddZone(
+			const char* name, std::uint64_t startNanoseconds, std::uint64_t endNanoseconds
+		) noexcept {
+			const std::uint64_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+
+			// If a reader sees any of the new values, it will also see the write index of this
+			// slot and know that the old zone might have been overwritten.
+			std::atomic_thread_fence(std::memory_order_release);
+
+			ZoneSlot& zoneSlot = m_zones[writeIndex % s_slotCount];
+
+			zoneSlot.name.store(name, std::memory_order_relaxed);
+			zoneSlot.startNanoseconds.store(startNanoseconds, std::memory_order_relaxed);
+			zoneSlot.endNanoseconds.store(endNanoseconds, std::memory_order_relaxed);
+
+			m_writeIndex.store(writeIndex + 1u, std::memory_order_release);
+		}
+
+		void CollectZones(std::vector<Zone>& zones) const
+		{
+			const std::uint64_t endIndex   = m_writeIndex.load(std::memory_order_acquire);
+			const std::uint64_t startIndex
+				= endIndex > s_zonesPerThread ? endIndex - s_zonesPerThread : 0u;
+
+			zones.clear();
+
+			for (std::uint64_t index = startIndex; index < endIndex; ++index)
+			{
+				const ZoneSlot& zoneSlot = m_zones[index % s_slotCount];
+
+				zones.emplace_back(
+					Zone{
+						.name             = zoneSlot.name.load(std::memory_order_relaxed),
+						.startNanoseconds = zoneSlot.startNanoseconds.load(
+							std::memory_order_relaxed
+						),
+						.endNanoseconds   = zoneSlot.endNanoseconds.load(
+							std::memory_order_relaxed
+						)
+					}
+				);
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			// The owner might already be writing the slot after the last written index, which
+			// would overwrite the zone a whole ring before it.
+			const std::uint64_t newEndIndex     = m_writeIndex.load(std::memory_order_relaxed);
+			const std::uint64_t firstValidIndex
+				= newEndIndex > s_zonesPerThread ? newEndIndex - s_zonesPerThread : 0u;
+
+			if (firstValidIndex > startIndex)
+			{
+				const auto overwrittenCount = static_cast<size_t>(
+					std::min(firstValidIndex - startIndex, endIndex - startIndex)
+				);
+
+				zones.erase(std::begin(zones), std::next(std::begin(zones), overwrittenCount));
+			}
+		}
+
+		[[nodiscard]]
+		std::uint32_t GetThreadID() const noexcept { return m_threadID; }
+
+	private:
+		std::array<ZoneSlot, s_slotCount> m_zones;
+		std::atomic<std::uint64_t>        m_writeIndex;
+		std::uint32_t                     m_threadID;
+
+	public:
+		ThreadBuffer(const ThreadBuffer&) = delete;
+		ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+	};
+
+	// Each tracer has a unique ID, so a thread can't mistake the buffer of a destroyed tracer
+	// for its own.
+	struct CachedThreadBuffer
+	{
+		std::uint64_t tracerID;
+		ThreadBuffer* threadBuffer;
+	};
+
+public:
+	CpuTracer()
+		: m_threadBuffers{}, m_threadBufferMutex{},
+		m_startTime{ std::chrono::steady_clock::now() },
+		m_tracerID{ s_nextTracerID.fetch_add(1u, std::memory_order_relaxed) }
+	{}
+
+	// The one used by the trace zones.
+	[[nodiscard]]
+	static CpuTracer& Get() noexcept
+	{
+		static CpuTracer tracer{};
+
+		return tracer;
+	}
+
+	void AddZone(
+		const char* name, std::uint64_t startNanoseconds, std::uint64_t endNanoseconds
+	) {
+		GetThreadBuffer().AddZone(name, startNanoseconds, endNanoseconds);
+	}
+
+	[[nodiscard]]
+	std::uint64_t GetNanoseconds() const noexcept
+	{
+		return static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - m_startTime
+			).count()
+		);
+	}
+
+	// Each thread which has recorded a zone is added as a separate thread of the process.
+	void AddToTrace(ChromeTrace& trace, std::uint32_t processID) const
+	{
+		std::vector<Zone> zones{};
+
+		zones.reserve(s_zonesPerThread);
+
+		std::lock_guard lock{ m_threadBufferMutex };
+
+		for (const std::unique_ptr<ThreadBuffer>& threadBuffer : m_threadBuffers)
+		{
+			const std::uint32_t threadID = threadBuffer->GetThreadID();
+
+			trace.SetThreadName(processID, threadID, "CPU Thread " + std::to_string(threadID));
+
+			threadBuffer->CollectZones(zones);
+
+			for (const Zone& zone : zones)
+				trace.AddEvent(
+					ChromeTrace::Event{
+						.name                 = zone.name,
+						.category             = "CPU",
+						.startMicroseconds    = static_cast<double>(zone.startNanoseconds)
+							/ 1'000.0,
+						.durationMicroseconds = static_cast<double>(
+							zone.endNanoseconds - zone.startNanoseconds
+						) / 1'000.0,
+						.processID            = processID,
+						.threadID             = threadID
+					}
+				);
+		}
+	}
+
+	[[nodiscard]]
+	bool SaveToFile(const std::wstring& filePath) const
+	{
+		ChromeTrace trace{};
+
+		AddToTrace(trace, 0u);
+
+		return trace.SaveToFile(filePath);
+	}
+
+	[[nodiscard]]
+	size_t GetThreadCount() const
+	{
+		std::lock_guard lock{ m_threadBufferMutex };
+
+		return std::size(m_threadBuffers);
+	}
+
+private:
+	[[nodiscard]]
+	ThreadBuffer& GetThreadBuffer()
+	{
+		thread_local CachedThreadBuffer cachedThreadBuffer{
+			.tracerID = 0u, .threadBuffer = nullptr
+		};
+
+		if (cachedThreadBuffer.tracerID != m_tracerID)
+		{
+			std::lock_guard lock{ m_threadBufferMutex };
+
+			const auto threadID = static_cast<std::uint32_t>(std::size(m_threadBuffers));
+
+			cachedThreadBuffer = CachedThreadBuffer{
+				.tracerID     = m_tracerID,
+				.threadBuffer = m_threadBuffers.emplace_back(
+					std::make_unique<ThreadBuffer>(threadID)
+				).get()
+			};
+		}
+
+		return *cachedThreadBuffer.threadBuffer;
+	}
+
+private:
+	// The buffers are kept even after their threads have exited, so their zones can still be
+	// collected.
+	std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+	mutable std::mutex                         m_threadBufferMutex;
+	std::chrono::steady_clock::time_point      m_startTime;
+	std::uint64_t                              m_tracerID;
+
+	inline static std::atomic<std::uint64_t> s_nextTracerID{ 1u };
+
+public:
+	CpuTracer(const CpuTracer&) = delete;
+	CpuTracer& operator=(const CpuTracer&) = delete;
+};
+
+// Records the time from its creation to its destruction as a zone of the current thread. The
+// name should be a string literal, as only the pointer is kept.
+class CpuTraceZone
+{
+public:
+	CpuTraceZone(CpuTracer& tracer, const char* name)
+		: m_tracer{ tracer }, m_name{ name }, m_startNanoseconds{ tracer.GetNanoseconds() }
+	{}
+
+	~CpuTraceZone() noexcept
+	{
+		m_tracer.AddZone(m_name, m_startNanoseconds, m_tracer.GetNanoseconds());
+	}
+
+private:
+	CpuTracer&    m_tracer;
+	const char*   m_name;
+	std::uint64_t m_startNanoseconds;
+
+public:
+	CpuTraceZone(const CpuTraceZone&) = delete;
+	CpuTraceZone& operator=(const CpuTraceZone&) = delete;
+};
+
+// The zones are only compiled in with the TERRA_CPU_TRACING option.
+#ifdef TERRA_CPU_TRACING
+#define TERRA_CPU_TRACE_CONCAT_IMPL(first, second) first##second
+#define TERRA_CPU_TRACE_CONCAT(first, second) TERRA_CPU_TRACE_CONCAT_IMPL(first, second)
+#define TERRA_CPU_TRACE_ZONE(name) \
+	const CpuTraceZone TERRA_CPU_TRACE_CONCAT(cpuTraceZone, __LINE__){ CpuTracer::Get(), name }
+#else
+#define TERRA_CPU_TRACE_ZONE(name)
+#endif
+#endif
@@ -15,6 +15,37 @@ struct UVInfo
 	float vScale  = 1.f;
 };
 
+struct ModelMaterialData
+{
+	std::uint32_t materialIndex = 0u;
+	std::uint32_t diffuseIndex  = 0u;
+	std::uint32_t specularIndex = 0u;
+	UVInfo        diffuseUVInfo{};
+	UVInfo        specularUVInfo{};
+};
+
+enum class ModelState : std::uint8_t
+{
+	InUse             = 1u,
+	Modified          = 2u,
+	NormalMatrixStale = 4u
+};
+
+// Pointers to the data of a single model. The data might be in separate arrays.
+struct ModelFields
+{
+	DirectX::XMMATRIX* modelMatrix;
+	DirectX::XMMATRIX* normalMatrix;
+	DirectX::XMFLOAT3* modelOffset;
+	float*             modelScale;
+	ModelMaterialData* material;
+	std::uint32_t*     meshIndex;
+	std::uint8_t*      visibility;
+	std::uint8_t*      state;
+};
+
+// Doesn't own the transform data, so it should only be used while the model it was taken from
+// exists.
 class ModelTransform
 {
 	struct BrokenDownMatrix
@@ -25,9 +56,10 @@ class ModelTransform
 	};
 
 public:
-	ModelTransform()
-		: m_modelMatrix{ DirectX::XMMatrixIdentity() }, m_modelOffset{ 0.f, 0.f, 0.f },
-		m_modelScale{ 1.f }
+	ModelTransform(const ModelFields& fields)
+		: m_modelMatrix{ fields.modelMatrix }, m_normalMatrix{ fields.normalMatrix },
+		m_modelOffset{ fields.modelOffset }, m_modelScale{ fields.modelScale },
+		m_state{ fields.state }
 	{}
 
 	ModelTransform& RotatePitchDegree(float angle) noexcept
@@ -66,32 +98,41 @@ public:
 
 	ModelTransform& MoveTowardsX(float delta) noexcept
 	{
-		m_modelOffset.x += delta;
+		m_modelOffset->x += delta;
+
+		SetModified();
 
 		return *this;
 	}
 	ModelTransform& MoveTowardsY(float delta) noexcept
 	{
-		m_modelOffset.y += delta;
+		m_modelOffset->y += delta;
+
+		SetModified();
 
 		return *this;
 	}
 	ModelTransform& MoveTowardsZ(float delta) noexcept
 	{
-		m_modelOffset.z += delta;
+		m_modelOffset->z += delta;
+
+		SetModified();
 
 		return *this;
 	}
 
 	void Rotate(const DirectX::XMMATRIX& rotationMatrix) noexcept
 	{
-		m_modelMatrix *= rotationMatrix;
+		*m_modelMatrix *= rotationMatrix;
+
+		SetMatrixModified();
 	}
 	void Scale(const DirectX::XMMATRIX& scalingMatrix) noexcept
 	{
-		m_modelMatrix *= scalingMatrix;
+		*m_modelMatrix *= scalingMatrix;
 
 		RecalculateScale();
+		SetMatrixModified();
 	}
 
 	[[nodiscard]]
@@ -107,6 +148,14 @@ public:
 		return DirectX::XMMatrixScaling(scaleX, scaleY, scaleZ);
 	}
 
+	// The normal matrix is the transpose of the inversed model matrix. Not doing this to flip
+	// to Column major.
+	[[nodiscard]]
+	static DirectX::XMMATRIX CalculateNormalMatrix(const DirectX::XMMATRIX& modelMatrix) noexcept
+	{
+		return DirectX::XMMatrixTranspose(DirectX::XMMatrixInverse(nullptr, modelMatrix));
+	}
+
 	void Rotate(const DirectX::XMVECTOR& rotationAxis, float angleRadian) noexcept
 	{
 		Rotate(GetRotationMatrix(rotationAxis, angleRadian));
@@ -117,13 +166,16 @@ public:
 	}
 	void MultiplyModelMatrix(const DirectX::XMMATRIX& matrix) noexcept
 	{
-		m_modelMatrix *= matrix;
+		*m_modelMatrix *= matrix;
 
 		RecalculateScale();
+		SetMatrixModified();
 	}
 	void SetModelMatrix(const DirectX::XMMATRIX& matrix) noexcept
 	{
-		m_modelMatrix = matrix;
+		*m_modelMatrix = matrix;
+
+		SetMatrixModified();
 	}
 	void MultiplyAndBreakDownModelMatrix(const DirectX::XMMATRIX& matrix) noexcept
 	{
@@ -133,13 +185,15 @@ public:
 
 		{
 			XMVECTOR newOffset
-				= XMLoadFloat3(&m_modelOffset) + XMLoadFloat3(&brokenDownMatrix.position);
+				= XMLoadFloat3(m_modelOffset) + XMLoadFloat3(&brokenDownMatrix.position);
 
-			XMStoreFloat3(&m_modelOffset, newOffset);
+			XMStoreFloat3(m_modelOffset, newOffset);
 		}
 
-		m_modelMatrix *= brokenDownMatrix.matrix;
-		m_modelScale   = brokenDownMatrix.scale;
+		*m_modelMatrix *= brokenDownMatrix.matrix;
+		*m_modelScale   = brokenDownMatrix.scale;
+
+		SetMatrixModified();
 	}
 
 	void SetAndBreakDownModelMatrix(const DirectX::XMMATRIX& matrix) noexcept
@@ -148,43 +202,84 @@ public:
 
 		BrokenDownMatrix brokenDownMatrix = BreakDownMatrix(matrix);
 
-		m_modelOffset = brokenDownMatrix.position;
-		m_modelMatrix = brokenDownMatrix.matrix;
-		m_modelScale  = brokenDownMatrix.scale;
+		*m_modelOffset = brokenDownMatrix.position;
+		*m_modelMatrix = brokenDownMatrix.matrix;
+		*m_modelScale  = brokenDownMatrix.scale;
+
+		SetMatrixModified();
 	}
 
 	void ResetTransform() noexcept
 	{
-		m_modelMatrix = DirectX::XMMatrixIdentity();
-		m_modelOffset = DirectX::XMFLOAT3{ 0.f, 0.f, 0.f };
-		m_modelScale  = 1.f;
+		*m_modelMatrix = DirectX::XMMatrixIdentity();
+		*m_modelOffset = DirectX::XMFLOAT3{ 0.f, 0.f, 0.f };
+		*m_modelScale  = 1.f;
+
+		SetMatrixModified();
 	}
 	void MoveModel(const DirectX::XMFLOAT3& offset) noexcept
 	{
-		m_modelOffset.x += offset.x;
-		m_modelOffset.y += offset.y;
-		m_modelOffset.z += offset.z;
+		m_modelOffset->x += offset.x;
+		m_modelOffset->y += offset.y;
+		m_modelOffset->z += offset.z;
+
+		SetModified();
+	}
+	void SetModelOffset(const DirectX::XMFLOAT3& offset) noexcept
+	{
+		*m_modelOffset = offset;
+
+		SetModified();
 	}
-	void SetModelOffset(const DirectX::XMFLOAT3& offset) noexcept { m_modelOffset = offset; }
 
+	// The modified state is used by the renderer to only update the changed models. It is
+	// shared with the rest of the model, so it is set by any change to the model.
 	[[nodiscard]]
-	const DirectX::XMMATRIX& GetModelMatrix() const noexcept { return m_modelMatrix; }
+	bool IsModified() const noexcept
+	{
+		return *m_state & static_cast<std::uint8_t>(ModelState::Modified);
+	}
+
 	[[nodiscard]]
-	const DirectX::XMFLOAT3& GetModelOffset() const noexcept { return m_modelOffset; }
+	const DirectX::XMMATRIX& GetModelMatrix() const noexcept { return *m_modelMatrix; }
 	[[nodiscard]]
-	float GetModelScale() const noexcept { return m_modelScale; }
+	const DirectX::XMFLOAT3& GetModelOffset() const noexcept { return *m_modelOffset; }
+	[[nodiscard]]
+	float GetModelScale() const noexcept { return *m_modelScale; }
+
+	// The normal matrix is cached and only recalculated after the model matrix has changed.
+	[[nodiscard]]
+	const DirectX::XMMATRIX& GetNormalMatrix() noexcept
+	{
+		constexpr auto staleFlag = static_cast<std::uint8_t>(ModelState::NormalMatrixStale);
+
+		if (*m_state & staleFlag)
+		{
+			*m_normalMatrix = CalculateNormalMatrix(*m_modelMatrix);
+			*m_state       &= static_cast<std::uint8_t>(~staleFlag);
+		}
+
+		return *m_normalMatrix;
+	}
 
 private:
+	void SetModified() noexcept { *m_state |= static_cast<std::uint8_t>(ModelState::Modified); }
+	void SetMatrixModified() noexcept
+	{
+		*m_state |= static_cast<std::uint8_t>(ModelState::Modified)
+			| static_cast<std::uint8_t>(ModelState::NormalMatrixStale);
+	}
+
 	void RecalculateScale() noexcept
 	{
 		DirectX::XMVECTOR scale{};
 		DirectX::XMVECTOR rotationQuat{};
 		DirectX::XMVECTOR translation{};
 
-		DirectX::XMMatrixDecompose(&scale, &rotationQuat, &translation, m_modelMatrix);
+		DirectX::XMMatrixDecompose(&scale, &rotationQuat, &translation, *m_modelMatrix);
 
 		// We are scaling all of the components by the same amount.
-		m_modelScale = DirectX::XMVectorGetX(scale);
+		*m_modelScale = DirectX::XMVectorGetX(scale);
 	}
 
 	[[nodiscard]]
@@ -211,28 +306,40 @@ private:
 	}
 
 private:
-	DirectX::XMMATRIX m_modelMatrix;
-	DirectX::XMFLOAT3 m_modelOffset;
-	float             m_modelScale;
+	DirectX::XMMATRIX* m_modelMatrix;
+	DirectX::XMMATRIX* m_normalMatrix;
+	DirectX::XMFLOAT3* m_modelOffset;
+	float*             m_modelScale;
+	std::uint8_t*      m_state;
 };
 
+// Doesn't own the material data, so it should only be used while the model it was taken from
+// exists.
 class ModelMaterial
 {
 public:
-	ModelMaterial()
-		: m_materialIndex{ 0u }, m_diffuseIndex{ 0u }, m_specularIndex{ 0u },
-		m_diffuseUVInfo{ 0.f, 0.f, 1.f, 1.f }, m_specularUVInfo{ 0.f, 0.f, 1.f, 1.f }
+	ModelMaterial(const ModelFields& fields)
+		: m_material{ fields.material }, m_state{ fields.state }
 	{}
 
-	void SetMaterialIndex(std::uint32_t index) noexcept { m_materialIndex = index; }
+	void SetMaterialIndex(std::uint32_t index) noexcept
+	{
+		m_material->materialIndex = index;
+
+		SetModified();
+	}
 
 	void SetDiffuseIndex(size_t index) noexcept
 	{
-		m_diffuseIndex = static_cast<std::uint32_t>(index);
+		m_material->diffuseIndex = static_cast<std::uint32_t>(index);
+
+		SetModified();
 	}
 	void SetSpecularIndex(size_t index) noexcept
 	{
-		m_specularIndex = static_cast<std::uint32_t>(index);
+		m_material->specularIndex = static_cast<std::uint32_t>(index);
+
+		SetModified();
 	}
 
 	void SetDiffuseUVInfo(float uOffset, float vOffset, float uScale, float vScale) noexcept
@@ -241,133 +348,205 @@ public:
 			UVInfo{ .uOffset = uOffset, .vOffset = vOffset, .uScale = uScale, .vScale = vScale }
 		);
 	}
-	void SetDiffuseUVInfo(const UVInfo& uvInfo) noexcept { m_diffuseUVInfo = uvInfo; }
+	void SetDiffuseUVInfo(const UVInfo& uvInfo) noexcept
+	{
+		m_material->diffuseUVInfo = uvInfo;
+
+		SetModified();
+	}
 	void SetSpecularUVInfo(float uOffset, float vOffset, float uScale, float vScale) noexcept
 	{
 		SetSpecularUVInfo(
 			UVInfo{ .uOffset = uOffset, .vOffset = vOffset, .uScale = uScale, .vScale = vScale }
 		);
 	}
-	void SetSpecularUVInfo(const UVInfo& uvInfo) noexcept { m_specularUVInfo = uvInfo; }
+	void SetSpecularUVInfo(const UVInfo& uvInfo) noexcept
+	{
+		m_material->specularUVInfo = uvInfo;
+
+		SetModified();
+	}
 
 	[[nodiscard]]
-	std::uint32_t GetMaterialIndex() const noexcept { return m_materialIndex; }
+	bool IsModified() const noexcept
+	{
+		return *m_state & static_cast<std::uint8_t>(ModelState::Modified);
+	}
+
 	[[nodiscard]]
-	std::uint32_t GetDiffuseIndex() const noexcept { return m_diffuseIndex; }
+	std::uint32_t GetMaterialIndex() const noexcept { return m_material->materialIndex; }
 	[[nodiscard]]
-	const UVInfo& GetDiffuseUVInfo() const noexcept { return m_diffuseUVInfo; }
+	std::uint32_t GetDiffuseIndex() const noexcept { return m_material->diffuseIndex; }
 	[[nodiscard]]
-	std::uint32_t GetSpecularIndex() const noexcept { return m_specularIndex; }
+	const UVInfo& GetDiffuseUVInfo() const noexcept { return m_material->diffuseUVInfo; }
 	[[nodiscard]]
-	const UVInfo& GetSpecularUVInfo() const noexcept { return m_specularUVInfo; }
+	std::uint32_t GetSpecularIndex() const noexcept { return m_material->specularIndex; }
+	[[nodiscard]]
+	const UVInfo& GetSpecularUVInfo() const noexcept { return m_material->specularUVInfo; }
+
+private:
+	void SetModified() noexcept { *m_state |= static_cast<std::uint8_t>(ModelState::Modified); }
 
 private:
-	std::uint32_t m_materialIndex;
-	std::uint32_t m_diffuseIndex;
-	std::uint32_t m_specularIndex;
-	UVInfo        m_diffuseUVInfo;
-	UVInfo        m_specularUVInfo;
+	ModelMaterialData* m_material;
+	std::uint8_t*      m_state;
 };
 
-// Represent a single drawable object.
+// Represent a single drawable object. A model which is created on its own owns its data, which
+// is moved into a ModelContainer when it is added. The models returned by a ModelContainer are
+// handles to the data stored in it and should only be used until the container is changed.
 class Model
 {
+	// The layout of a model which isn't in a container.
+	struct ModelData
+	{
+		DirectX::XMMATRIX modelMatrix;
+		DirectX::XMMATRIX normalMatrix;
+		DirectX::XMFLOAT3 modelOffset;
+		float             modelScale;
+		ModelMaterialData material;
+		std::uint32_t     meshIndex;
+		std::uint8_t      visibility;
+		std::uint8_t      state;
+	};
+
 public:
 	Model()
-		: m_transform{}, m_material{}, m_meshIndex{ 0u }, m_visible{ true }
+		: m_data{
+			std::make_unique<ModelData>(
+				ModelData{
+					.modelMatrix  = DirectX::XMMatrixIdentity(),
+					.normalMatrix = DirectX::XMMatrixIdentity(),
+					.modelOffset  = DirectX::XMFLOAT3{ 0.f, 0.f, 0.f },
+					.modelScale   = 1.f,
+					.material     = ModelMaterialData{},
+					.meshIndex    = 0u,
+					.visibility   = 1u,
+					.state        = static_cast<std::uint8_t>(ModelState::Modified)
+				}
+			)
+		},
+		m_fields{
+			.modelMatrix  = &m_data->modelMatrix,
+			.normalMatrix = &m_data->normalMatrix,
+			.modelOffset  = &m_data->modelOffset,
+			.modelScale   = &m_data->modelScale,
+			.material     = &m_data->material,
+			.meshIndex    = &m_data->meshIndex,
+			.visibility   = &m_data->visibility,
+			.state        = &m_data->state
+		}
 	{}
 	Model(float scale) : Model{}
 	{
 		Scale(scale);
 	}
+	// Creates a handle to the data of a model stored somewhere else.
+	Model(const ModelFields& fields) : m_data{}, m_fields{ fields } {}
 
-	void SetMeshIndex(std::uint32_t index) noexcept { m_meshIndex = index; }
+	void SetMeshIndex(std::uint32_t index) noexcept
+	{
+		*m_fields.meshIndex = index;
+		*m_fields.state    |= static_cast<std::uint8_t>(ModelState::Modified);
+	}
 
 	void Scale(float scale) noexcept
 	{
 		GetTransform().Scale(scale);
 	}
 
-	void SetVisibility(bool value) noexcept { m_visible = value; }
-
-	[[nodiscard]]
-	const DirectX::XMMATRIX& GetModelMatrix() const noexcept
+	void SetVisibility(bool value) noexcept
 	{
-		return m_transform.GetModelMatrix();
+		*m_fields.visibility = static_cast<std::uint8_t>(value);
 	}
+
 	[[nodiscard]]
-	const DirectX::XMFLOAT3& GetModelOffset() const noexcept
-	{
-		return m_transform.GetModelOffset();
-	}
+	const DirectX::XMMATRIX& GetModelMatrix() const noexcept { return *m_fields.modelMatrix; }
+	[[nodiscard]]
+	const DirectX::XMFLOAT3& GetModelOffset() const noexcept { return *m_fields.modelOffset; }
 	[[nodiscard]]
 	std::uint32_t GetMaterialIndex() const noexcept
 	{
-		return m_material.GetMaterialIndex();
+		return m_fields.material->materialIndex;
 	}
 	[[nodiscard]]
-	std::uint32_t GetMeshIndex() const noexcept { return m_meshIndex; }
+	std::uint32_t GetMeshIndex() const noexcept { return *m_fields.meshIndex; }
 	[[nodiscard]]
-	float GetModelScale() const noexcept { return m_transform.GetModelScale(); }
+	float GetModelScale() const noexcept { return *m_fields.modelScale; }
 	[[nodiscard]]
-	bool IsVisible() const noexcept { return m_visible; }
+	bool IsVisible() const noexcept { return *m_fields.visibility; }
 
+	// If any of the data used by the renderer has been changed since the last reset.
 	[[nodiscard]]
-	std::uint32_t GetDiffuseIndex() const noexcept
+	bool IsModified() const noexcept
 	{
-		return m_material.GetDiffuseIndex();
+		return *m_fields.state & static_cast<std::uint8_t>(ModelState::Modified);
 	}
+	void ResetModified() noexcept
+	{
+		*m_fields.state &= static_cast<std::uint8_t>(
+			~static_cast<std::uint8_t>(ModelState::Modified)
+		);
+	}
+
+	[[nodiscard]]
+	std::uint32_t GetDiffuseIndex() const noexcept { return m_fields.material->diffuseIndex; }
 	[[nodiscard]]
-	const UVInfo& GetDiffuseUVInfo() const noexcept { return m_material.GetDiffuseUVInfo(); }
+	const UVInfo& GetDiffuseUVInfo() const noexcept { return m_fields.material->diffuseUVInfo; }
 	[[nodiscard]]
 	std::uint32_t GetSpecularIndex() const noexcept
 	{
-		return m_material.GetSpecularIndex();
+		return m_fields.material->specularIndex;
 	}
 	[[nodiscard]]
-	const UVInfo& GetSpecularUVInfo() const noexcept { return m_material.GetSpecularUVInfo(); }
-
-	[[nodiscard]]
-	auto&& GetTransform(this auto&& self) noexcept
+	const UVInfo& GetSpecularUVInfo() const noexcept
 	{
-		return std::forward_like<decltype(self)>(self.m_transform);
+		return m_fields.material->specularUVInfo;
 	}
 
 	[[nodiscard]]
-	auto&& GetMaterial(this auto&& self) noexcept
-	{
-		return std::forward_like<decltype(self)>(self.m_material);
-	}
+	ModelTransform GetTransform() noexcept { return ModelTransform{ m_fields }; }
+	[[nodiscard]]
+	const ModelTransform GetTransform() const noexcept { return ModelTransform{ m_fields }; }
+
+	[[nodiscard]]
+	ModelMaterial GetMaterial() noexcept { return ModelMaterial{ m_fields }; }
+	[[nodiscard]]
+	const ModelMaterial GetMaterial() const noexcept { return ModelMaterial{ m_fields }; }
+
+	[[nodiscard]]
+	const ModelFields& GetFields() const noexcept { return m_fields; }
 
 	void CopyCharacteristics(const Model& other) noexcept
 	{
-		m_transform = other.m_transform;
-		m_material  = other.m_material;
+		*m_fields.modelMatrix  = *other.m_fields.modelMatrix;
+		*m_fields.normalMatrix = *other.m_fields.normalMatrix;
+		*m_fields.modelOffset  = *other.m_fields.modelOffset;
+		*m_fields.modelScale   = *other.m_fields.modelScale;
+		*m_fields.material     = *other.m_fields.material;
+
+		// The normal matrix might not have been calculated yet.
+		*m_fields.state |= static_cast<std::uint8_t>(ModelState::Modified)
+			| (*other.m_fields.state & static_cast<std::uint8_t>(ModelState::NormalMatrixStale));
 	}
 
 private:
-	ModelTransform m_transform;
-	ModelMaterial  m_material;
-
-	std::uint32_t m_meshIndex;
-	bool          m_visible;
+	std::unique_ptr<ModelData> m_data;
+	ModelFields                m_fields;
 
 public:
 	Model(const Model&) = delete;
 	Model& operator=(const Model&) = delete;
 
+	// The data is on the heap, so the fields stay valid after a move.
 	Model(Model&& other) noexcept
-		: m_transform{ std::move(other.m_transform) },
-		m_material{ std::move(other.m_material) },
-		m_meshIndex{ other.m_meshIndex },
-		m_visible{ other.m_visible }
+		: m_data{ std::move(other.m_data) },
+		m_fields{ other.m_fields }
 	{}
 	Model& operator=(Model&& other) noexcept
 	{
-		m_transform = std::move(other.m_transform);
-		m_material  = std::move(other.m_material);
-		m_meshIndex = other.m_meshIndex;
-		m_visible   = other.m_visible;
+		m_data   = std::move(other.m_data);
+		m_fields = other.m_fields;
 
 		return *this;
 	}
@@ -184,12 +184,16 @@ public:
 		return m_pipelines;
 	}
 
+	// The returned model is a handle to the data in the container.
 	[[nodiscard]]
-	auto&& GetModel(this auto&& self, size_t localIndex) noexcept
+	Model GetModel(size_t localIndex) noexcept
 	{
-		const size_t containerIndex = self.m_modelIndicesInContainer[localIndex];
-
-		return std::forward_like<decltype(self)>(self.m_modelContainer->GetModel(containerIndex));
+		return m_modelContainer->GetModel(m_modelIndicesInContainer[localIndex]);
+	}
+	[[nodiscard]]
+	const Model GetModel(size_t localIndex) const noexcept
+	{
+		return m_modelContainer->GetModel(m_modelIndicesInContainer[localIndex]);
 	}
 
 	[[nodiscard]]
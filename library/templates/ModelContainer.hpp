@@ -1,62 +1,210 @@
 #ifndef MODEL_CONTAINER_HPP_
 #define MODEL_CONTAINER_HPP_
 #include <Model.hpp>
-#include <ReusableVector.hpp>
+#include <vector>
 
+// The data of the models is stored as separate arrays, so the per frame passes over the models
+// only need to access the fields they use. The removed indices are reused by the new models.
 class ModelContainer
 {
 public:
-	ModelContainer() : m_models{} {}
+	ModelContainer()
+		: m_modelMatrices{}, m_normalMatrices{}, m_modelOffsets{}, m_modelScales{}, m_materials{},
+		m_meshIndices{}, m_visibilities{}, m_modelStates{}, m_availableIndices{}
+	{}
 
 	[[nodiscard]]
 	std::uint32_t AddModel(Model&& model) noexcept
 	{
-		return static_cast<std::uint32_t>(m_models.Add(std::move(model)));
+		const size_t index = GetNewIndex();
+
+		SetModelData(index, model);
+
+		return static_cast<std::uint32_t>(index);
 	}
 	[[nodiscard]]
 	std::vector<std::uint32_t> AddModels(std::vector<Model>&& models) noexcept
 	{
-		return m_models.AddElementsU32(std::move(models));
+		std::vector<std::uint32_t> modelIndices{};
+		modelIndices.reserve(std::size(models));
+
+		Reserve(GetModelCount() + std::size(models));
+
+		for (Model& model : models)
+			modelIndices.emplace_back(AddModel(std::move(model)));
+
+		return modelIndices;
 	}
 
 	void RemoveModel(size_t index) noexcept
 	{
-		m_models.RemoveElement(index);
+		m_modelStates[index] = 0u;
+
+		m_availableIndices.emplace_back(index);
 	}
 
 	void RemoveModels(const std::vector<std::uint32_t>& indices) noexcept
 	{
 		for (size_t index : indices)
-			m_models.RemoveElement(index);
+			RemoveModel(index);
 	}
 
+	// The returned model is a handle to the data in the container.
+	[[nodiscard]]
+	Model GetModel(size_t index) noexcept
+	{
+		return Model{
+			ModelFields{
+				.modelMatrix  = &m_modelMatrices[index],
+				.normalMatrix = &m_normalMatrices[index],
+				.modelOffset  = &m_modelOffsets[index],
+				.modelScale   = &m_modelScales[index],
+				.material     = &m_materials[index],
+				.meshIndex    = &m_meshIndices[index],
+				.visibility   = &m_visibilities[index],
+				.state        = &m_modelStates[index]
+			}
+		};
+	}
 	[[nodiscard]]
-	auto&& GetModels(this auto&& self) noexcept
+	const Model GetModel(size_t index) const noexcept
 	{
-		return std::forward_like<decltype(self)>(self.m_models);
+		return const_cast<ModelContainer*>(this)->GetModel(index);
 	}
+
 	[[nodiscard]]
-	auto&& GetModel(this auto&& self, size_t index) noexcept
+	bool IsInUse(size_t index) const noexcept
 	{
-		return std::forward_like<decltype(self)>(self.m_models[index]);
+		return m_modelStates[index] & static_cast<std::uint8_t>(ModelState::InUse);
 	}
 
 	[[nodiscard]]
-	size_t GetModelCount() const noexcept { return std::size(m_models); }
+	const std::vector<DirectX::XMMATRIX>& GetModelMatrices() const noexcept
+	{
+		return m_modelMatrices;
+	}
+	[[nodiscard]]
+	auto&& GetNormalMatrices(this auto&& self) noexcept
+	{
+		return std::forward_like<decltype(self)>(self.m_normalMatrices);
+	}
+	[[nodiscard]]
+	const std::vector<DirectX::XMFLOAT3>& GetModelOffsets() const noexcept
+	{
+		return m_modelOffsets;
+	}
+	[[nodiscard]]
+	const std::vector<float>& GetModelScales() const noexcept { return m_modelScales; }
+	[[nodiscard]]
+	const std::vector<ModelMaterialData>& GetMaterials() const noexcept { return m_materials; }
+	[[nodiscard]]
+	const std::vector<std::uint32_t>& GetMeshIndices() const noexcept { return m_meshIndices; }
+	[[nodiscard]]
+	const std::vector<std::uint8_t>& GetVisibilities() const noexcept { return m_visibilities; }
+	// The states are the ModelState flags of each model.
+	[[nodiscard]]
+	auto&& GetModelStates(this auto&& self) noexcept
+	{
+		return std::forward_like<decltype(self)>(self.m_modelStates);
+	}
+
+	// The removed models are included.
+	[[nodiscard]]
+	size_t GetModelCount() const noexcept { return std::size(m_modelStates); }
+
+private:
+	[[nodiscard]]
+	size_t GetNewIndex() noexcept
+	{
+		if (!std::empty(m_availableIndices))
+		{
+			const size_t index = m_availableIndices.back();
+
+			m_availableIndices.pop_back();
+
+			return index;
+		}
+
+		const size_t index = GetModelCount();
+
+		m_modelMatrices.emplace_back();
+		m_normalMatrices.emplace_back();
+		m_modelOffsets.emplace_back();
+		m_modelScales.emplace_back();
+		m_materials.emplace_back();
+		m_meshIndices.emplace_back();
+		m_visibilities.emplace_back();
+		m_modelStates.emplace_back();
+
+		return index;
+	}
+
+	void Reserve(size_t modelCount)
+	{
+		m_modelMatrices.reserve(modelCount);
+		m_normalMatrices.reserve(modelCount);
+		m_modelOffsets.reserve(modelCount);
+		m_modelScales.reserve(modelCount);
+		m_materials.reserve(modelCount);
+		m_meshIndices.reserve(modelCount);
+		m_visibilities.reserve(modelCount);
+		m_modelStates.reserve(modelCount);
+	}
+
+	void SetModelData(size_t index, const Model& model) noexcept
+	{
+		const ModelFields& fields = model.GetFields();
+
+		m_modelMatrices[index]  = *fields.modelMatrix;
+		m_normalMatrices[index] = *fields.normalMatrix;
+		m_modelOffsets[index]   = *fields.modelOffset;
+		m_modelScales[index]    = *fields.modelScale;
+		m_materials[index]      = *fields.material;
+		m_meshIndices[index]    = *fields.meshIndex;
+		m_visibilities[index]   = *fields.visibility;
+		// A new model must always be written.
+		m_modelStates[index]    = *fields.state | static_cast<std::uint8_t>(ModelState::InUse)
+			| static_cast<std::uint8_t>(ModelState::Modified);
+	}
 
 private:
-	Callisto::ReusableVector<Model> m_models;
+	std::vector<DirectX::XMMATRIX> m_modelMatrices;
+	std::vector<DirectX::XMMATRIX> m_normalMatrices;
+	std::vector<DirectX::XMFLOAT3> m_modelOffsets;
+	std::vector<float>             m_modelScales;
+	std::vector<ModelMaterialData> m_materials;
+	std::vector<std::uint32_t>     m_meshIndices;
+	// Not using vector<bool>, so the flags can be read without any bit manipulation.
+	std::vector<std::uint8_t>      m_visibilities;
+	std::vector<std::uint8_t>      m_modelStates;
+	std::vector<size_t>            m_availableIndices;
 
 public:
 	ModelContainer(const ModelContainer&) = delete;
 	ModelContainer& operator=(const ModelContainer&) = delete;
 
 	ModelContainer(ModelContainer&& other) noexcept
-		: m_models{ std::move(other.m_models) }
+		: m_modelMatrices{ std::move(other.m_modelMatrices) },
+		m_normalMatrices{ std::move(other.m_normalMatrices) },
+		m_modelOffsets{ std::move(other.m_modelOffsets) },
+		m_modelScales{ std::move(other.m_modelScales) },
+		m_materials{ std::move(other.m_materials) },
+		m_meshIndices{ std::move(other.m_meshIndices) },
+		m_visibilities{ std::move(other.m_visibilities) },
+		m_modelStates{ std::move(other.m_modelStates) },
+		m_availableIndices{ std::move(other.m_availableIndices) }
 	{}
 	ModelContainer& operator=(ModelContainer&& other) noexcept
 	{
-		m_models = std::move(other.m_models);
+		m_modelMatrices    = std::move(other.m_modelMatrices);
+		m_normalMatrices   = std::move(other.m_normalMatrices);
+		m_modelOffsets     = std::move(other.m_modelOffsets);
+		m_modelScales      = std::move(other.m_modelScales);
+		m_materials        = std::move(other.m_materials);
+		m_meshIndices      = std::move(other.m_meshIndices);
+		m_visibilities     = std::move(other.m_visibilities);
+		m_modelStates      = std::move(other.m_modelStates);
+		m_availableIndices = std::move(other.m_availableIndices);
 
 		return *this;
 	}
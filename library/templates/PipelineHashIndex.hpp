@@ -0,0 +1,171 @@
+#ifndef PIPELINE_HASH_INDEX_HPP_
+#define PIPELINE_HASH_INDEX_HPP_
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <algorithm>
+
+// Maps the hash of an external pipeline to the index of its pipeline with open addressing. Since
+// different pipelines could have the same hash, the caller must still compare the pipeline at a
+// found index. A removed entry is marked as such, so the probing of the other entries isn't
+// broken, and the marked entries are discarded when the table grows.
+class PipelineHashIndex
+{
+	struct Entry
+	{
+		std::uint64_t hash;
+		std::uint32_t pipelineIndex;
+	};
+
+public:
+	PipelineHashIndex() : m_entries{}, m_entryCount{ 0u }, m_usedCount{ 0u } {}
+
+	void Add(std::uint64_t hash, std::uint32_t pipelineIndex)
+	{
+		// The removed entries are counted as well, as they make the probing longer.
+		if ((m_usedCount + 1u) * s_maxLoadDenominator > std::size(m_entries) * s_maxLoadNumerator)
+			Rehash(std::max(s_minEntryCount, (m_entryCount + 1u) * 2u));
+
+		Entry& entry = m_entries[FindFreeEntry(hash)];
+
+		if (entry.pipelineIndex == s_emptyIndex)
+			++m_usedCount;
+
+		entry = Entry{ .hash = hash, .pipelineIndex = pipelineIndex };
+
+		++m_entryCount;
+	}
+
+	void Remove(std::uint64_t hash, std::uint32_t pipelineIndex) noexcept
+	{
+		if (std::empty(m_entries))
+			return;
+
+		const size_t mask = std::size(m_entries) - 1u;
+
+		for (size_t index = hash & mask; m_entries[index].pipelineIndex != s_emptyIndex;
+			index = (index + 1u) & mask)
+		{
+			Entry& entry = m_entries[index];
+
+			if (entry.hash == hash && entry.pipelineIndex == pipelineIndex)
+			{
+				entry.pipelineIndex = s_removedIndex;
+
+				--m_entryCount;
+
+				break;
+			}
+		}
+	}
+
+	// IsSame is called with the index of every pipeline which has the same hash, until it
+	// returns true.
+	template<typename IsSame_t>
+	[[nodiscard]]
+	std::optional<std::uint32_t> Find(std::uint64_t hash, IsSame_t&& isSame) const
+	{
+		std::optional<std::uint32_t> oPipelineIndex{};
+
+		if (std::empty(m_entries))
+			return oPipelineIndex;
+
+		const size_t mask = std::size(m_entries) - 1u;
+
+		for (size_t index = hash & mask; m_entries[index].pipelineIndex != s_emptyIndex;
+			index = (index + 1u) & mask)
+		{
+			const Entry& entry = m_entries[index];
+
+			if (entry.pipelineIndex != s_removedIndex && entry.hash == hash
+				&& isSame(entry.pipelineIndex))
+			{
+				oPipelineIndex = entry.pipelineIndex;
+
+				break;
+			}
+		}
+
+		return oPipelineIndex;
+	}
+
+	void Clear() noexcept
+	{
+		m_entries.clear();
+
+		m_entryCount = 0u;
+		m_usedCount  = 0u;
+	}
+
+	[[nodiscard]]
+	size_t GetEntryCount() const noexcept { return m_entryCount; }
+
+private:
+	[[nodiscard]]
+	size_t FindFreeEntry(std::uint64_t hash) const noexcept
+	{
+		const size_t mask = std::size(m_entries) - 1u;
+
+		size_t index = hash & mask;
+
+		while (m_entries[index].pipelineIndex != s_emptyIndex
+			&& m_entries[index].pipelineIndex != s_removedIndex)
+			index = (index + 1u) & mask;
+
+		return index;
+	}
+
+	void Rehash(size_t minimumEntryCount)
+	{
+		size_t newEntryCount = s_minEntryCount;
+
+		while (newEntryCount < minimumEntryCount)
+			newEntryCount *= 2u;
+
+		std::vector<Entry> oldEntries = std::exchange(
+			m_entries, std::vector<Entry>(newEntryCount, Entry{ 0u, s_emptyIndex })
+		);
+
+		m_usedCount = 0u;
+
+		for (const Entry& entry : oldEntries)
+			if (entry.pipelineIndex != s_emptyIndex && entry.pipelineIndex != s_removedIndex)
+			{
+				m_entries[FindFreeEntry(entry.hash)] = entry;
+
+				++m_usedCount;
+			}
+	}
+
+private:
+	std::vector<Entry> m_entries;
+	size_t             m_entryCount;
+	size_t             m_usedCount;
+
+	static constexpr std::uint32_t s_emptyIndex         = std::numeric_limits<std::uint32_t>::max();
+	static constexpr std::uint32_t s_removedIndex       = s_emptyIndex - 1u;
+	static constexpr size_t        s_minEntryCount      = 16u;
+	static constexpr size_t        s_maxLoadNumerator   = 3u;
+	static constexpr size_t        s_maxLoadDenominator = 4u;
+
+public:
+	PipelineHashIndex(const PipelineHashIndex&) = delete;
+	PipelineHashIndex& operator=(const PipelineHashIndex&) = delete;
+
+	PipelineHashIndex(PipelineHashIndex&& other) noexcept
+		: m_entries{ std::move(other.m_entries) },
+		m_entryCount{ std::exchange(other.m_entryCount, 0u) },
+		m_usedCount{ std::exchange(other.m_usedCount, 0u) }
+	{}
+	PipelineHashIndex& operator=(PipelineHashIndex&& other) noexcept
+	{
+		m_entries    = std::move(other.m_entries);
+		m_entryCount = std::exchange(other.m_entryCount, 0u);
+		m_usedCount  = std::exchange(other.m_usedCount, 0u);
+
+		return *this;
+	}
+};
+#endif
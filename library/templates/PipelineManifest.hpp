@@ -0,0 +1,444 @@
+#ifndef PIPELINE_MANIFEST_HPP_
+#define PIPELINE_MANIFEST_HPP_
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <ExternalPipeline.hpp>
+#include <PipelineHashIndex.hpp>
+
+// Keeps the description of every pipeline which was requested, without any duplicates. Once a
+// directory is set, the manifest is loaded from a file in it and written back when the manifest
+// is destroyed. So, the pipelines of the previous runs can be compiled before the first frame.
+// The manifest doesn't depend on the device or the driver, those are handled by the pipeline
+// cache.
+class PipelineManifest
+{
+	struct FileHeader
+	{
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t graphicsPipelineCount;
+		std::uint32_t computePipelineCount;
+	};
+
+	class Writer
+	{
+	public:
+		Writer(std::vector<std::uint8_t>& data) : m_data{ data } {}
+
+		void Write(void const* data, size_t dataSize)
+		{
+			auto bytes = static_cast<std::uint8_t const*>(data);
+
+			m_data.insert(std::end(m_data), bytes, bytes + dataSize);
+		}
+
+		template<typename T>
+		void WriteValue(T value)
+		{
+			Write(&value, sizeof(T));
+		}
+
+		void WriteBool(bool value)
+		{
+			WriteValue(static_cast<std::uint8_t>(value));
+		}
+
+		void WriteShader(const ShaderName& shaderName)
+		{
+			const std::wstring name = shaderName.GetName();
+
+			// The size of wchar_t isn't the same on every platform.
+			WriteValue(static_cast<std::uint32_t>(std::size(name)));
+
+			for (wchar_t character : name)
+				WriteValue(static_cast<std::uint32_t>(character));
+		}
+
+	private:
+		std::vector<std::uint8_t>& m_data;
+	};
+
+	class Reader
+	{
+	public:
+		Reader(const std::vector<std::uint8_t>& data) : m_data{ data }, m_offset{ 0u } {}
+
+		// Returns false if there isn't enough data left.
+		[[nodiscard]]
+		bool Read(void* data, size_t dataSize) noexcept
+		{
+			if (std::size(m_data) - m_offset < dataSize)
+				return false;
+
+			std::memcpy(data, std::data(m_data) + m_offset, dataSize);
+
+			m_offset += dataSize;
+
+			return true;
+		}
+
+		template<typename T>
+		[[nodiscard]]
+		bool ReadValue(T& value) noexcept
+		{
+			return Read(&value, sizeof(T));
+		}
+
+		// The bools are written as bytes, as any other value wouldn't be a valid bool.
+		[[nodiscard]]
+		bool ReadBool(bool& value) noexcept
+		{
+			std::uint8_t byteValue = 0u;
+
+			const bool isRead = ReadValue(byteValue);
+
+			value = byteValue != 0u;
+
+			return isRead;
+		}
+
+		[[nodiscard]]
+		bool ReadShader(ShaderName& shaderName)
+		{
+			std::uint32_t characterCount = 0u;
+
+			if (!ReadValue(characterCount)
+				|| (std::size(m_data) - m_offset) / sizeof(std::uint32_t) < characterCount)
+				return false;
+
+			std::wstring name(characterCount, L'\0');
+
+			for (wchar_t& character : name)
+			{
+				std::uint32_t value = 0u;
+
+				if (!ReadValue(value))
+					return false;
+
+				character = static_cast<wchar_t>(value);
+			}
+
+			shaderName.SetName(name);
+
+			return true;
+		}
+
+		[[nodiscard]]
+		bool IsFinished() const noexcept { return m_offset == std::size(m_data); }
+
+	private:
+		const std::vector<std::uint8_t>& m_data;
+		size_t                           m_offset;
+	};
+
+public:
+	PipelineManifest()
+		: m_graphicsPipelines{}, m_computePipelines{}, m_graphicsHashIndex{},
+		m_computeHashIndex{}, m_filePath{}
+	{}
+	~PipelineManifest() noexcept
+	{
+		// Failing to write the file isn't an error, the pipelines would just be compiled when
+		// they are requested on the next launch.
+		[[maybe_unused]] const bool saved = Save();
+	}
+
+	// If there is a valid manifest in the directory, its pipelines will be added. The pipelines
+	// which have already been added will be kept. The renderers which share a directory should
+	// use different file names.
+	void LoadFromDirectory(const std::wstring& directory, const std::wstring& fileName)
+	{
+		m_filePath = (std::filesystem::path{ directory } / fileName).wstring();
+
+		std::ifstream manifestFile{ std::filesystem::path{ m_filePath }, std::ios_base::binary };
+
+		if (!manifestFile.is_open())
+			return;
+
+		const std::vector<std::uint8_t> manifestData{
+			std::istreambuf_iterator<char>{ manifestFile }, std::istreambuf_iterator<char>{}
+		};
+
+		// An invalid file would just be overwritten.
+		[[maybe_unused]] const bool loaded = Deserialise(manifestData);
+	}
+
+	// Writes the manifest to the file in the directory. Does nothing if no directory was set.
+	[[nodiscard]]
+	bool Save() const
+	{
+		if (std::empty(m_filePath))
+			return false;
+
+		const std::vector<std::uint8_t> manifestData = Serialise();
+
+		std::ofstream manifestFile{
+			std::filesystem::path{ m_filePath }, std::ios_base::binary | std::ios_base::trunc
+		};
+
+		if (!manifestFile.is_open())
+			return false;
+
+		manifestFile.write(
+			reinterpret_cast<const char*>(std::data(manifestData)),
+			static_cast<std::streamsize>(std::size(manifestData))
+		);
+
+		return manifestFile.good();
+	}
+
+	void AddPipeline(const ExternalGraphicsPipeline& graphicsPipeline)
+	{
+		AddPipeline(graphicsPipeline, m_graphicsPipelines, m_graphicsHashIndex);
+	}
+
+	void AddPipeline(const ExternalComputePipeline& computePipeline)
+	{
+		AddPipeline(computePipeline, m_computePipelines, m_computeHashIndex);
+	}
+
+	[[nodiscard]]
+	std::vector<std::uint8_t> Serialise() const
+	{
+		std::vector<std::uint8_t> manifestData{};
+
+		Writer writer{ manifestData };
+
+		const FileHeader header{
+			.magic                 = s_fileMagic,
+			.version               = s_fileVersion,
+			.graphicsPipelineCount = static_cast<std::uint32_t>(std::size(m_graphicsPipelines)),
+			.computePipelineCount  = static_cast<std::uint32_t>(std::size(m_computePipelines))
+		};
+
+		writer.WriteValue(header);
+
+		for (const ExternalGraphicsPipeline& graphicsPipeline : m_graphicsPipelines)
+			WriteGraphicsPipeline(writer, graphicsPipeline);
+
+		for (const ExternalComputePipeline& computePipeline : m_computePipelines)
+			writer.WriteShader(computePipeline.GetComputeShader());
+
+		return manifestData;
+	}
+
+	// Nothing is added, if the data isn't a valid manifest.
+	[[nodiscard]]
+	bool Deserialise(const std::vector<std::uint8_t>& manifestData)
+	{
+		Reader reader{ manifestData };
+
+		FileHeader header{};
+
+		if (!reader.ReadValue(header) || header.magic != s_fileMagic
+			|| header.version != s_fileVersion)
+			return false;
+
+		std::vector<ExternalGraphicsPipeline> graphicsPipelines{};
+
+		for (std::uint32_t index = 0u; index < header.graphicsPipelineCount; ++index)
+		{
+			ExternalGraphicsPipeline graphicsPipeline{};
+
+			if (!ReadGraphicsPipeline(reader, graphicsPipeline))
+				return false;
+
+			graphicsPipelines.emplace_back(std::move(graphicsPipeline));
+		}
+
+		std::vector<ExternalComputePipeline> computePipelines{};
+
+		for (std::uint32_t index = 0u; index < header.computePipelineCount; ++index)
+		{
+			ShaderName computeShader{};
+
+			if (!reader.ReadShader(computeShader))
+				return false;
+
+			computePipelines.emplace_back(computeShader);
+		}
+
+		if (!reader.IsFinished())
+			return false;
+
+		for (const ExternalGraphicsPipeline& graphicsPipeline : graphicsPipelines)
+			AddPipeline(graphicsPipeline);
+
+		for (const ExternalComputePipeline& computePipeline : computePipelines)
+			AddPipeline(computePipeline);
+
+		return true;
+	}
+
+	[[nodiscard]]
+	const std::vector<ExternalGraphicsPipeline>& GetGraphicsPipelines() const noexcept
+	{
+		return m_graphicsPipelines;
+	}
+	[[nodiscard]]
+	const std::vector<ExternalComputePipeline>& GetComputePipelines() const noexcept
+	{
+		return m_computePipelines;
+	}
+	[[nodiscard]]
+	const std::wstring& GetFilePath() const noexcept { return m_filePath; }
+
+private:
+	template<typename PipelineExt>
+	static void AddPipeline(
+		const PipelineExt& extPipeline, std::vector<PipelineExt>& extPipelines,
+		PipelineHashIndex& hashIndex
+	) {
+		const std::uint64_t pipelineHash = extPipeline.GetHash();
+
+		std::optional<std::uint32_t> oPipelineIndex = hashIndex.Find(
+			pipelineHash,
+			[&extPipeline, &extPipelines](std::uint32_t pipelineIndex)
+			{
+				return extPipelines[pipelineIndex] == extPipeline;
+			}
+		);
+
+		if (oPipelineIndex)
+			return;
+
+		hashIndex.Add(pipelineHash, static_cast<std::uint32_t>(std::size(extPipelines)));
+
+		extPipelines.emplace_back(extPipeline);
+	}
+
+	static void WriteGraphicsPipeline(
+		Writer& writer, const ExternalGraphicsPipeline& graphicsPipeline
+	) {
+		writer.WriteShader(graphicsPipeline.GetVertexShader());
+		writer.WriteShader(graphicsPipeline.GetFragmentShader());
+
+		const std::uint32_t renderTargetCount = graphicsPipeline.GetRenderTargetCount();
+
+		writer.WriteValue(static_cast<std::uint8_t>(renderTargetCount));
+
+		for (size_t index = 0u; index < renderTargetCount; ++index)
+		{
+			const ExternalBlendState blendState = graphicsPipeline.GetBlendState(index);
+
+			writer.WriteValue(graphicsPipeline.GetRenderTargetFormat(index));
+			writer.WriteBool(blendState.enabled);
+			writer.WriteValue(blendState.alphaBlendOP);
+			writer.WriteValue(blendState.colourBlendOP);
+			writer.WriteValue(blendState.alphaBlendSrc);
+			writer.WriteValue(blendState.alphaBlendDst);
+			writer.WriteValue(blendState.colourBlendSrc);
+			writer.WriteValue(blendState.colourBlendDst);
+		}
+
+		writer.WriteValue(graphicsPipeline.GetDepthFormat());
+		writer.WriteValue(graphicsPipeline.GetStencilFormat());
+		writer.WriteBool(graphicsPipeline.IsDepthWriteEnabled());
+		writer.WriteBool(graphicsPipeline.GetBackfaceCullingState());
+		writer.WriteBool(graphicsPipeline.IsGPUCullingEnabled());
+	}
+
+	// The pipeline is built with the same functions the renderer uses, so it would be equal to
+	// the one which was written.
+	[[nodiscard]]
+	static bool ReadGraphicsPipeline(Reader& reader, ExternalGraphicsPipeline& graphicsPipeline)
+	{
+		ShaderName vertexShader{};
+		ShaderName fragmentShader{};
+
+		if (!reader.ReadShader(vertexShader) || !reader.ReadShader(fragmentShader))
+			return false;
+
+		graphicsPipeline.SetVertexShader(vertexShader);
+		graphicsPipeline.SetFragmentShader(fragmentShader);
+
+		std::uint8_t renderTargetCount = 0u;
+
+		if (!reader.ReadValue(renderTargetCount)
+			|| renderTargetCount > ExternalGraphicsPipeline::s_maxRenderTargetCount)
+			return false;
+
+		for (std::uint8_t index = 0u; index < renderTargetCount; ++index)
+		{
+			ExternalFormat     format{};
+			ExternalBlendState blendState{};
+
+			const bool isValid = reader.ReadValue(format)
+				&& reader.ReadBool(blendState.enabled)
+				&& reader.ReadValue(blendState.alphaBlendOP)
+				&& reader.ReadValue(blendState.colourBlendOP)
+				&& reader.ReadValue(blendState.alphaBlendSrc)
+				&& reader.ReadValue(blendState.alphaBlendDst)
+				&& reader.ReadValue(blendState.colourBlendSrc)
+				&& reader.ReadValue(blendState.colourBlendDst);
+
+			if (!isValid)
+				return false;
+
+			graphicsPipeline.AddRenderTarget(format, blendState);
+		}
+
+		ExternalFormat depthFormat{};
+		ExternalFormat stencilFormat{};
+		bool           depthWrite      = false;
+		bool           backfaceCulling = false;
+		bool           gpuCulling      = false;
+
+		const bool isValid = reader.ReadValue(depthFormat) && reader.ReadValue(stencilFormat)
+			&& reader.ReadBool(depthWrite) && reader.ReadBool(backfaceCulling)
+			&& reader.ReadBool(gpuCulling);
+
+		if (!isValid)
+			return false;
+
+		graphicsPipeline.EnableDepthTesting(depthFormat, depthWrite);
+		graphicsPipeline.EnableStencilTesting(stencilFormat);
+
+		if (backfaceCulling)
+			graphicsPipeline.EnableBackfaceCulling();
+
+		if (!gpuCulling)
+			graphicsPipeline.DisableGPUCulling();
+
+		return true;
+	}
+
+private:
+	std::vector<ExternalGraphicsPipeline> m_graphicsPipelines;
+	std::vector<ExternalComputePipeline>  m_computePipelines;
+	PipelineHashIndex                     m_graphicsHashIndex;
+	PipelineHashIndex                     m_computeHashIndex;
+	std::wstring                          m_filePath;
+
+	static constexpr std::uint32_t s_fileMagic   = 0x54504D31u; // TPM1
+	static constexpr std::uint32_t s_fileVersion = 1u;
+
+public:
+	PipelineManifest(const PipelineManifest&) = delete;
+	PipelineManifest& operator=(const PipelineManifest&) = delete;
+
+	PipelineManifest(PipelineManifest&& other) noexcept
+		: m_graphicsPipelines{ std::move(other.m_graphicsPipelines) },
+		m_computePipelines{ std::move(other.m_computePipelines) },
+		m_graphicsHashIndex{ std::move(other.m_graphicsHashIndex) },
+		m_computeHashIndex{ std::move(other.m_computeHashIndex) },
+		m_filePath{ std::move(other.m_filePath) }
+	{}
+	PipelineManifest& operator=(PipelineManifest&& other) noexcept
+	{
+		m_graphicsPipelines = std::move(other.m_graphicsPipelines);
+		m_computePipelines  = std::move(other.m_computePipelines);
+		m_graphicsHashIndex = std::move(other.m_graphicsHashIndex);
+		m_computeHashIndex  = std::move(other.m_computeHashIndex);
+		m_filePath          = std::move(other.m_filePath);
+
+		return *this;
+	}
+};
+#endif
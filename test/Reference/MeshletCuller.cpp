@@ -0,0 +1,147 @@
+#include <cmath>
+#include <algorithm>
+#include <MeshletCuller.hpp>
+
+namespace Terra
+{
+MeshletCuller::MeshletCuller() : m_planes{}, m_viewPosition{ DirectX::XMVectorZero() }
+{
+	// Zero planes don't cull anything, so everything is in the frustum until one is set.
+	m_planes.fill(DirectX::XMVectorZero());
+}
+
+void MeshletCuller::SetFrustum(const Frustum& frustum) noexcept
+{
+	using namespace DirectX;
+
+	m_planes[0u] = XMLoadFloat4(&frustum.leftP);
+	m_planes[1u] = XMLoadFloat4(&frustum.rightP);
+	m_planes[2u] = XMLoadFloat4(&frustum.bottomP);
+	m_planes[3u] = XMLoadFloat4(&frustum.topP);
+	m_planes[4u] = XMLoadFloat4(&frustum.nearP);
+	m_planes[5u] = XMLoadFloat4(&frustum.farP);
+}
+
+void MeshletCuller::SetViewPosition(const DirectX::XMFLOAT3& viewPosition) noexcept
+{
+	m_viewPosition = DirectX::XMLoadFloat3(&viewPosition);
+}
+
+float MeshletCuller::GetMaxScale(const DirectX::XMMATRIX& modelMatrix) noexcept
+{
+	using namespace DirectX;
+
+	return std::max({
+		XMVectorGetX(XMVector3Length(modelMatrix.r[0])),
+		XMVectorGetX(XMVector3Length(modelMatrix.r[1])),
+		XMVectorGetX(XMVector3Length(modelMatrix.r[2]))
+	});
+}
+
+bool MeshletCuller::IsInFrustum(
+	const SphereBoundingVolume& sphereB, const DirectX::XMMATRIX& modelMatrix,
+	const DirectX::XMFLOAT3& modelOffset
+) const noexcept {
+	using namespace DirectX;
+
+	const XMVECTOR worldCentre = XMVectorAdd(
+		XMVector3Transform(XMLoadFloat4(&sphereB.sphere), modelMatrix),
+		XMLoadFloat3(&modelOffset)
+	);
+
+	const float radius = sphereB.sphere.w * GetMaxScale(modelMatrix);
+
+	for (const XMVECTOR& plane : m_planes)
+		if (XMVectorGetX(XMPlaneDotCoord(plane, worldCentre)) < -radius)
+			return false;
+
+	return true;
+}
+
+bool MeshletCuller::IsBackFacing(
+	const SphereBoundingVolume& sphereB, const ClusterNormalCone& coneNormal,
+	const DirectX::XMMATRIX& modelMatrix, const DirectX::XMFLOAT3& modelOffset
+) const noexcept {
+	using namespace DirectX;
+
+	if (IsConeDegenerate(coneNormal.packedCone))
+		return false;
+
+	const XMVECTOR cone = UnpackCone(coneNormal.packedCone);
+
+	const XMVECTOR worldCentre = XMVectorAdd(
+		XMVector3Transform(XMLoadFloat4(&sphereB.sphere), modelMatrix),
+		XMLoadFloat3(&modelOffset)
+	);
+	const XMVECTOR axis        = XMVector3Normalize(XMVector3TransformNormal(cone, modelMatrix));
+
+	// The apex is offset from the centre along the axis and should be scaled like the sphere.
+	const XMVECTOR apex = XMVectorSubtract(
+		worldCentre,
+		XMVectorScale(axis, coneNormal.apexOffset * GetMaxScale(modelMatrix))
+	);
+	const XMVECTOR view = XMVector3Normalize(XMVectorSubtract(m_viewPosition, apex));
+
+	return XMVectorGetX(XMVector3Dot(view, XMVectorNegate(axis))) > XMVectorGetW(cone);
+}
+
+bool MeshletCuller::IsMeshletVisible(
+	const MeshletDetails& meshletDetails, const DirectX::XMMATRIX& modelMatrix,
+	const DirectX::XMFLOAT3& modelOffset
+) const noexcept {
+	return IsInFrustum(meshletDetails.sphereB, modelMatrix, modelOffset)
+		&& !IsBackFacing(
+			meshletDetails.sphereB, meshletDetails.coneNormal, modelMatrix, modelOffset
+		);
+}
+
+std::uint32_t MeshletCuller::GetVisibleMeshletCount(
+	const std::vector<MeshletDetails>& meshletDetails, std::uint32_t meshletOffset,
+	std::uint32_t meshletCount, const DirectX::XMMATRIX& modelMatrix,
+	const DirectX::XMFLOAT3& modelOffset
+) const noexcept {
+	std::uint32_t visibleCount = 0u;
+
+	for (std::uint32_t index = 0u; index < meshletCount; ++index)
+		if (IsMeshletVisible(meshletDetails[meshletOffset + index], modelMatrix, modelOffset))
+			++visibleCount;
+
+	return visibleCount;
+}
+
+DirectX::XMVECTOR MeshletCuller::UnpackCone(std::uint32_t packedCone) noexcept
+{
+	using namespace DirectX;
+
+	const XMVECTOR unorm = XMVectorScale(
+		XMVectorSet(
+			static_cast<float>(packedCone & 0xFFu),
+			static_cast<float>((packedCone >> 8u) & 0xFFu),
+			static_cast<float>((packedCone >> 16u) & 0xFFu),
+			static_cast<float>((packedCone >> 24u) & 0xFFu)
+		), 1.f / 255.f
+	);
+
+	// Only the axis is remapped.
+	const XMVECTOR axis = XMVectorSubtract(XMVectorScale(unorm, 2.f), XMVectorReplicate(1.f));
+
+	return XMVectorSelect(unorm, axis, g_XMSelect1110);
+}
+
+std::uint32_t MeshletCuller::PackCone(const DirectX::XMFLOAT3& axis, float cutoff) noexcept
+{
+	auto packAxis = [](float value) -> std::uint32_t
+	{
+		return static_cast<std::uint32_t>(
+			std::lround(std::clamp(value * 0.5f + 0.5f, 0.f, 1.f) * 255.f)
+		);
+	};
+
+	const auto packedCutoff = static_cast<std::uint32_t>(
+		std::ceil(std::clamp(cutoff, 0.f, 1.f) * 255.f)
+	);
+
+	return packAxis(axis.x) | packAxis(axis.y) << 8u | packAxis(axis.z) << 16u
+		| packedCutoff << 24u;
+}
+}
@@ -0,0 +1,82 @@
+#ifndef MESHLET_CULLER_HPP_
+#define MESHLET_CULLER_HPP_
+#include <cstdint>
+#include <array>
+#include <vector>
+
+#include <MeshBundle.hpp>
+#include <BoundingVolumes.hpp>
+#include <Camera.hpp>
+#include <DirectXMath.h>
+
+namespace Terra
+{
+// The same tests as the ones the task shader does on each meshlet before emitting it, so they
+// can be checked on the CPU. A meshlet is culled if its bounding sphere is outside of the view
+// frustum or if every triangle in it is facing away from the camera. The data is the same as
+// the one in the per meshlet buffer.
+// The task shaders are built outside of this repo, so this only lives with the tests as the
+// reference those shaders should match.
+class MeshletCuller
+{
+public:
+	MeshletCuller();
+
+	// The planes and the position should be in the world space.
+	void SetFrustum(const Frustum& frustum) noexcept;
+	void SetViewPosition(const DirectX::XMFLOAT3& viewPosition) noexcept;
+
+	// The sphere is in the model space and is transformed by the model matrix and the offset.
+	[[nodiscard]]
+	bool IsInFrustum(
+		const SphereBoundingVolume& sphereB, const DirectX::XMMATRIX& modelMatrix,
+		const DirectX::XMFLOAT3& modelOffset
+	) const noexcept;
+	// If the view position is in the cone opposite to the normal cone, all of the triangles
+	// are back facing.
+	[[nodiscard]]
+	bool IsBackFacing(
+		const SphereBoundingVolume& sphereB, const ClusterNormalCone& coneNormal,
+		const DirectX::XMMATRIX& modelMatrix, const DirectX::XMFLOAT3& modelOffset
+	) const noexcept;
+
+	[[nodiscard]]
+	bool IsMeshletVisible(
+		const MeshletDetails& meshletDetails, const DirectX::XMMATRIX& modelMatrix,
+		const DirectX::XMFLOAT3& modelOffset
+	) const noexcept;
+
+	// The number of meshlets which would be emitted by the task shader for a mesh.
+	[[nodiscard]]
+	std::uint32_t GetVisibleMeshletCount(
+		const std::vector<MeshletDetails>& meshletDetails, std::uint32_t meshletOffset,
+		std::uint32_t meshletCount, const DirectX::XMMATRIX& modelMatrix,
+		const DirectX::XMFLOAT3& modelOffset
+	) const noexcept;
+
+	// The axis is stored in the xyz components and the cutoff in the w component. Each of them
+	// is an 8bit unorm and the axis is remapped to [-1, 1].
+	[[nodiscard]]
+	static DirectX::XMVECTOR UnpackCone(std::uint32_t packedCone) noexcept;
+	// The cutoff is the sine of the half angle of the cone. It is rounded up, so the packed cone
+	// never culls more.
+	[[nodiscard]]
+	static std::uint32_t PackCone(const DirectX::XMFLOAT3& axis, float cutoff) noexcept;
+
+	// If the normals are spread more than a hemisphere, the cone can't cull anything.
+	[[nodiscard]]
+	static bool IsConeDegenerate(std::uint32_t packedCone) noexcept
+	{
+		return (packedCone >> 24u) == 0xFFu;
+	}
+
+private:
+	[[nodiscard]]
+	static float GetMaxScale(const DirectX::XMMATRIX& modelMatrix) noexcept;
+
+private:
+	std::array<DirectX::XMVECTOR, 6u> m_planes;
+	DirectX::XMVECTOR                 m_viewPosition;
+};
+}
+#endif
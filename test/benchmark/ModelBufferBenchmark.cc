@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <chrono>
+#include <vector>
+#include <iostream>
+
+#include <VKInstanceManager.hpp>
+#include <VkDeviceManager.hpp>
+#include <VkModelBuffer.hpp>
+
+using namespace Terra;
+
+namespace Constants
+{
+	constexpr const char* appName      = "TerraTest";
+	constexpr std::uint32_t frameCount = 2u;
+}
+
+// Measures the CPU time of a ModelBuffers update per frame, depending on how many models have
+// been changed in that frame and on how many threads the update is split across. These only
+// print the timings, so they are built into TerraBenchmark instead of the tests.
+class ModelBufferBenchmarkTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite();
+	static void TearDownTestSuite();
+
+	[[nodiscard]]
+	static double RunUpdates(
+		ModelBuffers& modelBuffers, ModelContainer& modelContainer, size_t changedModelCount
+	);
+
+protected:
+	inline static std::unique_ptr<VkInstanceManager> s_instanceManager;
+	inline static std::unique_ptr<VkDeviceManager>   s_deviceManager;
+
+	static constexpr size_t s_modelCount  = 100'000u;
+	static constexpr size_t s_frameRounds = 16u;
+};
+
+void ModelBufferBenchmarkTest::SetUpTestSuite()
+{
+	const CoreVersion coreVersion = CoreVersion::V1_3;
+
+	s_instanceManager = std::make_unique<VkInstanceManager>(Constants::appName);
+	s_instanceManager->DebugLayers().AddDebugCallback(DebugCallbackType::StandardError);
+	s_instanceManager->CreateInstance(coreVersion);
+
+	VkInstance vkInstance = s_instanceManager->GetVKInstance();
+
+	s_deviceManager = std::make_unique<VkDeviceManager>();
+
+	{
+		VkDeviceExtensionManager& extensionManager = s_deviceManager->ExtensionManager();
+		extensionManager.AddExtensions(MemoryManager::GetRequiredExtensions());
+	}
+
+	s_deviceManager->SetDeviceFeatures(coreVersion)
+		.SetPhysicalDeviceAutomatic(vkInstance)
+		.CreateLogicalDevice();
+}
+
+void ModelBufferBenchmarkTest::TearDownTestSuite()
+{
+	s_deviceManager.reset();
+	s_instanceManager.reset();
+}
+
+double ModelBufferBenchmarkTest::RunUpdates(
+	ModelBuffers& modelBuffers, ModelContainer& modelContainer, size_t changedModelCount
+) {
+	std::chrono::duration<double, std::milli> totalDuration{};
+
+	for (size_t frame = 0u; frame < s_frameRounds; ++frame)
+	{
+		for (size_t index = 0u; index < changedModelCount; ++index)
+			modelContainer.GetModel(index).GetTransform().RotateYawDegree(1.f);
+
+		const auto start = std::chrono::steady_clock::now();
+
+		modelBuffers.Update(static_cast<VkDeviceSize>(frame % Constants::frameCount));
+
+		totalDuration += std::chrono::steady_clock::now() - start;
+	}
+
+	return totalDuration.count() / static_cast<double>(s_frameRounds);
+}
+
+TEST_F(ModelBufferBenchmarkTest, ChangedModelCountTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	MemoryManager memoryManager{ physicalDevice, logicalDevice, 20_MB, 64_MB };
+
+	auto modelContainer = std::make_shared<ModelContainer>();
+
+	{
+		std::vector<Model> models{};
+		models.reserve(s_modelCount);
+
+		for (size_t index = 0u; index < s_modelCount; ++index)
+			models.emplace_back(Model{ 1.f });
+
+		std::ignore = modelContainer->AddModels(std::move(models));
+	}
+
+	ModelBuffers modelBuffers{ logicalDevice, &memoryManager, Constants::frameCount, {} };
+
+	modelBuffers.SetModelContainer(modelContainer);
+	modelBuffers.ExtendModelBuffers();
+
+	// The first updates write every model to every instance.
+	for (std::uint32_t frame = 0u; frame < Constants::frameCount; ++frame)
+		modelBuffers.Update(static_cast<VkDeviceSize>(frame));
+
+	for (size_t changedModelCount : { 0u, 100u, 1'000u, 10'000u, 100'000u })
+	{
+		const double frameTimeMS = RunUpdates(modelBuffers, *modelContainer, changedModelCount);
+
+		std::cout << "Changed models " << changedModelCount << ": " << frameTimeMS
+			<< "ms per frame\n";
+	}
+}
+
+TEST_F(ModelBufferBenchmarkTest, ThreadCountTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	MemoryManager memoryManager{ physicalDevice, logicalDevice, 20_MB, 64_MB };
+
+	auto modelContainer = std::make_shared<ModelContainer>();
+
+	{
+		std::vector<Model> models{};
+		models.reserve(s_modelCount);
+
+		for (size_t index = 0u; index < s_modelCount; ++index)
+			models.emplace_back(Model{ 1.f });
+
+		std::ignore = modelContainer->AddModels(std::move(models));
+	}
+
+	ModelBuffers modelBuffers{ logicalDevice, &memoryManager, Constants::frameCount, {} };
+
+	modelBuffers.SetModelContainer(modelContainer);
+	modelBuffers.ExtendModelBuffers();
+
+	// Every model is changed in every frame, so this is the worst case.
+	{
+		const double frameTimeMS = RunUpdates(modelBuffers, *modelContainer, s_modelCount);
+
+		std::cout << "No thread pool: " << static_cast<double>(s_modelCount) / frameTimeMS
+			<< " models/ms\n";
+	}
+
+	for (size_t threadCount : { 1u, 2u, 4u, 8u })
+	{
+		ThreadPool threadPool{ threadCount };
+
+		modelBuffers.SetThreadPool(&threadPool);
+
+		const double frameTimeMS = RunUpdates(modelBuffers, *modelContainer, s_modelCount);
+
+		std::cout << "Threads " << threadCount << ": "
+			<< static_cast<double>(s_modelCount) / frameTimeMS << " models/ms\n";
+	}
+
+	modelBuffers.SetThreadPool(nullptr);
+}
@@ -0,0 +1,6 @@
+#version 460
+// The test passes only write the depth, so there isn't any colour output.
+
+void main()
+{
+}
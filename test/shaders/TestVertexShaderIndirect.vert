@@ -0,0 +1,49 @@
+#version 460
+// Only transforms the positions, for the depth passes of the VS Indirect tests. Each draw of a
+// pipeline reads its model index with the model offset of the pipeline and the draw index.
+
+layout(location = 0) in vec3 inPosition;
+
+struct ModelData
+{
+	mat4  modelMatrix;
+	mat4  normalMatrix;
+	vec3  modelOffset;
+	uint  materialIndex;
+	uint  meshIndex;
+	float modelScale;
+	uint  padding0;
+	uint  padding1;
+};
+
+layout(push_constant) uniform ConstantData
+{
+	uint modelOffset;
+} constantData;
+
+layout(set = 0, binding = 0) readonly buffer ModelBuffer
+{
+	ModelData models[];
+};
+
+layout(set = 0, binding = 1) uniform CameraBuffer
+{
+	mat4 view;
+	mat4 projection;
+	vec4 frustumPlanes[6];
+	vec4 viewPosition;
+} camera;
+
+layout(set = 0, binding = 2) readonly buffer ModelIndicesBuffer
+{
+	uint modelIndices[];
+};
+
+void main()
+{
+	const ModelData model = models[modelIndices[constantData.modelOffset + gl_DrawID]];
+
+	const vec3 worldPosition = (model.modelMatrix * vec4(inPosition, 1.0)).xyz + model.modelOffset;
+
+	gl_Position = camera.projection * camera.view * vec4(worldPosition, 1.0);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+#include <optional>
+
+#include <Buddy.hpp>
+#include <TLSFAllocator.hpp>
+
+using namespace Terra;
+
+// Compares the buddy allocator with the TLSF allocator of the small allocation tier. Only the
+// offsets are managed, so no device is required.
+class AllocatorBenchmarkTest : public ::testing::Test
+{
+protected:
+	struct Allocation
+	{
+		size_t offset;
+		size_t size;
+		size_t alignment;
+	};
+
+	struct Result
+	{
+		double durationMS;
+		size_t requestedSize;
+		size_t reservedSize;
+		size_t failedCount;
+	};
+
+	struct AllocationRequest
+	{
+		size_t size;
+		size_t alignment;
+		bool   deallocate;
+		size_t deallocationIndex;
+	};
+
+protected:
+	static void SetUpTestSuite();
+
+	template<class Allocator_t>
+	[[nodiscard]]
+	static Result Run(Allocator_t& allocator, size_t regionSize);
+
+	static void PrintResult(const char* name, const Result& result);
+
+protected:
+	inline static std::vector<AllocationRequest> s_requests;
+
+	static constexpr size_t s_regionSize   = 64_MB;
+	static constexpr size_t s_requestCount = 200'000u;
+};
+
+void AllocatorBenchmarkTest::SetUpTestSuite()
+{
+	// Mostly the sizes of the small buffers, like the per pipeline data and the counters, with
+	// some larger ones in between.
+	std::mt19937_64 generator{ 42u };
+	std::uniform_int_distribution<size_t> smallSizes{ 4u, 512u };
+	std::uniform_int_distribution<size_t> largeSizes{ 1_KB, 16_KB };
+	std::uniform_int_distribution<size_t> alignmentShifts{ 2u, 8u };
+	std::uniform_int_distribution<size_t> percentages{ 0u, 99u };
+
+	s_requests.reserve(s_requestCount);
+
+	size_t liveCount = 0u;
+
+	for (size_t index = 0u; index < s_requestCount; ++index)
+	{
+		const bool deallocate = liveCount && percentages(generator) < 45u;
+
+		if (deallocate)
+		{
+			std::uniform_int_distribution<size_t> liveIndices{ 0u, liveCount - 1u };
+
+			s_requests.emplace_back(
+				AllocationRequest{
+					.size = 0u, .alignment = 0u, .deallocate = true,
+					.deallocationIndex = liveIndices(generator)
+				}
+			);
+
+			--liveCount;
+		}
+		else
+		{
+			const size_t size = percentages(generator) < 90u ?
+				smallSizes(generator) : largeSizes(generator);
+
+			s_requests.emplace_back(
+				AllocationRequest{
+					.size       = size,
+					.alignment  = size_t{ 1u } << alignmentShifts(generator),
+					.deallocate = false, .deallocationIndex = 0u
+				}
+			);
+
+			++liveCount;
+		}
+	}
+}
+
+template<class Allocator_t>
+AllocatorBenchmarkTest::Result AllocatorBenchmarkTest::Run(
+	Allocator_t& allocator, size_t regionSize
+) {
+	std::vector<Allocation> liveAllocations{};
+	liveAllocations.reserve(s_requestCount);
+
+	size_t failedCount = 0u;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (const AllocationRequest& request : s_requests)
+	{
+		if (request.deallocate)
+		{
+			if (std::empty(liveAllocations))
+				continue;
+
+			const size_t deallocationIndex
+				= std::min(request.deallocationIndex, std::size(liveAllocations) - 1u);
+
+			const Allocation allocation = liveAllocations[deallocationIndex];
+
+			if constexpr (std::is_same_v<Allocator_t, TLSFAllocator>)
+				allocator.Deallocate(allocation.offset);
+			else
+				allocator.Deallocate(allocation.offset, allocation.size, allocation.alignment);
+
+			liveAllocations[deallocationIndex] = liveAllocations.back();
+			liveAllocations.pop_back();
+		}
+		else
+		{
+			std::optional<size_t> offset = allocator.AllocateN(request.size, request.alignment);
+
+			if (offset)
+				liveAllocations.emplace_back(
+					Allocation{
+						.offset = offset.value(), .size = request.size,
+						.alignment = request.alignment
+					}
+				);
+			else
+				++failedCount;
+		}
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+
+	size_t requestedSize = 0u;
+
+	for (const Allocation& allocation : liveAllocations)
+		requestedSize += allocation.size;
+
+	return Result{
+		.durationMS    = std::chrono::duration<double, std::milli>{ end - start }.count(),
+		.requestedSize = requestedSize,
+		.reservedSize  = regionSize - allocator.AvailableSize(),
+		.failedCount   = failedCount
+	};
+}
+
+void AllocatorBenchmarkTest::PrintResult(const char* name, const Result& result)
+{
+	const double wastePercentage = result.requestedSize ?
+		100.0 * static_cast<double>(result.reservedSize - result.requestedSize)
+		/ static_cast<double>(result.reservedSize) : 0.0;
+
+	std::cout << name << ": " << result.durationMS << "ms, requested " << result.requestedSize
+		<< " bytes, reserved " << result.reservedSize << " bytes, internal waste "
+		<< wastePercentage << "%, failed " << result.failedCount << '\n';
+}
+
+TEST_F(AllocatorBenchmarkTest, BuddyVsTLSFTest)
+{
+	Callisto::Buddy buddyAllocator{ 0u, s_regionSize, 256_B };
+
+	const Result buddyResult = Run(buddyAllocator, s_regionSize);
+
+	TLSFAllocator tlsfAllocator{};
+	tlsfAllocator.AddRegion(0u, s_regionSize);
+
+	const Result tlsfResult = Run(tlsfAllocator, s_regionSize);
+
+	PrintResult("Buddy", buddyResult);
+	PrintResult("TLSF", tlsfResult);
+
+	EXPECT_EQ(buddyResult.failedCount, 0u) << "Buddy allocations failed.";
+	EXPECT_EQ(tlsfResult.failedCount, 0u) << "TLSF allocations failed.";
+	EXPECT_EQ(buddyResult.requestedSize, tlsfResult.requestedSize)
+		<< "The allocators didn't run the same workload.";
+	EXPECT_LT(tlsfResult.reservedSize, buddyResult.reservedSize)
+		<< "TLSF is wasting more memory than the buddy allocator.";
+}
@@ -1,9 +1,11 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <vector>
 
 #include <VKInstanceManager.hpp>
 #include <VkDeviceManager.hpp>
 #include <VkResources.hpp>
+#include <TLSFAllocator.hpp>
 
 using namespace Terra;
 
@@ -66,3 +68,116 @@ TEST_F(AllocatorTest, VkAllocatorTest)
 		EXPECT_EQ(buffer.BufferSize(), 1_KB) << "BufferSize doesn't match.";
 	}
 }
+
+TEST_F(AllocatorTest, SmallAllocationTierTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	MemoryManager memoryManager{ physicalDevice, logicalDevice, 2_MB, 200_KB };
+
+	constexpr VkMemoryPropertyFlagBits memoryType = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+	{
+		std::vector<Buffer> buffers{};
+
+		for (size_t index = 0u; index < 64u; ++index)
+		{
+			Buffer& buffer = buffers.emplace_back(logicalDevice, &memoryManager, memoryType);
+			buffer.Create(16u, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, {});
+		}
+
+		const MemoryFragmentationReport report = memoryManager.GetFragmentationReport(memoryType);
+
+		EXPECT_EQ(report.smallTierSize, VkAllocator::s_smallTierPageSize)
+			<< "The small buffers weren't sub-allocated from a single page.";
+		EXPECT_GE(report.reservedSize, report.requestedSize)
+			<< "Reserved size is smaller than the requested size.";
+		// The buddy allocator would have wasted at least 240 bytes on each of them.
+		EXPECT_LT(report.InternalWaste(), 64u * TLSFAllocator::s_granularity)
+			<< "The small allocations are wasting more than the granularity.";
+	}
+
+	const MemoryFragmentationReport report = memoryManager.GetFragmentationReport(memoryType);
+
+	EXPECT_EQ(report.requestedSize, 0u) << "Requested size isn't 0 after deallocation.";
+	EXPECT_EQ(report.reservedSize, 0u) << "Reserved size isn't 0 after deallocation.";
+	EXPECT_EQ(report.smallTierAvailableSize, report.smallTierSize)
+		<< "The small tier page isn't fully free.";
+}
+
+TEST_F(AllocatorTest, HeapBudgetTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	MemoryManager memoryManager{ physicalDevice, logicalDevice, 2_MB, 200_KB };
+
+	constexpr VkMemoryPropertyFlagBits memoryType = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+	memoryManager.SetGrowthPolicy(
+		memoryType,
+		MemoryManager::GrowthPolicy{
+			.minimumSize           = 4_MB,
+			.maximumSize           = 8_MB,
+			.growthFactor          = 2.f,
+			.maximumBudgetFraction = 0.5f
+		}
+	);
+
+	// Larger than the initial budget, so a new allocation is required.
+	Buffer buffer{ logicalDevice, &memoryManager, memoryType };
+	buffer.Create(3_MB, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, {});
+
+	const std::vector<MemoryManager::HeapBudget> heapBudgets = memoryManager.GetHeapBudgets();
+
+	ASSERT_FALSE(std::empty(heapBudgets)) << "No heap budgets were found.";
+
+	VkDeviceSize allocatedSize = 0u;
+
+	for (const MemoryManager::HeapBudget& heapBudget : heapBudgets)
+	{
+		EXPECT_GE(heapBudget.usage, heapBudget.allocatedSize)
+			<< "The process usage is smaller than the allocated size.";
+
+		allocatedSize += heapBudget.allocatedSize;
+	}
+
+	// 200KB of CPU memory, 2MB and then 4MB of GPU memory, as the 3MB buffer rounds up to the
+	// minimum size of the policy.
+	EXPECT_EQ(allocatedSize, 200_KB + 2_MB + 4_MB) << "The allocated sizes don't match.";
+}
+
+TEST(TLSFAllocatorTest, AllocationTest)
+{
+	TLSFAllocator allocator{};
+	allocator.AddRegion(0u, 1_KB);
+
+	EXPECT_EQ(allocator.AvailableSize(), 1_KB) << "Available size doesn't match.";
+
+	std::optional<size_t> first = allocator.AllocateN(4u, 4u);
+	ASSERT_TRUE(first.has_value()) << "First allocation failed.";
+	EXPECT_EQ(first.value(), 0u) << "First allocation isn't at the start.";
+	EXPECT_EQ(allocator.AllocatedSize(), TLSFAllocator::s_granularity)
+		<< "Allocation wasn't rounded up to the granularity.";
+
+	std::optional<size_t> second = allocator.AllocateN(100u, 256u);
+	ASSERT_TRUE(second.has_value()) << "Second allocation failed.";
+	EXPECT_EQ(second.value() % 256u, 0u) << "Second allocation isn't aligned.";
+
+	EXPECT_FALSE(allocator.AllocateN(2_KB, 16u).has_value())
+		<< "Allocation larger than the region succeeded.";
+
+	EXPECT_FALSE(allocator.Deallocate(first.value()).has_value())
+		<< "Region was reported free with a live allocation.";
+
+	std::optional<TLSFAllocator::Region> freeRegion = allocator.Deallocate(second.value());
+	ASSERT_TRUE(freeRegion.has_value()) << "Region wasn't reported free.";
+	EXPECT_EQ(freeRegion->size, 1_KB) << "Free blocks weren't merged.";
+	EXPECT_EQ(allocator.LargestFreeBlockSize(), 1_KB) << "Largest free block doesn't match.";
+
+	allocator.RemoveRegion(freeRegion->start);
+
+	EXPECT_EQ(allocator.TotalSize(), 0u) << "Region wasn't removed.";
+	EXPECT_EQ(allocator.RegionCount(), 0u) << "Region count isn't 0.";
+}
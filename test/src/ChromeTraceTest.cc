@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include <ChromeTrace.hpp>
+
+TEST(ChromeTraceTest, SerialiseTest)
+{
+	ChromeTrace trace{};
+
+	trace.SetThreadName(0u, 2u, "Graphics Queue");
+	trace.SetThreadName(0u, 2u, "Graphics");
+
+	trace.AddEvent(
+		ChromeTrace::Event{
+			.name                 = "DrawingStage",
+			.category             = "GPU",
+			.startMicroseconds    = 1.5,
+			.durationMicroseconds = 250.25,
+			.processID            = 0u,
+			.threadID             = 2u
+		}
+	);
+	trace.AddEvent(
+		ChromeTrace::Event{
+			.name                 = "Pass \"1\"\\\n",
+			.category             = "GPU",
+			.startMicroseconds    = 0.0,
+			.durationMicroseconds = 1.0,
+			.processID            = 0u,
+			.threadID             = 2u
+		}
+	);
+
+	EXPECT_EQ(trace.GetEventCount(), 2u) << "The event count is wrong.";
+
+	const std::string serialisedTrace = trace.Serialise();
+
+	EXPECT_NE(
+		serialisedTrace.find(
+			"{\"name\":\"DrawingStage\",\"cat\":\"GPU\",\"ph\":\"X\",\"ts\":1.500,"
+			"\"dur\":250.250,\"pid\":0,\"tid\":2}"
+		), std::string::npos
+	) << "The event wasn't written.";
+	EXPECT_NE(serialisedTrace.find("\"name\":\"Pass \\\"1\\\"\\\\\\u000a\""), std::string::npos)
+		<< "The name wasn't escaped.";
+	EXPECT_NE(serialisedTrace.find("\"args\":{\"name\":\"Graphics\"}"), std::string::npos)
+		<< "The thread name wasn't replaced.";
+	EXPECT_EQ(serialisedTrace.find("Graphics Queue"), std::string::npos)
+		<< "The old thread name was written.";
+
+	trace.Clear();
+
+	EXPECT_EQ(trace.GetEventCount(), 0u) << "The events weren't cleared.";
+	EXPECT_NE(trace.Serialise().find("thread_name"), std::string::npos)
+		<< "The thread names should be kept.";
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include <CpuTracer.hpp>
+
+TEST(CpuTracerTest, ThreadZoneTest)
+{
+	CpuTracer tracer{};
+
+	{
+		const CpuTraceZone zone{ tracer, "MainThreadZone" };
+	}
+
+	std::thread workerThread{ [&tracer]
+		{
+			const CpuTraceZone zone{ tracer, "WorkerThreadZone" };
+		}
+	};
+
+	workerThread.join();
+
+	EXPECT_EQ(tracer.GetThreadCount(), 2u) << "Each thread should have its own buffer.";
+
+	ChromeTrace trace{};
+
+	tracer.AddToTrace(trace, 1u);
+
+	const std::vector<ChromeTrace::Event>& events = trace.GetEvents();
+
+	ASSERT_EQ(std::size(events), 2u) << "The zone count is wrong.";
+
+	EXPECT_EQ(events[0].name, "MainThreadZone") << "The zone name is wrong.";
+	EXPECT_EQ(events[0].threadID, 0u) << "The main thread's ID is wrong.";
+	EXPECT_EQ(events[1].name, "WorkerThreadZone") << "The zone name is wrong.";
+	EXPECT_EQ(events[1].threadID, 1u) << "The worker thread's ID is wrong.";
+	EXPECT_EQ(events[1].processID, 1u) << "The process ID is wrong.";
+	EXPECT_GE(events[1].durationMicroseconds, 0.0) << "The duration is wrong.";
+}
+
+TEST(CpuTracerTest, RingBufferTest)
+{
+	CpuTracer tracer{};
+
+	constexpr size_t extraZoneCount = 10u;
+	constexpr size_t zoneCount      = CpuTracer::s_zonesPerThread + extraZoneCount;
+
+	for (size_t index = 0u; index < zoneCount; ++index)
+		tracer.AddZone("Zone", index * 1'000u, index * 1'000u + 500u);
+
+	ChromeTrace trace{};
+
+	tracer.AddToTrace(trace, 0u);
+
+	const std::vector<ChromeTrace::Event>& events = trace.GetEvents();
+
+	ASSERT_EQ(std::size(events), CpuTracer::s_zonesPerThread)
+		<< "Only the last zones should be kept.";
+
+	EXPECT_DOUBLE_EQ(events.front().startMicroseconds, static_cast<double>(extraZoneCount))
+		<< "The oldest zones weren't overwritten.";
+	EXPECT_DOUBLE_EQ(events.back().startMicroseconds, static_cast<double>(zoneCount - 1u))
+		<< "The newest zone is wrong.";
+	EXPECT_DOUBLE_EQ(events.back().durationMicroseconds, 0.5) << "The duration is wrong.";
+}
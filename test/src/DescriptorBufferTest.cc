@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <vector>
+#include <cstring>
 
 #include <VKInstanceManager.hpp>
 #include <VkDeviceManager.hpp>
@@ -299,3 +301,59 @@ TEST_F(DescriptorBufferTest, DescriptorBufferRecreationTest)
 		}
 	}
 }
+
+TEST_F(DescriptorBufferTest, VariableDescriptorCountTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	{
+		MemoryManager memoryManager{ physicalDevice, logicalDevice, 20_MB, 200_KB };
+
+		VkDescriptorBuffer descBuffer{ logicalDevice, &memoryManager, Constants::setCount };
+
+		descBuffer.SetDescriptorBufferInfo(physicalDevice);
+		descBuffer.AddBinding(
+			0u, 1u, VK_DESCRIPTOR_TYPE_SAMPLER, 64u, VK_SHADER_STAGE_FRAGMENT_BIT,
+			VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+			| VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT
+		);
+		descBuffer.SetVariableDescriptorCount(1u, 2u);
+
+		// No buffer has been created yet, so there is nothing to retire.
+		EXPECT_FALSE(descBuffer.HasRetiredBuffers());
+
+		descBuffer.CreateBuffer();
+
+		VkSamplerCreateInfoBuilder samplerCreateInfo{};
+
+		VKSampler sampler{ logicalDevice };
+		sampler.Create(samplerCreateInfo);
+
+		descBuffer.SetSamplerDescriptor(sampler, 0u, 1u, 1u);
+
+		const size_t descriptorSize
+			= VkDescriptorBuffer::GetDescriptorSize<VK_DESCRIPTOR_TYPE_SAMPLER>();
+
+		std::vector<std::uint8_t> oldDescriptor(descriptorSize, 0u);
+
+		memcpy(
+			std::data(oldDescriptor), descBuffer.GetSamplerDescriptor(0u, 1u, 1u), descriptorSize
+		);
+
+		descBuffer.SetVariableDescriptorCount(1u, 4u);
+
+		// The old buffer could still be used by the frames in flight.
+		EXPECT_TRUE(descBuffer.HasRetiredBuffers());
+		EXPECT_EQ(
+			memcmp(
+				std::data(oldDescriptor), descBuffer.GetSamplerDescriptor(0u, 1u, 1u),
+				descriptorSize
+			), 0
+		) << "The descriptor wasn't copied to the new buffer.";
+
+		descBuffer.ReleaseRetiredBuffers();
+
+		EXPECT_FALSE(descBuffer.HasRetiredBuffers());
+	}
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <MeshBundle.hpp>
+#include <FrustumCuller.hpp>
+
+using namespace Terra;
+
+namespace
+{
+struct FakeMeshBundle
+{
+	const MeshTemporaryDetailsVS& GetMeshDetails([[maybe_unused]] size_t index) const noexcept
+	{
+		return meshDetails;
+	}
+
+	MeshTemporaryDetailsVS meshDetails;
+};
+
+static Frustum GetTestFrustum() noexcept
+{
+	using namespace DirectX;
+
+	Camera camera{};
+
+	camera.SetProjectionMatrix(XMMatrixPerspectiveFovLH(XM_PIDIV4, 1.f, 0.1f, 100.f));
+	camera.SetViewMatrix(XMMatrixLookAtLH(
+		XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f),
+		XMVectorSet(0.f, 1.f, 0.f, 0.f)
+	));
+
+	return camera.GetViewFrustum(camera.GetViewMatrix());
+}
+
+static const AxisAlignedBoundingBox unitBox
+{
+	.maxAxes = DirectX::XMFLOAT4{ 1.f, 1.f, 1.f, 1.f },
+	.minAxes = DirectX::XMFLOAT4{ -1.f, -1.f, -1.f, 1.f }
+};
+}
+
+TEST(FrustumCullerTest, IsInFrustumTest)
+{
+	using namespace DirectX;
+
+	FrustumCuller frustumCuller{ nullptr };
+
+	frustumCuller.SetFrustum(GetTestFrustum());
+
+	const XMMATRIX identity = XMMatrixIdentity();
+
+	EXPECT_TRUE(frustumCuller.IsInFrustum(unitBox, identity, XMFLOAT3{ 0.f, 0.f, 10.f }))
+		<< "The box in front of the camera was culled.";
+	EXPECT_FALSE(frustumCuller.IsInFrustum(unitBox, identity, XMFLOAT3{ 0.f, 0.f, -10.f }))
+		<< "The box behind the camera wasn't culled.";
+	EXPECT_FALSE(frustumCuller.IsInFrustum(unitBox, identity, XMFLOAT3{ 50.f, 0.f, 10.f }))
+		<< "The box on the right of the frustum wasn't culled.";
+	EXPECT_FALSE(frustumCuller.IsInFrustum(unitBox, identity, XMFLOAT3{ 0.f, 0.f, 200.f }))
+		<< "The box beyond the far plane wasn't culled.";
+	// Only a corner of the box is inside.
+	EXPECT_TRUE(frustumCuller.IsInFrustum(unitBox, identity, XMFLOAT3{ 5.f, 0.f, 10.f }))
+		<< "The box intersecting the frustum was culled.";
+	// The box is moved in front by the model matrix.
+	EXPECT_TRUE(frustumCuller.IsInFrustum(
+		unitBox, XMMatrixTranslation(0.f, 0.f, 20.f), XMFLOAT3{ 0.f, 0.f, -10.f }
+	)) << "The model matrix wasn't applied.";
+}
+
+TEST(FrustumCullerTest, CullModelsTest)
+{
+	ThreadPool threadPool{ 2u };
+
+	FrustumCuller frustumCuller{ &threadPool };
+
+	frustumCuller.SetFrustum(GetTestFrustum());
+
+	FakeMeshBundle meshBundle{};
+	meshBundle.meshDetails.aabb = unitBox;
+
+	ModelContainer modelContainer{};
+	std::vector<std::uint32_t> modelIndices{};
+
+	// Every other model is behind the camera. Enough to have multiple chunks.
+	constexpr size_t modelCount = 5000u;
+
+	for (size_t index = 0u; index < modelCount; ++index)
+	{
+		Model model{};
+
+		model.GetTransform().MoveTowardsZ(index % 2u ? -10.f : 10.f);
+
+		modelIndices.emplace_back(modelContainer.AddModel(std::move(model)));
+	}
+
+	// An invisible model in the frustum should stay invisible.
+	modelContainer.GetModel(0u).SetVisibility(false);
+
+	frustumCuller.Reset(modelContainer.GetModelCount());
+	frustumCuller.CullModels(modelContainer, modelIndices, meshBundle);
+	frustumCuller.Wait();
+
+	const std::vector<std::uint8_t>& visibilities = frustumCuller.GetModelVisibilities();
+
+	ASSERT_EQ(std::size(visibilities), modelCount) << "The visibility count is wrong.";
+
+	EXPECT_EQ(visibilities[0u], 0u) << "The invisible model was drawn.";
+
+	for (size_t index = 1u; index < modelCount; ++index)
+		EXPECT_EQ(visibilities[index], index % 2u ? 0u : 1u)
+			<< "The model " << index << " wasn't culled correctly.";
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include <MeshletCuller.hpp>
+
+using namespace Terra;
+
+namespace
+{
+static Frustum GetTestFrustum() noexcept
+{
+	using namespace DirectX;
+
+	Camera camera{};
+
+	camera.SetProjectionMatrix(XMMatrixPerspectiveFovLH(XM_PIDIV4, 1.f, 0.1f, 100.f));
+	camera.SetViewMatrix(XMMatrixLookAtLH(
+		XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f),
+		XMVectorSet(0.f, 1.f, 0.f, 0.f)
+	));
+
+	return camera.GetViewFrustum(camera.GetViewMatrix());
+}
+
+// A unit sphere split into a latitude and longitude grid, where each cell is a meshlet. The poles
+// are on the Y axis, so half of the columns are facing a camera on the Z axis.
+static std::vector<MeshletDetails> GetSphereMeshlets(
+	std::uint32_t columnCount, std::uint32_t rowCount
+) noexcept {
+	using namespace DirectX;
+
+	auto getPoint = [](float theta, float phi) -> XMVECTOR
+	{
+		return XMVectorSet(
+			std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta), 0.f
+		);
+	};
+
+	std::vector<MeshletDetails> meshletDetails{};
+
+	for (std::uint32_t row = 0u; row < rowCount; ++row)
+		for (std::uint32_t column = 0u; column < columnCount; ++column)
+		{
+			const float thetaStart = XM_2PI * column / columnCount;
+			const float thetaEnd   = XM_2PI * (column + 1u) / columnCount;
+			const float phiStart   = XM_PI * row / rowCount;
+			const float phiEnd     = XM_PI * (row + 1u) / rowCount;
+
+			// On a unit sphere, the normals are the same as the points.
+			const XMVECTOR corners[]
+			{
+				getPoint(thetaStart, phiStart), getPoint(thetaEnd, phiStart),
+				getPoint(thetaStart, phiEnd), getPoint(thetaEnd, phiEnd)
+			};
+
+			const XMVECTOR axis = XMVector3Normalize(
+				getPoint((thetaStart + thetaEnd) * 0.5f, (phiStart + phiEnd) * 0.5f)
+			);
+
+			float minDot  = 1.f;
+			float maxDist = 0.f;
+
+			for (const XMVECTOR& corner : corners)
+			{
+				minDot  = std::min(minDot, XMVectorGetX(XMVector3Dot(axis, corner)));
+				maxDist = std::max(
+					maxDist, XMVectorGetX(XMVector3Length(XMVectorSubtract(corner, axis)))
+				);
+			}
+
+			// The cutoff is the sine of the half angle, which is the cosine of the complement.
+			const float cutoff = std::sqrt(std::max(0.f, 1.f - minDot * minDot));
+
+			XMFLOAT3 axisF{};
+			XMStoreFloat3(&axisF, axis);
+
+			MeshletDetails details{};
+
+			details.sphereB.sphere        = XMFLOAT4{ axisF.x, axisF.y, axisF.z, maxDist };
+			details.coneNormal.packedCone = MeshletCuller::PackCone(axisF, cutoff);
+			details.coneNormal.apexOffset = 0.f;
+
+			meshletDetails.emplace_back(details);
+		}
+
+	return meshletDetails;
+}
+}
+
+TEST(MeshletCullerTest, PackConeTest)
+{
+	using namespace DirectX;
+
+	const std::uint32_t packedCone = MeshletCuller::PackCone(XMFLOAT3{ 0.f, 0.f, -1.f }, 0.5f);
+
+	const XMVECTOR cone = MeshletCuller::UnpackCone(packedCone);
+
+	EXPECT_NEAR(XMVectorGetX(cone), 0.f, 0.01f) << "The axis wasn't unpacked correctly.";
+	EXPECT_NEAR(XMVectorGetY(cone), 0.f, 0.01f) << "The axis wasn't unpacked correctly.";
+	EXPECT_NEAR(XMVectorGetZ(cone), -1.f, 0.01f) << "The axis wasn't unpacked correctly.";
+	EXPECT_GE(XMVectorGetW(cone), 0.5f) << "The cutoff wasn't rounded up.";
+
+	EXPECT_FALSE(MeshletCuller::IsConeDegenerate(packedCone))
+		<< "The cone was marked as degenerate.";
+	EXPECT_TRUE(
+		MeshletCuller::IsConeDegenerate(MeshletCuller::PackCone(XMFLOAT3{ 0.f, 0.f, 1.f }, 1.f))
+	) << "The cone with a full cutoff wasn't marked as degenerate.";
+}
+
+TEST(MeshletCullerTest, ConeCullingTest)
+{
+	using namespace DirectX;
+
+	MeshletCuller meshletCuller{};
+
+	meshletCuller.SetFrustum(GetTestFrustum());
+	meshletCuller.SetViewPosition(XMFLOAT3{ 0.f, 0.f, 0.f });
+
+	constexpr std::uint32_t columnCount  = 32u;
+	constexpr std::uint32_t rowCount     = 16u;
+	constexpr std::uint32_t meshletCount = columnCount * rowCount;
+
+	const std::vector<MeshletDetails> meshletDetails = GetSphereMeshlets(columnCount, rowCount);
+
+	const XMMATRIX identity = XMMatrixIdentity();
+
+	// The closed mesh is viewed from one side, so about half of the meshlets should be emitted.
+	// The cones are conservative, so the ones on the silhouette are kept.
+	const std::uint32_t visibleCount = meshletCuller.GetVisibleMeshletCount(
+		meshletDetails, 0u, meshletCount, identity, XMFLOAT3{ 0.f, 0.f, 10.f }
+	);
+
+	EXPECT_GE(visibleCount, meshletCount * 4u / 10u) << "Too many meshlets were culled.";
+	EXPECT_LE(visibleCount, meshletCount * 6u / 10u) << "Not enough meshlets were culled.";
+
+	// The meshlet facing the camera must be kept and the one on the far side must be culled.
+	const std::uint32_t middleRow = rowCount / 2u;
+	// The theta of the column 24 is 3PI/2, which faces -Z.
+	const MeshletDetails& frontMeshlet = meshletDetails[middleRow * columnCount + 24u];
+	const MeshletDetails& backMeshlet  = meshletDetails[middleRow * columnCount + 8u];
+
+	EXPECT_TRUE(meshletCuller.IsMeshletVisible(frontMeshlet, identity, XMFLOAT3{ 0.f, 0.f, 10.f }))
+		<< "The meshlet facing the camera was culled.";
+	EXPECT_FALSE(meshletCuller.IsMeshletVisible(backMeshlet, identity, XMFLOAT3{ 0.f, 0.f, 10.f }))
+		<< "The back facing meshlet wasn't culled.";
+
+	// Scaling the mesh shouldn't change which side is facing the camera.
+	EXPECT_FALSE(meshletCuller.IsMeshletVisible(
+		backMeshlet, XMMatrixScaling(2.f, 2.f, 2.f), XMFLOAT3{ 0.f, 0.f, 20.f }
+	)) << "The back facing meshlet of the scaled mesh wasn't culled.";
+}
+
+TEST(MeshletCullerTest, FrustumCullingTest)
+{
+	using namespace DirectX;
+
+	MeshletCuller meshletCuller{};
+
+	meshletCuller.SetFrustum(GetTestFrustum());
+	meshletCuller.SetViewPosition(XMFLOAT3{ 0.f, 0.f, 0.f });
+
+	constexpr std::uint32_t columnCount  = 32u;
+	constexpr std::uint32_t rowCount     = 16u;
+	constexpr std::uint32_t meshletCount = columnCount * rowCount;
+
+	const std::vector<MeshletDetails> meshletDetails = GetSphereMeshlets(columnCount, rowCount);
+
+	const XMMATRIX identity = XMMatrixIdentity();
+
+	EXPECT_EQ(
+		meshletCuller.GetVisibleMeshletCount(
+			meshletDetails, 0u, meshletCount, identity, XMFLOAT3{ 0.f, 0.f, -10.f }
+		), 0u
+	) << "The meshlets behind the camera weren't culled.";
+	EXPECT_EQ(
+		meshletCuller.GetVisibleMeshletCount(
+			meshletDetails, 0u, meshletCount, identity, XMFLOAT3{ 50.f, 0.f, 10.f }
+		), 0u
+	) << "The meshlets on the right of the frustum weren't culled.";
+
+	// The sphere is only partly inside the frustum, so the meshlets on the right side of the
+	// mesh are culled as well.
+	const std::uint32_t partialCount = meshletCuller.GetVisibleMeshletCount(
+		meshletDetails, 0u, meshletCount, identity, XMFLOAT3{ 4.5f, 0.f, 10.f }
+	);
+	const std::uint32_t wholeCount   = meshletCuller.GetVisibleMeshletCount(
+		meshletDetails, 0u, meshletCount, identity, XMFLOAT3{ 0.f, 0.f, 10.f }
+	);
+
+	EXPECT_GT(partialCount, 0u) << "The meshlets in the frustum were culled.";
+	EXPECT_LT(partialCount, wholeCount) << "The meshlets outside of the frustum weren't culled.";
+}
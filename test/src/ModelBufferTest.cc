@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#include <VKInstanceManager.hpp>
+#include <VkDeviceManager.hpp>
+#include <VkModelBuffer.hpp>
+
+using namespace Terra;
+
+namespace Constants
+{
+	constexpr const char* appName      = "TerraTest";
+	constexpr std::uint32_t frameCount = 2u;
+}
+
+class ModelBufferTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite();
+	static void TearDownTestSuite();
+
+protected:
+	inline static std::unique_ptr<VkInstanceManager> s_instanceManager;
+	inline static std::unique_ptr<VkDeviceManager>   s_deviceManager;
+};
+
+void ModelBufferTest::SetUpTestSuite()
+{
+	const CoreVersion coreVersion = CoreVersion::V1_3;
+
+	s_instanceManager = std::make_unique<VkInstanceManager>(Constants::appName);
+	s_instanceManager->DebugLayers().AddDebugCallback(DebugCallbackType::StandardError);
+	s_instanceManager->CreateInstance(coreVersion);
+
+	VkInstance vkInstance = s_instanceManager->GetVKInstance();
+
+	s_deviceManager = std::make_unique<VkDeviceManager>();
+
+	{
+		VkDeviceExtensionManager& extensionManager = s_deviceManager->ExtensionManager();
+		extensionManager.AddExtensions(MemoryManager::GetRequiredExtensions());
+	}
+
+	s_deviceManager->SetDeviceFeatures(coreVersion)
+		.SetPhysicalDeviceAutomatic(vkInstance)
+		.CreateLogicalDevice();
+}
+
+void ModelBufferTest::TearDownTestSuite()
+{
+	s_deviceManager.reset();
+	s_instanceManager.reset();
+}
+
+TEST_F(ModelBufferTest, PendingFrameUpdatesTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	MemoryManager memoryManager{ physicalDevice, logicalDevice, 2_MB, 200_KB };
+
+	constexpr size_t modelCount = 8u;
+
+	auto modelContainer = std::make_shared<ModelContainer>();
+
+	{
+		std::vector<Model> models{};
+
+		for (size_t index = 0u; index < modelCount; ++index)
+			models.emplace_back(Model{});
+
+		const std::vector<std::uint32_t> modelIndices
+			= modelContainer->AddModels(std::move(models));
+
+		// The buffers are checked with the model indices, so they should be the same as the
+		// order of the models.
+		for (size_t index = 0u; index < modelCount; ++index)
+			ASSERT_EQ(modelIndices[index], index) << "The model indices aren't sequential.";
+	}
+
+	ModelBuffers modelBuffers{ logicalDevice, &memoryManager, Constants::frameCount, {} };
+
+	modelBuffers.SetModelContainer(modelContainer);
+	modelBuffers.ExtendModelBuffers();
+
+	// The new buffers don't have any data, so every model is written to every instance.
+	for (std::uint32_t frameIndex = 0u; frameIndex < Constants::frameCount; ++frameIndex)
+		modelBuffers.Update(static_cast<VkDeviceSize>(frameIndex));
+
+	for (size_t index = 0u; index < modelCount; ++index)
+		EXPECT_EQ(modelBuffers.GetPendingFrameUpdates(index), 0u)
+			<< "Every instance should have been written.";
+
+	constexpr size_t vertexStride      = ModelBuffers::GetVertexStride();
+	// The offset is after the model and the normal matrices.
+	constexpr size_t modelOffsetOffset = 2u * sizeof(DirectX::XMMATRIX);
+	constexpr std::uint8_t marker      = 0xFFu;
+
+	// The data of every model is overwritten with the marker, so a rewrite can be found.
+	const auto markInstances = [&modelBuffers]
+	{
+		for (std::uint32_t frameIndex = 0u; frameIndex < Constants::frameCount; ++frameIndex)
+			memset(
+				modelBuffers.GetVertexInstanceData(frameIndex), marker, vertexStride * modelCount
+			);
+	};
+
+	const auto isMarked = [&modelBuffers](std::uint32_t frameIndex, size_t modelIndex)
+	{
+		std::uint8_t const* modelData
+			= modelBuffers.GetVertexInstanceData(frameIndex) + modelIndex * vertexStride;
+
+		return std::all_of(
+			modelData, modelData + vertexStride,
+			[](std::uint8_t value) { return value == marker; }
+		);
+	};
+
+	markInstances();
+
+	const std::vector<size_t> modifiedModels{ 0u, 3u, 6u };
+
+	for (size_t modelIndex : modifiedModels)
+		modelContainer->GetModel(modelIndex).GetTransform().MoveTowardsX(
+			static_cast<float>(modelIndex + 1u)
+		);
+
+	for (std::uint32_t frameIndex = 0u; frameIndex < Constants::frameCount; ++frameIndex)
+	{
+		modelBuffers.Update(static_cast<VkDeviceSize>(frameIndex));
+
+		for (size_t modelIndex = 0u; modelIndex < modelCount; ++modelIndex)
+		{
+			const bool isModified = std::ranges::find(modifiedModels, modelIndex)
+				!= std::end(modifiedModels);
+
+			if (!isModified)
+			{
+				EXPECT_EQ(modelBuffers.GetPendingFrameUpdates(modelIndex), 0u);
+				EXPECT_TRUE(isMarked(frameIndex, modelIndex))
+					<< "The model " << modelIndex << " wasn't modified, so it shouldn't be "
+					<< "written.";
+
+				continue;
+			}
+
+			EXPECT_EQ(
+				modelBuffers.GetPendingFrameUpdates(modelIndex),
+				Constants::frameCount - frameIndex - 1u
+			) << "The model " << modelIndex << " should still be written to the other instances.";
+
+			DirectX::XMFLOAT3 modelOffset{};
+
+			memcpy(
+				&modelOffset,
+				modelBuffers.GetVertexInstanceData(frameIndex) + modelIndex * vertexStride
+				+ modelOffsetOffset, sizeof(DirectX::XMFLOAT3)
+			);
+
+			EXPECT_EQ(modelOffset.x, static_cast<float>(modelIndex + 1u))
+				<< "The model " << modelIndex << " wasn't written to the instance " << frameIndex;
+		}
+	}
+
+	// Every instance has the modified models now, so they shouldn't be written again.
+	markInstances();
+
+	for (std::uint32_t frameIndex = 0u; frameIndex < Constants::frameCount; ++frameIndex)
+	{
+		modelBuffers.Update(static_cast<VkDeviceSize>(frameIndex));
+
+		for (size_t modelIndex = 0u; modelIndex < modelCount; ++modelIndex)
+			EXPECT_TRUE(isMarked(frameIndex, modelIndex))
+				<< "The model " << modelIndex << " was written more than once to the instance "
+				<< frameIndex;
+	}
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <ModelContainer.hpp>
+
+TEST(ModelTest, ModifiedStateTest)
+{
+	Model model{};
+
+	EXPECT_TRUE(model.IsModified()) << "A new model should be modified.";
+
+	model.ResetModified();
+
+	EXPECT_FALSE(model.IsModified()) << "The modified state wasn't reset.";
+
+	model.GetTransform().MoveTowardsX(1.f);
+
+	EXPECT_TRUE(model.IsModified()) << "Moving didn't set the modified state.";
+
+	model.ResetModified();
+	model.GetMaterial().SetDiffuseIndex(2u);
+
+	EXPECT_TRUE(model.IsModified()) << "The material change didn't set the modified state.";
+
+	model.ResetModified();
+	model.SetMeshIndex(1u);
+
+	EXPECT_TRUE(model.IsModified()) << "The mesh index change didn't set the modified state.";
+
+	{
+		using namespace DirectX;
+
+		ModelTransform transform = model.GetTransform();
+
+		transform.Scale(2.f);
+
+		const XMMATRIX expectedNormalMatrix
+			= XMMatrixTranspose(XMMatrixInverse(nullptr, transform.GetModelMatrix()));
+
+		const XMMATRIX& normalMatrix = transform.GetNormalMatrix();
+
+		for (size_t index = 0u; index < 4u; ++index)
+			EXPECT_TRUE(XMVector4NearEqual(
+				normalMatrix.r[index], expectedNormalMatrix.r[index], XMVectorReplicate(1e-5f)
+			)) << "The cached normal matrix is wrong.";
+	}
+}
+
+TEST(ModelContainerTest, ModelHandleTest)
+{
+	ModelContainer modelContainer{};
+
+	{
+		Model model{};
+
+		model.SetMeshIndex(3u);
+		model.GetTransform().MoveTowardsY(2.f);
+		model.GetMaterial().SetSpecularIndex(5u);
+
+		const std::uint32_t modelIndex = modelContainer.AddModel(std::move(model));
+
+		EXPECT_EQ(modelIndex, 0u) << "The model index is wrong.";
+	}
+
+	EXPECT_EQ(modelContainer.GetMeshIndices()[0u], 3u) << "The mesh index wasn't stored.";
+	EXPECT_EQ(modelContainer.GetModelOffsets()[0u].y, 2.f) << "The offset wasn't stored.";
+	EXPECT_EQ(modelContainer.GetMaterials()[0u].specularIndex, 5u)
+		<< "The material wasn't stored.";
+	EXPECT_TRUE(modelContainer.IsInUse(0u)) << "The model isn't in use.";
+
+	// The handle should write into the arrays of the container.
+	{
+		Model model = modelContainer.GetModel(0u);
+
+		model.ResetModified();
+		model.SetVisibility(false);
+		model.GetTransform().MoveTowardsX(4.f);
+
+		EXPECT_TRUE(model.IsModified()) << "The handle didn't set the modified state.";
+	}
+
+	EXPECT_EQ(modelContainer.GetVisibilities()[0u], 0u) << "The visibility wasn't changed.";
+	EXPECT_EQ(modelContainer.GetModelOffsets()[0u].x, 4.f) << "The offset wasn't changed.";
+}
+
+TEST(ModelContainerTest, RemoveModelTest)
+{
+	ModelContainer modelContainer{};
+
+	{
+		std::vector<Model> models{};
+
+		for (size_t index = 0u; index < 4u; ++index)
+			models.emplace_back(Model{});
+
+		const std::vector<std::uint32_t> modelIndices
+			= modelContainer.AddModels(std::move(models));
+
+		EXPECT_EQ(std::size(modelIndices), 4u) << "The model count is wrong.";
+		EXPECT_EQ(modelContainer.GetModelCount(), 4u) << "The model count is wrong.";
+	}
+
+	modelContainer.RemoveModels({ 1u, 2u });
+
+	EXPECT_FALSE(modelContainer.IsInUse(1u)) << "The model wasn't removed.";
+	EXPECT_FALSE(modelContainer.IsInUse(2u)) << "The model wasn't removed.";
+	EXPECT_TRUE(modelContainer.IsInUse(3u)) << "The wrong model was removed.";
+
+	{
+		const std::uint32_t modelIndex = modelContainer.AddModel(Model{});
+
+		EXPECT_TRUE(modelIndex == 1u || modelIndex == 2u) << "The removed index wasn't reused.";
+		EXPECT_TRUE(modelContainer.IsInUse(modelIndex)) << "The new model isn't in use.";
+	}
+
+	EXPECT_EQ(modelContainer.GetModelCount(), 4u) << "The container shouldn't have grown.";
+}
@@ -102,7 +102,19 @@ TEST_F(ModelManagerTest, ModelManagerVSIndividualTest)
 	VKRenderPass renderPass{ logicalDevice };
 	renderPass.Create(RenderPassBuilder{});
 
-	ModelManagerVSIndividual vsIndividual{};
+	ModelManagerVSIndividual vsIndividual{ logicalDevice, &memoryManager, Constants::frameCount };
+
+	std::vector<VkDescriptorBuffer> descBuffersVS{};
+
+	for (size_t _ = 0u; _ < Constants::frameCount; ++_)
+		descBuffersVS.emplace_back(
+			VkDescriptorBuffer{ logicalDevice, &memoryManager, Constants::descSetLayoutCount }
+		);
+
+	vsIndividual.SetDescriptorBufferLayoutVS(descBuffersVS, Constants::vsSetLayoutIndex);
+
+	for (auto& descBuffer : descBuffersVS)
+		descBuffer.CreateBuffer();
 
 	MeshManagerVSIndividual vsIndividualMesh{
 		logicalDevice, &memoryManager, queueManager.GetAllIndices()
@@ -203,6 +215,38 @@ TEST_F(ModelManagerTest, ModelManagerVSIndividualTest)
 
 		EXPECT_EQ(index, 1u) << "Index isn't 1.";
 	}
+
+	// Every model is visible and uses the same mesh, so every pipeline should have a single
+	// draw with an instance for each of its models.
+	vsIndividual.UpdateDrawArguments(
+		0u, vsIndividualMesh, nullptr, descBuffersVS.front(), Constants::vsSetLayoutIndex
+	);
+
+	{
+		const std::optional<size_t> pipeline0LocalIndex = vsIndividual.GetPipelineLocalIndex(1u, 0u);
+		const std::optional<size_t> pipeline1LocalIndex = vsIndividual.GetPipelineLocalIndex(1u, 1u);
+
+		ASSERT_TRUE(pipeline0LocalIndex.has_value()) << "The pipeline 0 wasn't found.";
+		ASSERT_TRUE(pipeline1LocalIndex.has_value()) << "The pipeline 1 wasn't found.";
+
+		EXPECT_EQ(vsIndividual.GetDrawCount(1u, *pipeline0LocalIndex), 1u)
+			<< "The draw count of the pipeline 0 is wrong.";
+		EXPECT_EQ(vsIndividual.GetDrawCount(1u, *pipeline1LocalIndex), 1u)
+			<< "The draw count of the pipeline 1 is wrong.";
+
+		EXPECT_EQ(vsIndividual.GetInstanceCount(1u, *pipeline0LocalIndex), 7u)
+			<< "The instance count of the pipeline 0 is wrong.";
+		EXPECT_EQ(vsIndividual.GetInstanceCount(1u, *pipeline1LocalIndex), 5u)
+			<< "The instance count of the pipeline 1 is wrong.";
+	}
+
+	modelContainer->GetModel(0u).SetVisibility(false);
+
+	vsIndividual.UpdateDrawArguments(
+		0u, vsIndividualMesh, nullptr, descBuffersVS.front(), Constants::vsSetLayoutIndex
+	);
+
+	EXPECT_EQ(vsIndividual.GetDrawCount(0u, 0u), 0u) << "The invisible model was drawn.";
 }
 
 TEST_F(ModelManagerTest, ModelManagerVSIndirectTest)
@@ -231,6 +275,8 @@ TEST_F(ModelManagerTest, ModelManagerVSIndirectTest)
 		logicalDevice, &memoryManager, queueManager.GetAllIndices()
 	};
 
+	vsIndirect.SetDrawCountReadback(true);
+
 	std::vector<VkDescriptorBuffer> descBuffersVS{};
 	std::vector<VkDescriptorBuffer> descBuffersCS{};
 
@@ -428,6 +474,10 @@ TEST_F(ModelManagerTest, ModelManagerVSIndirectTest)
 		modelBundle->ChangeModelPipeline(4u, 2u, 1u);
 		vsIndirect.ReconfigureModels(index, 2u, 1u);
 	}
+
+	for (size_t frameIndex = 0u; frameIndex < Constants::frameCount; ++frameIndex)
+		EXPECT_EQ(vsIndirect.GetDrawCount(frameIndex), 0u)
+			<< "Nothing has been dispatched yet.";
 }
 
 TEST_F(ModelManagerTest, ModelManagerMS)
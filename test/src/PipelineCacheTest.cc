@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+#include <VKInstanceManager.hpp>
+#include <VkDeviceManager.hpp>
+#include <VkPipelineCache.hpp>
+#include <VkShader.hpp>
+
+using namespace Terra;
+
+namespace Constants
+{
+	constexpr const char* appName = "TerraTest";
+}
+
+class PipelineCacheTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite();
+	static void TearDownTestSuite();
+
+protected:
+	inline static std::unique_ptr<VkInstanceManager> s_instanceManager;
+	inline static std::unique_ptr<VkDeviceManager>   s_deviceManager;
+};
+
+void PipelineCacheTest::SetUpTestSuite()
+{
+	const CoreVersion coreVersion = CoreVersion::V1_3;
+
+	s_instanceManager = std::make_unique<VkInstanceManager>(Constants::appName);
+	s_instanceManager->DebugLayers().AddDebugCallback(DebugCallbackType::StandardError);
+	s_instanceManager->CreateInstance(coreVersion);
+
+	VkInstance vkInstance = s_instanceManager->GetVKInstance();
+
+	s_deviceManager = std::make_unique<VkDeviceManager>();
+
+	s_deviceManager->SetDeviceFeatures(coreVersion)
+		.SetPhysicalDeviceAutomatic(vkInstance)
+		.CreateLogicalDevice();
+}
+
+void PipelineCacheTest::TearDownTestSuite()
+{
+	s_deviceManager.reset();
+	s_instanceManager.reset();
+}
+
+TEST_F(PipelineCacheTest, InMemoryCacheTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	PipelineCache pipelineCache{ logicalDevice };
+	pipelineCache.Create(physicalDevice);
+
+	EXPECT_NE(pipelineCache.Get(), VK_NULL_HANDLE) << "The pipeline cache wasn't created.";
+	EXPECT_FALSE(pipelineCache.Save()) << "A cache without a directory shouldn't be saved.";
+	EXPECT_EQ(pipelineCache.GetHitCount(), 0u) << "The hit count should be zero.";
+	EXPECT_EQ(pipelineCache.GetMissCount(), 0u) << "The miss count should be zero.";
+}
+
+TEST_F(PipelineCacheTest, CacheFileTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	std::filesystem::path cacheFilePath{};
+
+	{
+		PipelineCache pipelineCache{ logicalDevice };
+		pipelineCache.Create(physicalDevice);
+		pipelineCache.LoadFromDirectory(L"");
+
+		cacheFilePath = pipelineCache.GetCacheFilePath();
+
+		EXPECT_TRUE(pipelineCache.Save()) << "The cache file wasn't written.";
+		EXPECT_TRUE(std::filesystem::exists(cacheFilePath)) << "The cache file doesn't exist.";
+	}
+
+	// The file written by the same device should be loaded.
+	{
+		PipelineCache pipelineCache{ logicalDevice };
+		pipelineCache.Create(physicalDevice);
+		pipelineCache.LoadFromDirectory(L"");
+
+		EXPECT_EQ(cacheFilePath, std::filesystem::path{ pipelineCache.GetCacheFilePath() })
+			<< "The cache file name should be the same on the same device.";
+		EXPECT_NE(pipelineCache.Get(), VK_NULL_HANDLE) << "The loaded cache wasn't created.";
+	}
+
+	std::filesystem::remove(cacheFilePath);
+}
+
+TEST_F(PipelineCacheTest, CacheDirectoryTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	const std::filesystem::path cacheDirectory
+		= std::filesystem::temp_directory_path() / L"TerraPipelineCacheTest";
+
+	std::filesystem::create_directories(cacheDirectory);
+
+	{
+		PipelineCache pipelineCache{ logicalDevice };
+		pipelineCache.Create(physicalDevice);
+		// Without a trailing separator.
+		pipelineCache.LoadFromDirectory(cacheDirectory.wstring());
+
+		const std::filesystem::path cacheFilePath{ pipelineCache.GetCacheFilePath() };
+
+		EXPECT_EQ(cacheFilePath.parent_path(), cacheDirectory)
+			<< "The cache file should be inside the directory.";
+		EXPECT_TRUE(pipelineCache.Save()) << "The cache file wasn't written.";
+		EXPECT_TRUE(std::filesystem::exists(cacheFilePath)) << "The cache file doesn't exist.";
+	}
+
+	std::filesystem::remove_all(cacheDirectory);
+}
+
+TEST_F(PipelineCacheTest, CorruptCacheFileTest)
+{
+	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
+	VkPhysicalDevice physicalDevice = s_deviceManager->GetPhysicalDevice();
+
+	std::filesystem::path cacheFilePath{};
+
+	{
+		PipelineCache pipelineCache{ logicalDevice };
+		pipelineCache.Create(physicalDevice);
+		pipelineCache.LoadFromDirectory(L"");
+
+		cacheFilePath = pipelineCache.GetCacheFilePath();
+
+		ASSERT_TRUE(pipelineCache.Save()) << "The cache file wasn't written.";
+	}
+
+	// The data size is the last member of the header, after the four ids and the UUID.
+	constexpr std::streamoff dataSizeOffset = sizeof(std::uint32_t) * 4u + VK_UUID_SIZE;
+	constexpr std::streamoff headerSize     = dataSizeOffset + sizeof(std::uint64_t);
+
+	const auto fileSize = static_cast<std::streamoff>(std::filesystem::file_size(cacheFilePath));
+
+	{
+		std::fstream cacheFile{
+			cacheFilePath, std::ios_base::binary | std::ios_base::in | std::ios_base::out
+		};
+
+		std::uint64_t dataSize = 0u;
+
+		cacheFile.seekg(dataSizeOffset);
+		cacheFile.read(reinterpret_cast<char*>(&dataSize), sizeof(std::uint64_t));
+
+		ASSERT_EQ(dataSize, static_cast<std::uint64_t>(fileSize - headerSize))
+			<< "The header layout has changed.";
+
+		// Way more than the file has, it shouldn't be allocated.
+		dataSize = std::numeric_limits<std::uint64_t>::max() / 2u;
+
+		cacheFile.seekp(dataSizeOffset);
+		cacheFile.write(reinterpret_cast<const char*>(&dataSize), sizeof(std::uint64_t));
+	}
+
+	{
+		PipelineCache pipelineCache{ logicalDevice };
+		pipelineCache.Create(physicalDevice);
+		pipelineCache.LoadFromDirectory(L"");
+
+		EXPECT_NE(pipelineCache.Get(), VK_NULL_HANDLE)
+			<< "An empty cache should be used instead of the corrupted one.";
+	}
+
+	std::filesystem::resize_file(cacheFilePath, static_cast<std::uintmax_t>(headerSize / 2));
+
+	{
+		PipelineCache pipelineCache{ logicalDevice };
+		pipelineCache.Create(physicalDevice);
+		pipelineCache.LoadFromDirectory(L"");
+
+		EXPECT_NE(pipelineCache.Get(), VK_NULL_HANDLE)
+			<< "An empty cache should be used instead of the truncated one.";
+	}
+
+	std::filesystem::remove(cacheFilePath);
+}
+
+TEST_F(PipelineCacheTest, ShaderModuleCacheTest)
+{
+	VkDevice logicalDevice = s_deviceManager->GetLogicalDevice();
+
+	ShaderModuleCache shaderModules{ logicalDevice };
+	shaderModules.SetShaderPath(L"NonExistentPath/");
+
+	VkShaderModule shaderModule = shaderModules.GetShaderModule(
+		ShaderName{ L"NonExistentShader" }, ShaderBinaryType::SPIRV
+	);
+
+	EXPECT_EQ(shaderModule, VK_NULL_HANDLE) << "A missing shader shouldn't have a module.";
+	EXPECT_EQ(shaderModules.GetShaderCount(), 0u) << "A missing shader shouldn't be cached.";
+	EXPECT_EQ(shaderModules.GetShaderPath(), L"NonExistentPath/") << "The shader path is wrong.";
+}
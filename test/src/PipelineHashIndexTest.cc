@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <PipelineHashIndex.hpp>
+#include <ExternalPipeline.hpp>
+
+TEST(PipelineHashIndexTest, ExternalPipelineHashTest)
+{
+	ExternalGraphicsPipeline pipeline1{ L"FragmentShader", L"VertexShader" };
+	ExternalGraphicsPipeline pipeline2{ L"FragmentShader", L"VertexShader" };
+
+	EXPECT_EQ(pipeline1.GetHash(), pipeline2.GetHash())
+		<< "The same pipelines have different hashes.";
+
+	pipeline2.EnableBackfaceCulling();
+
+	EXPECT_NE(pipeline1.GetHash(), pipeline2.GetHash()) << "The pipeline states weren't hashed.";
+
+	// The shader names shouldn't run into each other.
+	ExternalGraphicsPipeline pipeline3{ L"B", L"A" };
+	ExternalGraphicsPipeline pipeline4{ L"", L"AB" };
+
+	EXPECT_NE(pipeline3.GetHash(), pipeline4.GetHash()) << "The shader names weren't separated.";
+
+	ExternalComputePipeline computePipeline1{ L"ComputeShader" };
+	ExternalComputePipeline computePipeline2{ L"ComputeShader" };
+
+	EXPECT_EQ(computePipeline1.GetHash(), computePipeline2.GetHash())
+		<< "The same compute pipelines have different hashes.";
+}
+
+TEST(PipelineHashIndexTest, AddRemoveTest)
+{
+	PipelineHashIndex hashIndex{};
+
+	std::vector<std::uint64_t> hashes{};
+
+	// Everything goes in the same bucket, so the probing is tested as well.
+	for (std::uint32_t index = 0u; index < 100u; ++index)
+	{
+		hashes.emplace_back(static_cast<std::uint64_t>(index) << 32u);
+
+		hashIndex.Add(hashes[index], index);
+	}
+
+	EXPECT_EQ(hashIndex.GetEntryCount(), 100u) << "The entry count is wrong.";
+
+	for (std::uint32_t index = 0u; index < 100u; ++index)
+	{
+		std::optional<std::uint32_t> oPipelineIndex = hashIndex.Find(
+			hashes[index], [index](std::uint32_t pipelineIndex) { return pipelineIndex == index; }
+		);
+
+		ASSERT_TRUE(oPipelineIndex) << "Pipeline " << index << " wasn't found.";
+		EXPECT_EQ(oPipelineIndex.value(), index) << "The pipeline index is wrong.";
+	}
+
+	for (std::uint32_t index = 0u; index < 100u; index += 2u)
+		hashIndex.Remove(hashes[index], index);
+
+	EXPECT_EQ(hashIndex.GetEntryCount(), 50u) << "The entries weren't removed.";
+
+	for (std::uint32_t index = 0u; index < 100u; ++index)
+	{
+		std::optional<std::uint32_t> oPipelineIndex = hashIndex.Find(
+			hashes[index], [](std::uint32_t) { return true; }
+		);
+
+		EXPECT_EQ(static_cast<bool>(oPipelineIndex), index % 2u != 0u)
+			<< "The state of pipeline " << index << " is wrong.";
+	}
+
+	// A reused slot with a different pipeline.
+	hashIndex.Add(hashes[1u], 0u);
+
+	std::optional<std::uint32_t> oPipelineIndex = hashIndex.Find(
+		hashes[1u], [](std::uint32_t pipelineIndex) { return pipelineIndex == 0u; }
+	);
+
+	ASSERT_TRUE(oPipelineIndex) << "The pipeline with the same hash wasn't found.";
+	EXPECT_EQ(oPipelineIndex.value(), 0u) << "The pipeline index is wrong.";
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <cstdlib>
+#include <string>
+
+#include <VKInstanceManager.hpp>
+#include <VkDeviceManager.hpp>
+#include <VkRenderEngineVS.hpp>
+#include <VkPipelineManager.hpp>
+
+using namespace Terra;
+
+namespace Constants
+{
+	constexpr const char* appName     = "TerraTest";
+	constexpr size_t frameCount       = 2u;
+	constexpr CoreVersion coreVersion = CoreVersion::V1_3;
+}
+
+[[nodiscard]]
+static std::wstring GetEnvironmentString(const char* name)
+{
+	const char* value = std::getenv(name);
+
+	if (value == nullptr)
+		return {};
+
+	const std::string valueS{ value };
+
+	return std::wstring{ std::begin(valueS), std::end(valueS) };
+}
+
+TEST(PipelineLibraryTest, OptimisedLinkSwapTest)
+{
+	// The shaders are built outside of this repo. They shouldn't use any descriptors, as the
+	// pipeline layout is empty.
+	const std::wstring shaderPath     = GetEnvironmentString("TERRA_TEST_SHADER_PATH");
+	const std::wstring vertexShader   = GetEnvironmentString("TERRA_TEST_VERTEX_SHADER");
+	const std::wstring fragmentShader = GetEnvironmentString("TERRA_TEST_FRAGMENT_SHADER");
+
+	if (std::empty(shaderPath) || std::empty(vertexShader) || std::empty(fragmentShader))
+		GTEST_SKIP() << "The test shaders aren't set.";
+
+	VkInstanceManager instanceManager{ Constants::appName };
+	instanceManager.DebugLayers().AddDebugCallback(DebugCallbackType::StandardError);
+	instanceManager.CreateInstance(Constants::coreVersion);
+
+	VkDeviceManager deviceManager{};
+
+	{
+		VkDeviceExtensionManager& extensionManager = deviceManager.ExtensionManager();
+		RenderEngineVSIndividualDeviceExtension::SetDeviceExtensions(extensionManager);
+	}
+
+	const auto& pipelineLibraryExtensions = GraphicsPipelineLibrary::GetRequiredExtensions();
+
+	deviceManager.SetDeviceFeatures(Constants::coreVersion)
+		.SetPhysicalDeviceAutomatic(instanceManager.GetVKInstance())
+		.AddOptionalExtensions(
+			{ std::begin(pipelineLibraryExtensions), std::end(pipelineLibraryExtensions) }
+		)
+		.CreateLogicalDevice();
+
+	if (!deviceManager.ExtensionManager().IsExtensionActive(
+		DeviceExtension::VkExtGraphicsPipelineLibrary
+	))
+		GTEST_SKIP() << "The device doesn't support the graphics pipeline library.";
+
+	VkDevice logicalDevice = deviceManager.GetLogicalDevice();
+
+	ThreadPool threadPool{ 4u };
+
+	PipelineLayout pipelineLayout{ logicalDevice };
+	pipelineLayout.Create(std::vector<VkDescriptorSetLayout>{});
+
+	PipelineManager<GraphicsPipelineVSIndividualDraw> pipelineManager{ logicalDevice };
+	pipelineManager.SetPipelineLayout(pipelineLayout.Get());
+	pipelineManager.SetThreadPool(&threadPool);
+	pipelineManager.EnablePipelineLibrary(Constants::frameCount);
+	pipelineManager.SetShaderPath(shaderPath);
+
+	ExternalGraphicsPipeline extPipeline{ fragmentShader, vertexShader };
+	extPipeline.AddRenderTarget(ExternalFormat::R8G8B8A8_UNORM, ExternalBlendState{});
+
+	const std::uint32_t pipelineIndex = pipelineManager.AddOrGetGraphicsPipeline(extPipeline);
+
+	// The fast linked one should be usable straight away.
+	ASSERT_TRUE(pipelineManager.IsPipelineReady(pipelineIndex))
+		<< "The fast linked pipeline wasn't created.";
+	EXPECT_EQ(pipelineManager.GetPendingPipelineCount(), 1u)
+		<< "The optimised link wasn't scheduled.";
+
+	const VkPipeline fastLinkedPipeline = pipelineManager.GetPipeline(pipelineIndex).Get();
+
+	pipelineManager.WaitForPendingPipelines();
+
+	EXPECT_EQ(pipelineManager.GetPendingPipelineCount(), 0u)
+		<< "The optimised link wasn't installed.";
+	EXPECT_TRUE(pipelineManager.IsPipelineReady(pipelineIndex))
+		<< "The optimised pipeline wasn't created.";
+	EXPECT_NE(pipelineManager.GetPipeline(pipelineIndex).Get(), fastLinkedPipeline)
+		<< "The fast linked pipeline wasn't replaced by the optimised one.";
+
+	// The same pipeline again shouldn't be linked again.
+	EXPECT_EQ(pipelineManager.AddOrGetGraphicsPipeline(extPipeline), pipelineIndex)
+		<< "The pipeline wasn't found.";
+	EXPECT_EQ(pipelineManager.GetPendingPipelineCount(), 0u)
+		<< "An existing pipeline was linked again.";
+}
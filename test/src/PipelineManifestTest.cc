@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <filesystem>
+
+#include <PipelineManifest.hpp>
+
+TEST(PipelineManifestTest, AddPipelineTest)
+{
+	PipelineManifest manifest{};
+
+	ExternalGraphicsPipeline pipeline1{ L"FragmentShader", L"VertexShader" };
+	ExternalGraphicsPipeline pipeline2{ L"FragmentShader", L"VertexShader" };
+
+	manifest.AddPipeline(pipeline1);
+	manifest.AddPipeline(pipeline2);
+
+	EXPECT_EQ(std::size(manifest.GetGraphicsPipelines()), 1u) << "A duplicate pipeline was added.";
+
+	pipeline2.EnableBackfaceCulling();
+
+	manifest.AddPipeline(pipeline2);
+	manifest.AddPipeline(ExternalComputePipeline{ L"ComputeShader" });
+	manifest.AddPipeline(ExternalComputePipeline{ L"ComputeShader" });
+
+	EXPECT_EQ(std::size(manifest.GetGraphicsPipelines()), 2u) << "The pipeline wasn't added.";
+	EXPECT_EQ(std::size(manifest.GetComputePipelines()), 1u)
+		<< "The compute pipelines weren't deduplicated.";
+}
+
+TEST(PipelineManifestTest, SerialiseTest)
+{
+	PipelineManifest manifest{};
+
+	{
+		ExternalGraphicsPipeline pipeline{ L"FragmentShader", L"VertexShader" };
+
+		pipeline.AddRenderTarget(
+			ExternalFormat::R8G8B8A8_UNORM,
+			ExternalBlendState{
+				.enabled        = true,
+				.colourBlendSrc = ExternalBlendFactor::SrcAlpha,
+				.colourBlendDst = ExternalBlendFactor::OneMinusSrcAlpha
+			}
+		);
+		pipeline.AddRenderTarget(ExternalFormat::R16G16B16A16_FLOAT, ExternalBlendState{});
+		pipeline.EnableDepthTesting(ExternalFormat::D32_FLOAT, true);
+		pipeline.EnableBackfaceCulling();
+		pipeline.DisableGPUCulling();
+
+		manifest.AddPipeline(pipeline);
+		manifest.AddPipeline(ExternalGraphicsPipeline{ L"", L"MeshShader" });
+		manifest.AddPipeline(ExternalComputePipeline{ L"ComputeShader" });
+	}
+
+	const std::vector<std::uint8_t> manifestData = manifest.Serialise();
+
+	PipelineManifest loadedManifest{};
+
+	ASSERT_TRUE(loadedManifest.Deserialise(manifestData)) << "The manifest couldn't be loaded.";
+
+	const std::vector<ExternalGraphicsPipeline>& graphicsPipelines
+		= manifest.GetGraphicsPipelines();
+	const std::vector<ExternalGraphicsPipeline>& loadedGraphicsPipelines
+		= loadedManifest.GetGraphicsPipelines();
+
+	ASSERT_EQ(std::size(loadedGraphicsPipelines), std::size(graphicsPipelines))
+		<< "The graphics pipeline count is wrong.";
+
+	for (size_t index = 0u; index < std::size(graphicsPipelines); ++index)
+	{
+		EXPECT_TRUE(loadedGraphicsPipelines[index] == graphicsPipelines[index])
+			<< "Graphics pipeline " << index << " isn't the same.";
+		EXPECT_EQ(loadedGraphicsPipelines[index].GetHash(), graphicsPipelines[index].GetHash())
+			<< "The hash of graphics pipeline " << index << " isn't the same.";
+	}
+
+	ASSERT_EQ(std::size(loadedManifest.GetComputePipelines()), 1u)
+		<< "The compute pipeline count is wrong.";
+	EXPECT_TRUE(
+		loadedManifest.GetComputePipelines().front() == manifest.GetComputePipelines().front()
+	) << "The compute pipeline isn't the same.";
+
+	// A truncated manifest shouldn't add anything.
+	std::vector<std::uint8_t> truncatedData = manifestData;
+	truncatedData.pop_back();
+
+	PipelineManifest truncatedManifest{};
+
+	EXPECT_FALSE(truncatedManifest.Deserialise(truncatedData))
+		<< "A truncated manifest was loaded.";
+	EXPECT_TRUE(std::empty(truncatedManifest.GetGraphicsPipelines()))
+		<< "A truncated manifest added the pipelines.";
+}
+
+TEST(PipelineManifestTest, SharedDirectoryTest)
+{
+	const std::filesystem::path manifestDirectory
+		= std::filesystem::temp_directory_path() / L"TerraPipelineManifestTest";
+
+	std::filesystem::create_directories(manifestDirectory);
+
+	// The manifests of two different engines in the same directory.
+	{
+		PipelineManifest manifestVS{};
+		manifestVS.LoadFromDirectory(manifestDirectory.wstring(), L"PipelineManifestVS.bin");
+		manifestVS.AddPipeline(ExternalGraphicsPipeline{ L"FragmentShader", L"VertexShader" });
+
+		PipelineManifest manifestMS{};
+		manifestMS.LoadFromDirectory(manifestDirectory.wstring(), L"PipelineManifestMS.bin");
+		manifestMS.AddPipeline(ExternalGraphicsPipeline{ L"FragmentShader", L"MeshShader" });
+
+		EXPECT_EQ(
+			std::filesystem::path{ manifestVS.GetFilePath() }.parent_path(), manifestDirectory
+		) << "The manifest file should be inside the directory.";
+	}
+
+	{
+		PipelineManifest manifestVS{};
+		manifestVS.LoadFromDirectory(manifestDirectory.wstring(), L"PipelineManifestVS.bin");
+
+		const std::vector<ExternalGraphicsPipeline>& graphicsPipelines
+			= manifestVS.GetGraphicsPipelines();
+
+		ASSERT_EQ(std::size(graphicsPipelines), 1u)
+			<< "The manifest should only have the pipelines of its own engine.";
+		EXPECT_TRUE(
+			graphicsPipelines.front()
+				== ExternalGraphicsPipeline{ L"FragmentShader", L"VertexShader" }
+		) << "The wrong pipeline was loaded.";
+	}
+
+	std::filesystem::remove_all(manifestDirectory);
+}
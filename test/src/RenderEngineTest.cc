@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <string>
+#include <filesystem>
+#include <fstream>
 
 #include <VKInstanceManager.hpp>
 #include <VkDeviceManager.hpp>
@@ -11,6 +14,7 @@
 #endif
 
 #include <RendererVK.hpp>
+#include <RendererVKHeadless.hpp>
 
 using namespace Terra;
 
@@ -111,6 +115,60 @@ TEST_F(RenderEngineTest, RenderEngineMSTest)
 	RenderEngineMS renderEngine{ deviceManager, threadPool, Constants::frameCount };
 }
 
+TEST_F(RenderEngineTest, RenderEngineMSIndirectTest)
+{
+	VkDeviceManager deviceManager{};
+
+	{
+		VkDeviceExtensionManager& extensionManager = deviceManager.ExtensionManager();
+		RenderEngineMSIndirectDeviceExtension::SetDeviceExtensions(extensionManager);
+	}
+
+	{
+		VkInstance vkInstance = s_instanceManager->GetVKInstance();
+
+		deviceManager.SetDeviceFeatures(Constants::coreVersion)
+			.SetPhysicalDeviceAutomatic(vkInstance)
+			.CreateLogicalDevice();
+	}
+
+	auto threadPool = std::make_shared<ThreadPool>(2u);
+
+	RenderEngineMSIndirect renderEngine{ deviceManager, threadPool, Constants::frameCount };
+}
+
+TEST(ShaderInterfaceVersionTest, VersionFileTest)
+{
+	const std::filesystem::path shaderPath
+		= std::filesystem::temp_directory_path() / "TerraShaderInterfaceVersionTest";
+
+	std::filesystem::remove_all(shaderPath);
+	std::filesystem::create_directories(shaderPath);
+
+	// Without a version file, the shaders are unversioned and should only give a warning.
+	EXPECT_NO_THROW(RenderEngine::CheckShaderInterfaceVersion(shaderPath.wstring()));
+
+	const std::filesystem::path versionFilePath = shaderPath / "ShaderInterfaceVersion.txt";
+
+	{
+		std::ofstream versionFile{ versionFilePath, std::ios::trunc };
+		versionFile << RenderEngine::s_shaderInterfaceVersion;
+	}
+
+	EXPECT_NO_THROW(RenderEngine::CheckShaderInterfaceVersion(shaderPath.wstring()));
+
+	{
+		std::ofstream versionFile{ versionFilePath, std::ios::trunc };
+		versionFile << RenderEngine::s_shaderInterfaceVersion + 1u;
+	}
+
+	EXPECT_THROW(
+		RenderEngine::CheckShaderInterfaceVersion(shaderPath.wstring()), Exception
+	) << "The old shaders shouldn't be used.";
+
+	std::filesystem::remove_all(shaderPath);
+}
+
 TEST(RendererVKTest, RendererTest)
 {
 #ifdef TERRA_WIN32
@@ -123,3 +181,394 @@ TEST(RendererVKTest, RendererTest)
 	};
 #endif
 }
+
+TEST(RendererVKTest, HeadlessRendererReadbackTest)
+{
+	constexpr std::uint32_t width  = 64u;
+	constexpr std::uint32_t height = 64u;
+
+	RendererVKHeadless<RenderEngineVSIndividual> renderer{
+		Constants::appName, width, height, Constants::frameCount,
+		std::make_shared<ThreadPool>(2u)
+	};
+
+	VkExternalResourceFactory& resourceFactory
+		= renderer.GetExternalResourceManager().GetResourceFactory();
+
+	const auto textureIndex = static_cast<std::uint32_t>(resourceFactory.CreateExternalTexture());
+
+	resourceFactory.GetExternalTextureRP(textureIndex)->Create(
+		width, height, ExternalFormat::R8G8B8A8_UNORM, ExternalTexture2DType::RenderTarget,
+		ExternalTextureCreationFlags{ .copySrc = true }
+	);
+
+	renderer.FinaliseInitialisation();
+
+	{
+		const std::uint32_t renderPassIndex = renderer.AddExternalRenderPass();
+
+		std::shared_ptr<VkExternalRenderPass> renderPass
+			= renderer.GetExternalRenderPassSP(renderPassIndex);
+
+		const std::uint32_t renderTargetIndex = renderPass->AddRenderTarget(
+			textureIndex, ExternalAttachmentLoadOp::Clear, ExternalAttachmentStoreOp::Store,
+			resourceFactory
+		);
+
+		renderPass->SetRenderTargetClearColour(
+			renderTargetIndex, DirectX::XMFLOAT4{ 1.f, 0.f, 0.f, 1.f }, resourceFactory
+		);
+	}
+
+	const std::uint32_t readbackIndex = renderer.AddReadbackTexture(textureIndex);
+
+	const size_t frameIndex = renderer.WaitForCurrentBackBuffer();
+
+	renderer.Render(frameIndex);
+
+	renderer.WaitForGPUToFinish();
+
+	EXPECT_EQ(
+		renderer.GetReadbackDataSize(frameIndex, readbackIndex),
+		static_cast<size_t>(width * height * 4u)
+	) << "The readback size doesn't match the texture size.";
+
+	std::uint8_t const* pixels = renderer.GetReadbackData(frameIndex, readbackIndex);
+
+	EXPECT_EQ(pixels[0], 255u) << "The red channel wasn't cleared.";
+	EXPECT_EQ(pixels[1], 0u) << "The green channel wasn't cleared.";
+	EXPECT_EQ(pixels[2], 0u) << "The blue channel wasn't cleared.";
+	EXPECT_EQ(pixels[3], 255u) << "The alpha channel wasn't cleared.";
+}
+
+[[nodiscard]]
+static MeshBundleTemporaryData GetCubeMeshBundle()
+{
+	using namespace DirectX;
+
+	MeshBundleTemporaryData meshBundle{};
+
+	for (std::uint32_t index = 0u; index < 8u; ++index)
+		meshBundle.vertices.emplace_back(Vertex{
+			.position = XMFLOAT3{
+				index & 1u ? 1.f : -1.f, index & 2u ? 1.f : -1.f, index & 4u ? 1.f : -1.f
+			}
+		});
+
+	meshBundle.indices = {
+		0u, 2u, 1u, 1u, 2u, 3u, // -Z
+		4u, 5u, 6u, 5u, 7u, 6u, // +Z
+		0u, 4u, 2u, 2u, 4u, 6u, // -X
+		1u, 3u, 5u, 3u, 7u, 5u, // +X
+		0u, 1u, 4u, 1u, 5u, 4u, // -Y
+		2u, 6u, 3u, 3u, 6u, 7u  // +Y
+	};
+
+	meshBundle.bundleDetails.meshTemporaryDetailsVS.emplace_back(MeshTemporaryDetailsVS{
+		.indexCount  = static_cast<std::uint32_t>(std::size(meshBundle.indices)),
+		.indexOffset = 0u,
+		.aabb        = AxisAlignedBoundingBox{
+			.maxAxes = XMFLOAT4{ 1.f, 1.f, 1.f, 1.f },
+			.minAxes = XMFLOAT4{ -1.f, -1.f, -1.f, 1.f }
+		}
+	});
+
+	return meshBundle;
+}
+
+TEST(RendererVKTest, HeadlessOcclusionCullingTest)
+{
+	using namespace DirectX;
+
+	// The culling, the pyramid and the graphics shaders are built from test/shaders.
+	const std::string shaderPath{ TERRA_TEST_SHADER_DIRECTORY };
+
+	constexpr std::uint32_t width  = 64u;
+	constexpr std::uint32_t height = 64u;
+
+	RendererVKHeadless<RenderEngineVSIndirect> renderer{
+		Constants::appName, width, height, Constants::frameCount,
+		std::make_shared<ThreadPool>(2u)
+	};
+
+	renderer.SetShaderPath(std::wstring{ std::begin(shaderPath), std::end(shaderPath) }.c_str());
+
+	VkExternalResourceFactory& resourceFactory
+		= renderer.GetExternalResourceManager().GetResourceFactory();
+
+	const auto depthIndex = static_cast<std::uint32_t>(resourceFactory.CreateExternalTexture());
+
+	resourceFactory.GetExternalTextureRP(depthIndex)->Create(
+		width, height, ExternalFormat::D32_FLOAT, ExternalTexture2DType::Depth,
+		ExternalTextureCreationFlags{ .sampleTexture = true }
+	);
+
+	renderer.FinaliseInitialisation();
+
+	const std::uint32_t renderPassIndex = renderer.AddExternalRenderPass();
+
+	{
+		std::shared_ptr<VkExternalRenderPass> renderPass
+			= renderer.GetExternalRenderPassSP(renderPassIndex);
+
+		renderPass->SetDepthTesting(
+			depthIndex, ExternalAttachmentLoadOp::Clear, ExternalAttachmentStoreOp::Store,
+			resourceFactory
+		);
+		renderPass->SetDepthClearColour(1.f, resourceFactory);
+	}
+
+	ExternalGraphicsPipeline depthPipeline{
+		L"TestFragmentShader", L"TestVertexShaderIndirect"
+	};
+	depthPipeline.EnableDepthTesting(ExternalFormat::D32_FLOAT, true);
+
+	const std::uint32_t pipelineIndex = renderer.AddGraphicsPipeline(depthPipeline);
+
+	const std::uint32_t meshBundleIndex = renderer.AddMeshBundle(GetCubeMeshBundle());
+
+	auto modelContainer = std::make_shared<ModelContainer>();
+
+	renderer.SetModelContainer(modelContainer);
+
+	// The occluder covers the whole view and the other models are right behind it, but they are
+	// still in the frustum.
+	constexpr std::uint32_t hiddenModelCount = 4u;
+
+	{
+		auto modelBundle = std::make_shared<ModelBundle>();
+
+		modelBundle->SetModelContainer(modelContainer);
+		modelBundle->SetMeshBundleIndex(meshBundleIndex);
+
+		{
+			Model occluder{ 10.f };
+
+			occluder.GetTransform().MoveTowardsZ(15.f);
+
+			modelBundle->AddModel(std::move(occluder), pipelineIndex);
+		}
+
+		for (std::uint32_t index = 0u; index < hiddenModelCount; ++index)
+		{
+			Model hiddenModel{};
+
+			hiddenModel.GetTransform().MoveTowardsX(index % 2u ? 3.f : -3.f);
+			hiddenModel.GetTransform().MoveTowardsY(index / 2u ? 3.f : -3.f);
+			hiddenModel.GetTransform().MoveTowardsZ(50.f);
+
+			modelBundle->AddModel(std::move(hiddenModel), pipelineIndex);
+		}
+
+		const std::uint32_t modelBundleIndex = renderer.AddModelBundle(std::move(modelBundle));
+
+		renderer.AddLocalPipelinesInExternalRenderPass(modelBundleIndex, renderPassIndex);
+	}
+
+	Camera camera{};
+
+	camera.SetProjectionMatrix(XMMatrixPerspectiveFovLH(XM_PIDIV4, 1.f, 0.1f, 100.f));
+	camera.SetViewMatrix(XMMatrixLookAtLH(
+		XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f),
+		XMVectorSet(0.f, 1.f, 0.f, 0.f)
+	));
+
+	renderer.SetOcclusionCullingDepth(depthIndex);
+	renderer.SetDrawCountReadback(true);
+
+	// The first frames don't have a pyramid with the occluder yet, so the models would only be
+	// culled after a few frames.
+	for (size_t index = 0u; index < Constants::frameCount * 4u; ++index)
+	{
+		const size_t frameIndex = renderer.WaitForCurrentBackBuffer();
+
+		renderer.UpdateCamera(frameIndex, camera);
+		renderer.Update(frameIndex);
+		renderer.Render(frameIndex);
+	}
+
+	renderer.WaitForGPUToFinish();
+
+	// The occluder is the closest model and fills the view, so a single draw in both of the
+	// phases can only be the occluder.
+	for (size_t frameIndex = 0u; frameIndex < Constants::frameCount; ++frameIndex)
+		EXPECT_EQ(renderer.GetDrawCount(frameIndex), 1u)
+			<< "Only the occluder should be drawn, the hidden models should have no draws.";
+
+	// Without the culling, the hidden models should be drawn too.
+	renderer.DisableOcclusionCulling();
+
+	for (size_t index = 0u; index < Constants::frameCount; ++index)
+	{
+		const size_t frameIndex = renderer.WaitForCurrentBackBuffer();
+
+		renderer.UpdateCamera(frameIndex, camera);
+		renderer.Update(frameIndex);
+		renderer.Render(frameIndex);
+	}
+
+	renderer.WaitForGPUToFinish();
+
+	for (size_t frameIndex = 0u; frameIndex < Constants::frameCount; ++frameIndex)
+		EXPECT_EQ(renderer.GetDrawCount(frameIndex), hiddenModelCount + 1u)
+			<< "The frustum culling shouldn't cull the hidden models.";
+}
+
+[[nodiscard]]
+static MeshBundleTemporaryData GetCubeMeshBundleMS()
+{
+	using namespace DirectX;
+
+	MeshBundleTemporaryData meshBundle{};
+
+	for (std::uint32_t index = 0u; index < 8u; ++index)
+	{
+		meshBundle.vertices.emplace_back(Vertex{
+			.position = XMFLOAT3{
+				index & 1u ? 1.f : -1.f, index & 2u ? 1.f : -1.f, index & 4u ? 1.f : -1.f
+			}
+		});
+
+		meshBundle.indices.emplace_back(index);
+	}
+
+	// The vertex indices of each triangle are packed in 10 bits each.
+	constexpr std::uint32_t triangles[12u][3u]{
+		{ 0u, 2u, 1u }, { 1u, 2u, 3u }, { 4u, 5u, 6u }, { 5u, 7u, 6u },
+		{ 0u, 4u, 2u }, { 2u, 4u, 6u }, { 1u, 3u, 5u }, { 3u, 7u, 5u },
+		{ 0u, 1u, 4u }, { 1u, 5u, 4u }, { 2u, 6u, 3u }, { 3u, 6u, 7u }
+	};
+
+	for (const auto& triangle : triangles)
+		meshBundle.primIndices.emplace_back(triangle[0] | triangle[1] << 10u | triangle[2] << 20u);
+
+	meshBundle.meshletDetails.emplace_back(MeshletDetails{
+		.meshlet = Meshlet{
+			.indexCount      = static_cast<std::uint32_t>(std::size(meshBundle.indices)),
+			.indexOffset     = 0u,
+			.primitiveCount  = static_cast<std::uint32_t>(std::size(meshBundle.primIndices)),
+			.primitiveOffset = 0u
+		}
+	});
+
+	meshBundle.bundleDetails.meshTemporaryDetailsMS.emplace_back(MeshTemporaryDetailsMS{
+		.meshletCount    = 1u,
+		.meshletOffset   = 0u,
+		.indexOffset     = 0u,
+		.primitiveOffset = 0u,
+		.vertexOffset    = 0u,
+		.aabb            = AxisAlignedBoundingBox{
+			.maxAxes = XMFLOAT4{ 1.f, 1.f, 1.f, 1.f },
+			.minAxes = XMFLOAT4{ -1.f, -1.f, -1.f, 1.f }
+		}
+	});
+
+	return meshBundle;
+}
+
+TEST(RendererVKTest, HeadlessMSIndirectDrawCountTest)
+{
+	using namespace DirectX;
+
+	// The test task shader doesn't launch any meshes, so only the draws written by the culling
+	// shader are checked.
+	const std::string shaderPath{ TERRA_TEST_SHADER_DIRECTORY };
+
+	constexpr std::uint32_t width  = 64u;
+	constexpr std::uint32_t height = 64u;
+
+	RendererVKHeadless<RenderEngineMSIndirect> renderer{
+		Constants::appName, width, height, Constants::frameCount,
+		std::make_shared<ThreadPool>(2u)
+	};
+
+	renderer.SetShaderPath(std::wstring{ std::begin(shaderPath), std::end(shaderPath) }.c_str());
+
+	VkExternalResourceFactory& resourceFactory
+		= renderer.GetExternalResourceManager().GetResourceFactory();
+
+	const auto depthIndex = static_cast<std::uint32_t>(resourceFactory.CreateExternalTexture());
+
+	resourceFactory.GetExternalTextureRP(depthIndex)->Create(
+		width, height, ExternalFormat::D32_FLOAT, ExternalTexture2DType::Depth,
+		ExternalTextureCreationFlags{}
+	);
+
+	renderer.FinaliseInitialisation();
+
+	const std::uint32_t renderPassIndex = renderer.AddExternalRenderPass();
+
+	{
+		std::shared_ptr<VkExternalRenderPass> renderPass
+			= renderer.GetExternalRenderPassSP(renderPassIndex);
+
+		renderPass->SetDepthTesting(
+			depthIndex, ExternalAttachmentLoadOp::Clear, ExternalAttachmentStoreOp::Store,
+			resourceFactory
+		);
+		renderPass->SetDepthClearColour(1.f, resourceFactory);
+	}
+
+	ExternalGraphicsPipeline meshPipeline{ L"TestFragmentShader", L"TestMeshShader" };
+	meshPipeline.EnableDepthTesting(ExternalFormat::D32_FLOAT, true);
+
+	const std::uint32_t pipelineIndex = renderer.AddGraphicsPipeline(meshPipeline);
+
+	const std::uint32_t meshBundleIndex = renderer.AddMeshBundle(GetCubeMeshBundleMS());
+
+	auto modelContainer = std::make_shared<ModelContainer>();
+
+	renderer.SetModelContainer(modelContainer);
+
+	// The models in front of the camera should be drawn and the ones behind it culled.
+	constexpr std::uint32_t visibleModelCount = 3u;
+	constexpr std::uint32_t culledModelCount  = 2u;
+
+	{
+		auto modelBundle = std::make_shared<ModelBundle>();
+
+		modelBundle->SetModelContainer(modelContainer);
+		modelBundle->SetMeshBundleIndex(meshBundleIndex);
+
+		for (std::uint32_t index = 0u; index < visibleModelCount + culledModelCount; ++index)
+		{
+			Model model{};
+
+			const auto column = static_cast<float>(index % visibleModelCount);
+
+			model.GetTransform().MoveTowardsX((column - 1.f) * 3.f);
+			model.GetTransform().MoveTowardsZ(index < visibleModelCount ? 10.f : -10.f);
+
+			modelBundle->AddModel(std::move(model), pipelineIndex);
+		}
+
+		const std::uint32_t modelBundleIndex = renderer.AddModelBundle(std::move(modelBundle));
+
+		renderer.AddLocalPipelinesInExternalRenderPass(modelBundleIndex, renderPassIndex);
+	}
+
+	Camera camera{};
+
+	camera.SetProjectionMatrix(XMMatrixPerspectiveFovLH(XM_PIDIV4, 1.f, 0.1f, 100.f));
+	camera.SetViewMatrix(XMMatrixLookAtLH(
+		XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f),
+		XMVectorSet(0.f, 1.f, 0.f, 0.f)
+	));
+
+	renderer.SetDrawCountReadback(true);
+
+	for (size_t index = 0u; index < Constants::frameCount * 2u; ++index)
+	{
+		const size_t frameIndex = renderer.WaitForCurrentBackBuffer();
+
+		renderer.UpdateCamera(frameIndex, camera);
+		renderer.Update(frameIndex);
+		renderer.Render(frameIndex);
+	}
+
+	renderer.WaitForGPUToFinish();
+
+	for (size_t frameIndex = 0u; frameIndex < Constants::frameCount; ++frameIndex)
+		EXPECT_EQ(renderer.GetDrawCount(frameIndex), visibleModelCount)
+			<< "Only the models in the frustum should have draws.";
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <span>
+#include <algorithm>
+#include <vector>
+#include <chrono>
 
 #include <VKInstanceManager.hpp>
 #include <VkDeviceManager.hpp>
@@ -53,6 +57,63 @@ void StagingBufferTest::TearDownTestSuite()
 	s_instanceManager.reset();
 }
 
+// Each test gets its own staging manager and the objects to submit its copies with.
+class StagingRingTest : public StagingBufferTest
+{
+protected:
+	StagingRingTest();
+
+	// Records the queued copies, submits them and waits for them to finish.
+	void CopyQueuedBuffers(std::uint64_t signalValue);
+
+protected:
+	MemoryManager        m_memoryManager;
+	VkCommandQueue       m_transferQueue;
+	ThreadPool           m_threadPool;
+	StagingBufferManager m_stagingBufferMan;
+	VKSemaphore          m_transferSemaphore;
+	VKFence              m_waitFence;
+};
+
+StagingRingTest::StagingRingTest()
+	: m_memoryManager{
+		s_deviceManager->GetPhysicalDevice(), s_deviceManager->GetLogicalDevice(), 20_MB, 200_KB
+	}, m_transferQueue{
+		s_deviceManager->GetLogicalDevice(),
+		s_deviceManager->GetQueueFamilyManager().GetQueue(QueueType::TransferQueue),
+		s_deviceManager->GetQueueFamilyManager().GetIndex(QueueType::TransferQueue)
+	}, m_threadPool{ 8u },
+	m_stagingBufferMan{
+		s_deviceManager->GetLogicalDevice(), &m_memoryManager, &m_threadPool,
+		s_deviceManager->GetQueueFamilyManagerRef()
+	}, m_transferSemaphore{ s_deviceManager->GetLogicalDevice() },
+	m_waitFence{ s_deviceManager->GetLogicalDevice() }
+{
+	m_transferQueue.CreateCommandBuffers(1u);
+	m_transferSemaphore.Create(true);
+	m_waitFence.Create(false);
+}
+
+void StagingRingTest::CopyQueuedBuffers(std::uint64_t signalValue)
+{
+	{
+		const CommandBufferScope cmdBufferScope{ m_transferQueue.GetCommandBuffer(0u) };
+
+		m_stagingBufferMan.CopyAndClearQueuedBuffers(
+			cmdBufferScope, m_transferSemaphore, signalValue
+		);
+	}
+
+	QueueSubmitBuilder<0u, 1u> submitBuilder{};
+	submitBuilder
+		.SignalSemaphore(m_transferSemaphore.Get(), signalValue)
+		.CommandBuffer(m_transferQueue.GetCommandBuffer(0u));
+
+	m_waitFence.Reset();
+	m_transferQueue.SubmitCommandBuffer(submitBuilder, m_waitFence);
+	m_waitFence.Wait();
+}
+
 TEST_F(StagingBufferTest, StagingTest)
 {
 	VkDevice logicalDevice          = s_deviceManager->GetLogicalDevice();
@@ -93,22 +154,259 @@ TEST_F(StagingBufferTest, StagingTest)
 
 	auto textureData                     = std::make_unique<std::uint8_t[]>(textureBufferSize);
 
-	Callisto::TemporaryDataBufferGPU tempDataBuffer{};
+	stagingBufferMan.AddBuffer(std::move(bufferData), 2_KB, &testStorage, 0u);
+	stagingBufferMan.AddTextureView(std::move(textureData), &testTextureView, {});
 
-	stagingBufferMan.AddBuffer(std::move(bufferData), 2_KB, &testStorage, 0u, tempDataBuffer);
-	stagingBufferMan.AddTextureView(std::move(textureData), &testTextureView, {}, tempDataBuffer);
+	VKSemaphore transferSemaphore{ logicalDevice };
+	transferSemaphore.Create(true);
 
 	{
 		const size_t bufferIndex = 0u;
 		const CommandBufferScope cmdBufferScope{ transferQueue.GetCommandBuffer(bufferIndex) };
 
-		stagingBufferMan.CopyAndClearQueuedBuffers(cmdBufferScope);
+		stagingBufferMan.CopyAndClearQueuedBuffers(cmdBufferScope, transferSemaphore, 1u);
 	}
 
 	VKFence waitFence{ logicalDevice };
 	waitFence.Create(false);
 
-	transferQueue.SubmitCommandBuffer(0u, waitFence);
+	QueueSubmitBuilder<0u, 1u> submitBuilder{};
+	submitBuilder
+		.SignalSemaphore(transferSemaphore.Get(), 1u)
+		.CommandBuffer(transferQueue.GetCommandBuffer(0u));
+
+	transferQueue.SubmitCommandBuffer(submitBuilder, waitFence);
 	waitFence.Wait();
 }
 
+TEST_F(StagingRingTest, StagingRingReuseTest)
+{
+	Buffer testStorage{
+		s_deviceManager->GetLogicalDevice(), &m_memoryManager, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+	};
+	testStorage.Create(
+		64_KB,
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		{});
+
+	VkDeviceSize stagingBufferSize = 0u;
+
+	// The ranges of the finished submissions should be reused, so the ring buffer shouldn't
+	// need to grow after the first upload.
+	for (std::uint64_t signalValue = 1u; signalValue <= 4u; ++signalValue)
+	{
+		// Multiple regions of the same destination, so they can be batched in a single copy.
+		for (VkDeviceSize offset = 0u; offset < 64_KB; offset += 16_KB)
+			m_stagingBufferMan.AddBuffer(
+				std::make_shared<std::uint8_t[]>(16_KB), 16_KB, &testStorage, offset
+			);
+
+		CopyQueuedBuffers(signalValue);
+
+		if (signalValue == 1u)
+			stagingBufferSize = m_stagingBufferMan.GetStagingBufferSize();
+
+		EXPECT_EQ(m_stagingBufferMan.GetStagingBufferSize(), stagingBufferSize)
+			<< "The staging ring buffer grew, even though the old ranges have been finished.";
+	}
+}
+
+TEST_F(StagingRingTest, InPlaceStagingTest)
+{
+	// CPU visible, so the copied data can be checked.
+	Buffer testStorage{
+		s_deviceManager->GetLogicalDevice(), &m_memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+	};
+	testStorage.Create(4_KB, VK_BUFFER_USAGE_TRANSFER_DST_BIT, {});
+
+	{
+		std::span<std::uint8_t> stagingData = m_stagingBufferMan.AddBufferInPlace(
+			2_KB, &testStorage, 0u
+		);
+
+		EXPECT_EQ(std::size(stagingData), 2_KB) << "The staging span has the wrong size.";
+
+		std::ranges::fill(stagingData, std::uint8_t{ 7u });
+	}
+
+	// The in place and the copied ones should be usable together.
+	{
+		auto bufferData = std::make_shared<std::uint8_t[]>(2_KB);
+
+		std::fill_n(bufferData.get(), 2_KB, std::uint8_t{ 9u });
+
+		m_stagingBufferMan.AddBuffer(std::move(bufferData), 2_KB, &testStorage, 2_KB);
+	}
+
+	CopyQueuedBuffers(1u);
+
+	std::uint8_t const* storageData = testStorage.CPUHandle();
+
+	EXPECT_EQ(storageData[0u], 7u) << "The in place data wasn't copied.";
+	EXPECT_EQ(storageData[2_KB - 1u], 7u) << "The in place data wasn't copied.";
+	EXPECT_EQ(storageData[2_KB], 9u) << "The CPU data wasn't copied.";
+	EXPECT_EQ(storageData[4_KB - 1u], 9u) << "The CPU data wasn't copied.";
+}
+
+TEST_F(StagingRingTest, StagingRingGrowTest)
+{
+	// The two uploads together are larger than the initial size of the ring buffer, so it
+	// must grow while the in place upload is still pending.
+	constexpr VkDeviceSize uploadSize = 5_MB;
+
+	Buffer testStorage{
+		s_deviceManager->GetLogicalDevice(), &m_memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+	};
+	testStorage.Create(uploadSize * 2u, VK_BUFFER_USAGE_TRANSFER_DST_BIT, {});
+
+	{
+		std::span<std::uint8_t> stagingData = m_stagingBufferMan.AddBufferInPlace(
+			uploadSize, &testStorage, 0u
+		);
+
+		std::ranges::fill(stagingData, std::uint8_t{ 3u });
+	}
+
+	const VkDeviceSize initialStagingBufferSize = m_stagingBufferMan.GetStagingBufferSize();
+
+	{
+		auto bufferData = std::make_shared<std::uint8_t[]>(uploadSize);
+
+		std::fill_n(bufferData.get(), uploadSize, std::uint8_t{ 5u });
+
+		m_stagingBufferMan.AddBuffer(
+			std::move(bufferData), uploadSize, &testStorage, uploadSize
+		);
+	}
+
+	CopyQueuedBuffers(1u);
+
+	// The ring buffer never shrinks, so it can be checked after the copies have finished.
+	EXPECT_GT(m_stagingBufferMan.GetStagingBufferSize(), initialStagingBufferSize)
+		<< "The staging ring buffer didn't grow.";
+
+	std::uint8_t const* storageData = testStorage.CPUHandle();
+
+	EXPECT_EQ(storageData[0u], 3u) << "The data staged before the growth wasn't copied.";
+	EXPECT_EQ(storageData[uploadSize - 1u], 3u)
+		<< "The data staged before the growth wasn't copied.";
+	EXPECT_EQ(storageData[uploadSize], 5u) << "The data staged after the growth wasn't copied.";
+	EXPECT_EQ(storageData[uploadSize * 2u - 1u], 5u)
+		<< "The data staged after the growth wasn't copied.";
+}
+
+TEST_F(StagingRingTest, StreamingTest)
+{
+	// Only a single request should fit in the budget of a frame.
+	m_stagingBufferMan.SetStreamingBudget(
+		StagingBufferManager::StreamingBudget{
+			.bytesPerFrame = 1_KB, .timePerFrame = std::chrono::microseconds{ 1'000'000 }
+		}
+	);
+
+	Buffer testStorage{
+		s_deviceManager->GetLogicalDevice(), &m_memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+	};
+	testStorage.Create(3_KB, VK_BUFFER_USAGE_TRANSFER_DST_BIT, {});
+
+	std::vector<std::uint64_t> requestIDs{};
+
+	// The requests should be able to be added from other threads. Adding one at a time, so
+	// the order is known.
+	for (std::uint8_t index = 0u; index < 3u; ++index)
+	{
+		auto bufferData = std::make_shared<std::uint8_t[]>(1_KB);
+
+		std::fill_n(bufferData.get(), 1_KB, static_cast<std::uint8_t>(index + 1u));
+
+		m_threadPool.SubmitWork(std::function{
+			[this, &testStorage, &requestIDs, index, data = std::move(bufferData)]
+			{
+				requestIDs.emplace_back(
+					m_stagingBufferMan.StreamBuffer(data, 1_KB, &testStorage, index * 1_KB)
+				);
+			}}).wait();
+	}
+
+	EXPECT_TRUE(m_stagingBufferMan.HasPendingStreamingRequests())
+		<< "The requests weren't added.";
+	EXPECT_FALSE(m_stagingBufferMan.IsStreamingRequestComplete(requestIDs[0u]))
+		<< "The request is complete before being submitted.";
+
+	for (std::uint64_t signalValue = 1u; signalValue <= 3u; ++signalValue)
+	{
+		CopyQueuedBuffers(signalValue);
+
+		const size_t completedIndex = static_cast<size_t>(signalValue - 1u);
+
+		EXPECT_TRUE(m_stagingBufferMan.IsStreamingRequestComplete(requestIDs[completedIndex]))
+			<< "The request " << completedIndex << " wasn't completed.";
+
+		if (completedIndex + 1u < std::size(requestIDs))
+			EXPECT_FALSE(
+				m_stagingBufferMan.IsStreamingRequestComplete(requestIDs[completedIndex + 1u])
+			) << "More requests than the budget were processed.";
+	}
+
+	EXPECT_FALSE(m_stagingBufferMan.HasPendingStreamingRequests())
+		<< "All of the requests should have been processed.";
+
+	std::uint8_t const* storageData = testStorage.CPUHandle();
+
+	EXPECT_EQ(storageData[0u], 1u) << "The first request wasn't copied.";
+	EXPECT_EQ(storageData[1_KB], 2u) << "The second request wasn't copied.";
+	EXPECT_EQ(storageData[3_KB - 1u], 3u) << "The third request wasn't copied.";
+}
+
+TEST_F(StagingRingTest, StreamingRingGrowTest)
+{
+	// The default byte budget is larger than the initial size of the ring buffer. The time
+	// budget is raised, so every request is processed in the same frame.
+	m_stagingBufferMan.SetStreamingBudget(
+		StagingBufferManager::StreamingBudget{
+			.bytesPerFrame = 32_MB, .timePerFrame = std::chrono::microseconds{ 1'000'000 }
+		}
+	);
+
+	constexpr VkDeviceSize requestSize  = 3_MB;
+	constexpr std::uint8_t requestCount = 4u;
+
+	Buffer testStorage{
+		s_deviceManager->GetLogicalDevice(), &m_memoryManager, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+	};
+	testStorage.Create(requestSize * requestCount, VK_BUFFER_USAGE_TRANSFER_DST_BIT, {});
+
+	std::vector<std::uint64_t> requestIDs{};
+
+	for (std::uint8_t index = 0u; index < requestCount; ++index)
+	{
+		auto bufferData = std::make_shared<std::uint8_t[]>(requestSize);
+
+		std::fill_n(bufferData.get(), requestSize, static_cast<std::uint8_t>(index + 1u));
+
+		requestIDs.emplace_back(
+			m_stagingBufferMan.StreamBuffer(
+				std::move(bufferData), requestSize, &testStorage, index * requestSize
+			)
+		);
+	}
+
+	CopyQueuedBuffers(1u);
+
+	for (std::uint64_t requestID : requestIDs)
+		EXPECT_TRUE(m_stagingBufferMan.IsStreamingRequestComplete(requestID))
+			<< "The request " << requestID << " wasn't completed.";
+
+	std::uint8_t const* storageData = testStorage.CPUHandle();
+
+	for (std::uint8_t index = 0u; index < requestCount; ++index)
+	{
+		const VkDeviceSize requestStart = index * requestSize;
+		const auto expectedValue        = static_cast<std::uint8_t>(index + 1u);
+
+		EXPECT_EQ(storageData[requestStart], expectedValue)
+			<< "The start of the request " << +index << " wasn't copied.";
+		EXPECT_EQ(storageData[requestStart + requestSize - 1u], expectedValue)
+			<< "The end of the request " << +index << " wasn't copied.";
+	}
+}